@@ -247,7 +247,9 @@ typedef struct {
 
   /* FEM */
   PetscBool useCeed;      /* This should convert to a registration system when there are more FEM backends */
-  PetscBool useMatClPerm; /* Use the closure permutation when assembling matrices */
+  PetscBool useMatClPerm;  /* Use the closure permutation when assembling matrices */
+  PetscBool useClDofIndex;   /* Index the closure dofs of the cells in the default sections on first use */
+  PetscBool assemblyThreads; /* Use OpenMP threads in the cell loops of FEM assembly */
 
   /* Debugging */
   PetscBool printSetValues;
@@ -260,6 +262,9 @@ typedef struct {
 
 PETSC_INTERN PetscErrorCode DMPlexCopy_Internal(DM, PetscBool, PetscBool, DM);
 PETSC_INTERN PetscErrorCode DMPlexReplace_Internal(DM, DM *);
+PETSC_INTERN PetscErrorCode DMPlexCreateClosureDofIndex_Internal(DM, PetscSection, PetscSection, PetscBool);
+PETSC_INTERN PetscErrorCode DMPlexVecGetClosures_Internal(DM, PetscSection, Vec, PetscInt, PetscInt, const PetscInt[], PetscInt, PetscScalar[], PetscBool *);
+PETSC_INTERN PetscErrorCode DMPlexVecAddClosures_Internal(DM, PetscSection, Vec, PetscInt, PetscInt, PetscInt, const PetscScalar[], InsertMode, PetscBool *);
 
 PETSC_EXTERN PetscErrorCode DMPlexVTKWriteAll_VTU(DM, PetscViewer);
 PETSC_EXTERN PetscErrorCode VecView_Plex_Local(Vec, PetscViewer);
@@ -474,6 +479,7 @@ PETSC_EXTERN PetscErrorCode DMPlexComputeResidual_Hybrid_Internal(DM, PetscFormK
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Hybrid_Internal(DM, PetscFormKey[], IS, PetscReal, PetscReal, Vec, Vec, Mat, Mat, void *);
 PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Vec, Vec, void *);
+PETSC_EXTERN PetscErrorCode DMPlexComputeJacobian_Diagonal_Internal(DM, PetscFormKey, IS, PetscReal, PetscReal, Vec, Vec, Vec, void *);
 PETSC_EXTERN PetscErrorCode DMPlexReconstructGradients_Internal(DM, PetscFV, PetscInt, PetscInt, Vec, Vec, Vec, Vec);
 
 /* Matvec with A in row-major storage, x and y can be aliased */
@@ -846,6 +852,17 @@ PETSC_INTERN PetscErrorCode DMCreateDomainDecompositionScatters_Plex(DM, PetscIn
 PETSC_INTERN PetscErrorCode DMCreateDomainDecomposition_Plex(DM, PetscInt *, char ***, IS **, IS **, DM **);
 PETSC_INTERN PetscErrorCode DMCreateSectionPermutation_Plex(DM dm, IS *permutation, PetscBT *blockStarts);
 
+/* Get the indexed dofs of the closure of point, or NULL. With -dm_plex_closure_dof_index, the default sections are indexed on first use. */
+static inline PetscErrorCode DMPlexGetClosureDofIndex_Internal(DM dm, PetscSection section, PetscSection idxSection, PetscBool useClPerm, PetscInt point, PetscInt *numDofs, const PetscInt *dofs[])
+{
+  DM_Plex *mesh = (DM_Plex *)dm->data;
+
+  PetscFunctionBeginHot;
+  if (mesh->useClDofIndex && idxSection->clDofObj != (PetscObject)dm && section == dm->localSection && (idxSection == section || idxSection == dm->globalSection)) PetscCall(DMPlexCreateClosureDofIndex_Internal(dm, section, idxSection, useClPerm));
+  PetscCall(PetscSectionGetClosureDofIndex_Internal(idxSection, (PetscObject)dm, section, useClPerm, point, numDofs, dofs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 // Coordinate mapping functions
 PETSC_INTERN void coordMap_identity(PetscInt, PetscInt, PetscInt, const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
 PETSC_INTERN void coordMap_shear(PetscInt, PetscInt, PetscInt, const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], const PetscInt[], const PetscInt[], const PetscScalar[], const PetscScalar[], const PetscScalar[], PetscReal, const PetscReal[], PetscInt, const PetscScalar[], PetscScalar[]);
@@ -388,6 +388,16 @@ struct _MatStash {
   MPI_Datatype    blocktype;
   size_t          blocktype_size;
   InsertMode     *insertmode; /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+
+  /* The following variables are used for the frozen BTS communication, see MAT_FROZEN_OFF_PROC_ENTRIES */
+  PetscBool        freeze;            /* the current assembly records the communication pattern */
+  PetscBool        frozen;            /* the communication pattern has been recorded and the requests are persistent */
+  PetscObjectState frozen_state;      /* value of mat->assembly_frozen_state when the pattern was recorded */
+  PetscInt         frozen_n;          /* number of stashed entries in the recorded assembly */
+  PetscInt        *frozen_block;      /* frozen_block[k] is the send block the k-th stashed entry is packed into */
+  char            *frozen_sendblocks; /* the send blocks, they keep their row and column between assemblies */
+  size_t           frozen_nblocks;    /* number of send blocks */
+  InsertMode       frozen_insertmode; /* insert mode currently encoded in the rows of the send blocks */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -478,6 +488,8 @@ struct _p_Mat {
   PetscBool        symmetry_eternal, structural_symmetry_eternal, spd_eternal;
   PetscBool        nooffprocentries, nooffproczerorows;
   PetscBool        assembly_subset; /* set by MAT_SUBSET_OFF_PROC_ENTRIES */
+  PetscBool        assembly_frozen; /* set by MAT_FROZEN_OFF_PROC_ENTRIES */
+  PetscObjectState assembly_frozen_state; /* increased each time MAT_FROZEN_OFF_PROC_ENTRIES is set, so the stashes record the pattern again */
   PetscBool        submat_singleis; /* for efficient PCSetUp_ASM() */
   PetscBool        structure_only;
   PetscBool        sortedfull;      /* full, sorted rows are inserted */
@@ -581,10 +593,13 @@ struct _p_MatCoarsen {
   PetscReal         threshold; /* HEM can filter interim graphs */
   PetscInt          strength_index_size;
   PetscInt          strength_index[MAT_COARSEN_STRENGTH_INDEX_SIZE];
+  PetscBool         threads; /* use OpenMP threads in the local MIS sweeps, set with -mat_coarsen_threads */
 };
 
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKSetDistance(MatCoarsen, PetscInt);
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen, PetscInt *);
+PETSC_INTERN PetscErrorCode MatCoarsenMISUseThreads_Private(Mat, PetscBool, PetscBool *);
+PETSC_INTERN PetscErrorCode MatCoarsenMISSelect_Threads(Mat, const PetscInt[], const PetscInt[], const PetscInt[], const PetscInt[], const PetscInt[], PetscBool[], PetscBool, PetscInt[], PetscInt *, PetscInt *);
 
 /*
     Used in aijdevice.h
@@ -10,6 +10,7 @@ struct _PCGAMGOps {
   PetscErrorCode (*coarsen)(PC, Mat *, PetscCoarsenData **);
   PetscErrorCode (*prolongator)(PC, Mat, PetscCoarsenData *, Mat *);
   PetscErrorCode (*optprolongator)(PC, Mat, Mat *);
+  PetscErrorCode (*refreshprolongator)(PC, Mat); /* recompute the values of the kept prolongator of the current level */
   PetscErrorCode (*createlevel)(PC, Mat, PetscInt, Mat *, Mat *, PetscMPIInt *, IS *, PetscBool);
   PetscErrorCode (*createdefaultdata)(PC, Mat); /* for data methods that have a default (SA) */
   PetscErrorCode (*setfromoptions)(PC, PetscOptionItems *);
@@ -22,6 +23,7 @@ typedef struct gamg_TAG {
   PetscInt         Nlevels;
   PetscBool        repart;
   PetscBool        reuse_prol;
+  PetscBool        reuse_aggs;
   PetscBool        use_aggs_in_asm;
   PetscBool        use_parallel_coarse_grid_solver;
   PCGAMGLayoutType layout_type;
@@ -52,6 +54,10 @@ typedef struct gamg_TAG {
   PetscBool recompute_esteig;
   PetscInt  injection_index_size;
   PetscInt  injection_index[MAT_COARSEN_STRENGTH_INDEX_SIZE];
+  /* aggregate reuse: tentative prolongator and smoothing products of each level, kept to refresh the prolongator values */
+  PetscInt nprol_kept[PETSC_MG_MAXLEVELS];
+  Mat     *prol_kept[PETSC_MG_MAXLEVELS];
+  IS       prol_colperm[PETSC_MG_MAXLEVELS]; /* columns of the kept prolongator after coarse grid reduction */
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
@@ -214,28 +214,41 @@ struct _PetscFEOps {
   PetscErrorCode (*integrateresidual)(PetscDS, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
   PetscErrorCode (*integratebdresidual)(PetscDS, PetscWeakForm, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
   PetscErrorCode (*integratehybridresidual)(PetscDS, PetscDS, PetscFormKey, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
-  PetscErrorCode (*integratejacobianaction)(PetscFE, PetscDS, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
+  PetscErrorCode (*integratejacobianaction)(PetscDS, PetscFEJacobianType, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, const PetscScalar[], PetscScalar[]);
   PetscErrorCode (*integratejacobian)(PetscDS, PetscFEJacobianType, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
   PetscErrorCode (*integratebdjacobian)(PetscDS, PetscWeakForm, PetscFEJacobianType, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
   PetscErrorCode (*integratehybridjacobian)(PetscDS, PetscDS, PetscFEJacobianType, PetscFormKey, PetscInt, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
 };
 
+/* Factorization of the tabulation of a tensor product Lagrange element into 1D tabulations, used for sum factorization */
+typedef struct {
+  PetscQuadrature quad;     /* The quadrature the factorization was computed for */
+  PetscBool       isTensor; /* The tabulation at quad factors into 1D Lagrange tabulations */
+  PetscInt        Nb, Nq;   /* The number of 1D nodes and 1D quadrature points */
+  PetscReal      *B, *D;    /* 1D basis and derivative tabulation, Nq x Nb */
+  PetscReal      *points;   /* 1D quadrature points */
+  PetscInt       *perm;     /* Basis function for each (component, tensor node index) */
+  PetscInt       *qperm;    /* Quadrature point for each tensor point index */
+} PetscFETensorTabulation;
+
 struct _p_PetscFE {
   PETSCHEADER(struct _PetscFEOps);
-  void           *data;                  /* Implementation object */
-  PetscSpace      basisSpace;            /* The basis space P */
-  PetscDualSpace  dualSpace;             /* The dual space P' */
-  PetscInt        numComponents;         /* The number of field components */
-  PetscQuadrature quadrature;            /* Suitable quadrature on K */
-  PetscQuadrature faceQuadrature;        /* Suitable face quadrature on \partial K */
-  PetscFE        *subspaces;             /* Subspaces for each dimension */
-  PetscReal      *invV;                  /* Change of basis matrix, from prime to nodal basis set */
-  PetscTabulation T;                     /* Tabulation of basis and derivatives at quadrature points */
-  PetscTabulation Tf;                    /* Tabulation of basis and derivatives at quadrature points on each face */
-  PetscTabulation Tc;                    /* Tabulation of basis at face centroids */
-  PetscInt        blockSize, numBlocks;  /* Blocks are processed concurrently */
-  PetscInt        batchSize, numBatches; /* A batch is made up of blocks, Batches are processed in serial */
-  PetscBool       setupcalled;
+  void                   *data;                  /* Implementation object */
+  PetscSpace              basisSpace;            /* The basis space P */
+  PetscDualSpace          dualSpace;             /* The dual space P' */
+  PetscInt                numComponents;         /* The number of field components */
+  PetscQuadrature         quadrature;            /* Suitable quadrature on K */
+  PetscQuadrature         faceQuadrature;        /* Suitable face quadrature on \partial K */
+  PetscFE                *subspaces;             /* Subspaces for each dimension */
+  PetscReal              *invV;                  /* Change of basis matrix, from prime to nodal basis set */
+  PetscTabulation         T;                     /* Tabulation of basis and derivatives at quadrature points */
+  PetscTabulation         Tf;                    /* Tabulation of basis and derivatives at quadrature points on each face */
+  PetscTabulation         Tc;                    /* Tabulation of basis at face centroids */
+  PetscInt                blockSize, numBlocks;  /* Blocks are processed concurrently */
+  PetscInt                batchSize, numBatches; /* A batch is made up of blocks, Batches are processed in serial */
+  PetscInt                sumFactDegree;         /* Lowest degree integrated with sum factorization on tensor product cells, or -1 for none */
+  PetscFETensorTabulation tensor;                /* 1D factorization of T, computed on first use */
+  PetscBool               setupcalled;
 #ifdef PETSC_HAVE_LIBCEED
   Ceed      ceed;      /* The LibCEED context, usually set by the DM */
   CeedBasis ceedBasis; /* Basis for libCEED matching this element */
@@ -458,3 +471,4 @@ PETSC_EXTERN PetscErrorCode PetscFEGetDimension_Basic(PetscFE, PetscInt *);
 PETSC_EXTERN PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscFEIntegrateBdResidual_Basic(PetscDS, PetscWeakForm, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS, PetscFEJacobianType, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, PetscScalar[]);
+PETSC_EXTERN PetscErrorCode PetscFEIntegrateJacobianAction_Basic(PetscDS, PetscFEJacobianType, PetscFormKey, PetscInt, PetscFEGeom *, const PetscScalar[], const PetscScalar[], PetscDS, const PetscScalar[], PetscReal, PetscReal, const PetscScalar[], PetscScalar[]);
@@ -51,6 +51,16 @@ struct _p_PetscSection {
   PetscSection    clSection; /* Section giving the number of points in each closure */
   IS              clPoints;  /* Points in each closure */
   PetscSectionSym sym;       /* Symmetries of the data */
+
+  PetscObject  clDofObj;             /* Key for the closure dof index (right now we only have one) */
+  PetscSection clDofSection;         /* Local section laying out the closures, or NULL if it is this section (local indices) */
+  PetscBool    clDofUseClPerm;       /* The closure dof index follows the closure permutation */
+  PetscInt     clDofStart, clDofEnd; /* Points with an indexed closure */
+  PetscInt    *clDofOff;             /* Offset of the closure of each point in clDofs */
+  PetscInt    *clDofs;               /* Dof indices of each closure, or NULL if the closures could not be indexed */
+  PetscInt     clDofNumColors;       /* Number of colors of the indexed points, so that the closures of points of one color share no dof */
+  PetscInt    *clDofColorOff;        /* Offset of each color in clDofColorPoints, or NULL if the coloring has not been computed */
+  PetscInt    *clDofColorPoints;     /* Indexed points by color, counted from clDofStart */
 };
 
 struct _PetscSectionSymOps {
@@ -80,6 +90,9 @@ struct _p_PetscSectionSym {
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionCopy_Internal(PetscSection, PetscSection, PetscBT);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscInt, PetscCopyMode, PetscInt *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionGetClosureInversePermutation_Internal(PetscSection, PetscObject, PetscInt, PetscInt, const PetscInt *[]);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionSetClosureDofIndex_Internal(PetscSection, PetscObject, PetscSection, PetscBool, PetscInt, PetscInt, PetscInt[], PetscInt[]);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionResetClosureDofIndex_Internal(PetscSection);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode PetscSectionGetClosureDofColoring_Internal(PetscSection, PetscInt *, const PetscInt *[], const PetscInt *[]);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode ISIntersect_Caching_Internal(IS, IS, IS *);
 #if defined(PETSC_HAVE_HDF5)
 PETSC_INTERN PetscErrorCode PetscSectionView_HDF5_Internal(PetscSection, PetscViewer);
@@ -103,6 +116,17 @@ static inline PetscErrorCode PetscSectionInvalidateMaxDof_Internal(PetscSection
   return PETSC_SUCCESS;
 }
 
+/* Get the dof indices of the closure of point set with PetscSectionSetClosureDofIndex_Internal(), or NULL if they are not indexed for this layout */
+static inline PetscErrorCode PetscSectionGetClosureDofIndex_Internal(PetscSection s, PetscObject obj, PetscSection section, PetscBool useClPerm, PetscInt point, PetscInt *numDofs, const PetscInt *dofs[])
+{
+  *dofs = NULL;
+  if (s->clDofObj != obj || !s->clDofs || (s->clDofSection ? s->clDofSection : s) != section || s->clDofUseClPerm != useClPerm) return PETSC_SUCCESS;
+  if (point < s->clDofStart || point >= s->clDofEnd) return PETSC_SUCCESS;
+  *numDofs = s->clDofOff[point - s->clDofStart + 1] - s->clDofOff[point - s->clDofStart];
+  *dofs    = s->clDofs + s->clDofOff[point - s->clDofStart];
+  return PETSC_SUCCESS;
+}
+
 #if defined(PETSC_CLANG_STATIC_ANALYZER)
 void PetscSectionCheckValidField(PetscInt, PetscInt);
 void PetscSectionCheckValidFieldComponent(PetscInt, PetscInt);
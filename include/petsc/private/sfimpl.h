@@ -14,6 +14,7 @@ PETSC_EXTERN PetscLogEvent PETSCSF_BcastBegin;
 PETSC_EXTERN PetscLogEvent PETSCSF_BcastEnd;
 PETSC_EXTERN PetscLogEvent PETSCSF_ReduceBegin;
 PETSC_EXTERN PetscLogEvent PETSCSF_ReduceEnd;
+PETSC_EXTERN PetscLogEvent PETSCSF_Autotune;
 PETSC_EXTERN PetscLogEvent PETSCSF_FetchAndOpBegin;
 PETSC_EXTERN PetscLogEvent PETSCSF_FetchAndOpEnd;
 PETSC_EXTERN PetscLogEvent PETSCSF_EmbedSF;
@@ -53,6 +54,10 @@ struct _PetscSFOps {
   PetscErrorCode (*BcastEnd)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
   PetscErrorCode (*ReduceBegin)(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
   PetscErrorCode (*ReduceEnd)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+  PetscErrorCode (*BcastManyBegin)(PetscSF, PetscInt, const MPI_Datatype *, const PetscMemType *, const void *const *, const PetscMemType *, void *const *, const MPI_Op *);
+  PetscErrorCode (*BcastManyEnd)(PetscSF, PetscInt, const MPI_Datatype *, const void *const *, void *const *, const MPI_Op *);
+  PetscErrorCode (*ReduceManyBegin)(PetscSF, PetscInt, const MPI_Datatype *, const PetscMemType *, const void *const *, const PetscMemType *, void *const *, const MPI_Op *);
+  PetscErrorCode (*ReduceManyEnd)(PetscSF, PetscInt, const MPI_Datatype *, const void *const *, void *const *, const MPI_Op *);
   PetscErrorCode (*FetchAndOpBegin)(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
   PetscErrorCode (*FetchAndOpEnd)(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op);
   PetscErrorCode (*BcastToZero)(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *); /* For internal use only */
@@ -68,7 +73,8 @@ struct _PetscSFOps {
   PetscErrorCode (*Free)(PetscMemType, void *);
 };
 
-typedef struct _n_PetscSFPackOpt *PetscSFPackOpt;
+typedef struct _n_PetscSFPackOpt    *PetscSFPackOpt;
+typedef struct _n_PetscSFThreadPlan *PetscSFThreadPlan;
 
 struct _p_PetscSF {
   PETSCHEADER(struct _PetscSFOps);
@@ -105,6 +111,7 @@ struct _p_PetscSF {
   PetscSFPackOpt leafpackopt[2];   /* Optimization plans to (un)pack leaves connected to remote roots, based on index patterns in rmine[]. NULL for no optimization */
   PetscSFPackOpt leafpackopt_d[2]; /* Copy of leafpackopt_d[] on device if needed */
   PetscBool      leafdups[2];      /* Indices in rmine[] for self(0)/remote(1) communication have dups respectively? TRUE implies threads working on them in parallel may have data race. */
+  PetscSFThreadPlan leafthreadplan[2]; /* Split of rmine[self/remote] among OpenMP threads for host (un)packing, built on demand */
 
   PetscInt       nleafreqs;            /* Number of MPI requests for leaves */
   PetscInt      *rremote;              /* Concatenated array holding remote indices referenced for each remote rank */
@@ -126,6 +133,13 @@ struct _p_PetscSF {
   PetscBool      use_stream_aware_mpi; /* If true, SF assumes the underlying MPI is cuda-stream aware and we won't sync streams for send/recv buffers passed to MPI */
   PetscInt       maxResidentThreadsPerGPU;
   PetscBool      allow_multi_leaves;
+  PetscBool      pack_threads;           /* Use OpenMP threads in host pack/unpack kernels */
+  PetscInt       pack_threads_threshold; /* Minimal size in bytes of a pack/unpack to use threads */
+  PetscBool       autotune;              /* Time candidate types in PetscSFSetUp() and keep the fastest */
+  PetscInt        autotune_its;          /* Number of timed Bcast and Reduce pairs per candidate */
+  PetscInt        autotune_ntypes;       /* Number of candidate types */
+  char          **autotune_types;        /* Candidate types, the default list is used when empty */
+  PetscLogDouble *autotune_time;         /* Measured time of a Bcast and Reduce pair for each candidate, set at setup */
   PetscSFBackend backend; /* The device backend (if any) SF will use */
   void          *data;    /* Pointer to implementation */
 
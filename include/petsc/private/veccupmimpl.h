@@ -1014,6 +1014,7 @@ inline PetscErrorCode Vec_CUPMBase<T, D>::BindToCPU_CUPMBase(Vec v, PetscBool us
   VecSetOp_CUPM(axpy, VecAXPY_Seq, VecSeq_T::AXPY);
   VecSetOp_CUPM(axpby, VecAXPBY_Seq, VecSeq_T::AXPBY);
   VecSetOp_CUPM(maxpy, VecMAXPY_Seq, VecSeq_T::MAXPY);
+  VecSetOp_CUPM(maxpby, VecMAXPBY_Seq, nullptr);
   VecSetOp_CUPM(aypx, VecAYPX_Seq, VecSeq_T::AYPX);
   VecSetOp_CUPM(waxpy, VecWAXPY_Seq, VecSeq_T::WAXPY);
   VecSetOp_CUPM(axpbypcz, VecAXPBYPCZ_Seq, VecSeq_T::AXPBYPCZ);
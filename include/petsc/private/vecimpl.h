@@ -107,6 +107,7 @@ struct _VecOps {
   PetscErrorCode (*setvaluescoo)(Vec, const PetscScalar[], InsertMode);
   PetscErrorCode (*errorwnorm)(Vec, Vec, Vec, NormType, PetscReal, Vec, PetscReal, Vec, PetscReal, PetscReal *, PetscInt *, PetscReal *, PetscInt *, PetscReal *, PetscInt *);
   PetscErrorCode (*maxpby)(Vec, PetscInt, const PetscScalar *, PetscScalar, Vec *); /* y = beta y + alpha[j] x[j] */
+  PetscErrorCode (*maxpymdot)(Vec, PetscInt, const PetscScalar *, Vec *, PetscInt, const Vec[], PetscScalar *); /* y = y + alpha[j] x[j], z[k] = y dot w[k] */
 };
 
 #if defined(offsetof) && (defined(__cplusplus) || (PETSC_C_VERSION >= 23))
@@ -192,6 +193,7 @@ PETSC_EXTERN PetscLogEvent VEC_AXPY;
 PETSC_EXTERN PetscLogEvent VEC_AYPX;
 PETSC_EXTERN PetscLogEvent VEC_WAXPY;
 PETSC_EXTERN PetscLogEvent VEC_MAXPY;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYMDot;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent VEC_PointwiseMult;
 PETSC_EXTERN PetscLogEvent VEC_SetValues;
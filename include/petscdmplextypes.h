@@ -80,6 +80,25 @@ typedef enum {
 } DMPlexCSRAlgorithm;
 PETSC_EXTERN const char *const DMPlexCSRAlgorithms[];
 
+/*E
+  DMPlexSFCType - The space filling curve used to order the cells of a mesh for memory locality
+
+  Values:
++ `DM_PLEX_SFC_NONE`    - Keep the current cell order
+. `DM_PLEX_SFC_MORTON`  - Order cells along the Morton (Z-order) curve through their centroids
+- `DM_PLEX_SFC_HILBERT` - Order cells along the Hilbert curve through their centroids
+
+  Level: intermediate
+
+.seealso: [](ch_dmbase), `DMPLEX`, `DMPlexGetOrderingSFC()`, `DMPlexPermute()`, `DMPlexGetOrdering()`
+E*/
+typedef enum {
+  DM_PLEX_SFC_NONE,
+  DM_PLEX_SFC_MORTON,
+  DM_PLEX_SFC_HILBERT
+} DMPlexSFCType;
+PETSC_EXTERN const char *const DMPlexSFCTypes[];
+
 typedef struct _p_DMPlexPointQueue *DMPlexPointQueue;
 struct _p_DMPlexPointQueue {
   PetscInt  size;   /* Size of the storage array */
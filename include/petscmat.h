@@ -64,6 +64,9 @@ typedef const char *MatType;
 #define MATAIJSELL                   "aijsell"
 #define MATSEQAIJSELL                "seqaijsell"
 #define MATMPIAIJSELL                "mpiaijsell"
+#define MATAIJSINGLE                 "aijsingle"
+#define MATSEQAIJSINGLE              "seqaijsingle"
+#define MATMPIAIJSINGLE              "mpiaijsingle"
 #define MATAIJMKL                    "aijmkl"
 #define MATSEQAIJMKL                 "seqaijmkl"
 #define MATMPIAIJMKL                 "mpiaijmkl"
@@ -278,6 +281,7 @@ typedef const char *MatProductAlgorithm;
 #define MATPRODUCTALGORITHMALLATONCEMERGED "allatonce_merged"
 #define MATPRODUCTALGORITHMALLGATHERV      "allgatherv"
 #define MATPRODUCTALGORITHMCYCLIC          "cyclic"
+#define MATPRODUCTALGORITHMTHREADED        "threaded"
 #if defined(PETSC_HAVE_HYPRE)
   #define MATPRODUCTALGORITHMHYPRE "hypre"
 #endif
@@ -638,7 +642,8 @@ typedef enum {
   MAT_FORM_EXPLICIT_TRANSPOSE     = 24,
   MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25,
   MAT_SPD_ETERNAL                 = 26,
-  MAT_OPTION_MAX                  = 27
+  MAT_FROZEN_OFF_PROC_ENTRIES     = 27,
+  MAT_OPTION_MAX                  = 28
 } MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
@@ -1533,6 +1538,8 @@ typedef struct {
   PetscReal zeropivot;     /* pivot is called zero if less than this */
   PetscReal shifttype;     /* type of shift added to matrix factor to prevent zero pivots */
   PetscReal shiftamount;   /* how large the shift is */
+  PetscReal factorsweeps;  /* ILU: number of fixed-point sweeps computing the factor entries, 0 for the exact factorization */
+  PetscReal solvesweeps;   /* ILU: number of Jacobi sweeps of the triangular solves, 0 for exact triangular solves */
 } MatFactorInfo;
 
 PETSC_EXTERN PetscErrorCode MatFactorInfoInitialize(MatFactorInfo *);
@@ -1587,7 +1594,8 @@ PETSC_EXTERN PetscErrorCode MatSeqDenseInvert(Mat);
 .  `SOR_ZERO_INITIAL_GUESS`    - indicates the initial solution is zero so the sweep can avoid unneeded computation
 .  `SOR_EISENSTAT`             - apply the Eisentat application of SOR, see `PCEISENSTAT`
 .  `SOR_APPLY_UPPER`           - multiply by the upper triangular portion of the matrix
--  `SOR_APPLY_LOWER`           - multiply by the lower triangular portion of the matrix
+.  `SOR_APPLY_LOWER`           - multiply by the lower triangular portion of the matrix
+-  `SOR_MULTICOLOR`            - sweep the rows in a multicolor ordering, so rows of the same color can be relaxed concurrently by threads
 
    Level: beginner
 
@@ -1609,7 +1617,8 @@ typedef enum {
   SOR_ZERO_INITIAL_GUESS    = 16,
   SOR_EISENSTAT             = 32,
   SOR_APPLY_UPPER           = 64,
-  SOR_APPLY_LOWER           = 128
+  SOR_APPLY_LOWER           = 128,
+  SOR_MULTICOLOR            = 256
 } MatSORType;
 PETSC_EXTERN PetscErrorCode MatSOR(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 
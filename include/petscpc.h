@@ -204,6 +204,8 @@ PETSC_EXTERN PetscErrorCode PCFactorSetPivotInBlocks(PC, PetscBool);
 PETSC_EXTERN PetscErrorCode PCFactorSetLevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCFactorGetLevels(PC, PetscInt *);
 PETSC_EXTERN PetscErrorCode PCFactorSetDropTolerance(PC, PetscReal, PetscReal, PetscInt);
+PETSC_EXTERN PetscErrorCode PCFactorSetSweeps(PC, PetscInt, PetscInt);
+PETSC_EXTERN PetscErrorCode PCFactorGetSweeps(PC, PetscInt *, PetscInt *);
 PETSC_EXTERN PetscErrorCode PCFactorGetZeroPivot(PC, PetscReal *);
 PETSC_EXTERN PetscErrorCode PCFactorGetShiftAmount(PC, PetscReal *);
 PETSC_EXTERN PetscErrorCode PCFactorGetShiftType(PC, MatFactorShiftType *);
@@ -336,6 +338,7 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNlevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetAggressiveLevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetReuseAggregates(PC, PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGRegister(PCGAMGType, PetscErrorCode (*)(PC));
@@ -170,6 +170,11 @@ PETSC_EXTERN PetscErrorCode PetscSFBcastWithMemTypeBegin(PetscSF, MPI_Datatype,
 PETSC_EXTERN PetscErrorCode PetscSFReduceBegin(PetscSF, MPI_Datatype, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceEnd(PetscSF, MPI_Datatype, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2);
 PETSC_EXTERN PetscErrorCode PetscSFReduceWithMemTypeBegin(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(6, 2);
+/* Several Bcasts or Reduces on the same SF with aggregated messages */
+PETSC_EXTERN PetscErrorCode PetscSFBcastManyBegin(PetscSF, PetscInt, const MPI_Datatype[], const void *const[], void *const[], const MPI_Op[]);
+PETSC_EXTERN PetscErrorCode PetscSFBcastManyEnd(PetscSF, PetscInt, const MPI_Datatype[], const void *const[], void *const[], const MPI_Op[]);
+PETSC_EXTERN PetscErrorCode PetscSFReduceManyBegin(PetscSF, PetscInt, const MPI_Datatype[], const void *const[], void *const[], const MPI_Op[]);
+PETSC_EXTERN PetscErrorCode PetscSFReduceManyEnd(PetscSF, PetscInt, const MPI_Datatype[], const void *const[], void *const[], const MPI_Op[]);
 
 /* Atomically modifies (using provided operation) rootdata using leafdata from each leaf, value at root at time of modification is returned in leafupdate. */
 PETSC_EXTERN PetscErrorCode PetscSFFetchAndOpBegin(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(3, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(4, 2) PETSC_ATTRIBUTE_MPI_POINTER_WITH_TYPE(5, 2);
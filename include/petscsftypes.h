@@ -31,6 +31,7 @@ typedef const char *PetscSFType;
 #define PETSCSFGATHER     "gather"
 #define PETSCSFALLTOALL   "alltoall"
 #define PETSCSFWINDOW     "window"
+#define PETSCSFHYBRID     "hybrid"
 
 /*S
    PetscSFNode - specifier of owner and index
@@ -34,6 +34,9 @@ class MatType(object):
     AIJSELL         = S_(MATAIJSELL)
     SEQAIJSELL      = S_(MATSEQAIJSELL)
     MPIAIJSELL      = S_(MATMPIAIJSELL)
+    AIJSINGLE       = S_(MATAIJSINGLE)
+    SEQAIJSINGLE    = S_(MATSEQAIJSINGLE)
+    MPIAIJSINGLE    = S_(MATMPIAIJSINGLE)
     AIJMKL          = S_(MATAIJMKL)
     SEQAIJMKL       = S_(MATSEQAIJMKL)
     MPIAIJMKL       = S_(MATMPIAIJMKL)
@@ -127,6 +130,7 @@ class MatOption(object):
     SUBMAT_SINGLEIS             = MAT_SUBMAT_SINGLEIS
     STRUCTURE_ONLY              = MAT_STRUCTURE_ONLY
     SORTED_FULL                 = MAT_SORTED_FULL
+    FROZEN_OFF_PROC_ENTRIES     = MAT_FROZEN_OFF_PROC_ENTRIES
     OPTION_MAX                  = MAT_OPTION_MAX
 
 class MatAssemblyType(object):
@@ -264,6 +268,7 @@ class MatSORType(object):
     EISENSTAT             = SOR_EISENSTAT
     APPLY_UPPER           = SOR_APPLY_UPPER
     APPLY_LOWER           = SOR_APPLY_LOWER
+    MULTICOLOR            = SOR_MULTICOLOR
 
 @cython.internal
 cdef class MatStencil:
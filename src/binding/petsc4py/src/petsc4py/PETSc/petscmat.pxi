@@ -27,6 +27,9 @@ cdef extern from * nogil:
     PetscMatType MATAIJSELL
     PetscMatType   MATSEQAIJSELL
     PetscMatType   MATMPIAIJSELL
+    PetscMatType MATAIJSINGLE
+    PetscMatType   MATSEQAIJSINGLE
+    PetscMatType   MATMPIAIJSINGLE
     PetscMatType MATAIJMKL
     PetscMatType    MATSEQAIJMKL
     PetscMatType    MATMPIAIJMKL
@@ -142,6 +145,7 @@ cdef extern from * nogil:
         SOR_EISENSTAT
         SOR_APPLY_UPPER
         SOR_APPLY_LOWER
+        SOR_MULTICOLOR
 
     ctypedef enum PetscMatProductType "MatProductType":
         MATPRODUCT_UNSPECIFIED
@@ -194,6 +198,7 @@ cdef extern from * nogil:
         MAT_SUBMAT_SINGLEIS
         MAT_STRUCTURE_ONLY
         MAT_SORTED_FULL
+        MAT_FROZEN_OFF_PROC_ENTRIES
         MAT_OPTION_MAX
 
     ctypedef enum PetscMatOperation "MatOperation":
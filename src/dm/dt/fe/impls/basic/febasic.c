@@ -1,5 +1,6 @@
 #include <petsc/private/petscfeimpl.h> /*I "petscfe.h" I*/
 #include <petscblaslapack.h>
+#include <petscdmplex.h>
 
 static PetscErrorCode PetscFEDestroy_Basic(PetscFE fem)
 {
@@ -354,6 +355,507 @@ PETSC_INTERN PetscErrorCode PetscFEIntegrateBd_Basic(PetscDS ds, PetscInt field,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscFEBasicResetTensor_Private(PetscFETensorTabulation *tt)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree5(tt->B, tt->D, tt->points, tt->perm, tt->qperm));
+  PetscCall(PetscQuadratureDestroy(&tt->quad));
+  tt->isTensor = PETSC_FALSE;
+  tt->Nb       = 0;
+  tt->Nq       = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Sort the values of coordinate d of the points into vals[] and remove duplicates */
+static PetscErrorCode PetscFEBasicGetDistinctCoordinates_Private(PetscInt Np, PetscInt dim, PetscInt d, const PetscReal points[], PetscReal tol, PetscInt *n, PetscReal vals[])
+{
+  PetscInt p, k = 0;
+
+  PetscFunctionBegin;
+  for (p = 0; p < Np; ++p) vals[p] = points[p * dim + d];
+  PetscCall(PetscSortReal(Np, vals));
+  for (p = 0; p < Np; ++p) {
+    if (!k || vals[p] - vals[k - 1] > tol) vals[k++] = vals[p];
+  }
+  *n = k;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Return the tensor index of a point whose coordinates all lie in vals[], or -1 */
+static PetscInt PetscFEBasicGetTensorIndex_Private(PetscInt dim, PetscInt n, const PetscReal vals[], const PetscReal point[], PetscReal tol)
+{
+  PetscInt idx = 0;
+
+  for (PetscInt d = 0; d < dim; ++d) {
+    PetscInt i;
+
+    for (i = 0; i < n; ++i)
+      if (PetscAbsReal(point[d] - vals[i]) <= tol) break;
+    if (i == n) return -1;
+    idx = idx * n + i;
+  }
+  return idx;
+}
+
+/* Tabulate the 1D Lagrange basis on nodes[] and its derivative at x */
+static void PetscFEBasicTabulateLagrange1D_Private(PetscInt n, const PetscReal nodes[], PetscReal x, PetscReal B[], PetscReal D[])
+{
+  for (PetscInt j = 0; j < n; ++j) {
+    PetscReal val = 1.0, der = 0.0;
+
+    for (PetscInt i = 0; i < n; ++i) {
+      if (i == j) continue;
+      der = der * (x - nodes[i]) / (nodes[j] - nodes[i]) + val / (nodes[j] - nodes[i]);
+      val *= (x - nodes[i]) / (nodes[j] - nodes[i]);
+    }
+    B[j] = val;
+    D[j] = der;
+  }
+}
+
+/*
+  PetscFEBasicSetUpTensor_Private - Factor the tabulation of a Lagrange element on a tensor product cell into 1D tabulations
+
+  Input Parameter:
+. fem - The `PetscFE`
+
+  Note:
+  The nodes are taken from the point evaluation functionals of the dual space and the 1D tabulation is checked against the full
+  tabulation at the quadrature points, so that any element which is not a tensor product of 1D Lagrange bases is rejected. The
+  factorization is recomputed when the quadrature changes.
+*/
+static PetscErrorCode PetscFEBasicSetUpTensor_Private(PetscFE fem)
+{
+  PetscFETensorTabulation *tt  = &fem->tensor;
+  const PetscReal          tol = PETSC_SQRT_MACHINE_EPSILON;
+  PetscQuadrature          quad;
+  PetscDualSpace           dual;
+  PetscTabulation          T;
+  DM                       dm;
+  DMPolytopeType           ct;
+  const PetscReal         *points;
+  PetscReal               *npoints, *vals, *nodes;
+  PetscInt                *ncomp;
+  PetscInt                 dim, qdim, qNc, Nq, Nb, Nc, k, n, m, nd, nT = 1, mT = 1, i, j, d;
+  PetscBool                isTensor = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFEGetQuadrature(fem, &quad));
+  if (quad == tt->quad) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFEBasicResetTensor_Private(tt));
+  if (!quad) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectReference((PetscObject)quad));
+  tt->quad = quad;
+  PetscCall(PetscFEGetDualSpace(fem, &dual));
+  PetscCall(PetscDualSpaceGetDeRahm(dual, &k));
+  PetscCall(PetscDualSpaceGetDM(dual, &dm));
+  PetscCall(DMGetDimension(dm, &dim));
+  PetscCall(DMPlexGetCellType(dm, 0, &ct));
+  PetscCall(PetscQuadratureGetData(quad, &qdim, &qNc, &Nq, &points, NULL));
+  if (k || qdim != dim || qNc != 1 || (ct != DM_POLYTOPE_SEGMENT && ct != DM_POLYTOPE_QUADRILATERAL && ct != DM_POLYTOPE_HEXAHEDRON)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFEGetCellTabulation(fem, 1, &T));
+  Nb = T->Nb;
+  Nc = T->Nc;
+  PetscCall(PetscMalloc4(Nb * dim, &npoints, Nb, &ncomp, PetscMax(Nb, Nq), &vals, Nb, &nodes));
+  /* The nodes of the point evaluation functionals, and the component each one samples */
+  for (i = 0; i < Nb && isTensor; ++i) {
+    PetscQuadrature  f;
+    const PetscReal *fpoints, *fweights;
+    PetscInt         fNc, fNq, c;
+
+    PetscCall(PetscDualSpaceGetFunctional(dual, i, &f));
+    PetscCall(PetscQuadratureGetData(f, NULL, &fNc, &fNq, &fpoints, &fweights));
+    if (fNq != 1 || fNc != Nc) isTensor = PETSC_FALSE;
+    ncomp[i] = -1;
+    for (c = 0; c < fNc && isTensor; ++c) {
+      if (PetscAbsReal(fweights[c]) <= tol) continue;
+      if (ncomp[i] >= 0) isTensor = PETSC_FALSE;
+      ncomp[i] = c;
+    }
+    if (ncomp[i] < 0) isTensor = PETSC_FALSE;
+    for (d = 0; d < dim && isTensor; ++d) npoints[i * dim + d] = fpoints[d];
+  }
+  /* Every direction must use the same 1D nodes and the same 1D quadrature points */
+  if (isTensor) {
+    PetscCall(PetscFEBasicGetDistinctCoordinates_Private(Nb, dim, 0, npoints, tol, &n, nodes));
+    for (d = 1; d < dim && isTensor; ++d) {
+      PetscCall(PetscFEBasicGetDistinctCoordinates_Private(Nb, dim, d, npoints, tol, &nd, vals));
+      if (nd != n) isTensor = PETSC_FALSE;
+      for (i = 0; i < nd && isTensor; ++i)
+        if (PetscAbsReal(vals[i] - nodes[i]) > tol) isTensor = PETSC_FALSE;
+    }
+  }
+  if (isTensor) {
+    PetscCall(PetscFEBasicGetDistinctCoordinates_Private(Nq, dim, 0, points, tol, &m, vals));
+    PetscCall(PetscMalloc5(m * n, &tt->B, m * n, &tt->D, m, &tt->points, Nb, &tt->perm, Nq, &tt->qperm));
+    PetscCall(PetscArraycpy(tt->points, vals, m));
+    for (d = 1; d < dim && isTensor; ++d) {
+      PetscCall(PetscFEBasicGetDistinctCoordinates_Private(Nq, dim, d, points, tol, &nd, vals));
+      if (nd != m) isTensor = PETSC_FALSE;
+      for (i = 0; i < nd && isTensor; ++i)
+        if (PetscAbsReal(vals[i] - tt->points[i]) > tol) isTensor = PETSC_FALSE;
+    }
+    for (d = 0; d < dim; ++d) {
+      nT *= n;
+      mT *= m;
+    }
+    if (Nb != Nc * nT || Nq != mT) isTensor = PETSC_FALSE;
+  }
+  /* Number the basis functions and quadrature points lexicographically, with the first coordinate varying slowest */
+  if (isTensor) {
+    for (i = 0; i < Nb; ++i) tt->perm[i] = -1;
+    for (i = 0; i < Nq; ++i) tt->qperm[i] = -1;
+    for (i = 0; i < Nb && isTensor; ++i) {
+      const PetscInt idx = PetscFEBasicGetTensorIndex_Private(dim, n, nodes, &npoints[i * dim], tol);
+
+      if (idx < 0 || tt->perm[ncomp[i] * nT + idx] >= 0) isTensor = PETSC_FALSE;
+      else tt->perm[ncomp[i] * nT + idx] = i;
+    }
+    for (i = 0; i < Nq && isTensor; ++i) {
+      const PetscInt idx = PetscFEBasicGetTensorIndex_Private(dim, m, tt->points, &points[i * dim], tol);
+
+      if (idx < 0 || tt->qperm[idx] >= 0) isTensor = PETSC_FALSE;
+      else tt->qperm[idx] = i;
+    }
+  }
+  if (isTensor) {
+    for (i = 0; i < m; ++i) PetscFEBasicTabulateLagrange1D_Private(n, nodes, tt->points[i], &tt->B[i * n], &tt->D[i * n]);
+    /* Check the factorization against the full tabulation */
+    for (i = 0; i < mT && isTensor; ++i) {
+      const PetscInt q = tt->qperm[i];
+
+      for (j = 0; j < Nb && isTensor; ++j) {
+        const PetscInt bf = tt->perm[j], c = j / nT;
+        PetscReal      val = 1.0, der[3] = {1.0, 1.0, 1.0};
+        PetscInt       qi = i, bi = j % nT, cc, e;
+
+        for (d = dim - 1; d >= 0; --d, qi /= m, bi /= n) {
+          val *= tt->B[(qi % m) * n + bi % n];
+          for (e = 0; e < dim; ++e) der[e] *= e == d ? tt->D[(qi % m) * n + bi % n] : tt->B[(qi % m) * n + bi % n];
+        }
+        for (cc = 0; cc < Nc; ++cc) {
+          const PetscInt bcidx = (q * Nb + bf) * Nc + cc;
+
+          if (PetscAbsReal(T->T[0][bcidx] - (cc == c ? val : 0.0)) > tol * (1.0 + PetscAbsReal(val))) isTensor = PETSC_FALSE;
+          for (e = 0; e < dim; ++e)
+            if (PetscAbsReal(T->T[1][bcidx * dim + e] - (cc == c ? der[e] : 0.0)) > tol * (1.0 + PetscAbsReal(der[e]))) isTensor = PETSC_FALSE;
+        }
+      }
+    }
+  }
+  if (isTensor) {
+    tt->isTensor = PETSC_TRUE;
+    tt->Nb      = n;
+    tt->Nq      = m;
+    PetscCall(PetscInfo(fem, "Basis of degree %" PetscInt_FMT " factors into 1D tabulations at %" PetscInt_FMT " points\n", n - 1, m));
+  } else PetscCall(PetscFree5(tt->B, tt->D, tt->points, tt->perm, tt->qperm));
+  PetscCall(PetscFree4(npoints, ncomp, vals, nodes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  PetscFEBasicUseTensor_Private - Decide whether field is integrated with sum factorization
+
+  Input Parameters:
++ ds    - The `PetscDS`
+. field - The field integrated against the test functions
+- cgeom - The cell geometry
+
+  Output Parameter:
+. useTensor - `PETSC_TRUE` if every field is a `PETSCFEBASIC` or `PETSCFEVECTOR` tensor product Lagrange element on the same 1D quadrature, and
+              field has at least the degree given by -petscfe_sum_factorization_degree
+*/
+static PetscErrorCode PetscFEBasicUseTensor_Private(PetscDS ds, PetscInt field, PetscFEGeom *cgeom, PetscBool *useTensor)
+{
+  PetscFETensorTabulation *tt0 = NULL;
+  PetscBool                isCohesive;
+  PetscInt                 Nf, cdim, f, i;
+
+  PetscFunctionBegin;
+  *useTensor = PETSC_FALSE;
+  PetscCall(PetscDSIsCohesive(ds, &isCohesive));
+  PetscCall(PetscDSGetCoordinateDimension(ds, &cdim));
+  if (isCohesive || cgeom->dim != cgeom->dimEmbed || cdim != cgeom->dim) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  for (f = 0; f < Nf; ++f) {
+    PetscObject              obj;
+    PetscClassId             id;
+    PetscFETensorTabulation *tt;
+    PetscBool                isBasic;
+    PetscInt                 k;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, &obj));
+    if (!obj) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(PetscObjectGetClassId(obj, &id));
+    if (id != PETSCFE_CLASSID) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(PetscObjectTypeCompareAny(obj, &isBasic, PETSCFEBASIC, PETSCFEVECTOR, ""));
+    PetscCall(PetscDSGetJetDegree(ds, f, &k));
+    if (!isBasic || k > 1) PetscFunctionReturn(PETSC_SUCCESS);
+    tt = &((PetscFE)obj)->tensor;
+    if (f == field && ((PetscFE)obj)->sumFactDegree < 0) PetscFunctionReturn(PETSC_SUCCESS);
+    PetscCall(PetscFEBasicSetUpTensor_Private((PetscFE)obj));
+    if (!tt->isTensor) PetscFunctionReturn(PETSC_SUCCESS);
+    if (!tt0) tt0 = tt;
+    if (tt->Nq != tt0->Nq) PetscFunctionReturn(PETSC_SUCCESS);
+    for (i = 0; i < tt->Nq; ++i)
+      if (tt->points[i] != tt0->points[i]) PetscFunctionReturn(PETSC_SUCCESS);
+    if (f == field && tt->Nb - 1 < ((PetscFE)obj)->sumFactDegree) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *useTensor = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Apply the m x n matrix M, or its transpose, along one axis of a tensor with pre entries before and post entries after the axis */
+static inline void PetscFEBasicTensorApply_Private(PetscInt pre, PetscInt post, PetscInt m, PetscInt n, const PetscReal M[], PetscBool trans, const PetscScalar in[], PetscScalar out[])
+{
+  const PetscInt nin = trans ? m : n, nout = trans ? n : m;
+
+  for (PetscInt i = 0; i < pre; ++i) {
+    for (PetscInt a = 0; a < nout; ++a) {
+      PetscScalar *o = &out[(i * nout + a) * post];
+
+      for (PetscInt p = 0; p < post; ++p) o[p] = 0.0;
+      for (PetscInt c = 0; c < nin; ++c) {
+        const PetscReal    Mac = trans ? M[c * n + a] : M[a * n + c];
+        const PetscScalar *x   = &in[(i * nin + c) * post];
+
+        for (PetscInt p = 0; p < post; ++p) o[p] += Mac * x[p];
+      }
+    }
+  }
+}
+
+/* Map the n^dim nodal tensor in[] to the m^dim point tensor out[] using M[d] along axis d, or the reverse with the transposes. The work array has 2 max(m, n)^dim entries */
+static void PetscFEBasicTensorInterpolate_Private(PetscInt dim, PetscInt m, PetscInt n, const PetscReal *M[], PetscBool trans, const PetscScalar in[], PetscScalar out[], PetscScalar work[])
+{
+  const PetscInt     nin = trans ? m : n, nout = trans ? n : m;
+  const PetscScalar *src = in;
+  PetscInt           size = 1, pre = 1, post = 1, d;
+
+  for (d = 0; d < dim; ++d) size *= PetscMax(m, n);
+  for (d = 1; d < dim; ++d) post *= nin;
+  for (d = 0; d < dim; ++d) {
+    PetscScalar *dst = d == dim - 1 ? out : &work[(d % 2) * size];
+
+    PetscFEBasicTensorApply_Private(pre, post, m, n, M[d], trans, src, dst);
+    src = dst;
+    pre *= nout;
+    if (d < dim - 1) post /= nin;
+  }
+}
+
+/* Evaluate a field and its reference gradient at the tensor quadrature points, u[q * su + c] and u_x[(q * su + c) * dim + d]. The work array has 4 max(m, n)^dim entries */
+static void PetscFEBasicTensorEvaluate_Private(const PetscFETensorTabulation *tt, PetscInt dim, PetscInt Nc, const PetscScalar coef[], PetscInt su, PetscScalar u[], PetscScalar u_x[], PetscScalar work[])
+{
+  const PetscInt   n = tt->Nb, m = tt->Nq;
+  const PetscReal *M[3];
+  PetscInt         size = 1, nT = 1, mT = 1, c, d, e, i;
+  PetscScalar     *U, *Q;
+
+  for (d = 0; d < dim; ++d) {
+    size *= PetscMax(m, n);
+    nT *= n;
+    mT *= m;
+  }
+  U = work;
+  Q = &work[size];
+  for (c = 0; c < Nc; ++c) {
+    for (i = 0; i < nT; ++i) U[i] = coef[tt->perm[c * nT + i]];
+    for (d = 0; d < dim; ++d) M[d] = tt->B;
+    PetscFEBasicTensorInterpolate_Private(dim, m, n, M, PETSC_FALSE, U, Q, &work[2 * size]);
+    for (i = 0; i < mT; ++i) u[i * su + c] = Q[i];
+    if (!u_x) continue;
+    for (e = 0; e < dim; ++e) {
+      for (d = 0; d < dim; ++d) M[d] = d == e ? tt->D : tt->B;
+      PetscFEBasicTensorInterpolate_Private(dim, m, n, M, PETSC_FALSE, U, Q, &work[2 * size]);
+      for (i = 0; i < mT; ++i) u_x[(i * su + c) * dim + e] = Q[i];
+    }
+  }
+}
+
+/* Add the integral of f0[q * Nc + c] against the basis and of the reference f1[(q * Nc + c) * dim + d] against its reference gradient to elemVec[]. The work array has 4 max(m, n)^dim entries */
+static void PetscFEBasicTensorIntegrate_Private(const PetscFETensorTabulation *tt, PetscInt dim, PetscInt Nc, const PetscScalar f0[], const PetscScalar f1[], PetscScalar elemVec[], PetscScalar work[])
+{
+  const PetscInt   n = tt->Nb, m = tt->Nq;
+  const PetscReal *M[3];
+  PetscInt         size = 1, nT = 1, mT = 1, c, d, e, i;
+  PetscScalar     *U, *Q;
+
+  for (d = 0; d < dim; ++d) {
+    size *= PetscMax(m, n);
+    nT *= n;
+    mT *= m;
+  }
+  U = work;
+  Q = &work[size];
+  for (c = 0; c < Nc; ++c) {
+    for (i = 0; i < mT; ++i) Q[i] = f0[i * Nc + c];
+    for (d = 0; d < dim; ++d) M[d] = tt->B;
+    PetscFEBasicTensorInterpolate_Private(dim, m, n, M, PETSC_TRUE, Q, U, &work[2 * size]);
+    for (i = 0; i < nT; ++i) elemVec[tt->perm[c * nT + i]] += U[i];
+    for (e = 0; e < dim; ++e) {
+      for (i = 0; i < mT; ++i) Q[i] = f1[(i * Nc + c) * dim + e];
+      for (d = 0; d < dim; ++d) M[d] = d == e ? tt->D : tt->B;
+      PetscFEBasicTensorInterpolate_Private(dim, m, n, M, PETSC_TRUE, Q, U, &work[2 * size]);
+      for (i = 0; i < nT; ++i) elemVec[tt->perm[c * nT + i]] += U[i];
+    }
+  }
+}
+
+/* Evaluate all fields of the element at the tensor quadrature points, the gradients are left in reference coordinates */
+static PetscErrorCode PetscFEBasicTensorEvaluateFields_Private(PetscDS ds, PetscInt dim, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscScalar u[], PetscScalar u_x[], PetscScalar u_t[], PetscScalar work[])
+{
+  PetscInt Nf, NcT, f, dOffset = 0, fOffset = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  PetscCall(PetscDSGetTotalComponents(ds, &NcT));
+  for (f = 0; f < Nf; ++f) {
+    PetscFE  fe;
+    PetscInt Nb, Nc;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, (PetscObject *)&fe));
+    PetscCall(PetscFEGetDimension(fe, &Nb));
+    PetscCall(PetscFEGetNumComponents(fe, &Nc));
+    PetscFEBasicTensorEvaluate_Private(&fe->tensor, dim, Nc, &coefficients[dOffset], NcT, &u[fOffset], &u_x[fOffset * dim], work);
+    if (u_t) PetscFEBasicTensorEvaluate_Private(&fe->tensor, dim, Nc, &coefficients_t[dOffset], NcT, &u_t[fOffset], NULL, work);
+    fOffset += Nc;
+    dOffset += Nb;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the largest max(Nb, Nq)^dim over the fields, which sizes the work array shared by the tensor kernels of all fields */
+static PetscErrorCode PetscFEBasicTensorGetWorkSize_Private(PetscDS ds, PetscInt dim, PetscInt *size)
+{
+  PetscInt Nf, f, d;
+
+  PetscFunctionBegin;
+  *size = 1;
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  for (f = 0; f < Nf; ++f) {
+    PetscFE  fe;
+    PetscInt fsize = 1;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, (PetscObject *)&fe));
+    for (d = 0; d < dim; ++d) fsize *= PetscMax(fe->tensor.Nb, fe->tensor.Nq);
+    *size = PetscMax(*size, fsize);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Map the reference gradients of Nv functions at a point to real space, for H1 elements */
+static inline void PetscFEBasicTensorPushforwardGradient_Private(PetscInt dim, const PetscReal invJ[], PetscInt Nv, PetscScalar u_x[])
+{
+  for (PetscInt v = 0; v < Nv; ++v) {
+    PetscScalar tmp[3] = {0.0, 0.0, 0.0};
+
+    for (PetscInt d = 0; d < dim; ++d)
+      for (PetscInt e = 0; e < dim; ++e) tmp[d] += invJ[e * dim + d] * u_x[v * dim + e];
+    for (PetscInt d = 0; d < dim; ++d) u_x[v * dim + d] = tmp[d];
+  }
+}
+
+/* Map the weighted f1 of Nv functions at a point to reference coordinates, so that it can be integrated against the reference gradient */
+static inline void PetscFEBasicTensorPullbackFlux_Private(PetscInt dim, const PetscReal invJ[], PetscReal w, PetscInt Nv, const PetscScalar f1[], PetscScalar f1ref[])
+{
+  for (PetscInt v = 0; v < Nv; ++v) {
+    for (PetscInt e = 0; e < dim; ++e) {
+      PetscScalar tmp = 0.0;
+
+      for (PetscInt d = 0; d < dim; ++d) tmp += invJ[e * dim + d] * f1[v * dim + d];
+      f1ref[v * dim + e] = w * tmp;
+    }
+  }
+}
+
+/*
+  PetscFEIntegrateResidual_Tensor_Private - The residual integration of PetscFEIntegrateResidual_Basic() by sum factorization
+
+  Note:
+  The fields are interpolated to the quadrature points, and the pointwise functions integrated against the test functions, by
+  applying the 1D tabulations one direction at a time. This costs O(p^{d+1}) per element instead of O(p^{2d}) for the full tabulation.
+  Auxiliary fields are still evaluated with the full tabulation.
+*/
+static PetscErrorCode PetscFEIntegrateResidual_Tensor_Private(PetscDS ds, PetscFormKey key, PetscInt Ne, PetscFEGeom *cgeom, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
+{
+  const PetscInt     field = key.field;
+  PetscFE            fe;
+  PetscWeakForm      wf;
+  PetscInt           n0, n1, i;
+  PetscPointFunc    *f0_func, *f1_func;
+  PetscQuadrature    quad;
+  PetscTabulation   *TAux = NULL;
+  PetscScalar       *f1, *uQ, *u_tQ = NULL, *u_xQ, *f0Q, *f1Q, *a = NULL, *a_x = NULL, *work;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, numConstants, Nf, NfAux = 0, NcT, Nc, totDim, totDimAux = 0, cOffset = 0, cOffsetAux = 0, fOffset, size = 1, e;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           Nq, q;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDSGetDiscretization(ds, field, (PetscObject *)&fe));
+  PetscCall(PetscFEGetSpatialDimension(fe, &dim));
+  PetscCall(PetscFEGetQuadrature(fe, &quad));
+  PetscCall(PetscFEGetNumComponents(fe, &Nc));
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  PetscCall(PetscDSGetTotalDimension(ds, &totDim));
+  PetscCall(PetscDSGetTotalComponents(ds, &NcT));
+  PetscCall(PetscDSGetComponentOffsets(ds, &uOff));
+  PetscCall(PetscDSGetComponentDerivativeOffsets(ds, &uOff_x));
+  PetscCall(PetscDSGetFieldOffset(ds, field, &fOffset));
+  PetscCall(PetscDSGetWeakForm(ds, &wf));
+  PetscCall(PetscWeakFormGetResidual(wf, key.label, key.value, key.field, key.part, &n0, &f0_func, &n1, &f1_func));
+  PetscCall(PetscDSGetWorkspace(ds, &x, NULL, NULL, NULL, NULL));
+  PetscCall(PetscDSGetWeakFormArrays(ds, NULL, &f1, NULL, NULL, NULL, NULL));
+  PetscCall(PetscDSGetConstants(ds, &numConstants, &constants));
+  if (dsAux) {
+    PetscCall(PetscDSGetNumFields(dsAux, &NfAux));
+    PetscCall(PetscDSGetTotalDimension(dsAux, &totDimAux));
+    PetscCall(PetscDSGetComponentOffsets(dsAux, &aOff));
+    PetscCall(PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x));
+    PetscCall(PetscDSGetEvaluationArrays(dsAux, &a, NULL, &a_x));
+    PetscCall(PetscDSGetTabulation(dsAux, &TAux));
+  }
+  PetscCall(PetscQuadratureGetData(quad, NULL, NULL, &Nq, &quadPoints, &quadWeights));
+  if (dsAux) PetscCheck(Nq == TAux[0]->Np, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of quadrature points %" PetscInt_FMT " != %" PetscInt_FMT " number of auxiliary tabulation points", Nq, TAux[0]->Np);
+  PetscCall(PetscFEBasicTensorGetWorkSize_Private(ds, dim, &size));
+  PetscCall(PetscMalloc6(Nq * NcT, &uQ, coefficients_t ? Nq * NcT : 0, &u_tQ, Nq * NcT * dim, &u_xQ, Nq * Nc, &f0Q, Nq * Nc * dim, &f1Q, 4 * size, &work));
+  for (e = 0; e < Ne; ++e) {
+    PetscFEGeom fegeom;
+
+    fegeom.v = x; /* workspace */
+    PetscCall(PetscFEGeomGetPoint(cgeom, e, 0, NULL, &fegeom));
+    PetscCall(PetscFEBasicTensorEvaluateFields_Private(ds, dim, &coefficients[cOffset], PetscSafePointerPlusOffset(coefficients_t, cOffset), uQ, u_xQ, coefficients_t ? u_tQ : NULL, work));
+    PetscCall(PetscArrayzero(f0Q, Nq * Nc));
+    PetscCall(PetscArrayzero(f1Q, Nq * Nc * dim));
+    for (q = 0; q < Nq; ++q) {
+      const PetscInt qp = fe->tensor.qperm[q];
+      PetscScalar   *u = &uQ[q * NcT], *u_x = &u_xQ[q * NcT * dim], *u_t = coefficients_t ? &u_tQ[q * NcT] : NULL;
+      PetscReal      w;
+      PetscInt       c;
+
+      PetscCall(PetscFEGeomGetPoint(cgeom, e, qp, &quadPoints[qp * dim], &fegeom));
+      w = fegeom.detJ[0] * quadWeights[qp];
+      PetscFEBasicTensorPushforwardGradient_Private(dim, fegeom.invJ, NcT, u_x);
+      if (dsAux) PetscCall(PetscFEEvaluateFieldJets_Internal(dsAux, NfAux, 0, qp, TAux, &fegeom, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL));
+      for (i = 0; i < n0; ++i) f0_func[i](dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, fegeom.v, numConstants, constants, &f0Q[q * Nc]);
+      for (c = 0; c < Nc; ++c) f0Q[q * Nc + c] *= w;
+      if (n1) {
+        PetscCall(PetscArrayzero(f1, Nc * dim));
+        for (i = 0; i < n1; ++i) f1_func[i](dim, Nf, NfAux, uOff, uOff_x, u, u_t, u_x, aOff, aOff_x, a, NULL, a_x, t, fegeom.v, numConstants, constants, f1);
+        PetscFEBasicTensorPullbackFlux_Private(dim, fegeom.invJ, w, Nc, f1, &f1Q[q * Nc * dim]);
+      }
+    }
+    PetscFEBasicTensorIntegrate_Private(&fe->tensor, dim, Nc, f0Q, f1Q, &elemVec[cOffset + fOffset], work);
+    cOffset += totDim;
+    cOffsetAux += totDimAux;
+  }
+  PetscCall(PetscFree6(uQ, u_tQ, u_xQ, f0Q, f1Q, work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscFormKey key, PetscInt Ne, PetscFEGeom *cgeom, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscScalar elemVec[])
 {
   const PetscInt     debug = 0;
@@ -371,6 +873,7 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscFormKey key, Pets
   PetscInt           dim, numConstants, Nf, NfAux = 0, totDim, totDimAux = 0, cOffset = 0, cOffsetAux = 0, fOffset, e;
   const PetscReal   *quadPoints, *quadWeights;
   PetscInt           qdim, qNc, Nq, q, dE;
+  PetscBool          useTensor;
 
   PetscFunctionBegin;
   PetscCall(PetscDSGetDiscretization(ds, field, (PetscObject *)&fe));
@@ -384,6 +887,11 @@ PetscErrorCode PetscFEIntegrateResidual_Basic(PetscDS ds, PetscFormKey key, Pets
   PetscCall(PetscDSGetWeakForm(ds, &wf));
   PetscCall(PetscWeakFormGetResidual(wf, key.label, key.value, key.field, key.part, &n0, &f0_func, &n1, &f1_func));
   if (!n0 && !n1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFEBasicUseTensor_Private(ds, field, cgeom, &useTensor));
+  if (useTensor) {
+    PetscCall(PetscFEIntegrateResidual_Tensor_Private(ds, key, Ne, cgeom, coefficients, coefficients_t, dsAux, coefficientsAux, t, elemVec));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x));
   PetscCall(PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, NULL, NULL));
   PetscCall(PetscDSGetWeakFormArrays(ds, &f0, &f1, NULL, NULL, NULL, NULL));
@@ -831,6 +1339,162 @@ PetscErrorCode PetscFEIntegrateJacobian_Basic(PetscDS ds, PetscFEJacobianType jt
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  PetscFEIntegrateJacobianAction_Basic - Apply the pointwise Jacobian functions to the values and gradients of fieldJ of y at each
+  quadrature point, and integrate the result against the test functions of fieldI, without forming the element matrix
+
+  Note:
+  When all fields are tensor product Lagrange elements, see PetscFEBasicUseTensor_Private(), the interpolation and integration use
+  sum factorization, otherwise they use the full tabulation.
+*/
+PetscErrorCode PetscFEIntegrateJacobianAction_Basic(PetscDS ds, PetscFEJacobianType jtype, PetscFormKey key, PetscInt Ne, PetscFEGeom *cgeom, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, const PetscScalar y[], PetscScalar z[])
+{
+  PetscFE            feI, feJ;
+  PetscWeakForm      wf;
+  PetscPointJac     *g0_func, *g1_func, *g2_func, *g3_func;
+  PetscInt           n0, n1, n2, n3, i;
+  PetscInt           cOffset    = 0; /* Offset into coefficients[], y[] and z[] for element e */
+  PetscInt           cOffsetAux = 0; /* Offset into coefficientsAux[] for element e */
+  PetscInt           offsetI    = 0; /* Offset into an element vector for fieldI */
+  PetscInt           offsetJ    = 0; /* Offset into an element vector for fieldJ */
+  PetscQuadrature    quad;
+  PetscTabulation   *T, *TAux = NULL;
+  PetscScalar       *g0, *g1, *g2, *g3, *f1, *u, *u_t = NULL, *u_x, *a = NULL, *a_x = NULL, *basisReal, *basisDerReal;
+  PetscScalar       *uQ, *u_tQ, *u_xQ, *yQ, *y_xQ, *f0Q, *f1Q, *work;
+  const PetscScalar *constants;
+  PetscReal         *x;
+  PetscInt          *uOff, *uOff_x, *aOff = NULL, *aOff_x = NULL;
+  PetscInt           dim, dE, numConstants, Nf, fieldI, fieldJ, NfAux = 0, NcT, NcI, NcJ, totDim, totDimAux = 0, size = 1, e;
+  const PetscReal   *quadPoints, *quadWeights;
+  PetscInt           qNc, Nq, q;
+  PetscBool          useTensor;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  fieldI = key.field / Nf;
+  fieldJ = key.field % Nf;
+  PetscCall(PetscDSGetDiscretization(ds, fieldI, (PetscObject *)&feI));
+  PetscCall(PetscDSGetDiscretization(ds, fieldJ, (PetscObject *)&feJ));
+  PetscCall(PetscFEGetSpatialDimension(feI, &dim));
+  PetscCall(PetscFEGetQuadrature(feI, &quad));
+  PetscCall(PetscDSGetTotalDimension(ds, &totDim));
+  PetscCall(PetscDSGetTotalComponents(ds, &NcT));
+  PetscCall(PetscDSGetComponentOffsets(ds, &uOff));
+  PetscCall(PetscDSGetComponentDerivativeOffsets(ds, &uOff_x));
+  PetscCall(PetscDSGetWeakForm(ds, &wf));
+  switch (jtype) {
+  case PETSCFE_JACOBIAN_DYN:
+    PetscCall(PetscWeakFormGetDynamicJacobian(wf, key.label, key.value, fieldI, fieldJ, key.part, &n0, &g0_func, &n1, &g1_func, &n2, &g2_func, &n3, &g3_func));
+    break;
+  case PETSCFE_JACOBIAN_PRE:
+    PetscCall(PetscWeakFormGetJacobianPreconditioner(wf, key.label, key.value, fieldI, fieldJ, key.part, &n0, &g0_func, &n1, &g1_func, &n2, &g2_func, &n3, &g3_func));
+    break;
+  case PETSCFE_JACOBIAN:
+    PetscCall(PetscWeakFormGetJacobian(wf, key.label, key.value, fieldI, fieldJ, key.part, &n0, &g0_func, &n1, &g1_func, &n2, &g2_func, &n3, &g3_func));
+    break;
+  }
+  if (!n0 && !n1 && !n2 && !n3) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFEBasicUseTensor_Private(ds, fieldI, cgeom, &useTensor));
+  PetscCall(PetscDSGetEvaluationArrays(ds, &u, coefficients_t ? &u_t : NULL, &u_x));
+  PetscCall(PetscDSGetWorkspace(ds, &x, &basisReal, &basisDerReal, NULL, NULL));
+  PetscCall(PetscDSGetWeakFormArrays(ds, NULL, &f1, &g0, &g1, &g2, &g3));
+  PetscCall(PetscDSGetTabulation(ds, &T));
+  PetscCall(PetscDSGetFieldOffset(ds, fieldI, &offsetI));
+  PetscCall(PetscDSGetFieldOffset(ds, fieldJ, &offsetJ));
+  PetscCall(PetscDSGetConstants(ds, &numConstants, &constants));
+  if (dsAux) {
+    PetscCall(PetscDSGetNumFields(dsAux, &NfAux));
+    PetscCall(PetscDSGetTotalDimension(dsAux, &totDimAux));
+    PetscCall(PetscDSGetComponentOffsets(dsAux, &aOff));
+    PetscCall(PetscDSGetComponentDerivativeOffsets(dsAux, &aOff_x));
+    PetscCall(PetscDSGetEvaluationArrays(dsAux, &a, NULL, &a_x));
+    PetscCall(PetscDSGetTabulation(dsAux, &TAux));
+    PetscCheck(T[0]->Np == TAux[0]->Np, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Number of tabulation points %" PetscInt_FMT " != %" PetscInt_FMT " number of auxiliary tabulation points", T[0]->Np, TAux[0]->Np);
+  }
+  NcI = T[fieldI]->Nc;
+  NcJ = T[fieldJ]->Nc;
+  dE  = cgeom->dimEmbed;
+  PetscCall(PetscQuadratureGetData(quad, NULL, &qNc, &Nq, &quadPoints, &quadWeights));
+  PetscCheck(qNc == 1, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only supports scalar quadrature, not %" PetscInt_FMT " components", qNc);
+  /* With sum factorization the fields are interpolated to all points at once, otherwise yQ and y_xQ hold one point with room for Hessians */
+  if (useTensor) PetscCall(PetscFEBasicTensorGetWorkSize_Private(ds, dim, &size));
+  PetscCall(PetscMalloc4(useTensor ? Nq * NcT : NcT, &yQ, useTensor ? Nq * NcT * dE : NcT * dE * (dE + 1), &y_xQ, Nq * NcI, &f0Q, Nq * NcI * dE, &f1Q));
+  PetscCall(PetscCalloc4(useTensor ? Nq * NcT : 0, &uQ, useTensor && coefficients_t ? Nq * NcT : 0, &u_tQ, useTensor ? Nq * NcT * dE : 0, &u_xQ, 4 * size, &work));
+  for (e = 0; e < Ne; ++e) {
+    PetscFEGeom fegeom;
+
+    fegeom.v = x; /* workspace */
+    PetscCall(PetscFEGeomGetPoint(cgeom, e, 0, NULL, &fegeom));
+    if (useTensor) {
+      if (coefficients) PetscCall(PetscFEBasicTensorEvaluateFields_Private(ds, dim, &coefficients[cOffset], PetscSafePointerPlusOffset(coefficients_t, cOffset), uQ, u_xQ, coefficients_t ? u_tQ : NULL, work));
+      PetscFEBasicTensorEvaluate_Private(&feJ->tensor, dim, NcJ, &y[cOffset + offsetJ], NcT, &yQ[uOff[fieldJ]], &y_xQ[uOff[fieldJ] * dim], work);
+    }
+    PetscCall(PetscArrayzero(f0Q, Nq * NcI));
+    PetscCall(PetscArrayzero(f1Q, Nq * NcI * dE));
+    for (q = 0; q < Nq; ++q) {
+      const PetscInt qp = useTensor ? feI->tensor.qperm[q] : q;
+      PetscScalar   *uq = u, *u_xq = u_x, *u_tq = u_t, *du, *du_x, *f0q = &f0Q[q * NcI], *f1q = useTensor ? f1 : &f1Q[q * NcI * dE];
+      PetscReal      w;
+      PetscInt       fc, gc, df, dg;
+
+      PetscCall(PetscFEGeomGetPoint(cgeom, e, qp, &quadPoints[qp * dim], &fegeom));
+      w = fegeom.detJ[0] * quadWeights[qp];
+      if (useTensor) {
+        uq   = &uQ[q * NcT];
+        u_xq = &u_xQ[q * NcT * dim];
+        u_tq = coefficients_t ? &u_tQ[q * NcT] : NULL;
+        du   = &yQ[q * NcT + uOff[fieldJ]];
+        du_x = &y_xQ[(q * NcT + uOff[fieldJ]) * dim];
+        if (coefficients) PetscFEBasicTensorPushforwardGradient_Private(dim, fegeom.invJ, NcT, u_xq);
+        PetscFEBasicTensorPushforwardGradient_Private(dim, fegeom.invJ, NcJ, du_x);
+      } else {
+        if (coefficients) PetscCall(PetscFEEvaluateFieldJets_Internal(ds, Nf, 0, q, T, &fegeom, &coefficients[cOffset], PetscSafePointerPlusOffset(coefficients_t, cOffset), u, u_x, u_t));
+        PetscCall(PetscFEEvaluateFieldJets_Internal(ds, Nf, 0, q, T, &fegeom, &y[cOffset], NULL, yQ, y_xQ, NULL));
+        du   = &yQ[uOff[fieldJ]];
+        du_x = &y_xQ[uOff_x[fieldJ]];
+      }
+      if (dsAux) PetscCall(PetscFEEvaluateFieldJets_Internal(dsAux, NfAux, 0, qp, TAux, &fegeom, &coefficientsAux[cOffsetAux], NULL, a, a_x, NULL));
+      if (useTensor) PetscCall(PetscArrayzero(f1q, NcI * dE));
+      if (n0) {
+        PetscCall(PetscArrayzero(g0, NcI * NcJ));
+        for (i = 0; i < n0; ++i) g0_func[i](dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, a, NULL, a_x, t, u_tshift, fegeom.v, numConstants, constants, g0);
+        for (fc = 0; fc < NcI; ++fc)
+          for (gc = 0; gc < NcJ; ++gc) f0q[fc] += w * g0[fc * NcJ + gc] * du[gc];
+      }
+      if (n1) {
+        PetscCall(PetscArrayzero(g1, NcI * NcJ * dE));
+        for (i = 0; i < n1; ++i) g1_func[i](dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, a, NULL, a_x, t, u_tshift, fegeom.v, numConstants, constants, g1);
+        for (fc = 0; fc < NcI; ++fc)
+          for (gc = 0; gc < NcJ; ++gc)
+            for (dg = 0; dg < dE; ++dg) f0q[fc] += w * g1[(fc * NcJ + gc) * dE + dg] * du_x[gc * dE + dg];
+      }
+      if (n2) {
+        PetscCall(PetscArrayzero(g2, NcI * NcJ * dE));
+        for (i = 0; i < n2; ++i) g2_func[i](dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, a, NULL, a_x, t, u_tshift, fegeom.v, numConstants, constants, g2);
+        for (fc = 0; fc < NcI; ++fc)
+          for (gc = 0; gc < NcJ; ++gc)
+            for (df = 0; df < dE; ++df) f1q[fc * dE + df] += w * g2[(fc * NcJ + gc) * dE + df] * du[gc];
+      }
+      if (n3) {
+        PetscCall(PetscArrayzero(g3, NcI * NcJ * dE * dE));
+        for (i = 0; i < n3; ++i) g3_func[i](dim, Nf, NfAux, uOff, uOff_x, uq, u_tq, u_xq, aOff, aOff_x, a, NULL, a_x, t, u_tshift, fegeom.v, numConstants, constants, g3);
+        for (fc = 0; fc < NcI; ++fc)
+          for (gc = 0; gc < NcJ; ++gc)
+            for (df = 0; df < dE; ++df)
+              for (dg = 0; dg < dE; ++dg) f1q[fc * dE + df] += w * g3[((fc * NcJ + gc) * dE + df) * dE + dg] * du_x[gc * dE + dg];
+      }
+      if (useTensor) PetscFEBasicTensorPullbackFlux_Private(dim, fegeom.invJ, 1.0, NcI, f1q, &f1Q[q * NcI * dim]);
+    }
+    if (useTensor) PetscFEBasicTensorIntegrate_Private(&feI->tensor, dim, NcI, f0Q, f1Q, &z[cOffset + offsetI], work);
+    else PetscCall(PetscFEUpdateElementVec_Internal(feI, T[fieldI], 0, basisReal, basisDerReal, e, cgeom, f0Q, f1Q, &z[cOffset + offsetI]));
+    cOffset += totDim;
+    cOffsetAux += totDimAux;
+  }
+  PetscCall(PetscFree4(yQ, y_xQ, f0Q, f1Q));
+  PetscCall(PetscFree4(uQ, u_tQ, u_xQ, work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PetscFEIntegrateBdJacobian_Basic(PetscDS ds, PetscWeakForm wf, PetscFEJacobianType jtype, PetscFormKey key, PetscInt Ne, PetscFEGeom *fgeom, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS dsAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
 {
   const PetscInt     debug = 0;
@@ -1192,7 +1856,7 @@ static PetscErrorCode PetscFEInitialize_Basic(PetscFE fem)
   fem->ops->integrateresidual       = PetscFEIntegrateResidual_Basic;
   fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
   fem->ops->integratehybridresidual = PetscFEIntegrateHybridResidual_Basic;
-  fem->ops->integratejacobianaction = NULL /* PetscFEIntegrateJacobianAction_Basic */;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   fem->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
   fem->ops->integratehybridjacobian = PetscFEIntegrateHybridJacobian_Basic;
@@ -203,7 +203,7 @@ static PetscErrorCode PetscFEInitialize_Composite(PetscFE fem)
   fem->ops->createtabulation        = PetscFECreateTabulation_Composite;
   fem->ops->integrateresidual       = PetscFEIntegrateResidual_Basic;
   fem->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
-  fem->ops->integratejacobianaction = NULL /* PetscFEIntegrateJacobianAction_Basic */;
+  fem->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fem->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -237,7 +237,7 @@ static PetscErrorCode PetscFEInitialize_Vector(PetscFE fe)
   fe->ops->integrateresidual       = PetscFEIntegrateResidual_Basic;
   fe->ops->integratebdresidual     = PetscFEIntegrateBdResidual_Basic;
   fe->ops->integratehybridresidual = PetscFEIntegrateHybridResidual_Basic;
-  fe->ops->integratejacobianaction = NULL;
+  fe->ops->integratejacobianaction = PetscFEIntegrateJacobianAction_Basic;
   fe->ops->integratejacobian       = PetscFEIntegrateJacobian_Basic;
   fe->ops->integratebdjacobian     = PetscFEIntegrateBdJacobian_Basic;
   fe->ops->integratehybridjacobian = PetscFEIntegrateHybridJacobian_Basic;
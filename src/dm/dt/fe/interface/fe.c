@@ -214,8 +214,9 @@ PetscErrorCode PetscFEView(PetscFE fem, PetscViewer viewer)
 . fem - the `PetscFE` object to set options for
 
   Options Database Keys:
-+ -petscfe_num_blocks  - the number of cell blocks to integrate concurrently
-- -petscfe_num_batches - the number of cell batches to integrate serially
++ -petscfe_num_blocks               - the number of cell blocks to integrate concurrently
+. -petscfe_num_batches              - the number of cell batches to integrate serially
+- -petscfe_sum_factorization_degree - the lowest degree of tensor product Lagrange elements on quadrilaterals and hexahedra integrated with sum factorization, -1 to disable it
 
   Level: intermediate
 
@@ -245,6 +246,7 @@ PetscErrorCode PetscFESetFromOptions(PetscFE fem)
   }
   PetscCall(PetscOptionsBoundedInt("-petscfe_num_blocks", "The number of cell blocks to integrate concurrently", "PetscSpaceSetTileSizes", fem->numBlocks, &fem->numBlocks, NULL, 1));
   PetscCall(PetscOptionsBoundedInt("-petscfe_num_batches", "The number of cell batches to integrate serially", "PetscSpaceSetTileSizes", fem->numBatches, &fem->numBatches, NULL, 1));
+  PetscCall(PetscOptionsBoundedInt("-petscfe_sum_factorization_degree", "The lowest degree integrated with sum factorization on tensor product cells", "PetscFEIntegrateResidual", fem->sumFactDegree, &fem->sumFactDegree, NULL, -1));
   PetscTryTypeMethod(fem, setfromoptions, PetscOptionsObject);
   /* process any options handlers added with PetscObjectAddOptionsHandler() */
   PetscCall(PetscObjectProcessOptionsHandlers((PetscObject)fem, PetscOptionsObject));
@@ -312,6 +314,8 @@ PetscErrorCode PetscFEDestroy(PetscFE *fem)
   PetscCall(PetscTabulationDestroy(&(*fem)->T));
   PetscCall(PetscTabulationDestroy(&(*fem)->Tf));
   PetscCall(PetscTabulationDestroy(&(*fem)->Tc));
+  PetscCall(PetscFree5((*fem)->tensor.B, (*fem)->tensor.D, (*fem)->tensor.points, (*fem)->tensor.perm, (*fem)->tensor.qperm));
+  PetscCall(PetscQuadratureDestroy(&(*fem)->tensor.quad));
   PetscCall(PetscSpaceDestroy(&(*fem)->basisSpace));
   PetscCall(PetscDualSpaceDestroy(&(*fem)->dualSpace));
   PetscCall(PetscQuadratureDestroy(&(*fem)->quadrature));
@@ -363,10 +367,12 @@ PetscErrorCode PetscFECreate(MPI_Comm comm, PetscFE *fem)
   f->Tc            = NULL;
   PetscCall(PetscArrayzero(&f->quadrature, 1));
   PetscCall(PetscArrayzero(&f->faceQuadrature, 1));
-  f->blockSize  = 0;
-  f->numBlocks  = 1;
-  f->batchSize  = 0;
-  f->numBatches = 1;
+  f->blockSize     = 0;
+  f->numBlocks     = 1;
+  f->batchSize     = 0;
+  f->numBatches    = 1;
+  f->sumFactDegree = 3;
+  PetscCall(PetscArrayzero(&f->tensor, 1));
 
   *fem = f;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1572,6 +1578,51 @@ PetscErrorCode PetscFEIntegrateJacobian(PetscDS ds, PetscFEJacobianType jtype, P
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  PetscFEIntegrateJacobianAction - Apply the element Jacobian for a chunk of elements to element vectors without forming the element matrices
+
+  Not Collective
+
+  Input Parameters:
++ ds              - The `PetscDS` specifying the discretizations and continuum functions
+. jtype           - The type of matrix pointwise functions that should be used
+. key             - The (label+value, fieldI*Nf + fieldJ) being integrated
+. Ne              - The number of elements in the chunk
+. cgeom           - The cell geometry for each cell in the chunk
+. coefficients    - The array of FEM basis coefficients for the elements for the Jacobian evaluation point
+. coefficients_t  - The array of FEM basis time derivative coefficients for the elements
+. probAux         - The `PetscDS` specifying the auxiliary discretizations
+. coefficientsAux - The array of FEM auxiliary basis coefficients for the elements
+. t               - The time
+. u_tshift        - A multiplier for the dF/du_t term (as opposed to the dF/du term)
+- y               - The array of FEM basis coefficients for the elements of the vector the Jacobian is applied to
+
+  Output Parameter:
+. z - the element vectors, the action is added to the entries for fieldI
+
+  Level: intermediate
+
+  Notes:
+  The pointwise Jacobian functions are applied at each quadrature point to the values and gradients of fieldJ of `y`, and the result is integrated
+  against the test functions of fieldI, so that the work per element is proportional to that of a residual evaluation.
+
+  This is not supported by every `PetscFEType`, nothing is added to `z` if the type has no implementation.
+
+.seealso: `PetscFEIntegrateJacobian()`, `PetscFEIntegrateResidual()`
+@*/
+PetscErrorCode PetscFEIntegrateJacobianAction(PetscDS ds, PetscFEJacobianType jtype, PetscFormKey key, PetscInt Ne, PetscFEGeom *cgeom, const PetscScalar coefficients[], const PetscScalar coefficients_t[], PetscDS probAux, const PetscScalar coefficientsAux[], PetscReal t, PetscReal u_tshift, const PetscScalar y[], PetscScalar z[])
+{
+  PetscFE  fe;
+  PetscInt Nf;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ds, PETSCDS_CLASSID, 1);
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  PetscCall(PetscDSGetDiscretization(ds, key.field / Nf, (PetscObject *)&fe));
+  if (fe->ops->integratejacobianaction) PetscCall((*fe->ops->integratejacobianaction)(ds, jtype, key, Ne, cgeom, coefficients, coefficients_t, probAux, coefficientsAux, t, u_tshift, y, z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscFEIntegrateBdJacobian - Produce the boundary element Jacobian for a chunk of elements by quadrature integration
 
@@ -2866,6 +2866,9 @@ PetscErrorCode DMCreateMatrix_Plex(DM dm, Mat *J)
       PetscCall(MatSetVariableBlockSizes(*J, nblocks, pblocks));
     }
     PetscCall(PetscFree(pblocks));
+  } else {
+    /* DMPlexSNESComputeJacobianFEM() makes this shell a matrix-free Jacobian */
+    PetscCall(PetscObjectCompose((PetscObject)*J, "__PETSc_DMPlex_MatShell", (PetscObject)dm));
   }
   PetscCall(MatSetDM(*J, dm));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -6372,6 +6375,25 @@ PetscErrorCode DMPlexVecGetOrientedClosure_Internal(DM dm, PetscSection section,
     PetscCall(DMPlexVecGetClosure_Depth1_Static(dm, section, v, point, csize, values));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+  if (!ornt && useClPerm) {
+    const PetscInt *cldofs;
+
+    PetscCall(DMPlexGetClosureDofIndex_Internal(dm, section, section, PETSC_TRUE, point, &asize, &cldofs));
+    if (cldofs) {
+      if (values) {
+        const PetscScalar *vArray;
+
+        if (*values) {
+          PetscCheck(*csize >= asize, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Provided array size %" PetscInt_FMT " not sufficient to hold closure size %" PetscInt_FMT, *csize, asize);
+        } else PetscCall(DMGetWorkArray(dm, asize, MPIU_SCALAR, values));
+        PetscCall(VecGetArrayRead(v, &vArray));
+        for (PetscInt i = 0; i < asize; ++i) (*values)[i] = vArray[cldofs[i] < 0 ? -(cldofs[i] + 1) : cldofs[i]];
+        PetscCall(VecRestoreArrayRead(v, &vArray));
+      }
+      if (csize) *csize = asize;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   /* Get points */
   PetscCall(DMPlexGetCompressedClosure(dm, section, point, ornt, &numPoints, &points, &clSection, &clPoints, &clp));
   /* Get sizes */
@@ -6982,6 +7004,42 @@ PetscErrorCode DMPlexVecSetClosure(DM dm, PetscSection section, Vec v, PetscInt
     PetscCall(DMPlexVecSetClosure_Depth1_Static(dm, section, v, point, values, mode));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+  {
+    const PetscInt *cldofs;
+
+    PetscCall(DMPlexGetClosureDofIndex_Internal(dm, section, section, PETSC_TRUE, point, &clsize, &cldofs));
+    if (cldofs) {
+      PetscCall(VecGetArray(v, &array));
+      switch (mode) {
+      case INSERT_VALUES:
+        for (p = 0; p < clsize; ++p)
+          if (cldofs[p] >= 0) array[cldofs[p]] = values[p];
+        break;
+      case INSERT_ALL_VALUES:
+        for (p = 0; p < clsize; ++p) array[cldofs[p] < 0 ? -(cldofs[p] + 1) : cldofs[p]] = values[p];
+        break;
+      case INSERT_BC_VALUES:
+        for (p = 0; p < clsize; ++p)
+          if (cldofs[p] < 0) array[-(cldofs[p] + 1)] = values[p];
+        break;
+      case ADD_VALUES:
+        for (p = 0; p < clsize; ++p)
+          if (cldofs[p] >= 0) array[cldofs[p]] += values[p];
+        break;
+      case ADD_ALL_VALUES:
+        for (p = 0; p < clsize; ++p) array[cldofs[p] < 0 ? -(cldofs[p] + 1) : cldofs[p]] += values[p];
+        break;
+      case ADD_BC_VALUES:
+        for (p = 0; p < clsize; ++p)
+          if (cldofs[p] < 0) array[-(cldofs[p] + 1)] += values[p];
+        break;
+      default:
+        SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+      }
+      PetscCall(VecRestoreArray(v, &array));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   /* Get points */
   PetscCall(DMPlexGetCompressedClosure(dm, section, point, 0, &numPoints, &points, &clSection, &clPoints, &clp));
   for (clsize = 0, p = 0; p < numPoints; p++) {
@@ -8173,6 +8231,15 @@ PetscErrorCode DMPlexMatSetClosure_Internal(DM dm, PetscSection section, PetscSe
   PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
   PetscValidHeaderSpecific(A, MAT_CLASSID, 5);
 
+  if (!mesh->printSetValues && mesh->printFEM <= 1) {
+    const PetscInt *cldofs;
+
+    PetscCall(DMPlexGetClosureDofIndex_Internal(dm, section, globalSection, useClPerm, point, &numIndices, &cldofs));
+    if (cldofs) {
+      PetscCall(MatSetValues(A, numIndices, cldofs, numIndices, cldofs, values, mode));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   PetscCall(DMPlexGetClosureIndices(dm, section, globalSection, point, useClPerm, &numIndices, &indices, NULL, (PetscScalar **)&values));
 
   if (mesh->printSetValues) PetscCall(DMPlexPrintMatSetValues(PETSC_VIEWER_STDOUT_SELF, A, point, numIndices, indices, 0, NULL, values));
@@ -37,6 +37,8 @@ PetscErrorCode DMPlexCopy_Internal(DM dmin, PetscBool copyPeriodicity, PetscBool
   PetscCall(DMPlexGetUseCeed(dmin, &useCeed));
   PetscCall(DMPlexSetUseCeed(dmout, useCeed));
   ((DM_Plex *)dmout->data)->useHashLocation = ((DM_Plex *)dmin->data)->useHashLocation;
+  ((DM_Plex *)dmout->data)->useClDofIndex   = ((DM_Plex *)dmin->data)->useClDofIndex;
+  ((DM_Plex *)dmout->data)->assemblyThreads = ((DM_Plex *)dmin->data)->assemblyThreads;
   ((DM_Plex *)dmout->data)->printSetValues  = ((DM_Plex *)dmin->data)->printSetValues;
   ((DM_Plex *)dmout->data)->printFEM        = ((DM_Plex *)dmin->data)->printFEM;
   ((DM_Plex *)dmout->data)->printFVM        = ((DM_Plex *)dmin->data)->printFVM;
@@ -4139,6 +4141,11 @@ PetscErrorCode DMSetFromOptions_NonRefinement_Plex(DM dm, PetscOptionItems *Pets
   /* Projection behavior */
   PetscCall(PetscOptionsBoundedInt("-dm_plex_max_projection_height", "Maximum mesh point height used to project locally", "DMPlexSetMaxProjectionHeight", 0, &mesh->maxProjectionHeight, NULL, 0));
   PetscCall(PetscOptionsBool("-dm_plex_regular_refinement", "Use special nested projection algorithm for regular refinement", "DMPlexSetRegularRefinement", mesh->regularRefinement, &mesh->regularRefinement, NULL));
+  /* Closure operations */
+  PetscCall(PetscOptionsBool("-dm_plex_closure_dof_index", "Index the closure dofs of each cell for closure operations", "DMPlexCreateClosureDofIndex", mesh->useClDofIndex, &mesh->useClDofIndex, NULL));
+  PetscCall(PetscOptionsBool("-dm_plex_assembly_threads", "Use OpenMP threads in the cell loops of FEM assembly", "DMPlexComputeResidualByKey", mesh->assemblyThreads, &mesh->assemblyThreads, NULL));
+  /* The threaded cell loops gather and scatter with the closure dof index */
+  if (mesh->assemblyThreads) mesh->useClDofIndex = PETSC_TRUE;
   /* Checking structure */
   {
     PetscBool all = PETSC_FALSE;
@@ -4364,6 +4371,27 @@ static PetscErrorCode DMSetFromOptions_Plex(DM dm, PetscOptionItems *PetscOption
     if (saveSF) PetscCall(DMPlexSetMigrationSF(dm, sfMigration));
     PetscCall(PetscSFDestroy(&sfMigration));
   }
+  /* Handle DMPlex space filling curve reordering after distribution */
+  {
+    DMPlexSFCType stype = DM_PLEX_SFC_NONE;
+
+    PetscCall(PetscOptionsEnum("-dm_plex_reorder_sfc", "Reorder the local cells along a space filling curve", "DMPlexGetOrderingSFC", DMPlexSFCTypes, (PetscEnum)stype, (PetscEnum *)&stype, NULL));
+    if (stype != DM_PLEX_SFC_NONE) {
+      DM      pdm;
+      IS      perm;
+      PetscSF face_sf;
+
+      PetscCall(DMPlexGetIsoperiodicFaceSF(dm, &face_sf));
+      PetscCheck(!face_sf, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Space filling curve reordering does not support isoperiodic meshes");
+      PetscCheck(!dm->useNatural, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Space filling curve reordering does not support the natural ordering");
+      PetscCheck(!saveSF, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Space filling curve reordering does not support saving the migration SF");
+      PetscCall(DMPlexGetOrderingSFC(dm, stype, NULL, &perm));
+      PetscCall(DMPlexPermute(dm, perm, &pdm));
+      PetscCall(ISDestroy(&perm));
+      PetscCall(DMPlexReplace_Internal(dm, &pdm));
+      PetscCall(DMSetFromOptions_NonRefinement_Plex(dm, PetscOptionsObject));
+    }
+  }
   /* Must check CEED options before creating function space for coordinates */
   {
     PetscBool useCeed = PETSC_FALSE, flg;
@@ -4768,6 +4796,7 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 + -dm_refine_volume_limit_pre        - Cell volume limit after pre-refinement using generator
 . -dm_distribute                     - Distribute mesh across processes
 . -dm_distribute_overlap             - Number of cells to overlap for distribution
+. -dm_plex_reorder_sfc <type>        - Reorder the local cells along a space filling curve after distribution, see `DMPlexSFCType`
 . -dm_refine                         - Refine mesh after distribution
 . -dm_plex_hash_location             - Use grid hashing for point location
 . -dm_plex_hash_box_faces <n,m,p>    - The number of divisions in each direction of the grid hash
@@ -4775,6 +4804,8 @@ PETSC_INTERN PetscErrorCode DMClone_Plex(DM dm, DM *newdm)
 . -dm_plex_remesh_bd                 - Allow changes to the boundary on remeshing
 . -dm_plex_max_projection_height     - Maximum mesh point height used to project locally
 . -dm_plex_regular_refinement        - Use special nested projection algorithm for regular refinement
+. -dm_plex_closure_dof_index         - Index the closure dofs of each cell in the default sections for closure operations
+. -dm_plex_assembly_threads          - Use OpenMP threads in the cell loops of FEM assembly, with the closure dof index
 . -dm_plex_reorder_section           - Use specialized blocking if available
 . -dm_plex_check_all                 - Perform all checks below
 . -dm_plex_check_symmetry            - Check that the adjacency information in the mesh is symmetric
@@ -1106,7 +1106,7 @@ static PetscErrorCode DMPlexDistributeCones(DM dm, PetscSF migrationSF, ISLocalT
   MPI_Comm     comm;
   PetscSF      coneSF;
   PetscSection originalConeSection, newConeSection;
-  PetscInt    *remoteOffsets, *cones, *globCones, *newCones, newConesSize;
+  PetscInt    *remoteOffsets, *cones, *globCones, *newCones, *orients, *newOrients, newConesSize;
   PetscBool    flg;
 
   PetscFunctionBegin;
@@ -1133,8 +1133,18 @@ static PetscErrorCode DMPlexDistributeCones(DM dm, PetscSF migrationSF, ISLocalT
     globCones = cones;
   }
   PetscCall(DMPlexGetCones(dmParallel, &newCones));
-  PetscCall(PetscSFBcastBegin(coneSF, MPIU_INT, globCones, newCones, MPI_REPLACE));
-  PetscCall(PetscSFBcastEnd(coneSF, MPIU_INT, globCones, newCones, MPI_REPLACE));
+  PetscCall(DMPlexGetConeOrientations(dm, &orients));
+  PetscCall(DMPlexGetConeOrientations(dmParallel, &newOrients));
+  /* Cones and orientations share one message per neighbor */
+  {
+    const MPI_Datatype units[2]    = {MPIU_INT, MPIU_INT};
+    const MPI_Op       ops[2]      = {MPI_REPLACE, MPI_REPLACE};
+    const void *const  rootdata[2] = {globCones, orients};
+    void *const        leafdata[2] = {newCones, newOrients};
+
+    PetscCall(PetscSFBcastManyBegin(coneSF, 2, units, rootdata, leafdata, ops));
+    PetscCall(PetscSFBcastManyEnd(coneSF, 2, units, rootdata, leafdata, ops));
+  }
   if (original) PetscCall(PetscFree(globCones));
   PetscCall(PetscSectionGetStorageSize(newConeSection, &newConesSize));
   PetscCall(ISGlobalToLocalMappingApplyBlock(renumbering, IS_GTOLM_MASK, newConesSize, newCones, NULL, newCones));
@@ -1157,10 +1167,6 @@ static PetscErrorCode DMPlexDistributeCones(DM dm, PetscSF migrationSF, ISLocalT
     PetscCall(PetscSectionView(newConeSection, PETSC_VIEWER_STDOUT_(comm)));
     PetscCall(PetscSFView(coneSF, NULL));
   }
-  PetscCall(DMPlexGetConeOrientations(dm, &cones));
-  PetscCall(DMPlexGetConeOrientations(dmParallel, &newCones));
-  PetscCall(PetscSFBcastBegin(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
-  PetscCall(PetscSFBcastEnd(coneSF, MPIU_INT, cones, newCones, MPI_REPLACE));
   PetscCall(PetscSFDestroy(&coneSF));
   PetscCall(PetscLogEventEnd(DMPLEX_DistributeCones, dm, 0, 0, 0));
   /* Create supports and stratify DMPlex */
@@ -1368,11 +1374,16 @@ static PetscErrorCode DMPlexDistributeSetupTree(DM dm, PetscSF migrationSF, ISLo
     } else {
       globParents = origParents;
     }
-    PetscCall(PetscSFBcastBegin(parentSF, MPIU_INT, globParents, newParents, MPI_REPLACE));
-    PetscCall(PetscSFBcastEnd(parentSF, MPIU_INT, globParents, newParents, MPI_REPLACE));
+    {
+      const MPI_Datatype units[2]    = {MPIU_INT, MPIU_INT};
+      const MPI_Op       ops[2]      = {MPI_REPLACE, MPI_REPLACE};
+      const void *const  rootdata[2] = {globParents, origChildIDs};
+      void *const        leafdata[2] = {newParents, newChildIDs};
+
+      PetscCall(PetscSFBcastManyBegin(parentSF, 2, units, rootdata, leafdata, ops));
+      PetscCall(PetscSFBcastManyEnd(parentSF, 2, units, rootdata, leafdata, ops));
+    }
     if (original) PetscCall(PetscFree(globParents));
-    PetscCall(PetscSFBcastBegin(parentSF, MPIU_INT, origChildIDs, newChildIDs, MPI_REPLACE));
-    PetscCall(PetscSFBcastEnd(parentSF, MPIU_INT, origChildIDs, newChildIDs, MPI_REPLACE));
     PetscCall(ISGlobalToLocalMappingApplyBlock(renumbering, IS_GTOLM_MASK, newParentSize, newParents, NULL, newParents));
     if (PetscDefined(USE_DEBUG)) {
       PetscInt  p;
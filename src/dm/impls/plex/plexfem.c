@@ -3528,6 +3528,7 @@ PetscErrorCode DMPlexGetCellFields(DM dm, IS cellIS, Vec locX, Vec locX_t, Vec l
   PetscDS         prob;
   const PetscInt *cells;
   PetscInt        cStart, cEnd, numCells, totDim, totDimAux, c;
+  PetscBool       doneX, doneX_t = PETSC_TRUE, doneA = PETSC_TRUE;
 
   PetscFunctionBegin;
   PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
@@ -3559,21 +3560,28 @@ PetscErrorCode DMPlexGetCellFields(DM dm, IS cellIS, Vec locX, Vec locX_t, Vec l
   else *u_t = NULL;
   if (locA) PetscCall(DMGetWorkArray(dm, numCells * totDimAux, MPIU_SCALAR, a));
   else *a = NULL;
-  for (c = cStart; c < cEnd; ++c) {
+  /* With -dm_plex_assembly_threads, gather the indexed closures with threads */
+  PetscCall(DMPlexVecGetClosures_Internal(plex, section, locX, cStart, cEnd, cells, totDim, *u, &doneX));
+  if (locX_t) PetscCall(DMPlexVecGetClosures_Internal(plex, section, locX_t, cStart, cEnd, cells, totDim, *u_t, &doneX_t));
+  if (locA && encAux == DM_ENC_EQUALITY) PetscCall(DMPlexVecGetClosures_Internal(plexA, sectionAux, locA, cStart, cEnd, cells, totDimAux, *a, &doneA));
+  else if (locA) doneA = PETSC_FALSE;
+  for (c = cStart; c < cEnd && !(doneX && doneX_t && doneA); ++c) {
     const PetscInt cell = cells ? cells[c] : c;
     const PetscInt cind = c - cStart;
     PetscScalar   *x = NULL, *x_t = NULL, *ul = *u, *ul_t = *u_t, *al = *a;
     PetscInt       i;
 
-    PetscCall(DMPlexVecGetClosure(plex, section, locX, cell, NULL, &x));
-    for (i = 0; i < totDim; ++i) ul[cind * totDim + i] = x[i];
-    PetscCall(DMPlexVecRestoreClosure(plex, section, locX, cell, NULL, &x));
-    if (locX_t) {
+    if (!doneX) {
+      PetscCall(DMPlexVecGetClosure(plex, section, locX, cell, NULL, &x));
+      for (i = 0; i < totDim; ++i) ul[cind * totDim + i] = x[i];
+      PetscCall(DMPlexVecRestoreClosure(plex, section, locX, cell, NULL, &x));
+    }
+    if (!doneX_t) {
       PetscCall(DMPlexVecGetClosure(plex, section, locX_t, cell, NULL, &x_t));
       for (i = 0; i < totDim; ++i) ul_t[cind * totDim + i] = x_t[i];
       PetscCall(DMPlexVecRestoreClosure(plex, section, locX_t, cell, NULL, &x_t));
     }
-    if (locA) {
+    if (!doneA) {
       PetscInt subcell;
       PetscCall(DMGetEnclosurePoint(plexA, dm, encAux, cell, &subcell));
       PetscCall(DMPlexVecGetClosure(plexA, sectionAux, locA, subcell, NULL, &x));
@@ -4877,6 +4885,163 @@ static PetscErrorCode DMPlexComputeBdResidual_Internal(DM dm, Vec locX, Vec locX
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  The FE integration uses the workspace of the PetscDS, so with -dm_plex_assembly_threads each thread integrates
+  its share of the cells with its own copy of the PetscDS. The pointwise functions must be thread safe.
+
+  The DM caches the copies of the last PetscDS it assembled with, replacing them when the PetscDS, its discretizations,
+  or the number of threads change. They share its weak form and get its constants and contexts at each assembly.
+*/
+typedef struct {
+  PetscObjectId id; /* Id of the PetscDS that was copied */
+  PetscInt      Nt;
+  PetscDS      *dsT;
+} DMPlexThreadDS;
+
+static PetscErrorCode DMPlexThreadDSDestroy_Private(void *ctx)
+{
+  DMPlexThreadDS *tds = (DMPlexThreadDS *)ctx;
+
+  PetscFunctionBegin;
+  for (PetscInt t = 0; t < tds->Nt; ++t) PetscCall(PetscDSDestroy(&tds->dsT[t]));
+  PetscCall(PetscFree(tds->dsT));
+  PetscCall(PetscFree(tds));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMPlexThreadDSIsCurrent_Private(PetscDS ds, PetscInt Nt, DMPlexThreadDS *tds, PetscBool *current)
+{
+  PetscObjectId id;
+  PetscWeakForm wf, wfT;
+  PetscInt      Nf, NfT;
+
+  PetscFunctionBegin;
+  *current = PETSC_FALSE;
+  PetscCall(PetscObjectGetId((PetscObject)ds, &id));
+  if (tds->id != id || tds->Nt != Nt) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscDSGetWeakForm(ds, &wf));
+  PetscCall(PetscDSGetWeakForm(tds->dsT[0], &wfT));
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  PetscCall(PetscDSGetNumFields(tds->dsT[0], &NfT));
+  if (wf != wfT || Nf != NfT) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt f = 0; f < Nf; ++f) {
+    PetscObject disc, discT;
+
+    PetscCall(PetscDSGetDiscretization(ds, f, &disc));
+    PetscCall(PetscDSGetDiscretization(tds->dsT[0], f, &discT));
+    if (disc != discT) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *current = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMPlexGetThreadDS_Private(DM dm, PetscDS ds, PetscInt Nt, PetscDS *dsT[])
+{
+  PetscContainer  container;
+  DMPlexThreadDS *tds     = NULL;
+  PetscBool       current = PETSC_FALSE;
+  PetscInt        Nf;
+
+  PetscFunctionBegin;
+  *dsT = NULL;
+  if (!ds) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectQuery((PetscObject)dm, "DMPlexThreadDS", (PetscObject *)&container));
+  if (container) {
+    PetscCall(PetscContainerGetPointer(container, (void **)&tds));
+    PetscCall(DMPlexThreadDSIsCurrent_Private(ds, Nt, tds, &current));
+  }
+  if (!current) {
+    PetscWeakForm wf;
+
+    PetscCall(PetscDSGetWeakForm(ds, &wf));
+    PetscCall(PetscNew(&tds));
+    PetscCall(PetscMalloc1(Nt, &tds->dsT));
+    PetscCall(PetscObjectGetId((PetscObject)ds, &tds->id));
+    tds->Nt = Nt;
+    for (PetscInt t = 0; t < Nt; ++t) {
+      PetscCall(PetscDSCreate(PETSC_COMM_SELF, &tds->dsT[t]));
+      PetscCall(PetscDSCopy(ds, dm, tds->dsT[t]));
+      PetscCall(PetscDSSetWeakForm(tds->dsT[t], wf));
+      PetscCall(PetscDSSetUp(tds->dsT[t]));
+    }
+    /* Composing under the same name destroys the copies of the previous PetscDS */
+    PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+    PetscCall(PetscContainerSetPointer(container, (void *)tds));
+    PetscCall(PetscContainerSetUserDestroy(container, DMPlexThreadDSDestroy_Private));
+    PetscCall(PetscObjectCompose((PetscObject)dm, "DMPlexThreadDS", (PetscObject)container));
+    PetscCall(PetscContainerDestroy(&container));
+  }
+  PetscCall(PetscDSGetNumFields(ds, &Nf));
+  for (PetscInt t = 0; t < Nt; ++t) {
+    PetscCall(PetscDSCopyConstants(ds, tds->dsT[t]));
+    for (PetscInt f = 0; f < Nf; ++f) {
+      void *ctx;
+
+      PetscCall(PetscDSGetContext(ds, f, &ctx));
+      PetscCall(PetscDSSetContext(tds->dsT[t], f, ctx));
+    }
+  }
+  *dsT = tds->dsT;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the number of threads integrating the cells, which is 1 unless PETSc is thread safe and -dm_plex_assembly_threads is given */
+static PetscErrorCode DMPlexGetAssemblyThreads_Private(DM dm, PetscInt numCells, PetscInt *Nt)
+{
+  PetscFunctionBegin;
+  *Nt = 1;
+#if defined(PETSC_HAVE_OPENMP) && defined(PETSC_HAVE_THREADSAFETY)
+  if (((DM_Plex *)dm->data)->assemblyThreads) *Nt = PetscMax(1, PetscMin(PetscNumOMPThreads, numCells));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscFEIntegrateResidual_Threads_Private(PetscInt Nt, PetscDS dsT[], PetscFormKey key, PetscInt Ne, PetscFEGeom *geom, const PetscScalar u[], const PetscScalar u_t[], PetscDS dsAuxT[], const PetscScalar a[], PetscReal t, PetscScalar elemVec[])
+{
+  PetscInt totDim, totDimAux = 0;
+  int      ierr = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDSGetTotalDimension(dsT[0], &totDim));
+  if (dsAuxT) PetscCall(PetscDSGetTotalDimension(dsAuxT[0], &totDimAux));
+  PetscPragmaOMP(parallel for num_threads(Nt) schedule(static, 1) reduction(max : ierr))
+  for (PetscInt tid = 0; tid < Nt; ++tid) {
+    const PetscInt cS = (Ne * tid) / Nt, cE = (Ne * (tid + 1)) / Nt;
+    PetscFEGeom   *chunkGeom = NULL;
+    PetscErrorCode err;
+
+    err = PetscFEGeomGetChunk(geom, cS, cE, &chunkGeom);
+    if (!err) err = PetscFEIntegrateResidual(dsT[tid], key, cE - cS, chunkGeom, &u[cS * totDim], PetscSafePointerPlusOffset(u_t, cS * totDim), dsAuxT ? dsAuxT[tid] : NULL, PetscSafePointerPlusOffset(a, cS * totDimAux), t, &elemVec[cS * totDim]);
+    if (!err) err = PetscFEGeomRestoreChunk(geom, cS, cE, &chunkGeom);
+    ierr = PetscMax(ierr, (int)err);
+  }
+  PetscCall((PetscErrorCode)ierr);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscFEIntegrateJacobian_Threads_Private(PetscInt Nt, PetscDS dsT[], PetscFEJacobianType jtype, PetscFormKey key, PetscInt Ne, PetscFEGeom *geom, const PetscScalar u[], const PetscScalar u_t[], PetscDS dsAuxT[], const PetscScalar a[], PetscReal t, PetscReal u_tshift, PetscScalar elemMat[])
+{
+  PetscInt totDim, totDimAux = 0;
+  int      ierr = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscDSGetTotalDimension(dsT[0], &totDim));
+  if (dsAuxT) PetscCall(PetscDSGetTotalDimension(dsAuxT[0], &totDimAux));
+  PetscPragmaOMP(parallel for num_threads(Nt) schedule(static, 1) reduction(max : ierr))
+  for (PetscInt tid = 0; tid < Nt; ++tid) {
+    const PetscInt cS = (Ne * tid) / Nt, cE = (Ne * (tid + 1)) / Nt;
+    PetscFEGeom   *chunkGeom = NULL;
+    PetscErrorCode err;
+
+    err = PetscFEGeomGetChunk(geom, cS, cE, &chunkGeom);
+    if (!err) err = PetscFEIntegrateJacobian(dsT[tid], jtype, key, cE - cS, chunkGeom, &u[cS * totDim], PetscSafePointerPlusOffset(u_t, cS * totDim), dsAuxT ? dsAuxT[tid] : NULL, PetscSafePointerPlusOffset(a, cS * totDimAux), t, u_tshift, &elemMat[cS * totDim * totDim]);
+    if (!err) err = PetscFEGeomRestoreChunk(geom, cS, cE, &chunkGeom);
+    ierr = PetscMax(ierr, (int)err);
+  }
+  PetscCall((PetscErrorCode)ierr);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS, PetscReal time, Vec locX, Vec locX_t, PetscReal t, Vec locF, void *user)
 {
   DM_Plex        *mesh       = (DM_Plex *)dm->data;
@@ -4901,6 +5066,8 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
   PetscInt        maxDegree  = PETSC_MAX_INT;
   PetscQuadrature affineQuad = NULL, *quads = NULL;
   PetscFEGeom    *affineGeom = NULL, **geoms = NULL;
+  PetscDS        *dsT = NULL, *dsAuxT = NULL;
+  PetscInt        Nt = 1;
 
   PetscFunctionBegin;
   PetscCall(PetscLogEventBegin(DMPLEX_ResidualFEM, dm, 0, 0, 0));
@@ -4977,6 +5144,11 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
   /* Loop over chunks */
   if (useFEM) PetscCall(ISCreate(PETSC_COMM_SELF, &chunkIS));
   numCells      = cEnd - cStart;
+  if (useFEM) PetscCall(DMPlexGetAssemblyThreads_Private(dm, numCells, &Nt));
+  if (Nt > 1) {
+    PetscCall(DMPlexGetThreadDS_Private(dm, ds, Nt, &dsT));
+    PetscCall(DMPlexGetThreadDS_Private(dmAux, dsAux, Nt, &dsAuxT));
+  }
   numChunks     = 1;
   cellChunkSize = numCells / numChunks;
   faceChunkSize = (fEnd - fStart) / numChunks;
@@ -5035,11 +5207,14 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
         offset    = numCells - Nr;
         /* Integrate FE residual to get elemVec (need fields at quadrature points) */
         /*   For FV, I think we use a P0 basis and the cell coefficients (for subdivided cells, we can tweak the basis tabulation to be the indicator function) */
-        PetscCall(PetscFEGeomGetChunk(geom, 0, offset, &chunkGeom));
-        PetscCall(PetscFEIntegrateResidual(ds, key, Ne, chunkGeom, u, u_t, dsAux, a, t, elemVec));
-        PetscCall(PetscFEGeomGetChunk(geom, offset, numCells, &chunkGeom));
-        PetscCall(PetscFEIntegrateResidual(ds, key, Nr, chunkGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), dsAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, &elemVec[offset * totDim]));
-        PetscCall(PetscFEGeomRestoreChunk(geom, offset, numCells, &chunkGeom));
+        if (Nt > 1) PetscCall(PetscFEIntegrateResidual_Threads_Private(Nt, dsT, key, numCells, geom, u, u_t, dsAuxT, a, t, elemVec));
+        else {
+          PetscCall(PetscFEGeomGetChunk(geom, 0, offset, &chunkGeom));
+          PetscCall(PetscFEIntegrateResidual(ds, key, Ne, chunkGeom, u, u_t, dsAux, a, t, elemVec));
+          PetscCall(PetscFEGeomGetChunk(geom, offset, numCells, &chunkGeom));
+          PetscCall(PetscFEIntegrateResidual(ds, key, Nr, chunkGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), dsAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, &elemVec[offset * totDim]));
+          PetscCall(PetscFEGeomRestoreChunk(geom, offset, numCells, &chunkGeom));
+        }
       } else if (id == PETSCFV_CLASSID) {
         PetscFV fv = (PetscFV)obj;
 
@@ -5051,8 +5226,11 @@ PetscErrorCode DMPlexComputeResidual_Internal(DM dm, PetscFormKey key, IS cellIS
     }
     /* Loop over domain */
     if (useFEM) {
+      PetscBool done = PETSC_FALSE;
+
       /* Add elemVec to locX */
-      for (c = cS; c < cE; ++c) {
+      if (!cells && !ghostLabel && mesh->printFEM <= 1) PetscCall(DMPlexVecAddClosures_Internal(dm, section, locF, cS, cE, totDim, elemVec, ADD_ALL_VALUES, &done));
+      for (c = cS; c < cE && !done; ++c) {
         const PetscInt cell = cells ? cells[c] : c;
         const PetscInt cind = c - cStart;
 
@@ -5760,7 +5938,9 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
   const PetscInt *cells;
   PetscInt        Nf, fieldI, fieldJ;
   PetscInt        totDim, totDimAux = 0, cStart, cEnd, numCells, c;
-  PetscBool       hasJac = PETSC_FALSE, hasPrec = PETSC_FALSE, hasDyn, hasFV = PETSC_FALSE, transform;
+  PetscBool       hasJac = PETSC_FALSE, hasPrec = PETSC_FALSE, hasDyn, hasFV = PETSC_FALSE, transform, doneX = PETSC_FALSE, doneX_t = PETSC_TRUE;
+  PetscDS        *probT = NULL, *probAuxT = NULL;
+  PetscInt        Nt;
 
   PetscFunctionBegin;
   PetscCall(PetscLogEventBegin(DMPLEX_JacobianFEM, dm, 0, 0, 0));
@@ -5795,16 +5975,21 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
   PetscCall(PetscMalloc5(numCells * totDim, &u, X_t ? numCells * totDim : 0, &u_t, hasJac ? numCells * totDim * totDim : 0, &elemMat, hasPrec ? numCells * totDim * totDim : 0, &elemMatP, hasDyn ? numCells * totDim * totDim : 0, &elemMatD));
   if (dmAux) PetscCall(PetscMalloc1(numCells * totDimAux, &a));
   PetscCall(DMGetCoordinateField(dm, &coordField));
-  for (c = cStart; c < cEnd; ++c) {
+  /* With -dm_plex_assembly_threads, gather the indexed closures with threads */
+  PetscCall(DMPlexVecGetClosures_Internal(dm, section, X, cStart, cEnd, cells, totDim, u, &doneX));
+  if (X_t) PetscCall(DMPlexVecGetClosures_Internal(dm, section, X_t, cStart, cEnd, cells, totDim, u_t, &doneX_t));
+  for (c = cStart; c < cEnd && !(doneX && doneX_t && !dmAux); ++c) {
     const PetscInt cell = cells ? cells[c] : c;
     const PetscInt cind = c - cStart;
     PetscScalar   *x = NULL, *x_t = NULL;
     PetscInt       i;
 
-    PetscCall(DMPlexVecGetClosure(dm, section, X, cell, NULL, &x));
-    for (i = 0; i < totDim; ++i) u[cind * totDim + i] = x[i];
-    PetscCall(DMPlexVecRestoreClosure(dm, section, X, cell, NULL, &x));
-    if (X_t) {
+    if (!doneX) {
+      PetscCall(DMPlexVecGetClosure(dm, section, X, cell, NULL, &x));
+      for (i = 0; i < totDim; ++i) u[cind * totDim + i] = x[i];
+      PetscCall(DMPlexVecRestoreClosure(dm, section, X, cell, NULL, &x));
+    }
+    if (!doneX_t) {
       PetscCall(DMPlexVecGetClosure(dm, section, X_t, cell, NULL, &x_t));
       for (i = 0; i < totDim; ++i) u_t[cind * totDim + i] = x_t[i];
       PetscCall(DMPlexVecRestoreClosure(dm, section, X_t, cell, NULL, &x_t));
@@ -5820,6 +6005,11 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
   if (hasJac) PetscCall(PetscArrayzero(elemMat, numCells * totDim * totDim));
   if (hasPrec) PetscCall(PetscArrayzero(elemMatP, numCells * totDim * totDim));
   if (hasDyn) PetscCall(PetscArrayzero(elemMatD, numCells * totDim * totDim));
+  PetscCall(DMPlexGetAssemblyThreads_Private(dm, numCells, &Nt));
+  if (Nt > 1) {
+    PetscCall(DMPlexGetThreadDS_Private(dm, prob, Nt, &probT));
+    PetscCall(DMPlexGetThreadDS_Private(dmAux, probAux, Nt, &probAuxT));
+  }
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscClassId    id;
     PetscFE         fe;
@@ -5859,6 +6049,12 @@ PetscErrorCode DMPlexComputeJacobian_Internal(DM dm, PetscFormKey key, IS cellIS
     PetscCall(PetscFEGeomGetChunk(cgeomFEM, offset, numCells, &remGeom));
     for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
       key.field = fieldI * Nf + fieldJ;
+      if (Nt > 1) {
+        if (hasJac) PetscCall(PetscFEIntegrateJacobian_Threads_Private(Nt, probT, PETSCFE_JACOBIAN, key, numCells, cgeomFEM, u, u_t, probAuxT, a, t, X_tShift, elemMat));
+        if (hasPrec) PetscCall(PetscFEIntegrateJacobian_Threads_Private(Nt, probT, PETSCFE_JACOBIAN_PRE, key, numCells, cgeomFEM, u, u_t, probAuxT, a, t, X_tShift, elemMatP));
+        if (hasDyn) PetscCall(PetscFEIntegrateJacobian_Threads_Private(Nt, probT, PETSCFE_JACOBIAN_DYN, key, numCells, cgeomFEM, u, u_t, probAuxT, a, t, X_tShift, elemMatD));
+        continue;
+      }
       if (hasJac) {
         PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, key, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat));
         PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, key, Nr, remGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), probAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, X_tShift, &elemMat[offset * totDim * totDim]));
@@ -6300,11 +6496,12 @@ end:
 - user   - the user context
 
   Output Parameter:
-. Z - Local output vector
+. Z - Local output vector, the action is added to it
 
   Note:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
-  like a GPU, or vectorize on a multicore machine.
+  like a GPU, or vectorize on a multicore machine. When every discretization implements `PetscFEIntegrateJacobianAction()`,
+  the pointwise Jacobian is applied at the quadrature points and no element matrices are formed.
 */
 PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec Y, Vec Z, void *user)
 {
@@ -6319,9 +6516,9 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
   PetscSection    section, globalSection, sectionAux;
   PetscScalar    *elemMat, *elemMatD, *u, *u_t, *a = NULL, *y, *z;
   const PetscInt *cells;
-  PetscInt        Nf, fieldI, fieldJ;
+  PetscInt        Nf, f, fieldI, fieldJ;
   PetscInt        totDim, totDimAux = 0, cStart, cEnd, numCells, c;
-  PetscBool       hasDyn;
+  PetscBool       hasDyn, useAction = mesh->printFEM > 1 ? PETSC_FALSE : PETSC_TRUE;
 
   PetscFunctionBegin;
   if (!cellIS) PetscFunctionReturn(PETSC_SUCCESS);
@@ -6336,6 +6533,16 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
   PetscCall(PetscDSGetTotalDimension(prob, &totDim));
   PetscCall(PetscDSHasDynamicJacobian(prob, &hasDyn));
   hasDyn = hasDyn && (X_tShift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
+  /* Apply the pointwise Jacobian at quadrature points instead of forming element matrices when every discretization supports it */
+  for (f = 0; f < Nf; ++f) {
+    PetscObject  obj;
+    PetscClassId id;
+
+    PetscCall(PetscDSGetDiscretization(prob, f, &obj));
+    if (!obj) continue;
+    PetscCall(PetscObjectGetClassId(obj, &id));
+    if (id != PETSCFE_CLASSID || !((PetscFE)obj)->ops->integratejacobianaction) useAction = PETSC_FALSE;
+  }
   PetscCall(DMGetAuxiliaryVec(dm, key.label, key.value, key.part, &A));
   if (A) {
     PetscCall(VecGetDM(A, &dmAux));
@@ -6345,8 +6552,7 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     PetscCall(DMGetDS(dmAux, &probAux));
     PetscCall(PetscDSGetTotalDimension(probAux, &totDimAux));
   }
-  PetscCall(VecSet(Z, 0.0));
-  PetscCall(PetscMalloc6(numCells * totDim, &u, X_t ? numCells * totDim : 0, &u_t, numCells * totDim * totDim, &elemMat, hasDyn ? numCells * totDim * totDim : 0, &elemMatD, numCells * totDim, &y, totDim, &z));
+  PetscCall(PetscMalloc6(numCells * totDim, &u, X_t ? numCells * totDim : 0, &u_t, useAction ? 0 : numCells * totDim * totDim, &elemMat, hasDyn && !useAction ? numCells * totDim * totDim : 0, &elemMatD, numCells * totDim, &y, useAction ? (hasDyn ? 2 : 1) * numCells * totDim : totDim, &z));
   if (dmAux) PetscCall(PetscMalloc1(numCells * totDimAux, &a));
   PetscCall(DMGetCoordinateField(dm, &coordField));
   for (c = cStart; c < cEnd; ++c) {
@@ -6374,8 +6580,11 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     for (i = 0; i < totDim; ++i) y[cind * totDim + i] = x[i];
     PetscCall(DMPlexVecRestoreClosure(plex, section, Y, cell, NULL, &x));
   }
-  PetscCall(PetscArrayzero(elemMat, numCells * totDim * totDim));
-  if (hasDyn) PetscCall(PetscArrayzero(elemMatD, numCells * totDim * totDim));
+  if (useAction) PetscCall(PetscArrayzero(z, (hasDyn ? 2 : 1) * numCells * totDim));
+  else {
+    PetscCall(PetscArrayzero(elemMat, numCells * totDim * totDim));
+    if (hasDyn) PetscCall(PetscArrayzero(elemMatD, numCells * totDim * totDim));
+  }
   for (fieldI = 0; fieldI < Nf; ++fieldI) {
     PetscFE  fe;
     PetscInt Nb;
@@ -6410,6 +6619,17 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     PetscCall(PetscFEGeomGetChunk(cgeomFEM, offset, numCells, &remGeom));
     for (fieldJ = 0; fieldJ < Nf; ++fieldJ) {
       key.field = fieldI * Nf + fieldJ;
+      if (useAction) {
+        PetscScalar *zD = &z[numCells * totDim];
+
+        PetscCall(PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN, key, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, y, z));
+        PetscCall(PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN, key, Nr, remGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), probAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, X_tShift, &y[offset * totDim], &z[offset * totDim]));
+        if (hasDyn) {
+          PetscCall(PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN_DYN, key, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, y, zD));
+          PetscCall(PetscFEIntegrateJacobianAction(prob, PETSCFE_JACOBIAN_DYN, key, Nr, remGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), probAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, X_tShift, &y[offset * totDim], &zD[offset * totDim]));
+        }
+        continue;
+      }
       PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, key, Ne, chunkGeom, u, u_t, probAux, a, t, X_tShift, elemMat));
       PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, key, Nr, remGeom, &u[offset * totDim], PetscSafePointerPlusOffset(u_t, offset * totDim), probAux, PetscSafePointerPlusOffset(a, offset * totDimAux), t, X_tShift, &elemMat[offset * totDim * totDim]));
       if (hasDyn) {
@@ -6423,7 +6643,10 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     PetscCall(PetscQuadratureDestroy(&qGeom));
   }
   if (hasDyn) {
-    for (c = 0; c < numCells * totDim * totDim; ++c) elemMat[c] += X_tShift * elemMatD[c];
+    if (useAction)
+      for (c = 0; c < numCells * totDim; ++c) z[c] += X_tShift * z[numCells * totDim + c];
+    else
+      for (c = 0; c < numCells * totDim * totDim; ++c) elemMat[c] += X_tShift * elemMatD[c];
   }
   for (c = cStart; c < cEnd; ++c) {
     const PetscInt     cell = cells ? cells[c] : c;
@@ -6431,6 +6654,10 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
     const PetscBLASInt M = totDim, one = 1;
     const PetscScalar  a = 1.0, b = 0.0;
 
+    if (useAction) {
+      PetscCall(DMPlexVecSetClosure(dm, section, Z, cell, &z[cind * totDim], ADD_VALUES));
+      continue;
+    }
     PetscCallBLAS("BLASgemv", BLASgemv_("N", &M, &M, &a, &elemMat[cind * totDim * totDim], &M, &y[cind * totDim], &one, &b, z, &one));
     if (mesh->printFEM > 1) {
       PetscCall(DMPrintCellMatrix(c, name, totDim, totDim, &elemMat[cind * totDim * totDim]));
@@ -6451,3 +6678,145 @@ PetscErrorCode DMPlexComputeJacobian_Action_Internal(DM dm, PetscFormKey key, IS
   PetscCall(PetscLogEventEnd(DMPLEX_JacobianFEM, dm, 0, 0, 0));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/*
+  DMPlexComputeJacobian_Diagonal_Internal - Form the local portion of the diagonal of the Jacobian J(X) at the local solution X using pointwise functions specified by the user.
+
+  Input Parameters:
++ dm     - The mesh
+. key    - The PetscWeakFormKey indicating where integration should happen
+. cellIS - The cells to integrate over
+. t      - The time
+. X_tShift - The multiplier for the Jacobian with respect to X_t
+. X      - Local solution vector
+. X_t    - Time-derivative of the local solution vector
+- user   - the user context
+
+  Output Parameter:
+. D - Local output vector, the diagonal is added to it
+
+  Note:
+  Only the diagonal blocks of the fields are integrated, and the element matrices are formed for one batch of cells
+  at a time, so that the storage does not grow with the number of cells.
+*/
+PetscErrorCode DMPlexComputeJacobian_Diagonal_Internal(DM dm, PetscFormKey key, IS cellIS, PetscReal t, PetscReal X_tShift, Vec X, Vec X_t, Vec D, void *user)
+{
+  DM_Plex        *mesh  = (DM_Plex *)dm->data;
+  DM              dmAux = NULL, plex, plexAux = NULL;
+  DMEnclosureType encAux;
+  Vec             A;
+  DMField         coordField;
+  PetscDS         prob, probAux = NULL;
+  PetscSection    section, sectionAux;
+  PetscScalar    *elemMat, *elemMatD, *u, *u_t, *a = NULL, *d;
+  const PetscInt *cells;
+  PetscInt        Nf, fieldI;
+  PetscInt        totDim, totDimAux = 0, cStart, cEnd, numCells, c;
+  PetscBool       hasDyn;
+
+  PetscFunctionBegin;
+  if (!cellIS) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscLogEventBegin(DMPLEX_JacobianFEM, dm, 0, 0, 0));
+  PetscCall(DMConvert(dm, DMPLEX, &plex));
+  PetscCall(ISGetLocalSize(cellIS, &numCells));
+  PetscCall(ISGetPointRange(cellIS, &cStart, &cEnd, &cells));
+  PetscCall(DMGetLocalSection(dm, &section));
+  PetscCall(DMGetCellDS(dm, cells ? cells[cStart] : cStart, &prob, NULL));
+  PetscCall(PetscDSGetNumFields(prob, &Nf));
+  PetscCall(PetscDSGetTotalDimension(prob, &totDim));
+  PetscCall(PetscDSHasDynamicJacobian(prob, &hasDyn));
+  hasDyn = hasDyn && (X_tShift != 0.0) ? PETSC_TRUE : PETSC_FALSE;
+  PetscCall(DMGetAuxiliaryVec(dm, key.label, key.value, key.part, &A));
+  if (A) {
+    PetscCall(VecGetDM(A, &dmAux));
+    PetscCall(DMGetEnclosureRelation(dmAux, dm, &encAux));
+    PetscCall(DMConvert(dmAux, DMPLEX, &plexAux));
+    PetscCall(DMGetLocalSection(plexAux, &sectionAux));
+    PetscCall(DMGetDS(dmAux, &probAux));
+    PetscCall(PetscDSGetTotalDimension(probAux, &totDimAux));
+  }
+  PetscCall(PetscCalloc3(numCells * totDim, &u, X_t ? numCells * totDim : 0, &u_t, numCells * totDim, &d));
+  if (dmAux) PetscCall(PetscMalloc1(numCells * totDimAux, &a));
+  PetscCall(DMGetCoordinateField(dm, &coordField));
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+    const PetscInt cind = c - cStart;
+    PetscScalar   *x = NULL, *x_t = NULL;
+    PetscInt       i;
+
+    PetscCall(DMPlexVecGetClosure(plex, section, X, cell, NULL, &x));
+    for (i = 0; i < totDim; ++i) u[cind * totDim + i] = x[i];
+    PetscCall(DMPlexVecRestoreClosure(plex, section, X, cell, NULL, &x));
+    if (X_t) {
+      PetscCall(DMPlexVecGetClosure(plex, section, X_t, cell, NULL, &x_t));
+      for (i = 0; i < totDim; ++i) u_t[cind * totDim + i] = x_t[i];
+      PetscCall(DMPlexVecRestoreClosure(plex, section, X_t, cell, NULL, &x_t));
+    }
+    if (dmAux) {
+      PetscInt subcell;
+      PetscCall(DMGetEnclosurePoint(dmAux, dm, encAux, cell, &subcell));
+      PetscCall(DMPlexVecGetClosure(plexAux, sectionAux, A, subcell, NULL, &x));
+      for (i = 0; i < totDimAux; ++i) a[cind * totDimAux + i] = x[i];
+      PetscCall(DMPlexVecRestoreClosure(plexAux, sectionAux, A, subcell, NULL, &x));
+    }
+  }
+  for (fieldI = 0; fieldI < Nf; ++fieldI) {
+    PetscFE         fe;
+    PetscInt        Nb, offsetI, numBlocks, numBatches, batchSize, cS, cE, e, i;
+    PetscQuadrature qGeom = NULL;
+    PetscInt        maxDegree;
+    PetscFEGeom    *cgeomFEM, *chunkGeom = NULL;
+
+    PetscCall(PetscDSGetDiscretization(prob, fieldI, (PetscObject *)&fe));
+    PetscCall(PetscFEGetDimension(fe, &Nb));
+    PetscCall(PetscDSGetFieldOffset(prob, fieldI, &offsetI));
+    PetscCall(PetscFEGetTileSizes(fe, NULL, &numBlocks, NULL, &numBatches));
+    PetscCall(DMFieldGetDegree(coordField, cellIS, NULL, &maxDegree));
+    if (maxDegree <= 1) PetscCall(DMFieldCreateDefaultQuadrature(coordField, cellIS, &qGeom));
+    if (!qGeom) {
+      PetscCall(PetscFEGetQuadrature(fe, &qGeom));
+      PetscCall(PetscObjectReference((PetscObject)qGeom));
+    }
+    PetscCall(DMSNESGetFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(PetscFESetTileSizes(fe, Nb, numBlocks, numBlocks * Nb, numBatches));
+    /* The element matrices of one batch of cells at a time */
+    batchSize = PetscMin(numBatches * numBlocks * Nb, numCells);
+    PetscCall(PetscMalloc2(batchSize * totDim * totDim, &elemMat, hasDyn ? batchSize * totDim * totDim : 0, &elemMatD));
+    key.field = fieldI * Nf + fieldI;
+    for (cS = 0; cS < numCells; cS += batchSize) {
+      cE = PetscMin(cS + batchSize, numCells);
+      PetscCall(PetscFEGeomGetChunk(cgeomFEM, cS, cE, &chunkGeom));
+      PetscCall(PetscArrayzero(elemMat, (cE - cS) * totDim * totDim));
+      PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN, key, cE - cS, chunkGeom, &u[cS * totDim], PetscSafePointerPlusOffset(u_t, cS * totDim), probAux, PetscSafePointerPlusOffset(a, cS * totDimAux), t, X_tShift, elemMat));
+      if (hasDyn) {
+        PetscCall(PetscArrayzero(elemMatD, (cE - cS) * totDim * totDim));
+        PetscCall(PetscFEIntegrateJacobian(prob, PETSCFE_JACOBIAN_DYN, key, cE - cS, chunkGeom, &u[cS * totDim], PetscSafePointerPlusOffset(u_t, cS * totDim), probAux, PetscSafePointerPlusOffset(a, cS * totDimAux), t, X_tShift, elemMatD));
+      }
+      for (e = 0; e < cE - cS; ++e) {
+        for (i = offsetI; i < offsetI + Nb; ++i) {
+          const PetscInt ii = (e * totDim + i) * totDim + i;
+
+          d[(cS + e) * totDim + i] += elemMat[ii] + (hasDyn ? X_tShift * elemMatD[ii] : 0.0);
+        }
+      }
+    }
+    PetscCall(PetscFEGeomRestoreChunk(cgeomFEM, 0, numCells, &chunkGeom));
+    PetscCall(DMSNESRestoreFEGeom(coordField, cellIS, qGeom, PETSC_FALSE, &cgeomFEM));
+    PetscCall(PetscQuadratureDestroy(&qGeom));
+    PetscCall(PetscFree2(elemMat, elemMatD));
+  }
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+    const PetscInt cind = c - cStart;
+
+    if (mesh->printFEM > 1) PetscCall(DMPrintCellVector(cell, "Jacobian diagonal", totDim, &d[cind * totDim]));
+    PetscCall(DMPlexVecSetClosure(dm, section, D, cell, &d[cind * totDim], ADD_VALUES));
+  }
+  PetscCall(PetscFree3(u, u_t, d));
+  PetscCall(ISRestorePointRange(cellIS, &cStart, &cEnd, &cells));
+  PetscCall(PetscFree(a));
+  PetscCall(DMDestroy(&plexAux));
+  PetscCall(DMDestroy(&plex));
+  PetscCall(PetscLogEventEnd(DMPLEX_JacobianFEM, dm, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
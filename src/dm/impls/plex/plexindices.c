@@ -72,3 +72,320 @@ PetscErrorCode DMPlexCreateClosureIndex(DM dm, PetscSection section)
   PetscCall(ISDestroy(&closureIS));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/* Check whether the point symmetries of the closure flip the sign of any dof, which an index cannot express */
+static PetscErrorCode DMPlexClosureHasFlips_Private(PetscSection section, PetscInt Nf, PetscInt Ncl, const PetscInt points[], PetscBool *hasFlips)
+{
+  PetscFunctionBegin;
+  *hasFlips = PETSC_FALSE;
+  for (PetscInt f = 0; f < PetscMax(1, Nf); ++f) {
+    const PetscScalar **flips = NULL;
+
+    if (Nf) PetscCall(PetscSectionGetFieldPointSyms(section, f, Ncl, points, NULL, &flips));
+    else PetscCall(PetscSectionGetPointSyms(section, Ncl, points, NULL, &flips));
+    for (PetscInt p = 0; flips && p < Ncl; ++p)
+      if (flips[p]) *hasFlips = PETSC_TRUE;
+    if (Nf) PetscCall(PetscSectionRestoreFieldPointSyms(section, f, Ncl, points, NULL, &flips));
+    else PetscCall(PetscSectionRestorePointSyms(section, Ncl, points, NULL, &flips));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Gather the local indices of the closure in the order of DMPlexVecGetClosure(), with constrained dofs encoded as -(idx+1) */
+static PetscErrorCode DMPlexGetClosureLocalDofs_Private(PetscSection section, PetscInt Nf, PetscInt Ncl, const PetscInt points[], const PetscInt clperm[], PetscInt dofs[])
+{
+  PetscInt offset = 0;
+
+  PetscFunctionBegin;
+  for (PetscInt f = 0; f < PetscMax(1, Nf); ++f) {
+    const PetscInt **perms = NULL;
+
+    if (Nf) PetscCall(PetscSectionGetFieldPointSyms(section, f, Ncl, points, &perms, NULL));
+    else PetscCall(PetscSectionGetPointSyms(section, Ncl, points, &perms, NULL));
+    for (PetscInt p = 0; p < Ncl; ++p) {
+      const PetscInt  pnt  = points[2 * p];
+      const PetscInt *perm = perms ? perms[p] : NULL;
+      const PetscInt *cdofs;
+      PetscInt        dof, cdof, off, cind = 0;
+
+      if (Nf) {
+        PetscCall(PetscSectionGetFieldDof(section, pnt, f, &dof));
+        PetscCall(PetscSectionGetFieldConstraintDof(section, pnt, f, &cdof));
+        PetscCall(PetscSectionGetFieldOffset(section, pnt, f, &off));
+        if (cdof) PetscCall(PetscSectionGetFieldConstraintIndices(section, pnt, f, &cdofs));
+      } else {
+        PetscCall(PetscSectionGetDof(section, pnt, &dof));
+        PetscCall(PetscSectionGetConstraintDof(section, pnt, &cdof));
+        PetscCall(PetscSectionGetOffset(section, pnt, &off));
+        if (cdof) PetscCall(PetscSectionGetConstraintIndices(section, pnt, &cdofs));
+      }
+      for (PetscInt k = 0; k < dof; ++k) {
+        const PetscInt preind = offset + (perm ? perm[k] : k);
+        const PetscInt ind    = clperm ? clperm[preind] : preind;
+
+        if ((cind < cdof) && (k == cdofs[cind])) {
+          dofs[ind] = -(off + k + 1);
+          ++cind;
+        } else dofs[ind] = off + k;
+      }
+      offset += dof;
+    }
+    if (Nf) PetscCall(PetscSectionRestoreFieldPointSyms(section, f, Ncl, points, &perms, NULL));
+    else PetscCall(PetscSectionRestorePointSyms(section, Ncl, points, &perms, NULL));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexCreateClosureDofIndex_Internal - Index the dofs in the closure of each cell, so that closure operations gather and scatter directly
+
+  Input Parameters:
++ dm         - The `DM`
+. section    - The local section laying out the closures
+. idxSection - The section giving the indices, which is section for the local indices of DMPlexVecGetClosure() and DMPlexVecSetClosure(),
+               or a global section for the indices of DMPlexMatSetClosure()
+- useClPerm  - Whether the indices follow the closure permutation
+
+  Note:
+  If the closures cannot be indexed, because the point symmetries flip signs or (for global indices) there are anchors, the
+  section records this so that the index is not attempted again.
+*/
+PetscErrorCode DMPlexCreateClosureDofIndex_Internal(DM dm, PetscSection section, PetscSection idxSection, PetscBool useClPerm)
+{
+  const PetscBool isLocal = section == idxSection ? PETSC_TRUE : PETSC_FALSE;
+  PetscSection    clSection, aSec = NULL;
+  IS              clPoints;
+  const PetscInt *clp;
+  PetscInt       *points, *off, *dofs = NULL;
+  PetscInt        depth, Nf, Ncl, pStart, pEnd, cStart, cEnd;
+  PetscBool       indexable = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(DMPlexGetDepth(dm, &depth));
+  PetscCall(PetscSectionGetNumFields(section, &Nf));
+  PetscCall(PetscSectionGetChart(section, &pStart, &pEnd));
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  cStart = PetscMax(cStart, pStart);
+  cEnd   = PetscMax(cStart, PetscMin(cEnd, pEnd));
+  if (!isLocal) PetscCall(DMPlexGetAnchors(dm, &aSec, NULL));
+  if (aSec) indexable = PETSC_FALSE;
+  PetscCall(PetscMalloc1(cEnd - cStart + 1, &off));
+  off[0] = 0;
+  for (PetscInt c = cStart; c < cEnd && indexable; ++c) {
+    PetscInt  clsize = 0;
+    PetscBool hasFlips;
+
+    PetscCall(DMPlexGetCompressedClosure(dm, section, c, 0, &Ncl, &points, &clSection, &clPoints, &clp));
+    for (PetscInt p = 0; p < Ncl; ++p) {
+      PetscInt dof;
+
+      PetscCall(PetscSectionGetDof(section, points[2 * p], &dof));
+      clsize += dof;
+    }
+    PetscCall(DMPlexClosureHasFlips_Private(section, Nf, Ncl, points, &hasFlips));
+    PetscCall(DMPlexRestoreCompressedClosure(dm, section, c, &Ncl, &points, &clSection, &clPoints, &clp));
+    if (hasFlips) indexable = PETSC_FALSE;
+    off[c - cStart + 1] = off[c - cStart] + clsize;
+  }
+  if (!indexable) {
+    PetscCall(PetscInfo(dm, "Cannot index the closure dofs of the cells, since %s\n", aSec ? "the mesh has anchors" : "the point symmetries flip signs"));
+    PetscCall(PetscFree(off));
+    PetscCall(PetscSectionSetClosureDofIndex_Internal(idxSection, (PetscObject)dm, section, useClPerm, cStart, cEnd, NULL, NULL));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc1(off[cEnd - cStart], &dofs));
+  for (PetscInt c = cStart; c < cEnd; ++c) {
+    PetscInt *cdofs  = &dofs[off[c - cStart]];
+    PetscInt  clsize = off[c - cStart + 1] - off[c - cStart];
+
+    if (isLocal) {
+      const PetscInt *clperm = NULL;
+
+      /* DMPlexVecGetClosure() and DMPlexVecSetClosure() take the closure permutation of the mesh depth */
+      if (useClPerm) PetscCall(PetscSectionGetClosureInversePermutation_Internal(section, (PetscObject)dm, depth, clsize, &clperm));
+      PetscCall(DMPlexGetCompressedClosure(dm, section, c, 0, &Ncl, &points, &clSection, &clPoints, &clp));
+      PetscCall(DMPlexGetClosureLocalDofs_Private(section, Nf, Ncl, points, clperm, cdofs));
+      PetscCall(DMPlexRestoreCompressedClosure(dm, section, c, &Ncl, &points, &clSection, &clPoints, &clp));
+    } else {
+      PetscInt *idx, Ni;
+
+      PetscCall(DMPlexGetClosureIndices(dm, section, idxSection, c, useClPerm, &Ni, &idx, NULL, NULL));
+      PetscCheck(Ni == clsize, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Closure of cell %" PetscInt_FMT " has %" PetscInt_FMT " indices != %" PetscInt_FMT " dofs", c, Ni, clsize);
+      PetscCall(PetscArraycpy(cdofs, idx, Ni));
+      PetscCall(DMPlexRestoreClosureIndices(dm, section, idxSection, c, useClPerm, &Ni, &idx, NULL, NULL));
+    }
+  }
+  PetscCall(PetscInfo(dm, "Indexed %" PetscInt_FMT " %s closure dofs of %" PetscInt_FMT " cells\n", off[cEnd - cStart], isLocal ? "local" : "global", cEnd - cStart));
+  PetscCall(PetscSectionSetClosureDofIndex_Internal(idxSection, (PetscObject)dm, section, useClPerm, cStart, cEnd, off, dofs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  DMPlexCreateClosureDofIndex - Calculate an index of the dofs in the closure of each cell for the closure operations on the `DM`
+
+  Collective if the default global section has not been created
+
+  Input Parameters:
++ dm            - The `DM`
+. section       - The section describing the layout in the local vector, or `NULL` to use the default section
+- globalSection - The section describing the layout in the global vector, or `NULL` to use the default global section
+
+  Options Database Key:
+. -dm_plex_closure_dof_index - Index the default sections of the `DM` on first use
+
+  Level: intermediate
+
+  Notes:
+  `DMPlexVecGetClosure()`, `DMPlexVecSetClosure()`, and `DMPlexMatSetClosure()` on cells then gather and scatter with the
+  stored indices instead of traversing the closure, at the cost of storing every closure dof of every cell twice. The index
+  respects the orientations and the closure permutation, see `DMPlexGetUseMatClosurePermutation()`, and each cell has its
+  own entry, so meshes with several cell types are handled.
+
+  Sign flips from the point symmetries cannot be expressed in an index, nor can anchors (hanging node constraints) for
+  the matrix closure. In these cases the closure operations keep traversing the closure.
+
+  The index must be recreated if the closure permutation of the sections changes.
+
+.seealso: [](ch_unstructured), `DM`, `DMPLEX`, `PetscSection`, `DMPlexCreateClosureIndex()`, `DMPlexVecGetClosure()`, `DMPlexVecSetClosure()`, `DMPlexMatSetClosure()`
+@*/
+PetscErrorCode DMPlexCreateClosureDofIndex(DM dm, PetscSection section, PetscSection globalSection)
+{
+  PetscBool useClPerm;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  if (!section) PetscCall(DMGetLocalSection(dm, &section));
+  PetscValidHeaderSpecific(section, PETSC_SECTION_CLASSID, 2);
+  if (!globalSection) PetscCall(DMGetGlobalSection(dm, &globalSection));
+  PetscValidHeaderSpecific(globalSection, PETSC_SECTION_CLASSID, 3);
+  PetscCall(DMPlexGetUseMatClosurePermutation(dm, &useClPerm));
+  PetscCall(DMPlexCreateClosureDofIndex_Internal(dm, section, section, PETSC_TRUE));
+  PetscCall(DMPlexCreateClosureDofIndex_Internal(dm, section, globalSection, useClPerm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the closure dof index of the cells, if every cell is indexed with exactly stride dofs */
+static PetscErrorCode DMPlexGetCellClosureDofIndex_Private(DM dm, PetscSection section, PetscInt cStart, PetscInt cEnd, const PetscInt cells[], PetscInt stride, const PetscInt *off[], const PetscInt *dofs[])
+{
+  const PetscInt *cldofs = NULL;
+  PetscInt        n      = 0;
+
+  PetscFunctionBegin;
+  *off  = NULL;
+  *dofs = NULL;
+  PetscCall(DMPlexGetClosureDofIndex_Internal(dm, section, section, PETSC_TRUE, cells ? cells[cStart] : cStart, &n, &cldofs));
+  if (!cldofs) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt c = cStart; c < cEnd; ++c) {
+    const PetscInt cell = cells ? cells[c] : c;
+
+    if (cell < section->clDofStart || cell >= section->clDofEnd) PetscFunctionReturn(PETSC_SUCCESS);
+    if (section->clDofOff[cell - section->clDofStart + 1] - section->clDofOff[cell - section->clDofStart] != stride) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *off  = section->clDofOff;
+  *dofs = section->clDofs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexVecGetClosures_Internal - Gather the closures of the cells [cStart, cEnd) of a local vector with OpenMP threads, using the closure dof index
+
+  Input Parameters:
++ dm      - The `DM`
+. section - The local section
+. v       - The local vector
+. cStart  - The first cell
+. cEnd    - One past the last cell
+. cells   - The cell numbers, or `NULL` if the cells are [cStart, cEnd)
+- stride  - The closure size of each cell
+
+  Output Parameters:
++ values - The closure of cell c is stored at values[(c - cStart) * stride]
+- done   - `PETSC_FALSE` if nothing was gathered, because -dm_plex_assembly_threads is not set or the closures are not all indexed with stride dofs
+
+  Note:
+  The values are the same as `DMPlexVecGetClosure()` gives for each cell.
+*/
+PetscErrorCode DMPlexVecGetClosures_Internal(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, const PetscInt cells[], PetscInt stride, PetscScalar values[], PetscBool *done)
+{
+  DM_Plex           *mesh = (DM_Plex *)dm->data;
+  const PetscScalar *array;
+  const PetscInt    *off, *dofs;
+  PetscInt           pStart;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  if (!mesh->assemblyThreads || cStart >= cEnd) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(DMPlexGetCellClosureDofIndex_Private(dm, section, cStart, cEnd, cells, stride, &off, &dofs));
+  if (!dofs) PetscFunctionReturn(PETSC_SUCCESS);
+  pStart = section->clDofStart;
+  PetscCall(VecGetArrayRead(v, &array));
+  PetscPragmaOMP(parallel for num_threads(PetscNumOMPThreads) schedule(static))
+  for (PetscInt c = cStart; c < cEnd; ++c) {
+    const PetscInt  cell  = cells ? cells[c] : c;
+    const PetscInt *cdofs = &dofs[off[cell - pStart]];
+    PetscScalar    *cvals = &values[(c - cStart) * stride];
+
+    for (PetscInt i = 0; i < stride; ++i) cvals[i] = array[cdofs[i] < 0 ? -(cdofs[i] + 1) : cdofs[i]];
+  }
+  PetscCall(VecRestoreArrayRead(v, &array));
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexVecAddClosures_Internal - Add values on the closures of the cells [cStart, cEnd) into a local vector with OpenMP threads, using the closure dof index
+
+  Input Parameters:
++ dm      - The `DM`
+. section - The local section
+. v       - The local vector
+. cStart  - The first cell
+. cEnd    - One past the last cell
+. stride  - The closure size of each cell
+. values  - The closure values of cell c are stored at values[(c - cStart) * stride]
+- mode    - `ADD_VALUES` or `ADD_ALL_VALUES`
+
+  Output Parameter:
+. done - `PETSC_FALSE` if nothing was added, because -dm_plex_assembly_threads is not set or the closures are not all indexed with stride dofs
+
+  Note:
+  The cells are added one color of the closure dof coloring at a time, so that no two threads update the same dof. The sums
+  agree with `DMPlexVecSetClosure()` on each cell up to the order of the additions.
+*/
+PetscErrorCode DMPlexVecAddClosures_Internal(DM dm, PetscSection section, Vec v, PetscInt cStart, PetscInt cEnd, PetscInt stride, const PetscScalar values[], InsertMode mode, PetscBool *done)
+{
+  DM_Plex        *mesh = (DM_Plex *)dm->data;
+  PetscScalar    *array;
+  const PetscInt *off, *dofs, *colorOff, *colorPoints;
+  PetscInt        pStart, Ncolors;
+  const PetscBool addAll = mode == ADD_ALL_VALUES ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  PetscCheck(mode == ADD_VALUES || mode == ADD_ALL_VALUES, PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Invalid insert mode %d", mode);
+  if (!mesh->assemblyThreads || cStart >= cEnd) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(DMPlexGetCellClosureDofIndex_Private(dm, section, cStart, cEnd, NULL, stride, &off, &dofs));
+  if (!dofs) PetscFunctionReturn(PETSC_SUCCESS);
+  pStart = section->clDofStart;
+  PetscCall(PetscSectionGetClosureDofColoring_Internal(section, &Ncolors, &colorOff, &colorPoints));
+  PetscCall(VecGetArray(v, &array));
+  for (PetscInt color = 0; color < Ncolors; ++color) {
+    PetscPragmaOMP(parallel for num_threads(PetscNumOMPThreads) schedule(static))
+    for (PetscInt i = colorOff[color]; i < colorOff[color + 1]; ++i) {
+      const PetscInt     cell = pStart + colorPoints[i];
+      const PetscInt    *cdofs;
+      const PetscScalar *cvals;
+
+      if (cell < cStart || cell >= cEnd) continue;
+      cdofs = &dofs[off[cell - pStart]];
+      cvals = &values[(cell - cStart) * stride];
+      for (PetscInt k = 0; k < stride; ++k) {
+        if (cdofs[k] >= 0) array[cdofs[k]] += cvals[k];
+        else if (addAll) array[-(cdofs[k] + 1)] += cvals[k];
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(v, &array));
+  *done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -45,47 +45,12 @@ static PetscErrorCode DMPlexCreateOrderingClosure_Static(DM dm, PetscInt numPoin
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-/*@C
-  DMPlexGetOrdering - Calculate a reordering of the mesh
-
-  Collective
-
-  Input Parameters:
-+ dm    - The DMPlex object
-. otype - type of reordering, see `MatOrderingType`
-- label - [Optional] Label used to segregate ordering into sets, or `NULL`
-
-  Output Parameter:
-. perm - The point permutation as an `IS`, `perm`[old point number] = new point number
-
-  Level: intermediate
-
-  Note:
-  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
-  has different types of cells, and then loop over each set of reordered cells for assembly.
-
-.seealso: `DMPLEX`, `DMPlexPermute()`, `MatOrderingType`, `MatGetOrdering()`
-@*/
-PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
+/* Complete the cell permutation cperm[], cperm[new cell] = old cell, into a point permutation, perm[old point] = new point, grouping the cells by label value */
+static PetscErrorCode DMPlexCreateOrderingFromCells_Private(DM dm, PetscInt numCells, PetscInt cperm[], DMLabel label, IS *perm)
 {
-  PetscInt  numCells = 0;
-  PetscInt *start = NULL, *adjacency = NULL, *cperm, *clperm = NULL, *invclperm = NULL, *mask, *xls, pStart, pEnd, c, i;
+  PetscInt *clperm = NULL, *invclperm = NULL, pStart, pEnd, c;
 
   PetscFunctionBegin;
-  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
-  PetscAssertPointer(perm, 4);
-  PetscCall(DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency));
-  PetscCall(PetscMalloc3(numCells, &cperm, numCells, &mask, numCells * 2, &xls));
-  if (numCells) {
-    /* Shift for Fortran numbering */
-    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
-    for (i = 0; i <= numCells; ++i) ++start[i];
-    PetscCall(SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls));
-  }
-  PetscCall(PetscFree(start));
-  PetscCall(PetscFree(adjacency));
-  /* Shift for Fortran numbering */
-  for (c = 0; c < numCells; ++c) --cperm[c];
   /* Segregate */
   if (label) {
     IS              valueIS;
@@ -125,7 +90,6 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   }
   /* Construct closure */
   PetscCall(DMPlexCreateOrderingClosure_Static(dm, numCells, cperm, &clperm, &invclperm));
-  PetscCall(PetscFree3(cperm, mask, xls));
   PetscCall(PetscFree(clperm));
   /* Invert permutation */
   PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
@@ -133,6 +97,52 @@ PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  DMPlexGetOrdering - Calculate a reordering of the mesh
+
+  Collective
+
+  Input Parameters:
++ dm    - The DMPlex object
+. otype - type of reordering, see `MatOrderingType`
+- label - [Optional] Label used to segregate ordering into sets, or `NULL`
+
+  Output Parameter:
+. perm - The point permutation as an `IS`, `perm`[old point number] = new point number
+
+  Level: intermediate
+
+  Note:
+  The label is used to group sets of points together by label value. This makes it easy to reorder a mesh which
+  has different types of cells, and then loop over each set of reordered cells for assembly.
+
+.seealso: `DMPLEX`, `DMPlexPermute()`, `MatOrderingType`, `MatGetOrdering()`
+@*/
+PetscErrorCode DMPlexGetOrdering(DM dm, MatOrderingType otype, DMLabel label, IS *perm)
+{
+  PetscInt  numCells = 0;
+  PetscInt *start = NULL, *adjacency = NULL, *cperm, *mask, *xls, c, i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscAssertPointer(perm, 4);
+  PetscCall(DMPlexCreateNeighborCSR(dm, 0, &numCells, &start, &adjacency));
+  PetscCall(PetscMalloc3(numCells, &cperm, numCells, &mask, numCells * 2, &xls));
+  if (numCells) {
+    /* Shift for Fortran numbering */
+    for (i = 0; i < start[numCells]; ++i) ++adjacency[i];
+    for (i = 0; i <= numCells; ++i) ++start[i];
+    PetscCall(SPARSEPACKgenrcm(&numCells, start, adjacency, cperm, mask, xls));
+  }
+  PetscCall(PetscFree(start));
+  PetscCall(PetscFree(adjacency));
+  /* Shift for Fortran numbering */
+  for (c = 0; c < numCells; ++c) --cperm[c];
+  PetscCall(DMPlexCreateOrderingFromCells_Private(dm, numCells, cperm, label, perm));
+  PetscCall(PetscFree3(cperm, mask, xls));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   DMPlexGetOrdering1D - Reorder the vertices so that the mesh is in a line
 
@@ -195,6 +205,142 @@ PetscErrorCode DMPlexGetOrdering1D(DM dm, IS *perm)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+const char *const DMPlexSFCTypes[] = {"none", "morton", "hilbert", "DMPlexSFCType", "DM_PLEX_SFC_", NULL};
+
+/* Interleave the bits of the cdim quantized coordinates x[], most significant bit first, into a single key */
+static uint64_t DMPlexSFCInterleave_Private(PetscInt cdim, PetscInt bits, const uint32_t x[])
+{
+  uint64_t key = 0;
+
+  for (PetscInt b = bits - 1; b >= 0; --b)
+    for (PetscInt d = 0; d < cdim; ++d) key = (key << 1) | ((x[d] >> b) & 1);
+  return key;
+}
+
+/* Convert the quantized coordinates x[] in place to the transposed Hilbert index, following J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004 */
+static void DMPlexSFCHilbertTranspose_Private(PetscInt cdim, PetscInt bits, uint32_t x[])
+{
+  const uint32_t M = (uint32_t)1 << (bits - 1);
+  uint32_t       P, Q, t;
+
+  /* Inverse undo excess work */
+  for (Q = M; Q > 1; Q >>= 1) {
+    P = Q - 1;
+    for (PetscInt d = 0; d < cdim; ++d) {
+      if (x[d] & Q) x[0] ^= P;
+      else {
+        t = (x[0] ^ x[d]) & P;
+        x[0] ^= t;
+        x[d] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (PetscInt d = 1; d < cdim; ++d) x[d] ^= x[d - 1];
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+    if (x[cdim - 1] & Q) t ^= Q - 1;
+  for (PetscInt d = 0; d < cdim; ++d) x[d] ^= t;
+}
+
+static int DMPlexSFCCompare_Private(const void *a, const void *b, PETSC_UNUSED void *ctx)
+{
+  const uint64_t ka = *(const uint64_t *)a, kb = *(const uint64_t *)b;
+
+  return ka < kb ? -1 : (ka > kb ? 1 : 0);
+}
+
+/*@
+  DMPlexGetOrderingSFC - Calculate a reordering of the mesh which traverses the cells along a space filling curve
+
+  Collective
+
+  Input Parameters:
++ dm    - The `DMPLEX` object
+. stype - The type of space filling curve, see `DMPlexSFCType`
+- label - [Optional] Label used to segregate ordering into sets, or `NULL`
+
+  Output Parameter:
+. perm - The point permutation as an `IS`, `perm`[old point number] = new point number
+
+  Level: intermediate
+
+  Notes:
+  Cells are sorted by the position of their vertex centroid along the curve, where the centroids are quantized on the
+  local bounding box. Faces, edges, and vertices are then numbered in the order they are first reached from the closure
+  of the reordered cells, so that the dofs of a `PetscSection` laid out on the permuted mesh follow the same curve. This
+  keeps the data of neighboring cells close in memory, which improves cache reuse in residual and Jacobian assembly.
+
+  The ordering is purely local, so it can be applied to a distributed mesh, see `DMPlexPermute()`.
+
+.seealso: `DMPLEX`, `DMPlexSFCType`, `DMPlexGetOrdering()`, `DMPlexPermute()`
+@*/
+PetscErrorCode DMPlexGetOrderingSFC(DM dm, DMPlexSFCType stype, DMLabel label, IS *perm)
+{
+  PetscReal *centroids, lower[3] = {PETSC_MAX_REAL, PETSC_MAX_REAL, PETSC_MAX_REAL}, upper[3] = {PETSC_MIN_REAL, PETSC_MIN_REAL, PETSC_MIN_REAL}, extent = 0.;
+  uint64_t  *keys;
+  PetscInt  *cperm, cdim, cStart, cEnd, numCells, bits, c, d;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(dm, DM_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(dm, stype, 2);
+  PetscAssertPointer(perm, 4);
+  PetscCall(DMGetCoordinateDim(dm, &cdim));
+  PetscCheck(cdim >= 1 && cdim <= 3, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "Space filling curve ordering not supported for coordinate dimension %" PetscInt_FMT, cdim);
+  PetscCall(DMPlexGetHeightStratum(dm, 0, &cStart, &cEnd));
+  numCells = cEnd - cStart;
+  PetscCall(PetscMalloc3(numCells * cdim, &centroids, numCells, &keys, numCells, &cperm));
+  for (c = cStart; c < cEnd; ++c) {
+    const PetscScalar *array;
+    PetscScalar       *coords = NULL;
+    PetscInt           Nc, Nv, v;
+    PetscBool          isDG;
+
+    PetscCall(DMPlexGetCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+    Nv = Nc / cdim;
+    for (d = 0; d < cdim; ++d) {
+      PetscReal x = 0.;
+
+      for (v = 0; v < Nv; ++v) x += PetscRealPart(coords[v * cdim + d]);
+      x /= Nv;
+      centroids[(c - cStart) * cdim + d] = x;
+      lower[d]                           = PetscMin(lower[d], x);
+      upper[d]                           = PetscMax(upper[d], x);
+    }
+    PetscCall(DMPlexRestoreCellCoordinates(dm, c, &isDG, &Nc, &array, &coords));
+  }
+  /* Use a cube so that the curve does not stretch with the aspect ratio of the bounding box */
+  for (d = 0; d < cdim; ++d) extent = PetscMax(extent, upper[d] - lower[d]);
+  bits = PetscMin(31, 63 / cdim);
+  for (c = 0; c < numCells; ++c) {
+    uint32_t x[3] = {0, 0, 0};
+
+    for (d = 0; d < cdim; ++d) {
+      if (extent > 0.) x[d] = (uint32_t)(((centroids[c * cdim + d] - lower[d]) / extent) * (PetscReal)(((uint64_t)1 << bits) - 1));
+    }
+    switch (stype) {
+    case DM_PLEX_SFC_NONE:
+      keys[c] = (uint64_t)c;
+      break;
+    case DM_PLEX_SFC_MORTON:
+      keys[c] = DMPlexSFCInterleave_Private(cdim, bits, x);
+      break;
+    case DM_PLEX_SFC_HILBERT:
+      DMPlexSFCHilbertTranspose_Private(cdim, bits, x);
+      keys[c] = DMPlexSFCInterleave_Private(cdim, bits, x);
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)dm), PETSC_ERR_ARG_OUTOFRANGE, "Unknown space filling curve type %d", (int)stype);
+    }
+    cperm[c] = c + cStart;
+  }
+  /* Stable, so that cells with the same key keep their relative order */
+  if (numCells > 1) PetscCall(PetscTimSortWithArray(numCells, keys, sizeof(uint64_t), cperm, sizeof(PetscInt), DMPlexSFCCompare_Private, NULL));
+  PetscCall(DMPlexCreateOrderingFromCells_Private(dm, numCells, cperm, label, perm));
+  PetscCall(PetscFree3(centroids, keys, cperm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode DMPlexRemapCoordinates_Private(IS perm, PetscSection cs, Vec coordinates, PetscSection *csNew, Vec *coordinatesNew)
 {
   PetscScalar    *coords, *coordsNew;
@@ -239,7 +385,10 @@ static PetscErrorCode DMPlexRemapCoordinates_Private(IS perm, PetscSection cs, V
 
   Level: intermediate
 
-.seealso: `DMPLEX`, `MatPermute()`
+  Note:
+  The point `PetscSF` is permuted along with the mesh, so a distributed mesh can be permuted locally on each process.
+
+.seealso: `DMPLEX`, `MatPermute()`, `DMPlexGetOrdering()`, `DMPlexGetOrderingSFC()`
 @*/
 PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
 {
@@ -270,7 +419,45 @@ PetscErrorCode DMPlexPermute(DM dm, IS perm, DM *pdm)
   }
   plexNew = (DM_Plex *)(*pdm)->data;
   /* Ignore ltogmap, ltogmapb */
-  /* Ignore sf, sectionSF */
+  /* Reorder sf, the sectionSF is recreated from it */
+  {
+    PetscSF            sf, sfNew;
+    const PetscSFNode *iremote;
+    const PetscInt    *ilocal, *pperm;
+    PetscSFNode       *remoteNew;
+    PetscInt          *rperm, *lperm, *localNew, nroots, nleaves, pStart, pEnd, p, l;
+
+    PetscCall(DMGetPointSF(dm, &sf));
+    PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote));
+    if (nroots >= 0) {
+      PetscCall(DMPlexGetChart(dm, &pStart, &pEnd));
+      PetscCall(PetscMalloc2(pEnd - pStart, &rperm, pEnd - pStart, &lperm));
+      PetscCall(ISGetIndices(perm, &pperm));
+      for (p = pStart; p < pEnd; ++p) lperm[p - pStart] = -1;
+      /* Learn the new numbering of the root of each leaf, the arrays are indexed by point - pStart while the SF uses point numbers */
+      PetscCall(PetscSFBcastBegin(sf, MPIU_INT, pperm - pStart, rperm - pStart, MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(sf, MPIU_INT, pperm - pStart, rperm - pStart, MPI_REPLACE));
+      for (l = 0; l < nleaves; ++l) lperm[pperm[(ilocal ? ilocal[l] : l) - pStart] - pStart] = l;
+      PetscCall(PetscMalloc1(nleaves, &localNew));
+      PetscCall(PetscMalloc1(nleaves, &remoteNew));
+      /* Keep the leaves sorted by their new point number */
+      for (p = pStart, l = 0; p < pEnd; ++p) {
+        const PetscInt ol = lperm[p - pStart];
+
+        if (ol < 0) continue;
+        localNew[l]        = p;
+        remoteNew[l].rank  = iremote[ol].rank;
+        remoteNew[l].index = rperm[(ilocal ? ilocal[ol] : ol) - pStart];
+        ++l;
+      }
+      PetscCall(ISRestoreIndices(perm, &pperm));
+      PetscCall(PetscFree2(rperm, lperm));
+      PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)dm), &sfNew));
+      PetscCall(PetscSFSetGraph(sfNew, nroots, nleaves, localNew, PETSC_OWN_POINTER, remoteNew, PETSC_OWN_POINTER));
+      PetscCall(DMSetPointSF(*pdm, sfNew));
+      PetscCall(PetscSFDestroy(&sfNew));
+    }
+  }
   /* Ignore globalVertexNumbers, globalCellNumbers */
   /* Reorder labels */
   {
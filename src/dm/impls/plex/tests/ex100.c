@@ -0,0 +1,155 @@
+static char help[] = "Tests the threaded FEM residual and Jacobian against the serial assembly.\n\n";
+
+#include <petscdmplex.h>
+#include <petscds.h>
+#include <petscsnes.h>
+
+/* -div(kappa (1 + u^2) grad u) = c */
+static void f0_u(PetscInt dim, PetscInt Nf, PetscInt NfAux, const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[], const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[], PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f0[])
+{
+  f0[0] = -constants[0];
+}
+
+static void f1_u(PetscInt dim, PetscInt Nf, PetscInt NfAux, const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[], const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[], PetscReal t, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar f1[])
+{
+  for (PetscInt d = 0; d < dim; ++d) f1[d] = a[0] * (1.0 + u[0] * u[0]) * u_x[d];
+}
+
+static void g2_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux, const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[], const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[], PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g2[])
+{
+  for (PetscInt d = 0; d < dim; ++d) g2[d] = 2.0 * a[0] * u[0] * u_x[d];
+}
+
+static void g3_uu(PetscInt dim, PetscInt Nf, PetscInt NfAux, const PetscInt uOff[], const PetscInt uOff_x[], const PetscScalar u[], const PetscScalar u_t[], const PetscScalar u_x[], const PetscInt aOff[], const PetscInt aOff_x[], const PetscScalar a[], const PetscScalar a_t[], const PetscScalar a_x[], PetscReal t, PetscReal u_tShift, const PetscReal x[], PetscInt numConstants, const PetscScalar constants[], PetscScalar g3[])
+{
+  for (PetscInt d = 0; d < dim; ++d) g3[d * dim + d] = a[0] * (1.0 + u[0] * u[0]);
+}
+
+static PetscErrorCode solution(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = PetscSinReal(2.0 * PETSC_PI * x[0]) * x[1] + x[0] * x[0];
+  return PETSC_SUCCESS;
+}
+
+static PetscErrorCode coefficient(PetscInt dim, PetscReal time, const PetscReal x[], PetscInt Nc, PetscScalar *u, void *ctx)
+{
+  u[0] = 1.0 + x[0] + 2.0 * x[1] * x[1];
+  return PETSC_SUCCESS;
+}
+
+/* Both meshes are created without options, so that they are identical, and only the threaded one reads -dm_plex_assembly_threads */
+static PetscErrorCode CreateDiscretization(MPI_Comm comm, PetscBool threaded, DM *dm, Vec *u)
+{
+  const PetscInt faces[2] = {6, 6};
+  PetscErrorCode (*funcs[1])(PetscInt, PetscReal, const PetscReal[], PetscInt, PetscScalar *, void *);
+  DM          dmAux;
+  PetscFE     fe, feAux;
+  PetscDS     ds;
+  Vec         locU, kappa;
+  PetscScalar c = 1.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMPlexCreateBoxMesh(comm, 2, PETSC_FALSE, faces, NULL, NULL, NULL, PETSC_TRUE, dm));
+  if (threaded) PetscCall(DMSetFromOptions(*dm));
+  PetscCall(PetscFECreateLagrange(comm, 2, 1, PETSC_FALSE, 2, PETSC_DETERMINE, &fe));
+  PetscCall(DMSetField(*dm, 0, NULL, (PetscObject)fe));
+  PetscCall(DMCreateDS(*dm));
+  PetscCall(DMGetDS(*dm, &ds));
+  PetscCall(PetscDSSetResidual(ds, 0, f0_u, f1_u));
+  PetscCall(PetscDSSetJacobian(ds, 0, 0, NULL, NULL, g2_uu, g3_uu));
+  PetscCall(PetscDSSetConstants(ds, 1, &c));
+  /* The coefficient is a Q1 auxiliary field */
+  PetscCall(DMClone(*dm, &dmAux));
+  PetscCall(PetscFECreateLagrange(comm, 2, 1, PETSC_FALSE, 1, PETSC_DETERMINE, &feAux));
+  PetscCall(PetscFECopyQuadrature(fe, feAux));
+  PetscCall(DMSetField(dmAux, 0, NULL, (PetscObject)feAux));
+  PetscCall(DMCreateDS(dmAux));
+  PetscCall(DMCreateLocalVector(dmAux, &kappa));
+  funcs[0] = coefficient;
+  PetscCall(DMProjectFunctionLocal(dmAux, 0.0, funcs, NULL, INSERT_ALL_VALUES, kappa));
+  PetscCall(DMSetAuxiliaryVec(*dm, NULL, 0, 0, kappa));
+  PetscCall(VecDestroy(&kappa));
+  PetscCall(DMDestroy(&dmAux));
+  PetscCall(PetscFEDestroy(&feAux));
+  PetscCall(PetscFEDestroy(&fe));
+  PetscCall(DMCreateLocalVector(*dm, &locU));
+  funcs[0] = solution;
+  PetscCall(DMProjectFunctionLocal(*dm, 0.0, funcs, NULL, INSERT_ALL_VALUES, locU));
+  *u = locU;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Compares the threaded residual and Jacobian with the serial ones */
+static PetscErrorCode CompareAssembly(DM dmT, Vec uT, DM dmS, Vec uS, PetscInt pass)
+{
+  Vec       fT, fS;
+  Mat       JT, JS;
+  PetscReal fnorm, jnorm, fdiff, jdiff;
+
+  PetscFunctionBeginUser;
+  PetscCall(DMGetLocalVector(dmT, &fT));
+  PetscCall(DMGetLocalVector(dmS, &fS));
+  PetscCall(VecSet(fT, 0.0));
+  PetscCall(VecSet(fS, 0.0));
+  PetscCall(DMPlexSNESComputeResidualFEM(dmT, uT, fT, NULL));
+  PetscCall(DMPlexSNESComputeResidualFEM(dmS, uS, fS, NULL));
+  PetscCall(VecNorm(fS, NORM_INFINITY, &fnorm));
+  PetscCall(VecAXPY(fT, -1.0, fS));
+  PetscCall(VecNorm(fT, NORM_INFINITY, &fdiff));
+  PetscCall(DMRestoreLocalVector(dmT, &fT));
+  PetscCall(DMRestoreLocalVector(dmS, &fS));
+  PetscCall(DMCreateMatrix(dmT, &JT));
+  PetscCall(DMCreateMatrix(dmS, &JS));
+  PetscCall(DMPlexSNESComputeJacobianFEM(dmT, uT, JT, JT, NULL));
+  PetscCall(DMPlexSNESComputeJacobianFEM(dmS, uS, JS, JS, NULL));
+  PetscCall(MatNorm(JS, NORM_INFINITY, &jnorm));
+  PetscCall(MatAXPY(JT, -1.0, JS, SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(JT, NORM_INFINITY, &jdiff));
+  PetscCall(MatDestroy(&JT));
+  PetscCall(MatDestroy(&JS));
+  PetscCall(PetscPrintf(PetscObjectComm((PetscObject)dmT), "Pass %" PetscInt_FMT ": the residual %s and the Jacobian %s the serial assembly\n", pass, fdiff <= 1.0e-10 * fnorm ? "matches" : "does not match", jdiff <= 1.0e-10 * jnorm ? "matches" : "does not match"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  DM          dmT, dmS;
+  Vec         uT, uS;
+  PetscDS     dsT, dsS;
+  PetscScalar c = -3.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(CreateDiscretization(PETSC_COMM_WORLD, PETSC_TRUE, &dmT, &uT));
+  PetscCall(CreateDiscretization(PETSC_COMM_WORLD, PETSC_FALSE, &dmS, &uS));
+  PetscCall(CompareAssembly(dmT, uT, dmS, uS, 0));
+  /* The threads cache copies of the PetscDS, which must see the new constants */
+  PetscCall(DMGetDS(dmT, &dsT));
+  PetscCall(DMGetDS(dmS, &dsS));
+  PetscCall(PetscDSSetConstants(dsT, 1, &c));
+  PetscCall(PetscDSSetConstants(dsS, 1, &c));
+  PetscCall(CompareAssembly(dmT, uT, dmS, uS, 1));
+  PetscCall(VecDestroy(&uT));
+  PetscCall(VecDestroy(&uS));
+  PetscCall(DMDestroy(&dmT));
+  PetscCall(DMDestroy(&dmS));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    output_file: output/ex100_1.out
+
+    test:
+      suffix: 1
+      args: -dm_plex_assembly_threads
+
+    # Only threaded when PETSc is configured with OpenMP and thread safety, as in the CI job linux-pkgs-dbg-ftn-interfaces
+    test:
+      suffix: threads
+      requires: openmp threadsafety
+      args: -dm_plex_assembly_threads -omp_num_threads 3
+
+TEST*/
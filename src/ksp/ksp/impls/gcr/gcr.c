@@ -16,10 +16,10 @@ typedef struct {
 static PetscErrorCode KSPSolve_GCR_cycle(KSP ksp)
 {
   KSP_GCR    *ctx = (KSP_GCR *)ksp->data;
-  PetscScalar r_dot_v;
+  PetscScalar r_dot_v, dots[2];
   Mat         A, B;
   PC          pc;
-  Vec         s, v, r;
+  Vec         s, v, r, vr[2];
   /*
      The residual norm will not be computed when ksp->its > ksp->chknorm hence need to initialize norm_r with some dummy value
   */
@@ -45,12 +45,14 @@ static PetscErrorCode KSPSolve_GCR_cycle(KSP ksp)
 
     PetscCall(VecMDot(v, k, ctx->VV, ctx->val));
     for (i = 0; i < k; i++) ctx->val[i] = -ctx->val[i];
-    PetscCall(VecMAXPY(v, k, ctx->val, ctx->VV)); /* v = v - sum_{i=0}^{k-1} alpha_i v_i */
     PetscCall(VecMAXPY(s, k, ctx->val, ctx->SS)); /* s = s - sum_{i=0}^{k-1} alpha_i s_i */
 
-    PetscCall(VecDotNorm2(r, v, &r_dot_v, &nrm));
-    nrm     = PetscSqrtReal(nrm);
-    r_dot_v = r_dot_v / nrm;
+    /* v = v - sum_{i=0}^{k-1} alpha_i v_i, with <v,r> and <v,v> computed in the same sweep */
+    vr[0] = r;
+    vr[1] = v;
+    PetscCall(VecMAXPYAndMDot(v, k, ctx->val, ctx->VV, 2, vr, dots));
+    nrm     = PetscSqrtReal(PetscRealPart(dots[1]));
+    r_dot_v = PetscConj(dots[0]) / nrm;
     PetscCall(VecScale(v, 1.0 / nrm));
     PetscCall(VecScale(s, 1.0 / nrm));
     PetscCall(VecAXPY(x, r_dot_v, s));
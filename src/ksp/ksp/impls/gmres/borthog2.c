@@ -24,26 +24,30 @@
 
   Level: intermediate
 
-  Note:
+  Notes:
   Use `KSPGMRESSetCGSRefinementType()` to determine if iterative refinement is to be used.
   This is much faster than `KSPGMRESModifiedGramSchmidtOrthogonalization()` but has the small possibility of stability issues
   that can usually be handled by using a single step of iterative refinement with `KSPGMRESSetCGSRefinementType()`
 
+  The subtraction of the projection is fused with the inner products that follow it with `VecMAXPYAndMDot()`, those of the
+  refinement step or the norm of the new direction, so that the Krylov vectors are only read once for both.
+
 .seealso: [](ch_ksp), `KSPGMRESCGSRefinementType`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESSetCGSRefinementType()`,
            `KSPGMRESGetCGSRefinementType()`, `KSPGMRESGetOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`
 @*/
 PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt it)
 {
   KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  Vec          w     = VEC_VV(it + 1);
   PetscInt     j;
-  PetscScalar *hh, *hes, *lhh;
+  PetscScalar *hh, *hes, *lhh, *rhh, wdot;
   PetscReal    hnrm, wnrm;
-  PetscBool    refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
 
   PetscFunctionBegin;
   PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
-  if (!gmres->orthogwork) PetscCall(PetscMalloc1(gmres->max_k + 2, &gmres->orthogwork));
+  if (!gmres->orthogwork) PetscCall(PetscMalloc1(2 * (gmres->max_k + 2), &gmres->orthogwork));
   lhh = gmres->orthogwork;
+  rhh = gmres->orthogwork + gmres->max_k + 2;
 
   /* update Hessenberg matrix and do unmodified Gram-Schmidt */
   hh  = HH(0, it);
@@ -59,24 +63,38 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
      This is really a matrix-vector product, with the matrix stored
      as pointer to rows
   */
-  PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
+  PetscCall(VecMDot(w, it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
   for (j = 0; j <= it; j++) {
     KSPCheckDot(ksp, lhh[j]);
     if (ksp->reason) goto done;
     lhh[j] = -lhh[j];
   }
+  /* note lhh[j] is -<v,vnew> , hence the subtraction */
+  for (j = 0; j <= it; j++) {
+    hh[j] -= lhh[j];  /* hh += <v,vnew> */
+    hes[j] -= lhh[j]; /* hes += <v,vnew> */
+  }
 
   /*
          This is really a matrix-vector product:
          [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
+     With iterative refinement, the inner products of the second step are computed in the same sweep over the vectors
   */
-  PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
-  /* note lhh[j] is -<v,vnew> , hence the subtraction */
-  for (j = 0; j <= it; j++) {
-    hh[j] -= lhh[j];  /* hh += <v,vnew> */
-    hes[j] -= lhh[j]; /* hes += <v,vnew> */
+  if (gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS) {
+    PetscCall(VecMAXPYAndMDot(w, it + 1, lhh, &VEC_VV(0), it + 1, &VEC_VV(0), rhh)); /* <v,vnew> */
+    for (j = 0; j <= it; j++) {
+      KSPCheckDot(ksp, rhh[j]);
+      if (ksp->reason) goto done;
+      lhh[j] = -rhh[j];
+      hh[j] += rhh[j];  /* hh += <v,vnew> */
+      hes[j] += rhh[j]; /* hes += <v,vnew> */
+    }
   }
 
+  /* the norm of the new direction, which GMRES needs next, is computed with its last update */
+  PetscCall(VecMAXPYAndMDot(w, it + 1, lhh, &VEC_VV(0), 1, &w, &wdot));
+  wnrm = PetscSqrtReal(PetscRealPart(wdot));
+
   /*
      the second step classical Gram-Schmidt is only necessary
      when a simple test criteria is not passed
@@ -86,29 +104,26 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
     for (j = 0; j <= it; j++) hnrm += PetscRealPart(lhh[j] * PetscConj(lhh[j]));
 
     hnrm = PetscSqrtReal(hnrm);
-    PetscCall(VecNorm(VEC_VV(it + 1), NORM_2, &wnrm));
     KSPCheckNorm(ksp, wnrm);
     if (ksp->reason) goto done;
     if (wnrm < hnrm) {
-      refine = PETSC_TRUE;
       PetscCall(PetscInfo(ksp, "Performing iterative refinement wnorm %g hnorm %g\n", (double)wnrm, (double)hnrm));
+      PetscCall(VecMDot(w, it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
+      for (j = 0; j <= it; j++) {
+        KSPCheckDot(ksp, lhh[j]);
+        if (ksp->reason) goto done;
+        lhh[j] = -lhh[j];
+      }
+      /* note lhh[j] is -<v,vnew> , hence the subtraction */
+      for (j = 0; j <= it; j++) {
+        hh[j] -= lhh[j];  /* hh += <v,vnew> */
+        hes[j] -= lhh[j]; /* hes += <v,vnew> */
+      }
+      PetscCall(VecMAXPYAndMDot(w, it + 1, lhh, &VEC_VV(0), 1, &w, &wdot));
+      wnrm = PetscSqrtReal(PetscRealPart(wdot));
     }
   }
-
-  if (refine) {
-    PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
-    for (j = 0; j <= it; j++) {
-      KSPCheckDot(ksp, lhh[j]);
-      if (ksp->reason) goto done;
-      lhh[j] = -lhh[j];
-    }
-    PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
-    /* note lhh[j] is -<v,vnew> , hence the subtraction */
-    for (j = 0; j <= it; j++) {
-      hh[j] -= lhh[j];  /* hh += <v,vnew> */
-      hes[j] -= lhh[j]; /* hes += <v,vnew> */
-    }
-  }
+  gmres->orthognorm = wnrm;
 done:
   PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -0,0 +1,188 @@
+/*
+    Routines used for the orthogonalization of the Hessenberg matrix with a single global reduction per step.
+
+    Note that for the complex numbers version, the VecDot() and
+    VecMDot() arguments within the code MUST remain in the order
+    given for correct computation of inner products.
+*/
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+/*@C
+  KSPGMRESSingleReduceGramSchmidtOrthogonalization -  Classical Gram-Schmidt orthogonalization with a delayed second pass
+  (DCGS2) that needs a single global reduction per iteration, including the normalization of the new direction
+
+  Collective
+
+  Input Parameters:
++ ksp - `KSP` object, must be associated with `KSPGMRES` or `KSPFGMRES` Krylov method
+- it  - one less than the current GMRES restart iteration, i.e. the size of the Krylov space
+
+  Options Database Key:
+. -ksp_gmres_singlereducegramschmidt - Activates `KSPGMRESSingleReduceGramSchmidtOrthogonalization()`
+
+  Level: intermediate
+
+  Notes:
+  `KSPGMRES` and `KSPFGMRES` do not call this routine when it is selected, their cycles lag the second pass and the
+  normalization of each direction by one iteration instead. The operator is applied to the new direction before it is
+  normalized, and one reduction with `VecMDotBegin()` and `VecMDotEnd()` computes both the inner products of the second pass
+  of that direction, with its norm, and those of the first pass of its image. The norm follows from the Pythagorean theorem,
+  $\|w - V h\|^2 = \|w\|^2 - \|h\|^2$, and the image is corrected with the updated column of the Hessenberg matrix.
+  With `KSPGMRES` the reduction is overlapped with the next application of the operator, which is also corrected afterwards.
+  With `KSPFGMRES` it is not, since a flexible preconditioner cannot be corrected that way.
+  `KSPGMRESClassicalGramSchmidtOrthogonalization()` needs two reductions per iteration, three with iterative refinement,
+  and `KSPGMRESModifiedGramSchmidtOrthogonalization()` one per Krylov vector.
+
+  The other `KSPGMRES` variants call this routine, which does the two passes without delay: the inner products of the second
+  pass are computed with the update of the first pass by `VecMAXPYAndMDot()`, so it costs two reductions.
+  `KSPGMRESSetCGSRefinementType()` has no effect on this orthogonalization, the second pass is always done.
+
+.seealso: [](ch_ksp), `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`, `KSPGMRESClassicalGramSchmidtOrthogonalization()`,
+          `KSPGMRESModifiedGramSchmidtOrthogonalization()`, `KSPPGMRES`
+@*/
+PetscErrorCode KSPGMRESSingleReduceGramSchmidtOrthogonalization(KSP ksp, PetscInt it)
+{
+  KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  Vec          w     = VEC_VV(it + 1);
+  PetscInt     j;
+  PetscScalar *hh, *hes, *lhh, *rhh;
+  PetscReal    nrm2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  if (!gmres->orthogwork) PetscCall(PetscMalloc1(2 * (gmres->max_k + 2), &gmres->orthogwork));
+  lhh = gmres->orthogwork;
+  rhh = gmres->orthogwork + gmres->max_k + 2;
+
+  /* update Hessenberg matrix and do unmodified Gram-Schmidt */
+  hh  = HH(0, it);
+  hes = HES(0, it);
+
+  /* Clear hh and hes since we will accumulate values into them */
+  for (j = 0; j <= it; j++) {
+    hh[j]  = 0.0;
+    hes[j] = 0.0;
+  }
+
+  /* <v,vnew> for the it + 1 Krylov vectors */
+  PetscCall(VecMDot(w, it + 1, &VEC_VV(0), lhh));
+  for (j = 0; j <= it; j++) {
+    KSPCheckDot(ksp, lhh[j]);
+    if (ksp->reason) goto done;
+    hh[j] += lhh[j];  /* hh += <v,vnew> */
+    hes[j] += lhh[j]; /* hes += <v,vnew> */
+    lhh[j] = -lhh[j];
+  }
+  /* subtract the projection and compute the inner products of the second pass, with <vnew,vnew>, in the same sweep over the vectors */
+  PetscCall(VecMAXPYAndMDot(w, it + 1, lhh, &VEC_VV(0), it + 2, &VEC_VV(0), rhh));
+  for (j = 0; j <= it + 1; j++) {
+    KSPCheckDot(ksp, rhh[j]);
+    if (ksp->reason) goto done;
+  }
+  nrm2 = PetscRealPart(rhh[it + 1]);
+  for (j = 0; j <= it; j++) {
+    nrm2 -= PetscRealPart(rhh[j] * PetscConj(rhh[j]));
+    hh[j] += rhh[j];
+    hes[j] += rhh[j];
+    rhh[j] = -rhh[j];
+  }
+  PetscCall(VecMAXPY(w, it + 1, rhh, &VEC_VV(0)));
+  gmres->orthognorm = nrm2 > 0.0 ? PetscSqrtReal(nrm2) : 0.0;
+done:
+  PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   KSPGMRESSingleReduceNormalize_Private - delayed second pass and normalization of VEC_VV(it)
+
+   Input Parameters:
++  ksp - the KSPGMRES or KSPFGMRES solver
+.  it  - the direction, which was projected once on the orthogonal complement of VEC_VV(0), ..., VEC_VV(it - 1) with the coefficients in column it - 1 of the Hessenberg matrix
+-  lhh - the inner products of VEC_VV(it) with VEC_VV(0), ..., VEC_VV(it)
+
+   Output Parameters:
++  work - work array of length it
+-  nrm  - norm of VEC_VV(it) after the second pass, which is the subdiagonal entry of column it - 1
+
+   Note:
+   VEC_VV(it) is normalized unless nrm is zero.
+*/
+PetscErrorCode KSPGMRESSingleReduceNormalize_Private(KSP ksp, PetscInt it, const PetscScalar lhh[], PetscScalar work[], PetscReal *nrm)
+{
+  KSP_GMRES *gmres = (KSP_GMRES *)ksp->data;
+  PetscReal  nrm2;
+
+  PetscFunctionBegin;
+  *nrm = 0.0;
+  for (PetscInt j = 0; j <= it; j++) KSPCheckDot(ksp, lhh[j]);
+  nrm2 = PetscRealPart(lhh[it]);
+  for (PetscInt j = 0; j < it; j++) {
+    nrm2 -= PetscRealPart(lhh[j] * PetscConj(lhh[j]));
+    *HH(j, it - 1) += lhh[j];
+    *HES(j, it - 1) += lhh[j];
+  }
+  *nrm              = nrm2 > 0.0 ? PetscSqrtReal(nrm2) : 0.0;
+  *HH(it, it - 1)  = *nrm;
+  *HES(it, it - 1) = *nrm;
+  if (*nrm > 0.0) {
+    for (PetscInt j = 0; j < it; j++) work[j] = -lhh[j] / *nrm;
+    PetscCall(VecMAXPBY(VEC_VV(it), it, work, 1.0 / *nrm, &VEC_VV(0)));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   KSPGMRESSingleReduceProject_Private - first pass of the orthogonalization of the image of VEC_VV(it), which becomes the direction VEC_VV(it + 1)
+
+   Input Parameters:
++  ksp      - the KSPGMRES or KSPFGMRES solver
+.  it       - the column of the Hessenberg matrix
+.  lhh      - the inner products of VEC_VV(it) before KSPGMRESSingleReduceNormalize_Private() with VEC_VV(0), ..., VEC_VV(it - 1), not used if it is 0
+.  rhh      - the inner products of VEC_VV(it + 1), the image of VEC_VV(it) before KSPGMRESSingleReduceNormalize_Private(), with VEC_VV(0), ..., VEC_VV(it - 1) and with VEC_VV(it) before KSPGMRESSingleReduceNormalize_Private()
+.  nrm      - the norm from KSPGMRESSingleReduceNormalize_Private(), 1 if it is 0
+.  flexible - the caller scales the preconditioned VEC_VV(it) by 1 / nrm, as in KSPFGMRES, so that VEC_VV(it + 1) divided by nrm is its image
+-  x        - if not NULL, the image of VEC_VV(it + 1), which is corrected to the image of the direction; must be NULL if flexible
+
+   Output Parameter:
+.  work - work array of length 2 (it + 2)
+
+   Notes:
+   Without flexible, the image of the normalized VEC_VV(it) is VEC_VV(it + 1) minus the images of the Krylov vectors removed
+   by the second pass, divided by nrm. Those images are given by the complete columns of the Hessenberg matrix, and they
+   only change the coefficients of the projection. The same relations give the image of the direction from x.
+*/
+PetscErrorCode KSPGMRESSingleReduceProject_Private(KSP ksp, PetscInt it, const PetscScalar lhh[], const PetscScalar rhh[], PetscReal nrm, PetscBool flexible, PetscScalar work[], Vec x)
+{
+  KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  PetscScalar *g     = work, *coef = work + it + 2, c = rhh[it];
+
+  PetscFunctionBegin;
+  /* inner product of VEC_VV(it + 1) with the normalized VEC_VV(it) */
+  for (PetscInt k = 0; k < it; k++) c -= PetscConj(lhh[k]) * rhh[k];
+  c /= nrm;
+  /* g = H s, images of the Krylov vectors removed from VEC_VV(it) by the second pass */
+  for (PetscInt i = 0; i <= it; i++) {
+    g[i] = 0.0;
+    for (PetscInt k = PetscMax(i - 1, 0); !flexible && k < it; k++) g[i] += *HES(i, k) * lhh[k];
+  }
+  if (x) {
+    for (PetscInt i = 0; i <= it; i++) {
+      PetscScalar f = 0.0;
+
+      for (PetscInt k = PetscMax(i - 1, 0); k < it; k++) f += *HES(i, k) * rhh[k];
+      coef[i] = -(f - c * g[i] / nrm) / nrm;
+    }
+    coef[it + 1] = -c / (nrm * nrm);
+    PetscCall(VecMAXPBY(x, it + 2, coef, 1.0 / nrm, &VEC_VV(0)));
+  }
+  for (PetscInt i = 0; i <= it; i++) {
+    const PetscScalar h = i < it ? rhh[i] : c;
+
+    *HH(i, it)  = (h - g[i]) / nrm;
+    *HES(i, it) = *HH(i, it);
+    coef[i]     = -h / nrm;
+  }
+  PetscCall(VecMAXPBY(VEC_VV(it + 1), it + 1, coef, 1.0 / nrm, &VEC_VV(0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
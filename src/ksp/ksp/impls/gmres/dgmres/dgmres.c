@@ -157,10 +157,15 @@ static PetscErrorCode KSPDGMRESCycle(PetscInt *itcount, KSP ksp)
     }
     dgmres->matvecs += 1;
     /* update Hessenberg matrix and do Gram-Schmidt */
+    dgmres->orthognorm = -1.0;
     PetscCall((*dgmres->orthog)(ksp, it));
 
-    /* vv(i+1) . vv(i+1) */
-    PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    /* vv(i+1) . vv(i+1), unless the orthogonalization already computed it */
+    if (dgmres->orthognorm < 0.0) PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    else {
+      tt = dgmres->orthognorm;
+      if (tt > 0.0) PetscCall(VecScale(VEC_VV(it + 1), 1.0 / tt));
+    }
     /* save the magnitude */
     *HH(it + 1, it)  = tt;
     *HES(it + 1, it) = tt;
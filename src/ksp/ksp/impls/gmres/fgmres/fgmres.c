@@ -53,6 +53,91 @@ static PetscErrorCode KSPFGMRESResidual(KSP ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    KSPFGMRESSingleReduceCycle - The iterations of KSPFGMRESCycle() with KSPGMRESSingleReduceGramSchmidtOrthogonalization()
+
+    The second pass of the orthogonalization and the normalization of VEC_VV(loc_it) are lagged to iteration loc_it + 1,
+    where they share one reduction with the first pass of the image VEC_VV(loc_it + 1). The preconditioner is applied to the
+    direction before it is normalized, and the preconditioned direction is scaled afterwards. Unlike KSPGMRES the reduction
+    is not overlapped with the next application of the operator, a flexible preconditioner must be applied to the projected
+    direction.
+    It returns when the loop condition of KSPFGMRESCycle() is false.
+*/
+static PetscErrorCode KSPFGMRESSingleReduceCycle(KSP ksp, PetscInt *itcount, PetscReal *res_norm)
+{
+  KSP_FGMRES  *fgmres = (KSP_FGMRES *)ksp->data;
+  PetscReal    hapbnd, tt = 1.0;
+  PetscInt     loc_it = 0, max_k = fgmres->max_k;
+  PetscBool    hapend = PETSC_FALSE;
+  PetscScalar *lhh, *rhh, *work;
+  Mat          Amat, Pmat;
+
+  PetscFunctionBegin;
+  if (!max_k || ksp->its >= ksp->max_it) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc3(max_k + 1, &lhh, max_k + 1, &rhh, 2 * (max_k + 2), &work));
+  PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
+  while (PETSC_TRUE) {
+    /* column loc_it is computed unless column loc_it - 1 ends the cycle */
+    PetscBool apply = (PetscBool)(loc_it < max_k && ksp->its + (loc_it ? 1 : 0) < ksp->max_it);
+
+    if (apply) {
+      if (fgmres->vv_allocated <= loc_it + VEC_OFFSET + 1) PetscCall(KSPFGMRESGetNewVectors(ksp, loc_it + 1));
+      PetscCall((*fgmres->modifypc)(ksp, ksp->its, loc_it, *res_norm, fgmres->modifyctx));
+      PetscCall(KSP_PCApply(ksp, VEC_VV(loc_it), PREVEC(loc_it)));
+      PetscCall(KSP_MatMult(ksp, Amat, PREVEC(loc_it), VEC_VV(1 + loc_it)));
+    }
+    if (loc_it) PetscCall(VecMDotBegin(VEC_VV(loc_it), loc_it + 1, &VEC_VV(0), lhh));
+    if (apply) PetscCall(VecMDotBegin(VEC_VV(loc_it + 1), loc_it + 1, &VEC_VV(0), rhh));
+    if (loc_it) PetscCall(VecMDotEnd(VEC_VV(loc_it), loc_it + 1, &VEC_VV(0), lhh));
+    if (apply) PetscCall(VecMDotEnd(VEC_VV(loc_it + 1), loc_it + 1, &VEC_VV(0), rhh));
+
+    if (loc_it) {
+      /* complete column loc_it - 1 */
+      PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      PetscCall(KSPGMRESSingleReduceNormalize_Private(ksp, loc_it, lhh, work, &tt));
+      PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      if (ksp->reason) break;
+
+      /* Happy Breakdown Check */
+      hapbnd = PetscAbsScalar(tt / *RS(loc_it - 1));
+      hapbnd = PetscMin(fgmres->haptol, hapbnd);
+      if (!(tt > hapbnd)) hapend = PETSC_TRUE; /* no new direction, VEC_VV(loc_it) was not normalized */
+      PetscCall(KSPFGMRESUpdateHessenberg(ksp, loc_it - 1, hapend, res_norm));
+      if (ksp->reason) break;
+
+      fgmres->it = (loc_it - 1);
+      PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+      ksp->its++;
+      ksp->rnorm = *res_norm;
+      PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+
+      PetscCall((*ksp->converged)(ksp, ksp->its, *res_norm, &ksp->reason, ksp->cnvP));
+
+      /* Catch error in happy breakdown and signal convergence and break from loop */
+      if (hapend && !ksp->reason) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Reached happy break down, but convergence was not indicated. Residual norm = %g", (double)*res_norm);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      }
+      if (ksp->reason || loc_it >= max_k || ksp->its >= ksp->max_it) break;
+      PetscAssert(apply, PETSC_COMM_SELF, PETSC_ERR_PLIB, "The image of direction %" PetscInt_FMT " was not computed", loc_it);
+      PetscCall(KSPLogResidualHistory(ksp, *res_norm));
+      PetscCall(KSPMonitor(ksp, ksp->its, *res_norm));
+
+      /* the preconditioned direction was computed before the normalization */
+      PetscCall(VecScale(PREVEC(loc_it), 1.0 / tt));
+    }
+
+    /* first pass for column loc_it, VEC_VV(loc_it + 1) becomes the next direction */
+    PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+    PetscCall(KSPGMRESSingleReduceProject_Private(ksp, loc_it, lhh, rhh, tt, PETSC_TRUE, work, NULL));
+    PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+    loc_it++;
+  }
+  *itcount = loc_it;
+  PetscCall(PetscFree3(lhh, rhh, work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode KSPFGMRESCycle(PetscInt *itcount, KSP ksp)
 {
   KSP_FGMRES *fgmres = (KSP_FGMRES *)ksp->data;
@@ -99,6 +184,7 @@ static PetscErrorCode KSPFGMRESCycle(PetscInt *itcount, KSP ksp)
   /* MAIN ITERATION LOOP BEGINNING*/
   /* keep iterating until we have converged OR generated the max number
      of directions OR reached the max number of iterations for the method */
+  if (fgmres->orthog == KSPGMRESSingleReduceGramSchmidtOrthogonalization) PetscCall(KSPFGMRESSingleReduceCycle(ksp, &loc_it, &res_norm));
   while (!ksp->reason && loc_it < max_k && ksp->its < ksp->max_it) {
     if (loc_it) {
       PetscCall(KSPLogResidualHistory(ksp, res_norm));
@@ -128,10 +214,12 @@ static PetscErrorCode KSPFGMRESCycle(PetscInt *itcount, KSP ksp)
 
     /* update hessenberg matrix and do Gram-Schmidt - new direction is in
        VEC_VV(1+loc_it)*/
+    fgmres->orthognorm = -1.0;
     PetscCall((*fgmres->orthog)(ksp, loc_it));
 
-    /* new entry in hessenburg is the 2-norm of our new direction */
-    PetscCall(VecNorm(VEC_VV(loc_it + 1), NORM_2, &tt));
+    /* new entry in hessenburg is the 2-norm of our new direction, unless the orthogonalization already computed it */
+    if (fgmres->orthognorm < 0.0) PetscCall(VecNorm(VEC_VV(loc_it + 1), NORM_2, &tt));
+    else tt = fgmres->orthognorm;
     KSPCheckNorm(ksp, tt);
 
     *HH(loc_it + 1, loc_it)  = tt;
@@ -287,14 +375,13 @@ static PetscErrorCode KSPFGMRESBuildSoln(PetscScalar *nrs, Vec vguess, Vec vdest
 
   /* Accumulate the correction to the soln of the preconditioned prob. in
      VEC_TEMP - note that we use the preconditioned vectors  */
-  PetscCall(VecMAXPBY(VEC_TEMP, it + 1, nrs, 0, &PREVEC(0)));
-
-  /* put updated solution into vdest.*/
   if (vdest != vguess) {
+    PetscCall(VecMAXPBY(VEC_TEMP, it + 1, nrs, 0, &PREVEC(0)));
+    /* put updated solution into vdest.*/
     PetscCall(VecCopy(VEC_TEMP, vdest));
     PetscCall(VecAXPY(vdest, 1.0, vguess));
-  } else { /* replace guess with solution */
-    PetscCall(VecAXPY(vdest, 1.0, VEC_TEMP));
+  } else { /* replace guess with solution, without going through VEC_TEMP */
+    PetscCall(VecMAXPY(vdest, it + 1, nrs, &PREVEC(0)));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -500,6 +587,7 @@ static PetscErrorCode KSPGMRESGetRestart_FGMRES(KSP ksp, PetscInt *max_k)
 .   -ksp_gmres_preallocate - preallocate all the Krylov search directions initially (otherwise groups of vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_singlereducegramschmidt - use classical Gram-Schmidt with a delayed second pass and a single global reduction per iteration
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt orthogonalization.
 .   -ksp_gmres_krylov_monitor - plot the Krylov space generated
@@ -524,7 +612,7 @@ static PetscErrorCode KSPGMRESGetRestart_FGMRES(KSP ksp, PetscInt *max_k)
 
 .seealso: [](ch_ksp), [](sec_flexibleksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPGMRES`, `KSPLGMRES`,
           `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`,
-          `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
+          `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`, `KSPGMRESSingleReduceGramSchmidtOrthogonalization()`,
           `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPFGMRESSetModifyPC()`,
           `KSPFGMRESModifyPCKSP()`
 M*/
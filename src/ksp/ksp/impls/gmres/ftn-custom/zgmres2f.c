@@ -2,13 +2,15 @@
 #include <petscksp.h>
 
 #if defined(PETSC_HAVE_FORTRAN_CAPS)
-  #define kspgmressetorthogonalization_                  KSPGMRESSETORTHOGONALIZATION
-  #define kspgmresmodifiedgramschmidtorthogonalization_  KSPGMRESMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
-  #define kspgmresclassicalgramschmidtorthogonalization_ KSPGMRESCLASSICALGRAMSCHMIDTORTHOGONALIZATION
+  #define kspgmressetorthogonalization_                     KSPGMRESSETORTHOGONALIZATION
+  #define kspgmresmodifiedgramschmidtorthogonalization_     KSPGMRESMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
+  #define kspgmresclassicalgramschmidtorthogonalization_    KSPGMRESCLASSICALGRAMSCHMIDTORTHOGONALIZATION
+  #define kspgmressinglereducegramschmidtorthogonalization_ KSPGMRESSINGLEREDUCEGRAMSCHMIDTORTHOGONALIZATION
 #elif !defined(PETSC_HAVE_FORTRAN_UNDERSCORE)
-  #define kspgmressetorthogonalization_                  kspgmressetorthogonalization
-  #define kspgmresmodifiedgramschmidtorthogonalization_  kspgmresmodifiedgramschmidtorthogonalization
-  #define kspgmresclassicalgramschmidtorthogonalization_ kspgmresclassicalgramschmidtorthogonalization
+  #define kspgmressetorthogonalization_                     kspgmressetorthogonalization
+  #define kspgmresmodifiedgramschmidtorthogonalization_     kspgmresmodifiedgramschmidtorthogonalization
+  #define kspgmresclassicalgramschmidtorthogonalization_    kspgmresclassicalgramschmidtorthogonalization
+  #define kspgmressinglereducegramschmidtorthogonalization_ kspgmressinglereducegramschmidtorthogonalization
 #endif
 
 static struct {
@@ -25,6 +27,11 @@ PETSC_EXTERN void kspgmresclassicalgramschmidtorthogonalization_(KSP *ksp, Petsc
   *ierr = KSPGMRESClassicalGramSchmidtOrthogonalization(*ksp, *n);
 }
 
+PETSC_EXTERN void kspgmressinglereducegramschmidtorthogonalization_(KSP *ksp, PetscInt *n, PetscErrorCode *ierr)
+{
+  *ierr = KSPGMRESSingleReduceGramSchmidtOrthogonalization(*ksp, *n);
+}
+
 static PetscErrorCode ourorthog(KSP ksp, PetscInt n)
 {
   PetscObjectUseFortranCallback(ksp, _cb.orthog, (KSP *, PetscInt *, PetscErrorCode *), (&ksp, &n, &ierr));
@@ -36,6 +43,8 @@ PETSC_EXTERN void kspgmressetorthogonalization_(KSP *ksp, void (*orthog)(KSP *,
     *ierr = KSPGMRESSetOrthogonalization(*ksp, KSPGMRESModifiedGramSchmidtOrthogonalization);
   } else if ((PetscVoidFn *)orthog == (PetscVoidFn *)kspgmresclassicalgramschmidtorthogonalization_) {
     *ierr = KSPGMRESSetOrthogonalization(*ksp, KSPGMRESClassicalGramSchmidtOrthogonalization);
+  } else if ((PetscVoidFn *)orthog == (PetscVoidFn *)kspgmressinglereducegramschmidtorthogonalization_) {
+    *ierr = KSPGMRESSetOrthogonalization(*ksp, KSPGMRESSingleReduceGramSchmidtOrthogonalization);
   } else {
     *ierr = PetscObjectSetFortranCallback((PetscObject)*ksp, PETSC_FORTRAN_CALLBACK_CLASS, &_cb.orthog, (PetscVoidFn *)orthog, NULL);
     if (*ierr) return;
@@ -81,6 +81,94 @@ PetscErrorCode KSPSetUp_GMRES(KSP ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    KSPGMRESSingleReduceCycle - The iterations of KSPGMRESCycle() with KSPGMRESSingleReduceGramSchmidtOrthogonalization()
+
+    The second pass of the orthogonalization and the normalization of VEC_VV(it) are lagged to iteration it + 1, where they
+    share one reduction with the first pass of the image VEC_VV(it + 1) of the direction. The reduction is overlapped with
+    the application of the operator to VEC_VV(it + 1), before its projection, and the result is corrected afterwards.
+    It returns when the loop condition of KSPGMRESCycle() is false.
+*/
+static PetscErrorCode KSPGMRESSingleReduceCycle(KSP ksp, PetscInt *itcount, PetscReal *res)
+{
+  KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  PetscReal    hapbnd, tt = 1.0;
+  PetscInt     it = 0, max_k = gmres->max_k;
+  PetscBool    hapend = PETSC_FALSE, havew = PETSC_TRUE;
+  PetscScalar *lhh, *rhh, *work;
+
+  PetscFunctionBegin;
+  if (ksp->reason || !max_k || ksp->its >= ksp->max_it) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc3(max_k + 1, &lhh, max_k + 1, &rhh, 2 * (max_k + 2), &work));
+  if (gmres->vv_allocated <= VEC_OFFSET + 1) PetscCall(KSPGMRESGetNewVectors(ksp, 1));
+  PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(0), VEC_VV(1), VEC_TEMP_MATOP));
+  PetscCall(VecMDotBegin(VEC_VV(1), 1, &VEC_VV(0), rhh));
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(1))));
+  while (PETSC_TRUE) {
+    /* the image of VEC_VV(it + 1) is needed if column it + 1 is computed in the next iteration */
+    PetscBool apply = (PetscBool)(it + 1 < max_k && ksp->its + (it ? 1 : 0) + 1 < ksp->max_it);
+
+    if (apply) {
+      if (gmres->vv_allocated <= it + VEC_OFFSET + 2) PetscCall(KSPGMRESGetNewVectors(ksp, it + 2));
+      PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(it + 1), VEC_VV(it + 2), VEC_TEMP_MATOP));
+    }
+    if (it) PetscCall(VecMDotEnd(VEC_VV(it), it + 1, &VEC_VV(0), lhh));
+    if (havew) PetscCall(VecMDotEnd(VEC_VV(it + 1), it + 1, &VEC_VV(0), rhh));
+
+    if (it) {
+      /* complete column it - 1 */
+      PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      PetscCall(KSPGMRESSingleReduceNormalize_Private(ksp, it, lhh, work, &tt));
+      PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+      if (ksp->reason) break;
+
+      /* check for the happy breakdown */
+      hapbnd = PetscAbsScalar(tt / *GRS(it - 1));
+      if (hapbnd > gmres->haptol) hapbnd = gmres->haptol;
+      if (tt < hapbnd || tt == 0.0) {
+        PetscCall(PetscInfo(ksp, "Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n", (double)hapbnd, (double)tt));
+        hapend = PETSC_TRUE;
+      }
+      PetscCall(KSPGMRESUpdateHessenberg(ksp, it - 1, hapend, res));
+
+      gmres->it = (it - 1); /* For converged */
+      ksp->its++;
+      ksp->rnorm = *res;
+      if (ksp->reason) break;
+
+      PetscCall((*ksp->converged)(ksp, ksp->its, *res, &ksp->reason, ksp->cnvP));
+
+      /* Catch error in happy breakdown and signal convergence and break from loop */
+      if (hapend) {
+        if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+          ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+        } else if (!ksp->reason) {
+          PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Reached happy break down, but convergence was not indicated. Residual norm = %g", (double)*res);
+          ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        }
+      }
+      if (ksp->reason || it >= max_k || ksp->its >= ksp->max_it) break;
+      PetscAssert(havew, PETSC_COMM_SELF, PETSC_ERR_PLIB, "The image of direction %" PetscInt_FMT " was not computed", it);
+      PetscCall(KSPLogResidualHistory(ksp, *res));
+      PetscCall(KSPLogErrorHistory(ksp));
+      PetscCall(KSPMonitor(ksp, ksp->its, *res));
+    }
+
+    /* first pass for column it, VEC_VV(it + 1) becomes the next direction and VEC_VV(it + 2) its image */
+    PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+    PetscCall(KSPGMRESSingleReduceProject_Private(ksp, it, lhh, rhh, tt, PETSC_FALSE, work, apply ? VEC_VV(it + 2) : NULL));
+    PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+    it++;
+    havew = apply;
+    PetscCall(VecMDotBegin(VEC_VV(it), it + 1, &VEC_VV(0), lhh));
+    if (havew) PetscCall(VecMDotBegin(VEC_VV(it + 1), it + 1, &VEC_VV(0), rhh));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(it))));
+  }
+  *itcount = it;
+  PetscCall(PetscFree3(lhh, rhh, work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
     Run gmres, possibly with restart.  Return residual history if requested.
     input parameters:
@@ -135,6 +223,7 @@ static PetscErrorCode KSPGMRESCycle(PetscInt *itcount, KSP ksp)
   }
 
   PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+  if (gmres->orthog == KSPGMRESSingleReduceGramSchmidtOrthogonalization) PetscCall(KSPGMRESSingleReduceCycle(ksp, &it, &res));
   while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
     if (it) {
       PetscCall(KSPLogResidualHistory(ksp, res));
@@ -146,11 +235,16 @@ static PetscErrorCode KSPGMRESCycle(PetscInt *itcount, KSP ksp)
     PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(it), VEC_VV(1 + it), VEC_TEMP_MATOP));
 
     /* update hessenberg matrix and do Gram-Schmidt */
+    gmres->orthognorm = -1.0;
     PetscCall((*gmres->orthog)(ksp, it));
     if (ksp->reason) break;
 
-    /* vv(i+1) . vv(i+1) */
-    PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    /* vv(i+1) . vv(i+1), unless the orthogonalization already computed it */
+    if (gmres->orthognorm < 0.0) PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    else {
+      tt = gmres->orthognorm;
+      if (tt > 0.0) PetscCall(VecScale(VEC_VV(it + 1), 1.0 / tt));
+    }
     KSPCheckNorm(ksp, tt);
 
     /* save the magnitude */
@@ -474,6 +568,8 @@ PetscErrorCode KSPView_GMRES(KSP ksp, PetscViewer viewer)
     default:
       SETERRQ(PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Unknown orthogonalization");
     }
+  } else if (gmres->orthog == KSPGMRESSingleReduceGramSchmidtOrthogonalization) {
+    cstr = "Single reduction classical (unmodified) Gram-Schmidt Orthogonalization with delayed reorthogonalization (DCGS2)";
   } else if (gmres->orthog == KSPGMRESModifiedGramSchmidtOrthogonalization) {
     cstr = "Modified Gram-Schmidt Orthogonalization";
   } else {
@@ -549,8 +645,10 @@ PetscErrorCode KSPSetFromOptions_GMRES(KSP ksp, PetscOptionItems *PetscOptionsOb
   if (flg) PetscCall(KSPGMRESSetPreAllocateVectors(ksp));
   PetscCall(PetscOptionsBoolGroupBegin("-ksp_gmres_classicalgramschmidt", "Classical (unmodified) Gram-Schmidt (fast)", "KSPGMRESSetOrthogonalization", &flg));
   if (flg) PetscCall(KSPGMRESSetOrthogonalization(ksp, KSPGMRESClassicalGramSchmidtOrthogonalization));
-  PetscCall(PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt", "Modified Gram-Schmidt (slow,more stable)", "KSPGMRESSetOrthogonalization", &flg));
+  PetscCall(PetscOptionsBoolGroup("-ksp_gmres_modifiedgramschmidt", "Modified Gram-Schmidt (slow,more stable)", "KSPGMRESSetOrthogonalization", &flg));
   if (flg) PetscCall(KSPGMRESSetOrthogonalization(ksp, KSPGMRESModifiedGramSchmidtOrthogonalization));
+  PetscCall(PetscOptionsBoolGroupEnd("-ksp_gmres_singlereducegramschmidt", "Classical Gram-Schmidt with a delayed second pass and a single reduction per iteration", "KSPGMRESSetOrthogonalization", &flg));
+  if (flg) PetscCall(KSPGMRESSetOrthogonalization(ksp, KSPGMRESSingleReduceGramSchmidtOrthogonalization));
   PetscCall(PetscOptionsEnum("-ksp_gmres_cgs_refinement_type", "Type of iterative refinement for classical (unmodified) Gram-Schmidt", "KSPGMRESSetCGSRefinementType", KSPGMRESCGSRefinementTypes, (PetscEnum)gmres->cgstype, (PetscEnum *)&gmres->cgstype, &flg));
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-ksp_gmres_krylov_monitor", "Plot the Krylov directions", "KSPMonitorSet", flg, &flg, NULL));
@@ -828,6 +926,8 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
                              vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_singlereducegramschmidt - use classical Gram-Schmidt with a delayed second pass and a single global reduction per iteration, overlapped with the
+                                   application of the operator
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
@@ -839,7 +939,7 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 
 .seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPFGMRES`, `KSPLGMRES`,
           `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`,
-          `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
+          `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`, `KSPGMRESSingleReduceGramSchmidtOrthogonalization()`,
           `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPSetPCSide()`
 M*/
 
@@ -14,20 +14,21 @@
 - it  - the current iteration
 
   Options Database Keys:
-+ -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization() (default)
-- -ksp_gmres_modifiedgramschmidt  - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
++ -ksp_gmres_classicalgramschmidt    - Activates KSPGMRESClassicalGramSchmidtOrthogonalization() (default)
+. -ksp_gmres_modifiedgramschmidt     - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+- -ksp_gmres_singlereducegramschmidt - Activates KSPGMRESSingleReduceGramSchmidtOrthogonalization()
 
   Level: intermediate
 
   Notes:
-  Two orthogonalization routines are predefined, `KSPGMRESModifiedGramSchmidtOrthogonalization()` and the default
-  `KSPGMRESClassicalGramSchmidtOrthogonalization()`.
+  Three orthogonalization routines are predefined, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
+  `KSPGMRESSingleReduceGramSchmidtOrthogonalization()` and the default `KSPGMRESClassicalGramSchmidtOrthogonalization()`.
 
   Use `KSPGMRESSetCGSRefinementType()` to determine if iterative refinement is used to increase stability.
 
 .seealso: [](ch_ksp), `KSPGMRESSetRestart()`, `KSPGMRESSetPreAllocateVectors()`,
 `KSPGMRESSetCGSRefinementType()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
-`KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESGetCGSRefinementType()`
+`KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESSingleReduceGramSchmidtOrthogonalization()`, `KSPGMRESGetCGSRefinementType()`
 @*/
 PetscErrorCode KSPGMRESSetOrthogonalization(KSP ksp, PetscErrorCode (*fcn)(KSP ksp, PetscInt it))
 {
@@ -28,6 +28,7 @@
 \
   PetscErrorCode (*orthog)(KSP, PetscInt); \
   KSPGMRESCGSRefinementType cgstype; \
+  PetscReal                 orthognorm; /* norm of the new direction if computed by orthog(), negative otherwise */ \
 \
   Vec     *vecs;           /* the work vectors */ \
   Vec     *vecb;           /* holds the last full basis vectors of the Krylov subspace to compute (harmonic) Ritz pairs */ \
@@ -61,6 +62,8 @@ PETSC_INTERN PetscErrorCode KSPComputeRitz_GMRES(KSP, PetscBool, PetscBool, Pets
 PETSC_INTERN PetscErrorCode KSPReset_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPDestroy_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESGetNewVectors(KSP, PetscInt);
+PETSC_INTERN PetscErrorCode KSPGMRESSingleReduceNormalize_Private(KSP, PetscInt, const PetscScalar[], PetscScalar[], PetscReal *);
+PETSC_INTERN PetscErrorCode KSPGMRESSingleReduceProject_Private(KSP, PetscInt, const PetscScalar[], const PetscScalar[], PetscReal, PetscBool, PetscScalar[], Vec);
 
 typedef PetscErrorCode (*FCN)(KSP, PetscInt); /* force argument to next function to not be extern C*/
 
@@ -183,10 +183,12 @@ static PetscErrorCode KSPLGMRESCycle(PetscInt *itcount, KSP ksp)
     }
 
     /* update hessenberg matrix and do Gram-Schmidt - new direction is in VEC_VV(1+loc_it)*/
+    lgmres->orthognorm = -1.0;
     PetscCall((*lgmres->orthog)(ksp, loc_it));
 
-    /* new entry in hessenburg is the 2-norm of our new direction */
-    PetscCall(VecNorm(VEC_VV(loc_it + 1), NORM_2, &tt));
+    /* new entry in hessenburg is the 2-norm of our new direction, unless the orthogonalization already computed it */
+    if (lgmres->orthognorm < 0.0) PetscCall(VecNorm(VEC_VV(loc_it + 1), NORM_2, &tt));
+    else tt = lgmres->orthognorm;
 
     *HH(loc_it + 1, loc_it)  = tt;
     *HES(loc_it + 1, loc_it) = tt;
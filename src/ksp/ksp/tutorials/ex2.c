@@ -233,10 +233,61 @@ int main(int argc, char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   testset:
+      nsize: 2
+      args: -ksp_monitor_short -ksp_gmres_singlereducegramschmidt
+      test:
+         suffix: singlereduce
+         output_file: output/ex2_singlereduce.out
+      test:
+         suffix: singlereduce_fgmres
+         args: -ksp_type fgmres
+         output_file: output/ex2_singlereduce_fgmres.out
+      test:
+         suffix: singlereduce_restart
+         args: -ksp_gmres_restart 3
+         output_file: output/ex2_singlereduce_restart.out
+      test:
+         suffix: singlereduce_lgmres
+         args: -ksp_type lgmres -ksp_gmres_restart 3
+         output_file: output/ex2_singlereduce_lgmres.out
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   testset:
+      args: -pc_type sor -pc_sor_multicolor -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
+      output_file: output/ex2_sor_multicolor.out
+      test:
+         suffix: sor_multicolor
+         args: -omp_num_threads {{1 3}}
+      test:
+         suffix: sor_multicolor_2
+         nsize: 2
+         args: -mat_aij_threads
+         output_file: output/ex2_sor_multicolor_2.out
+
+   test:
+      suffix: sor_multicolor_transpose
+      args: -ksp_type bicg -pc_type sor -pc_sor_multicolor -ksp_monitor_short
+
+   test:
+      suffix: ilu_threads
+      args: -ksp_monitor_short -pc_type ilu -pc_factor_levels 1 -mat_aij_threads -omp_num_threads {{1 3}}
+
+   test:
+      suffix: icc_threads
+      args: -ksp_monitor_short -ksp_type cg -pc_type icc -pc_factor_levels 1 -pc_factor_mat_ordering_type {{natural rcm}separate output} -mat_aij_threads -omp_num_threads {{1 3}}
+
+   test:
+      suffix: ilu_sweeps
+      args: -ksp_monitor_short -pc_type ilu -pc_factor_levels 1 -pc_factor_sweeps 3 -pc_factor_solve_sweeps 3 -pc_factor_mat_ordering_type {{natural rcm}separate output} -omp_num_threads {{1 3}}
+
+   test:
+      suffix: supernodal
+      args: -m 37 -n 23 -ksp_type preonly -ksp_error_if_not_converged -pc_type {{lu cholesky}} -pc_factor_mat_ordering_type {{natural nd rcm}} -mat_factor_supernodal
+
    test:
       suffix: 4
       args: -pc_type eisenstat -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
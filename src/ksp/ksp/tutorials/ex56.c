@@ -26,7 +26,7 @@ int main(int argc, char **args)
   Mat           Amat;
   PetscInt      m, nn, M, Istart, Iend, i, j, k, ii, jj, kk, ic, ne = 4, id;
   PetscReal     x, y, z, h, *coords, soft_alpha = 1.e-3;
-  PetscBool     two_solves = PETSC_FALSE, test_nonzero_cols = PETSC_FALSE, use_nearnullspace = PETSC_FALSE, test_late_bs = PETSC_FALSE;
+  PetscBool     two_solves = PETSC_FALSE, test_nonzero_cols = PETSC_FALSE, use_nearnullspace = PETSC_FALSE, test_late_bs = PETSC_FALSE, test_rescale = PETSC_FALSE;
   Vec           xx, bb;
   KSP           ksp;
   MPI_Comm      comm;
@@ -52,6 +52,7 @@ int main(int argc, char **args)
     PetscCall(PetscOptionsBool("-test_nonzero_cols", "nonzero test", "", test_nonzero_cols, &test_nonzero_cols, NULL));
     PetscCall(PetscOptionsBool("-use_mat_nearnullspace", "MatNearNullSpace API test", "", use_nearnullspace, &use_nearnullspace, NULL));
     PetscCall(PetscOptionsBool("-test_late_bs", "", "", test_late_bs, &test_late_bs, NULL));
+    PetscCall(PetscOptionsBool("-test_rescale", "rescale the rows and columns non-uniformly for the 2nd solve and compare with a new solver", "", test_rescale, &test_rescale, NULL));
   }
   PetscOptionsEnd();
 
@@ -343,8 +344,21 @@ int main(int argc, char **args)
 
     PetscCall(MaybeLogStagePush(stage[2]));
     /* PC setup basically */
-    PetscCall(MatScale(Amat, -100000.0));
-    PetscCall(MatSetOption(Amat, MAT_SPD, PETSC_FALSE));
+    if (test_rescale) {
+      Vec          dd;
+      PetscScalar *d;
+
+      /* A symmetric diagonal scaling keeps the strength graph, and so the aggregates, but changes the smoothed prolongator */
+      PetscCall(MatCreateVecs(Amat, &dd, NULL));
+      PetscCall(VecGetArray(dd, &d));
+      for (i = 0; i < m; i++) d[i] = 1.0 + 0.5 * (PetscReal)((Istart + i) % 7);
+      PetscCall(VecRestoreArray(dd, &d));
+      PetscCall(MatDiagonalScale(Amat, dd, dd));
+      PetscCall(VecDestroy(&dd));
+    } else {
+      PetscCall(MatScale(Amat, -100000.0));
+      PetscCall(MatSetOption(Amat, MAT_SPD, PETSC_FALSE));
+    }
     PetscCall(KSPSetOperators(ksp, Amat, Amat));
     PetscCall(KSPSetUp(ksp));
 
@@ -353,6 +367,29 @@ int main(int argc, char **args)
     PetscCall(KSPSolve(ksp, bb, xx));
     PetscCall(KSPComputeExtremeSingularValues(ksp, &emax, &emin));
 
+    /* the updated solver must match one set up from scratch, for example with -pc_gamg_reuse_aggregates */
+    if (test_rescale) {
+      KSP       ksp2;
+      Vec       x2;
+      PetscInt  its, its2;
+      PetscReal xnorm, dnorm;
+
+      PetscCheck(use_nearnullspace, comm, PETSC_ERR_SUP, "-test_rescale requires -use_mat_nearnullspace");
+      PetscCall(KSPCreate(comm, &ksp2));
+      PetscCall(KSPSetFromOptions(ksp2));
+      PetscCall(KSPSetOperators(ksp2, Amat, Amat));
+      PetscCall(VecDuplicate(xx, &x2));
+      PetscCall(KSPSolve(ksp2, bb, x2));
+      PetscCall(KSPGetIterationNumber(ksp, &its));
+      PetscCall(KSPGetIterationNumber(ksp2, &its2));
+      PetscCall(VecNorm(xx, NORM_2, &xnorm));
+      PetscCall(VecAXPY(x2, -1.0, xx));
+      PetscCall(VecNorm(x2, NORM_2, &dnorm));
+      PetscCall(PetscPrintf(comm, "Updated solver: %" PetscInt_FMT " iterations, new solver: %" PetscInt_FMT " iterations, the solutions %s\n", its, its2, dnorm <= 1.e-10 * xnorm ? "match" : "differ"));
+      PetscCall(VecDestroy(&x2));
+      PetscCall(KSPDestroy(&ksp2));
+    }
+
     PetscCall(MaybeLogStagePop());
     PetscCall(MaybeLogStagePush(stage[4]));
 
@@ -484,6 +521,10 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
      test:
        suffix: gamg
        args: -pc_type gamg -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -mg_levels_pc_jacobi_type rowl1 -mg_levels_pc_jacobi_rowl1_scale .5 -mg_levels_pc_jacobi_fixdiagonal
+     test:
+       suffix: gamg_threads
+       args: -pc_type gamg -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -mg_levels_pc_jacobi_type rowl1 -mg_levels_pc_jacobi_rowl1_scale .5 -mg_levels_pc_jacobi_fixdiagonal -pc_gamg_threshold 0 -mat_coarsen_threads -omp_num_threads {{1 3}}
+       output_file: output/ex56_gamg.out
      test:
        nsize: 1
        suffix: baij
@@ -512,6 +553,16 @@ PetscErrorCode elem_3d_elast_v_25(PetscScalar *dd)
       suffix: nns
       args: -ne 9 -alpha 1.e-3 -ksp_converged_reason -ksp_type cg -ksp_max_it 50 -pc_type gamg -pc_gamg_esteig_ksp_type cg -pc_gamg_esteig_ksp_max_it 10 -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -pc_gamg_coarse_eq_limit 1000 -mg_levels_ksp_type chebyshev -mg_levels_pc_type sor -pc_gamg_reuse_interpolation true -two_solves -use_mat_nearnullspace -pc_gamg_use_sa_esteig 0 -mg_levels_esteig_ksp_max_it 10
 
+   testset:
+     args: -ne 9 -alpha 1.e-3 -ksp_converged_reason -ksp_type cg -ksp_max_it 50 -pc_type gamg -pc_gamg_esteig_ksp_type cg -pc_gamg_esteig_ksp_max_it 10 -pc_gamg_type agg -pc_gamg_agg_nsmooths 1 -mg_levels_ksp_type chebyshev -mg_levels_pc_type sor -pc_gamg_reuse_aggregates -two_solves -test_rescale -use_mat_nearnullspace -pc_gamg_use_sa_esteig 0 -mg_levels_esteig_ksp_max_it 10
+     test:
+       suffix: reuse_aggs
+       args: -pc_gamg_coarse_eq_limit 1000
+     test:
+       suffix: reuse_aggs_2
+       nsize: 8
+       args: -pc_gamg_coarse_eq_limit 200 -pc_gamg_process_eq_limit 30
+
    test:
       suffix: nns_telescope
       nsize: 2
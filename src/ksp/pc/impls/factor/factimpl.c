@@ -282,6 +282,8 @@ PetscErrorCode PCView_Factor(PC pc, PetscViewer viewer)
       } else {
         PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " levels of fill\n", (PetscInt)factor->info.levels));
       }
+      if (factor->info.factorsweeps > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " fixed-point sweeps of the factorization\n", (PetscInt)factor->info.factorsweeps));
+      if (factor->info.solvesweeps > 0) PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " Jacobi sweeps of the triangular solves\n", (PetscInt)factor->info.solvesweeps));
     }
 
     PetscCall(PetscViewerASCIIPrintf(viewer, "  tolerance for zero pivot %g\n", (double)factor->info.zeropivot));
@@ -335,6 +335,70 @@ PetscErrorCode PCFactorSetLevels(PC pc, PetscInt levels)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PCFactorSetSweeps - Sets the number of fixed-point sweeps computing the entries of the ILU factors and the number of Jacobi
+  sweeps of the triangular solves, instead of the exact factorization and the exact triangular solves.
+
+  Logically Collective
+
+  Input Parameters:
++ pc           - the preconditioner context
+. factorsweeps - number of fixed-point sweeps of the factorization, 0 for the exact factorization
+- solvesweeps  - number of Jacobi sweeps of each triangular solve, 0 for exact triangular solves
+
+  Options Database Keys:
++ -pc_factor_sweeps <factorsweeps>      - Sets the number of sweeps of the factorization
+- -pc_factor_solve_sweeps <solvesweeps> - Sets the number of sweeps of the triangular solves
+
+  Level: intermediate
+
+  Notes:
+  This is the fine-grained parallel ILU of {cite}`chow2015fine`: every sweep updates all the entries of L and U on the nonzero pattern
+  of ILU(k) from the values of the previous sweep, starting from the entries of the matrix, so the rows are computed concurrently by the
+  OpenMP threads. Each Jacobi sweep of a triangular solve is a product with the strictly triangular part of the factor. Both converge
+  to the exact ILU(k) preconditioner as the number of sweeps increases; a few sweeps usually give a preconditioner of similar quality
+  when the matrix is diagonally dominant.
+
+  Only used by `PCILU` with `MATSEQAIJ` matrices, for example as the subdomain solver of `PCBJACOBI` or `PCASM`, and not with `PCFactorSetUseInPlace()`
+  or `PCFactorSetDropTolerance()`. Only `MatSolve()` uses the Jacobi sweeps, `MatSolveTranspose()` remains exact.
+
+.seealso: [](ch_ksp), `PCILU`, `PCFactorGetSweeps()`, `PCFactorSetLevels()`
+@*/
+PetscErrorCode PCFactorSetSweeps(PC pc, PetscInt factorsweeps, PetscInt solvesweeps)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, factorsweeps, 2);
+  PetscValidLogicalCollectiveInt(pc, solvesweeps, 3);
+  PetscCheck(factorsweeps >= 0 && solvesweeps >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps cannot be negative");
+  PetscTryMethod(pc, "PCFactorSetSweeps_C", (PC, PetscInt, PetscInt), (pc, factorsweeps, solvesweeps));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCFactorGetSweeps - Gets the number of fixed-point sweeps of the ILU factorization and the number of Jacobi sweeps of the triangular solves
+
+  Not Collective
+
+  Input Parameter:
+. pc - the preconditioner context
+
+  Output Parameters:
++ factorsweeps - number of fixed-point sweeps of the factorization, 0 for the exact factorization
+- solvesweeps  - number of Jacobi sweeps of each triangular solve, 0 for exact triangular solves
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `PCILU`, `PCFactorSetSweeps()`
+@*/
+PetscErrorCode PCFactorGetSweeps(PC pc, PetscInt *factorsweeps, PetscInt *solvesweeps)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscUseMethod(pc, "PCFactorGetSweeps_C", (PC, PetscInt *, PetscInt *), (pc, factorsweeps, solvesweeps));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCFactorSetAllowDiagonalFill - Causes all diagonal matrix entries to be
   treated as level 0 fill even if there is no non-zero location.
@@ -746,5 +810,7 @@ PetscErrorCode PCFactorClearComposedFunctions(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorSetReuseFill_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorReorderForNonzeroDiagonal_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorSetDropTolerance_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorSetSweeps_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorGetSweeps_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
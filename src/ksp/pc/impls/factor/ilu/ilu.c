@@ -40,6 +40,30 @@ PetscErrorCode PCFactorSetDropTolerance_ILU(PC pc, PetscReal dt, PetscReal dtcol
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PCFactorSetSweeps_ILU(PC pc, PetscInt factorsweeps, PetscInt solvesweeps)
+{
+  PC_Factor *ilu = (PC_Factor *)pc->data;
+
+  PetscFunctionBegin;
+  if (pc->setupcalled && (ilu->info.factorsweeps != factorsweeps || ilu->info.solvesweeps != solvesweeps)) {
+    PetscUseTypeMethod(pc, reset); /* the sweeps are selected by the symbolic factorization */
+    pc->setupcalled = 0;
+  }
+  ilu->info.factorsweeps = factorsweeps;
+  ilu->info.solvesweeps  = solvesweeps;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCFactorGetSweeps_ILU(PC pc, PetscInt *factorsweeps, PetscInt *solvesweeps)
+{
+  PC_Factor *ilu = (PC_Factor *)pc->data;
+
+  PetscFunctionBegin;
+  if (factorsweeps) *factorsweeps = (PetscInt)ilu->info.factorsweeps;
+  if (solvesweeps) *solvesweeps = (PetscInt)ilu->info.solvesweeps;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCSetFromOptions_ILU(PC pc, PetscOptionItems *PetscOptionsObject)
 {
   PetscInt  itmp;
@@ -56,6 +80,14 @@ static PetscErrorCode PCSetFromOptions_ILU(PC pc, PetscOptionItems *PetscOptions
 
   PetscCall(PetscOptionsBool("-pc_factor_diagonal_fill", "Allow fill into empty diagonal entry", "PCFactorSetAllowDiagonalFill", ((PC_Factor *)ilu)->info.diagonal_fill ? PETSC_TRUE : PETSC_FALSE, &flg, &set));
   if (set) ((PC_Factor *)ilu)->info.diagonal_fill = (PetscReal)flg;
+  {
+    PetscInt factorsweeps = (PetscInt)((PC_Factor *)ilu)->info.factorsweeps, solvesweeps = (PetscInt)((PC_Factor *)ilu)->info.solvesweeps;
+    PetscBool flg2;
+
+    PetscCall(PetscOptionsInt("-pc_factor_sweeps", "Number of fixed-point sweeps of the factorization, 0 for the exact factorization", "PCFactorSetSweeps", factorsweeps, &factorsweeps, &flg));
+    PetscCall(PetscOptionsInt("-pc_factor_solve_sweeps", "Number of Jacobi sweeps of the triangular solves, 0 for exact triangular solves", "PCFactorSetSweeps", solvesweeps, &solvesweeps, &flg2));
+    if (flg || flg2) PetscCall(PCFactorSetSweeps(pc, factorsweeps, solvesweeps));
+  }
   PetscCall(PetscOptionsName("-pc_factor_nonzeros_along_diagonal", "Reorder to remove zeros from diagonal", "PCFactorReorderForNonzeroDiagonal", &flg));
   if (flg) {
     tol = PETSC_DECIDE;
@@ -249,6 +281,8 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
 .  -pc_factor_nonzeros_along_diagonal                    - reorder the matrix before factorization to remove zeros from the diagonal,
                                                          this decreases the chance of getting a zero pivot
 .  -pc_factor_mat_ordering_type <natural,nd,1wd,rcm,qmd> - set the row/column ordering of the factored matrix
+.  -pc_factor_sweeps <n>                                 - compute the factor with n fixed-point sweeps of the fine-grained parallel ILU
+.  -pc_factor_solve_sweeps <n>                           - replace the triangular solves by n Jacobi sweeps
 -  -pc_factor_pivot_in_blocks                            - for block ILU(k) factorization, i.e. with `MATBAIJ` matrices with block size larger
                                                          than 1 the diagonal blocks are factored with partial pivoting (this increases the
                                                          stability of the ILU factorization
@@ -263,6 +297,9 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
    The "symmetric" application of this preconditioner is not actually symmetric since L is not transpose(U)
    even when the matrix is not symmetric since the U stores the diagonals of the factorization.
 
+   With `PCFactorSetSweeps()` the factorization and the triangular solves of `MATSEQAIJ` matrices are approximated by sweeps in which
+   all the rows are computed concurrently, so they scale with the number of OpenMP threads.
+
    If you are using `MATSEQAIJCUSPARSE` matrices (or `MATMPIAIJCUSPARSE` matrices with block Jacobi), factorization
    is never done on the GPU).
 
@@ -270,7 +307,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc, Vec x, Vec y)
           `PCFactorSetZeroPivot()`, `PCFactorSetShiftSetType()`, `PCFactorSetAmount()`,
           `PCFactorSetDropTolerance()`, `PCFactorSetFill()`, `PCFactorSetMatOrderingType()`, `PCFactorSetReuseOrdering()`,
           `PCFactorSetLevels()`, `PCFactorSetUseInPlace()`, `PCFactorSetAllowDiagonalFill()`, `PCFactorSetPivotInBlocks()`,
-          `PCFactorGetAllowDiagonalFill()`, `PCFactorGetUseInPlace()`
+          `PCFactorGetAllowDiagonalFill()`, `PCFactorGetUseInPlace()`, `PCFactorSetSweeps()`
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_ILU(PC pc)
@@ -303,5 +340,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ILU(PC pc)
   pc->ops->applyrichardson     = NULL;
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorSetDropTolerance_C", PCFactorSetDropTolerance_ILU));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorReorderForNonzeroDiagonal_C", PCFactorReorderForNonzeroDiagonal_ILU));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorSetSweeps_C", PCFactorSetSweeps_ILU));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCFactorGetSweeps_C", PCFactorGetSweeps_ILU));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
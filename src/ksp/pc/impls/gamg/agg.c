@@ -585,6 +585,90 @@ static PetscErrorCode PCView_GAMG_AGG(PC pc, PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGFilterGraph_Threads - keeps the entries of the (MPI)AIJ graph with magnitude above vfilter using OpenMP threads
+
+   The rows of the diagonal and off-diagonal blocks are counted and then copied concurrently into new CSR arrays; the
+   result is the matrix that the MatSetValues() based filter of PCGAMGCreateGraph_AGG() assembles.
+*/
+static PetscErrorCode PCGAMGFilterGraph_Threads(Mat Gmat, PetscReal vfilter, PetscInt *a_nnz0, PetscInt *a_nnz1, PetscInt *a_maxcols, Mat *a_tGmat)
+{
+  const PetscInt  nloc   = Gmat->rmap->n;
+  const PetscInt *garray = NULL;
+  Mat             blk[2] = {NULL, NULL}, fblk[2] = {NULL, NULL};
+  PetscInt        nnz0 = 0, nnz1 = 0, maxcols = 0;
+  PetscBool       isseqaij;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  const PetscInt nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATSEQAIJ, &isseqaij));
+  if (isseqaij) blk[0] = Gmat;
+  else {
+    Mat_MPIAIJ *d = (Mat_MPIAIJ *)Gmat->data;
+
+    blk[0] = d->A;
+    blk[1] = d->B;
+    garray = d->garray;
+  }
+  for (PetscInt k = 0; k < 2 && blk[k]; k++) {
+    Mat_SeqAIJ        *a  = (Mat_SeqAIJ *)blk[k]->data;
+    const PetscInt    *ai = a->i, *aj = a->j;
+    const PetscScalar *aa;
+    PetscInt          *cnt, *fi, *fj, mx = 0;
+    PetscScalar       *fa;
+
+    PetscCall(MatSeqAIJGetArrayRead(blk[k], &aa));
+    PetscCall(PetscMalloc1(nloc + 1, &cnt));
+    cnt[0] = 0;
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static) reduction(max:mx))
+    for (PetscInt row = 0; row < nloc; row++) {
+      PetscInt c = 0;
+
+      for (PetscInt jj = ai[row]; jj < ai[row + 1]; jj++) {
+        if (PetscAbsReal(PetscRealPart(aa[jj])) > vfilter) c++;
+      }
+      cnt[row + 1] = c;
+      mx           = PetscMax(mx, ai[row + 1] - ai[row]);
+    }
+    for (PetscInt row = 0; row < nloc; row++) cnt[row + 1] += cnt[row];
+    /* a single allocation, as MatCreateMPIAIJWithSeqAIJ() requires for the off-diagonal block */
+    PetscCall(PetscMalloc3(cnt[nloc], &fa, cnt[nloc], &fj, nloc + 1, &fi));
+    PetscCall(PetscArraycpy(fi, cnt, nloc + 1));
+    PetscCall(PetscFree(cnt));
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+    for (PetscInt row = 0; row < nloc; row++) {
+      PetscInt f = fi[row];
+
+      for (PetscInt jj = ai[row]; jj < ai[row + 1]; jj++) {
+        if (PetscAbsReal(PetscRealPart(aa[jj])) > vfilter) {
+          fa[f]   = aa[jj];
+          fj[f++] = aj[jj];
+        }
+      }
+    }
+    PetscCall(MatSeqAIJRestoreArrayRead(blk[k], &aa));
+    nnz0 += ai[nloc];
+    nnz1 += fi[nloc];
+    maxcols = PetscMax(maxcols, mx);
+    PetscCall(MatCreateSeqAIJWithArrays(PETSC_COMM_SELF, nloc, blk[k]->cmap->n, fi, fj, fa, &fblk[k]));
+    a               = (Mat_SeqAIJ *)fblk[k]->data;
+    a->singlemalloc = PETSC_TRUE;
+    a->free_a       = PETSC_TRUE;
+    a->free_ij      = PETSC_TRUE;
+  }
+  if (isseqaij) *a_tGmat = fblk[0];
+  else {
+    PetscCall(MatCreateMPIAIJWithSeqAIJ(PetscObjectComm((PetscObject)Gmat), fblk[0], fblk[1], garray, a_tGmat));
+    PetscCall(MatSetOption(*a_tGmat, MAT_NEW_NONZERO_LOCATION_ERR, PETSC_FALSE));
+  }
+  *a_nnz0    = nnz0;
+  *a_nnz1    = nnz1;
+  *a_maxcols = maxcols;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCGAMGCreateGraph_AGG(PC pc, Mat Amat, Mat *a_Gmat)
 {
   PC_MG          *mg          = (PC_MG *)pc->data;
@@ -633,22 +717,20 @@ static PetscErrorCode PCGAMGCreateGraph_AGG(PC pc, Mat Amat, Mat *a_Gmat)
     // make scalar graph, symetrize if not know to be symetric, scale, but do not filter (expensive)
     PetscCall(MatCreateGraph(Amat, PETSC_TRUE, PETSC_TRUE, -1, pc_gamg_agg->crs->strength_index_size, pc_gamg_agg->crs->strength_index, a_Gmat));
     if (vfilter >= 0) {
-      PetscInt           Istart, Iend, ncols, nnz0, nnz1, NN, MM, nloc;
+      PetscInt           Istart, Iend, ncols, nnz0 = 0, nnz1 = 0, NN, MM, nloc;
       Mat                tGmat, Gmat = *a_Gmat;
       MPI_Comm           comm;
       const PetscScalar *vals;
       const PetscInt    *idx;
       PetscInt          *d_nnz, *o_nnz, kk, *garray = NULL, *AJ, maxcols = 0;
       MatScalar         *AA; // this is checked in graph
-      PetscBool          isseqaij;
+      PetscBool          isseqaij, isaij;
       Mat                a, b, c;
       MatType            jtype;
 
       PetscCall(PetscObjectGetComm((PetscObject)Gmat, &comm));
       PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATSEQAIJ, &isseqaij));
-      PetscCall(MatGetType(Gmat, &jtype));
-      PetscCall(MatCreate(comm, &tGmat));
-      PetscCall(MatSetType(tGmat, jtype));
+      PetscCall(PetscObjectTypeCompareAny((PetscObject)Gmat, &isaij, MATSEQAIJ, MATMPIAIJ, ""));
 
       /* TODO GPU: this can be called when filter = 0 -> Probably provide MatAIJThresholdCompress that compresses the entries below a threshold?
         Also, if the matrix is symmetric, can we skip this
@@ -658,60 +740,65 @@ static PetscErrorCode PCGAMGCreateGraph_AGG(PC pc, Mat Amat, Mat *a_Gmat)
       PetscCall(MatGetSize(Gmat, &MM, &NN));
       PetscCall(MatGetOwnershipRange(Gmat, &Istart, &Iend));
       nloc = Iend - Istart;
-      PetscCall(PetscMalloc2(nloc, &d_nnz, nloc, &o_nnz));
-      if (isseqaij) {
-        a = Gmat;
-        b = NULL;
-      } else {
-        Mat_MPIAIJ *d = (Mat_MPIAIJ *)Gmat->data;
-        a             = d->A;
-        b             = d->B;
-        garray        = d->garray;
-      }
-      /* Determine upper bound on non-zeros needed in new filtered matrix */
-      for (PetscInt row = 0; row < nloc; row++) {
-        PetscCall(MatGetRow(a, row, &ncols, NULL, NULL));
-        d_nnz[row] = ncols;
-        if (ncols > maxcols) maxcols = ncols;
-        PetscCall(MatRestoreRow(a, row, &ncols, NULL, NULL));
-      }
-      if (b) {
+      if (pc_gamg_agg->crs->threads && isaij) PetscCall(PCGAMGFilterGraph_Threads(Gmat, vfilter, &nnz0, &nnz1, &maxcols, &tGmat));
+      else {
+        PetscCall(MatGetType(Gmat, &jtype));
+        PetscCall(MatCreate(comm, &tGmat));
+        PetscCall(MatSetType(tGmat, jtype));
+        PetscCall(PetscMalloc2(nloc, &d_nnz, nloc, &o_nnz));
+        if (isseqaij) {
+          a = Gmat;
+          b = NULL;
+        } else {
+          Mat_MPIAIJ *d = (Mat_MPIAIJ *)Gmat->data;
+          a             = d->A;
+          b             = d->B;
+          garray        = d->garray;
+        }
+        /* Determine upper bound on non-zeros needed in new filtered matrix */
         for (PetscInt row = 0; row < nloc; row++) {
-          PetscCall(MatGetRow(b, row, &ncols, NULL, NULL));
-          o_nnz[row] = ncols;
+          PetscCall(MatGetRow(a, row, &ncols, NULL, NULL));
+          d_nnz[row] = ncols;
           if (ncols > maxcols) maxcols = ncols;
-          PetscCall(MatRestoreRow(b, row, &ncols, NULL, NULL));
+          PetscCall(MatRestoreRow(a, row, &ncols, NULL, NULL));
         }
-      }
-      PetscCall(MatSetSizes(tGmat, nloc, nloc, MM, MM));
-      PetscCall(MatSetBlockSizes(tGmat, 1, 1));
-      PetscCall(MatSeqAIJSetPreallocation(tGmat, 0, d_nnz));
-      PetscCall(MatMPIAIJSetPreallocation(tGmat, 0, d_nnz, 0, o_nnz));
-      PetscCall(MatSetOption(tGmat, MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE));
-      PetscCall(PetscFree2(d_nnz, o_nnz));
-      PetscCall(PetscMalloc2(maxcols, &AA, maxcols, &AJ));
-      nnz0 = nnz1 = 0;
-      for (c = a, kk = 0; c && kk < 2; c = b, kk++) {
-        for (PetscInt row = 0, grow = Istart, ncol_row, jj; row < nloc; row++, grow++) {
-          PetscCall(MatGetRow(c, row, &ncols, &idx, &vals));
-          for (ncol_row = jj = 0; jj < ncols; jj++, nnz0++) {
-            PetscScalar sv = PetscAbs(PetscRealPart(vals[jj]));
-            if (PetscRealPart(sv) > vfilter) {
-              PetscInt cid = idx[jj] + Istart; //diag
-              nnz1++;
-              if (c != a) cid = garray[idx[jj]];
-              AA[ncol_row] = vals[jj];
-              AJ[ncol_row] = cid;
-              ncol_row++;
+        if (b) {
+          for (PetscInt row = 0; row < nloc; row++) {
+            PetscCall(MatGetRow(b, row, &ncols, NULL, NULL));
+            o_nnz[row] = ncols;
+            if (ncols > maxcols) maxcols = ncols;
+            PetscCall(MatRestoreRow(b, row, &ncols, NULL, NULL));
+          }
+        }
+        PetscCall(MatSetSizes(tGmat, nloc, nloc, MM, MM));
+        PetscCall(MatSetBlockSizes(tGmat, 1, 1));
+        PetscCall(MatSeqAIJSetPreallocation(tGmat, 0, d_nnz));
+        PetscCall(MatMPIAIJSetPreallocation(tGmat, 0, d_nnz, 0, o_nnz));
+        PetscCall(MatSetOption(tGmat, MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE));
+        PetscCall(PetscFree2(d_nnz, o_nnz));
+        PetscCall(PetscMalloc2(maxcols, &AA, maxcols, &AJ));
+        for (c = a, kk = 0; c && kk < 2; c = b, kk++) {
+          for (PetscInt row = 0, grow = Istart, ncol_row, jj; row < nloc; row++, grow++) {
+            PetscCall(MatGetRow(c, row, &ncols, &idx, &vals));
+            for (ncol_row = jj = 0; jj < ncols; jj++, nnz0++) {
+              PetscScalar sv = PetscAbs(PetscRealPart(vals[jj]));
+              if (PetscRealPart(sv) > vfilter) {
+                PetscInt cid = idx[jj] + Istart; //diag
+                nnz1++;
+                if (c != a) cid = garray[idx[jj]];
+                AA[ncol_row] = vals[jj];
+                AJ[ncol_row] = cid;
+                ncol_row++;
+              }
             }
+            PetscCall(MatRestoreRow(c, row, &ncols, &idx, &vals));
+            PetscCall(MatSetValues(tGmat, 1, &grow, ncol_row, AJ, AA, INSERT_VALUES));
           }
-          PetscCall(MatRestoreRow(c, row, &ncols, &idx, &vals));
-          PetscCall(MatSetValues(tGmat, 1, &grow, ncol_row, AJ, AA, INSERT_VALUES));
         }
+        PetscCall(PetscFree2(AA, AJ));
+        PetscCall(MatAssemblyBegin(tGmat, MAT_FINAL_ASSEMBLY));
+        PetscCall(MatAssemblyEnd(tGmat, MAT_FINAL_ASSEMBLY));
       }
-      PetscCall(PetscFree2(AA, AJ));
-      PetscCall(MatAssemblyBegin(tGmat, MAT_FINAL_ASSEMBLY));
-      PetscCall(MatAssemblyEnd(tGmat, MAT_FINAL_ASSEMBLY));
       PetscCall(MatPropagateSymmetryOptions(Gmat, tGmat)); /* Normal Mat options are not relevant ? */
       PetscCall(PetscInfo(pc, "\t %g%% nnz after filtering, with threshold %g, %g nnz ave. (N=%" PetscInt_FMT ", max row size %" PetscInt_FMT "\n", (!nnz0) ? 1. : 100. * (double)nnz1 / (double)nnz0, (double)vfilter, (!nloc) ? 1. : (double)nnz0 / (double)nloc, MM, maxcols));
       PetscCall(MatViewFromOptions(tGmat, NULL, "-mat_filter_graph_view"));
@@ -1292,6 +1379,84 @@ static PetscErrorCode PCGAMGProlongator_AGG(PC pc, Mat Amat, PetscCoarsenData *a
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGSmoothEigenvalues_AGG - estimate the extreme eigenvalues of D^{-1}A used to smooth the prolongator of the current level
+
+  Input Parameter:
+   . pc - this
+   . Amat - matrix on this fine level
+ Output Parameter:
+   . a_emax - maximum eigenvalue estimate
+*/
+static PetscErrorCode PCGAMGSmoothEigenvalues_AGG(PC pc, Mat Amat, PetscReal *a_emax)
+{
+  PC_MG    *mg      = (PC_MG *)pc->data;
+  PC_GAMG  *pc_gamg = (PC_GAMG *)mg->innerctx;
+  MPI_Comm  comm;
+  KSP       eksp;
+  Vec       bb, xx;
+  PC        epc;
+  PetscReal emax, emin;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)Amat, &comm));
+  /* get eigen estimates */
+  if (pc_gamg->emax > 0) {
+    emin = pc_gamg->emin;
+    emax = pc_gamg->emax;
+  } else {
+    const char *prefix;
+
+    PetscCall(MatCreateVecs(Amat, &bb, NULL));
+    PetscCall(MatCreateVecs(Amat, &xx, NULL));
+    PetscCall(KSPSetNoisy_Private(bb));
+
+    PetscCall(KSPCreate(comm, &eksp));
+    PetscCall(KSPSetNestLevel(eksp, pc->kspnestlevel));
+    PetscCall(PCGetOptionsPrefix(pc, &prefix));
+    PetscCall(KSPSetOptionsPrefix(eksp, prefix));
+    PetscCall(KSPAppendOptionsPrefix(eksp, "pc_gamg_esteig_"));
+    {
+      PetscBool isset, sflg;
+      PetscCall(MatIsSPDKnown(Amat, &isset, &sflg));
+      if (isset && sflg) PetscCall(KSPSetType(eksp, KSPCG));
+    }
+    PetscCall(KSPSetErrorIfNotConverged(eksp, pc->erroriffailure));
+    PetscCall(KSPSetNormType(eksp, KSP_NORM_NONE));
+
+    PetscCall(KSPSetInitialGuessNonzero(eksp, PETSC_FALSE));
+    PetscCall(KSPSetOperators(eksp, Amat, Amat));
+
+    PetscCall(KSPGetPC(eksp, &epc));
+    PetscCall(PCSetType(epc, PCJACOBI)); /* smoother in smoothed agg. */
+
+    PetscCall(KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10)); // 10 is safer, but 5 is often fine, can override with -pc_gamg_esteig_ksp_max_it -mg_levels_ksp_chebyshev_esteig 0,0.25,0,1.2
+
+    PetscCall(KSPSetFromOptions(eksp));
+    PetscCall(KSPSetComputeSingularValues(eksp, PETSC_TRUE));
+    PetscCall(KSPSolve(eksp, bb, xx));
+    PetscCall(KSPCheckSolve(eksp, pc, xx));
+
+    PetscCall(KSPComputeExtremeSingularValues(eksp, &emax, &emin));
+    PetscCall(PetscInfo(pc, "%s: Smooth P0: max eigen=%e min=%e PC=%s\n", ((PetscObject)pc)->prefix, (double)emax, (double)emin, PCJACOBI));
+    PetscCall(VecDestroy(&xx));
+    PetscCall(VecDestroy(&bb));
+    PetscCall(KSPDestroy(&eksp));
+  }
+  if (pc_gamg->use_sa_esteig) {
+    mg->min_eigen_DinvA[pc_gamg->current_level] = emin;
+    mg->max_eigen_DinvA[pc_gamg->current_level] = emax;
+    PetscCall(PetscInfo(pc, "%s: Smooth P0: level %" PetscInt_FMT ", cache spectra %g %g\n", ((PetscObject)pc)->prefix, pc_gamg->current_level, (double)emin, (double)emax));
+  } else {
+    mg->min_eigen_DinvA[pc_gamg->current_level] = 0;
+    mg->max_eigen_DinvA[pc_gamg->current_level] = 0;
+  }
+  /* TODO: Set a PCFailedReason and exit the building of the AMG preconditioner */
+  PetscCheck(emax != 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_PLIB, "Computed maximum singular value as zero");
+  *a_emax = emax;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    PCGAMGOptProlongator_AGG
 
@@ -1307,75 +1472,29 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
   PC_GAMG     *pc_gamg     = (PC_GAMG *)mg->innerctx;
   PC_GAMG_AGG *pc_gamg_agg = (PC_GAMG_AGG *)pc_gamg->subctx;
   PetscInt     jj;
-  Mat          Prol = *a_P;
-  MPI_Comm     comm;
-  KSP          eksp;
-  Vec          bb, xx;
-  PC           epc;
-  PetscReal    alpha, emax, emin;
+  Mat          Prol = *a_P, *kept = NULL;
+  PetscReal    alpha, emax = 0;
 
   PetscFunctionBegin;
-  PetscCall(PetscObjectGetComm((PetscObject)Amat, &comm));
   PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
 
   /* compute maximum singular value of operator to be used in smoother */
   if (0 < pc_gamg_agg->nsmooths) {
-    /* get eigen estimates */
-    if (pc_gamg->emax > 0) {
-      emin = pc_gamg->emin;
-      emax = pc_gamg->emax;
-    } else {
-      const char *prefix;
-
-      PetscCall(MatCreateVecs(Amat, &bb, NULL));
-      PetscCall(MatCreateVecs(Amat, &xx, NULL));
-      PetscCall(KSPSetNoisy_Private(bb));
-
-      PetscCall(KSPCreate(comm, &eksp));
-      PetscCall(KSPSetNestLevel(eksp, pc->kspnestlevel));
-      PetscCall(PCGetOptionsPrefix(pc, &prefix));
-      PetscCall(KSPSetOptionsPrefix(eksp, prefix));
-      PetscCall(KSPAppendOptionsPrefix(eksp, "pc_gamg_esteig_"));
-      {
-        PetscBool isset, sflg;
-        PetscCall(MatIsSPDKnown(Amat, &isset, &sflg));
-        if (isset && sflg) PetscCall(KSPSetType(eksp, KSPCG));
-      }
-      PetscCall(KSPSetErrorIfNotConverged(eksp, pc->erroriffailure));
-      PetscCall(KSPSetNormType(eksp, KSP_NORM_NONE));
-
-      PetscCall(KSPSetInitialGuessNonzero(eksp, PETSC_FALSE));
-      PetscCall(KSPSetOperators(eksp, Amat, Amat));
-
-      PetscCall(KSPGetPC(eksp, &epc));
-      PetscCall(PCSetType(epc, PCJACOBI)); /* smoother in smoothed agg. */
-
-      PetscCall(KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10)); // 10 is safer, but 5 is often fine, can override with -pc_gamg_esteig_ksp_max_it -mg_levels_ksp_chebyshev_esteig 0,0.25,0,1.2
-
-      PetscCall(KSPSetFromOptions(eksp));
-      PetscCall(KSPSetComputeSingularValues(eksp, PETSC_TRUE));
-      PetscCall(KSPSolve(eksp, bb, xx));
-      PetscCall(KSPCheckSolve(eksp, pc, xx));
-
-      PetscCall(KSPComputeExtremeSingularValues(eksp, &emax, &emin));
-      PetscCall(PetscInfo(pc, "%s: Smooth P0: max eigen=%e min=%e PC=%s\n", ((PetscObject)pc)->prefix, (double)emax, (double)emin, PCJACOBI));
-      PetscCall(VecDestroy(&xx));
-      PetscCall(VecDestroy(&bb));
-      PetscCall(KSPDestroy(&eksp));
-    }
-    if (pc_gamg->use_sa_esteig) {
-      mg->min_eigen_DinvA[pc_gamg->current_level] = emin;
-      mg->max_eigen_DinvA[pc_gamg->current_level] = emax;
-      PetscCall(PetscInfo(pc, "%s: Smooth P0: level %" PetscInt_FMT ", cache spectra %g %g\n", ((PetscObject)pc)->prefix, pc_gamg->current_level, (double)emin, (double)emax));
-    } else {
-      mg->min_eigen_DinvA[pc_gamg->current_level] = 0;
-      mg->max_eigen_DinvA[pc_gamg->current_level] = 0;
-    }
+    PetscCall(PCGAMGSmoothEigenvalues_AGG(pc, Amat, &emax));
   } else {
     mg->min_eigen_DinvA[pc_gamg->current_level] = 0;
     mg->max_eigen_DinvA[pc_gamg->current_level] = 0;
   }
 
+  /* keep P0 and the products A P_j so that the smoothing can be redone numerically on the same aggregates */
+  if (pc_gamg->reuse_aggs && 0 < pc_gamg_agg->nsmooths) {
+    PetscCall(PetscMalloc1(pc_gamg_agg->nsmooths + 1, &kept));
+    PetscCall(PetscObjectReference((PetscObject)Prol));
+    kept[0]                                     = Prol;
+    pc_gamg->prol_kept[pc_gamg->current_level]  = kept;
+    pc_gamg->nprol_kept[pc_gamg->current_level] = pc_gamg_agg->nsmooths + 1;
+  }
+
   /* smooth P0 */
   for (jj = 0; jj < pc_gamg_agg->nsmooths; jj++) {
     Mat tMat;
@@ -1387,15 +1506,16 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
     PetscCall(PetscLogEventBegin(petsc_gamg_setup_matmat_events[pc_gamg->current_level][2], 0, 0, 0, 0));
     PetscCall(MatMatMult(Amat, Prol, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &tMat));
     PetscCall(PetscLogEventEnd(petsc_gamg_setup_matmat_events[pc_gamg->current_level][2], 0, 0, 0, 0));
-    PetscCall(MatProductClear(tMat));
+    if (kept) {
+      PetscCall(PetscObjectReference((PetscObject)tMat));
+      kept[jj + 1] = tMat;
+    } else PetscCall(MatProductClear(tMat));
     PetscCall(MatCreateVecs(Amat, &diag, NULL));
     PetscCall(MatGetDiagonal(Amat, diag)); /* effectively PCJACOBI */
     PetscCall(VecReciprocal(diag));
     PetscCall(MatDiagonalScale(tMat, diag, NULL));
     PetscCall(VecDestroy(&diag));
 
-    /* TODO: Set a PCFailedReason and exit the building of the AMG preconditioner */
-    PetscCheck(emax != 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_PLIB, "Computed maximum singular value as zero");
     /* TODO: Document the 1.4 and don't hardwire it in this routine */
     alpha = -1.4 / emax;
 
@@ -1409,6 +1529,49 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGRefreshProlongator_AGG - redo the smoothing of the prolongator kept by PCGAMGOptProlongator_AGG() with new values of Amat.
+   The aggregates, P0 and the sparsity of the products are reused, only numeric products are computed.
+
+  Input Parameter:
+   . pc - this
+   . Amat - matrix on this fine level, with the nonzero pattern it had when the prolongator was built
+*/
+static PetscErrorCode PCGAMGRefreshProlongator_AGG(PC pc, Mat Amat)
+{
+  PC_MG    *mg      = (PC_MG *)pc->data;
+  PC_GAMG  *pc_gamg = (PC_GAMG *)mg->innerctx;
+  PetscInt  jj, level = pc_gamg->current_level, nkept = pc_gamg->nprol_kept[level];
+  Mat      *kept = pc_gamg->prol_kept[level];
+  Vec       diag;
+  PetscReal alpha, emax;
+
+  PetscFunctionBegin;
+  if (nkept < 2) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!kept[1]->product || kept[1]->product->A != Amat) {
+    PetscCall(PetscInfo(pc, "%s: level %" PetscInt_FMT " operator is not the one used to build the prolongator, keep the prolongator\n", ((PetscObject)pc)->prefix, level));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
+  PetscCall(PCGAMGSmoothEigenvalues_AGG(pc, Amat, &emax));
+  PetscCall(MatCreateVecs(Amat, &diag, NULL));
+  PetscCall(MatGetDiagonal(Amat, diag)); /* effectively PCJACOBI */
+  PetscCall(VecReciprocal(diag));
+  alpha = -1.4 / emax;
+  for (jj = 1; jj < nkept; jj++) {
+    PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPTSM], 0, 0, 0, 0));
+    PetscCall(PetscLogEventBegin(petsc_gamg_setup_matmat_events[level][2], 0, 0, 0, 0));
+    PetscCall(MatProductNumeric(kept[jj]));
+    PetscCall(PetscLogEventEnd(petsc_gamg_setup_matmat_events[level][2], 0, 0, 0, 0));
+    PetscCall(MatDiagonalScale(kept[jj], diag, NULL));
+    PetscCall(MatAYPX(kept[jj], alpha, kept[jj - 1], SUBSET_NONZERO_PATTERN));
+    PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_OPTSM], 0, 0, 0, 0));
+  }
+  PetscCall(VecDestroy(&diag));
+  PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    PCCreateGAMG_AGG
 
@@ -1431,12 +1594,13 @@ PetscErrorCode PCCreateGAMG_AGG(PC pc)
   /* reset does not do anything; setup not virtual */
 
   /* set internal function pointers */
-  pc_gamg->ops->creategraph       = PCGAMGCreateGraph_AGG;
-  pc_gamg->ops->coarsen           = PCGAMGCoarsen_AGG;
-  pc_gamg->ops->prolongator       = PCGAMGProlongator_AGG;
-  pc_gamg->ops->optprolongator    = PCGAMGOptProlongator_AGG;
-  pc_gamg->ops->createdefaultdata = PCSetData_AGG;
-  pc_gamg->ops->view              = PCView_GAMG_AGG;
+  pc_gamg->ops->creategraph        = PCGAMGCreateGraph_AGG;
+  pc_gamg->ops->coarsen            = PCGAMGCoarsen_AGG;
+  pc_gamg->ops->prolongator        = PCGAMGProlongator_AGG;
+  pc_gamg->ops->optprolongator     = PCGAMGOptProlongator_AGG;
+  pc_gamg->ops->refreshprolongator = PCGAMGRefreshProlongator_AGG;
+  pc_gamg->ops->createdefaultdata  = PCSetData_AGG;
+  pc_gamg->ops->view               = PCView_GAMG_AGG;
 
   pc_gamg_agg->nsmooths                     = 1;
   pc_gamg_agg->aggressive_coarsening_levels = 1;
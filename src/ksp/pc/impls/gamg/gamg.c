@@ -23,12 +23,65 @@ static PetscLogStage gamg_stages[PETSC_MG_MAXLEVELS];
 static PetscFunctionList GAMGList = NULL;
 static PetscBool         PCGAMGPackageInitialized;
 
+/* free the prolongators and permutations kept to reuse the aggregates */
+static PetscErrorCode PCGAMGResetAggregates_GAMG(PC pc)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  for (PetscInt level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+    for (PetscInt jj = 0; jj < pc_gamg->nprol_kept[level]; jj++) PetscCall(MatDestroy(&pc_gamg->prol_kept[level][jj]));
+    PetscCall(PetscFree(pc_gamg->prol_kept[level]));
+    pc_gamg->nprol_kept[level] = 0;
+    PetscCall(ISDestroy(&pc_gamg->prol_colperm[level]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   PCGAMGRefreshProlongator_GAMG - recompute the values of the prolongator of a level whose aggregates are reused
+
+   Input Parameter:
+   . pc - the preconditioner context
+   . level - the (fine) level of the prolongator, 0 being the finest grid
+   . Amat - the new matrix on this level
+   . P - the prolongator used by PCMG, updated in place
+*/
+static PetscErrorCode PCGAMGRefreshProlongator_GAMG(PC pc, PetscInt level, Mat Amat, Mat P)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  if (!pc_gamg->ops->refreshprolongator) {
+    PetscCall(PetscInfo(pc, "%s: GAMG type %s cannot refresh prolongators, reuse the prolongator of level %" PetscInt_FMT "\n", ((PetscObject)pc)->prefix, pc_gamg->gamg_type_name, level));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  pc_gamg->current_level = level;
+  PetscCall(pc_gamg->ops->refreshprolongator(pc, Amat));
+  if (pc_gamg->prol_colperm[level]) { /* extract the columns of the reduced coarse grid, as PCGAMGCreateLevel_GAMG() does */
+    Mat      Psm = pc_gamg->prol_kept[level][pc_gamg->nprol_kept[level] - 1];
+    IS       findices;
+    PetscInt Istart, Iend, f_bs;
+
+    PetscCall(MatGetBlockSize(Amat, &f_bs));
+    PetscCall(MatGetOwnershipRange(Psm, &Istart, &Iend));
+    PetscCall(ISCreateStride(PetscObjectComm((PetscObject)Psm), Iend - Istart, Istart, 1, &findices));
+    PetscCall(ISSetBlockSize(findices, f_bs));
+    PetscCall(MatCreateSubMatrix(Psm, findices, pc_gamg->prol_colperm[level], MAT_REUSE_MATRIX, &P));
+    PetscCall(ISDestroy(&findices));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCReset_GAMG(PC pc)
 {
   PC_MG   *mg      = (PC_MG *)pc->data;
   PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
 
   PetscFunctionBegin;
+  PetscCall(PCGAMGResetAggregates_GAMG(pc));
   PetscCall(PetscFree(pc_gamg->data));
   pc_gamg->data_sz = 0;
   PetscCall(PetscFree(pc_gamg->orig_data));
@@ -56,6 +109,8 @@ static PetscErrorCode PCReset_GAMG(PC pc)
    . a_nactive_proc - number of active procs
    Output Parameter:
    . a_Amat_crs - coarse matrix that is created (k-1)
+   . Pcolumnperm - (optional) columns of the input prolongator kept by the reduced prolongator, NULL when there is no reduction.
+                   When requested, a_Amat_crs is computed as a product of the reduced prolongator so MatPtAP() can reuse it.
 */
 static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc, Mat Amat_fine, PetscInt cr_bs, Mat *a_P_inout, Mat *a_Amat_crs, PetscMPIInt *a_nactive_proc, IS *Pcolumnperm, PetscBool is_last)
 {
@@ -429,6 +484,16 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc, Mat Amat_fine, PetscInt cr_b
       PetscCall(MatSetOption(Pnew, MAT_FORM_EXPLICIT_TRANSPOSE, PETSC_TRUE));
 
       PetscCall(MatDestroy(a_P_inout));
+      if (Pcolumnperm) {
+        Mat mat;
+
+        PetscCall(PetscLogEventBegin(petsc_gamg_setup_matmat_events[pc_gamg->current_level][1], 0, 0, 0, 0));
+        PetscCall(MatPtAP(Amat_fine, Pnew, MAT_INITIAL_MATRIX, 2.0, &mat));
+        PetscCall(PetscLogEventEnd(petsc_gamg_setup_matmat_events[pc_gamg->current_level][1], 0, 0, 0, 0));
+        PetscCall(MatPropagateSymmetryOptions(*a_Amat_crs, mat));
+        PetscCall(MatDestroy(a_Amat_crs));
+        *a_Amat_crs = mat;
+      }
 
       /* output - repartitioned */
       *a_P_inout = Pnew;
@@ -489,6 +554,8 @@ PetscErrorCode PCGAMGSquareGraph_GAMG(PC a_pc, Mat Gmat1, Mat *Gmat2)
   PetscCall(MatProductClear(*Gmat2));
   /* we only need the sparsity, cheat and tell PETSc the matrix has been assembled */
   (*Gmat2)->assembled = PETSC_TRUE;
+  /* the sparsity of A^T A, or of A A with A structurally symmetric, is symmetric; the threaded MIS uses this */
+  (*Gmat2)->structurally_symmetric = PETSC_BOOL3_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -522,7 +589,7 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
   PetscCallMPI(MPI_Comm_size(comm, &size));
   PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_SETUP], 0, 0, 0, 0));
   if (pc->setupcalled) {
-    if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN) {
+    if ((!pc_gamg->reuse_prol && !pc_gamg->reuse_aggs) || pc->flag == DIFFERENT_NONZERO_PATTERN) {
       /* reset everything */
       PetscCall(PCReset_MG(pc));
       pc->setupcalled = 0;
@@ -538,10 +605,13 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
         PetscCall(KSPSetOperators(mglevels[pc_gamg->Nlevels - 1]->smoothd, dA, dB));
 
         for (level = pc_gamg->Nlevels - 2, gl = 0; level >= 0; level--, gl++) {
-          MatReuse reuse = MAT_INITIAL_MATRIX;
+          MatReuse  reuse     = MAT_INITIAL_MATRIX;
+          PetscBool refreshed = (PetscBool)(pc_gamg->reuse_aggs && pc_gamg->nprol_kept[gl] > 0);
 #if defined(GAMG_STAGES)
           PetscCall(PetscLogStagePush(gamg_stages[gl]));
 #endif
+          /* new prolongator values on the same aggregates */
+          if (refreshed) PetscCall(PCGAMGRefreshProlongator_GAMG(pc, gl, dB, mglevels[level + 1]->interpolate));
           /* matrix structure can change from repartitioning or process reduction but don't know if we have process reduction here. Should fix */
           PetscCall(KSPGetOperators(mglevels[level]->smoothd, NULL, &B));
           if (B->product) {
@@ -559,15 +629,20 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
           if (reuse == MAT_INITIAL_MATRIX) mglevels[level]->A = B;
           PetscCall(KSPSetOperators(mglevels[level]->smoothd, B, B));
           // check for redoing eigen estimates
-          if (pc_gamg->recompute_esteig) {
+          if (pc_gamg->recompute_esteig || refreshed) {
             PetscBool ischeb;
             KSP       smoother;
             PetscCall(PCMGGetSmoother(pc, level + 1, &smoother));
             PetscCall(PetscObjectTypeCompare((PetscObject)smoother, KSPCHEBYSHEV, &ischeb));
             if (ischeb) {
               KSP_Chebyshev *cheb = (KSP_Chebyshev *)smoother->data;
-              cheb->emin_provided = 0;
-              cheb->emax_provided = 0;
+              if (refreshed && mg->max_eigen_DinvA[gl] > 0) { /* estimates made while refreshing the prolongator */
+                cheb->emin_provided = mg->min_eigen_DinvA[gl];
+                cheb->emax_provided = mg->max_eigen_DinvA[gl];
+              } else {
+                cheb->emin_provided = 0;
+                cheb->emax_provided = 0;
+              }
             }
             /* we could call PetscCall(KSPChebyshevSetEigenvalues(smoother, 0, 0)); but the logic does not work properly */
           }
@@ -585,6 +660,7 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     }
   }
 
+  PetscCall(PCGAMGResetAggregates_GAMG(pc));
   if (!pc_gamg->data) {
     if (pc_gamg->orig_data) {
       PetscCall(MatGetBlockSize(Pmat, &bs));
@@ -767,7 +843,7 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels - 1) is_last = PETSC_TRUE;
     PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
-    PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], cr_bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last));
+    PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], cr_bs, &Parr[level1], &Aarr[level1], &nactivepe, pc_gamg->reuse_aggs ? &pc_gamg->prol_colperm[level] : NULL, is_last));
     PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
 
     PetscCall(MatGetSize(Aarr[level1], &M, &N)); /* M is loop test variables */
@@ -944,6 +1020,7 @@ PetscErrorCode PCDestroy_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregates_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", NULL));
@@ -1225,6 +1302,50 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PCGAMGSetReuseAggregates - Reuse the aggregates and the sparsity of the prolongation when rebuilding a `PCGAMG` algebraic multigrid preconditioner,
+  recomputing only the values of the smoothed prolongation and the coarse grid operators
+
+  Collective
+
+  Input Parameters:
++ pc - the preconditioner context
+- n  - `PETSC_TRUE` or `PETSC_FALSE`
+
+  Options Database Key:
+. -pc_gamg_reuse_aggregates <true,false> - reuse the previous aggregates
+
+  Level: intermediate
+
+  Notes:
+  Only used when the matrix keeps its nonzero pattern, a `DIFFERENT_NONZERO_PATTERN` rebuilds the preconditioner from scratch.
+
+  Unlike `PCGAMGSetReuseInterpolation()`, the prolongation follows the new matrix entries: the tentative prolongator is kept and
+  its smoothing, the eigenvalue estimate of the smoother and the Galerkin products are redone with numeric-only matrix products.
+  The products are kept between setups, which increases the memory used by the preconditioner.
+
+  Only `PCGAMGAGG` supports refreshing the prolongation, other types reuse it unchanged.
+
+.seealso: [](ch_ksp), `PCGAMG`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetNSmooths()`
+@*/
+PetscErrorCode PCGAMGSetReuseAggregates(PC pc, PetscBool n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscTryMethod(pc, "PCGAMGSetReuseAggregates_C", (PC, PetscBool), (pc, n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetReuseAggregates_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->reuse_aggs = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCGAMGASMSetUseAggs - Have the `PCGAMG` smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner
   used as the smoother
@@ -1658,6 +1779,7 @@ static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
   if (pc_gamg->use_aggs_in_asm) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using aggregates from coarsening process to define subdomains for PCASM\n")); // this take presedence
   else if (pc_gamg->asm_hem_aggs) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using aggregates made with %d applications of heavy edge matching (HEM) to define subdomains for PCASM\n", (int)pc_gamg->asm_hem_aggs));
   if (pc_gamg->use_parallel_coarse_grid_solver) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n"));
+  if (pc_gamg->reuse_aggs) PetscCall(PetscViewerASCIIPrintf(viewer, "      Reusing aggregates, prolongation values recomputed on each setup\n"));
   if (pc_gamg->injection_index_size) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "      Using injection restriction/prolongation on first level, dofs:"));
     for (int i = 0; i < pc_gamg->injection_index_size; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %d", (int)pc_gamg->injection_index[i]));
@@ -1727,6 +1849,7 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
   PetscCall(PetscOptionsBool("-pc_gamg_use_sa_esteig", "Use eigen estimate from smoothed aggregation for smoother", "PCGAMGSetUseSAEstEig", pc_gamg->use_sa_esteig, &pc_gamg->use_sa_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_recompute_esteig", "Set flag to recompute eigen estimates for Chebyshev when matrix changes", "PCGAMGSetRecomputeEstEig", pc_gamg->recompute_esteig, &pc_gamg->recompute_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_reuse_interpolation", "Reuse prolongation operator", "PCGAMGReuseInterpolation", pc_gamg->reuse_prol, &pc_gamg->reuse_prol, NULL));
+  PetscCall(PetscOptionsBool("-pc_gamg_reuse_aggregates", "Reuse aggregates and recompute the prolongation values", "PCGAMGSetReuseAggregates", pc_gamg->reuse_aggs, &pc_gamg->reuse_aggs, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_asm_use_agg", "Use aggregation aggregates for ASM smoother", "PCGAMGASMSetUseAggs", pc_gamg->use_aggs_in_asm, &pc_gamg->use_aggs_in_asm, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_parallel_coarse_grid_solver", "Use parallel coarse grid solver (otherwise put last grid on one process)", "PCGAMGSetParallelCoarseGridSolve", pc_gamg->use_parallel_coarse_grid_solver, &pc_gamg->use_parallel_coarse_grid_solver, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids", "Pin coarse grids to the CPU", "PCGAMGSetCpuPinCoarseGrids", pc_gamg->cpu_pin_coarse_grids, &pc_gamg->cpu_pin_coarse_grids, NULL));
@@ -1785,6 +1908,7 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
                                         equations on each process that has degrees of freedom
 . -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 . -pc_gamg_reuse_interpolation <bool,default=true> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations (should always be true)
+. -pc_gamg_reuse_aggregates <bool,default=false> - when rebuilding the algebraic multigrid preconditioner reuse the aggregates and recompute only the values of the interpolations
 . -pc_gamg_threshold[] <thresh,default=[-1,...]> - Before aggregating the graph `PCGAMG` will remove small values from the graph on each level (< 0 does no filtering)
 - -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
 
@@ -1814,7 +1938,7 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
   See [the Users Manual section on PCGAMG](sec_amg) and [the Users Manual section on PCMG](sec_mg)for more details.
 
 .seealso: [](ch_ksp), `PCCreate()`, `PCSetType()`, `MatSetBlockSize()`, `PCMGType`, `PCSetCoordinates()`, `MatSetNearNullSpace()`, `PCGAMGSetType()`, `PCGAMGAGG`, `PCGAMGGEO`, `PCGAMGCLASSICAL`, `PCGAMGSetProcEqLim()`,
-          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
+          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetReuseAggregates()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
 M*/
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
 {
@@ -1855,6 +1979,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", PCGAMGSetUseSAEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", PCGAMGSetRecomputeEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", PCGAMGSetReuseInterpolation_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregates_C", PCGAMGSetReuseAggregates_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", PCGAMGASMSetUseAggs_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", PCGAMGSetParallelCoarseGridSolve_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", PCGAMGSetCpuPinCoarseGrids_GAMG));
@@ -1869,6 +1994,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetInjectionIndex_C", PCGAMGSetInjectionIndex_GAMG));
   pc_gamg->repart                          = PETSC_FALSE;
   pc_gamg->reuse_prol                      = PETSC_TRUE;
+  pc_gamg->reuse_aggs                      = PETSC_FALSE;
   pc_gamg->use_aggs_in_asm                 = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids            = PETSC_FALSE;
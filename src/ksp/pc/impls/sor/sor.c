@@ -37,13 +37,14 @@ static PetscErrorCode PCApply_SOR(PC pc, Vec x, Vec y)
 
 static PetscErrorCode PCApplyTranspose_SOR(PC pc, Vec x, Vec y)
 {
-  PC_SOR   *jac  = (PC_SOR *)pc->data;
-  PetscInt  flag = jac->sym | SOR_ZERO_INITIAL_GUESS;
-  PetscBool set, sym;
+  PC_SOR    *jac   = (PC_SOR *)pc->data;
+  PetscInt   flag  = jac->sym | SOR_ZERO_INITIAL_GUESS;
+  MatSORType sweep = (MatSORType)(jac->sym & ~SOR_MULTICOLOR);
+  PetscBool  set, sym;
 
   PetscFunctionBegin;
   PetscCall(MatIsSymmetricKnown(pc->pmat, &set, &sym));
-  PetscCheck(set && sym && (jac->sym == SOR_SYMMETRIC_SWEEP || jac->sym == SOR_LOCAL_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
+  PetscCheck(set && sym && (sweep == SOR_SYMMETRIC_SWEEP || sweep == SOR_LOCAL_SYMMETRIC_SWEEP), PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Can only apply transpose of SOR if matrix is symmetric and sweep is symmetric");
   PetscCall(MatSOR(pc->pmat, x, jac->omega, (MatSORType)flag, jac->fshift, jac->its, jac->lits, y));
   PetscCall(MatFactorGetError(pc->pmat, (MatFactorError *)&pc->failedreason));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -67,7 +68,7 @@ static PetscErrorCode PCApplyRichardson_SOR(PC pc, Vec b, Vec y, Vec w, PetscRea
 static PetscErrorCode PCSetFromOptions_SOR(PC pc, PetscOptionItems *PetscOptionsObject)
 {
   PC_SOR   *jac = (PC_SOR *)pc->data;
-  PetscBool flg;
+  PetscBool flg, set;
   PetscReal omega;
 
   PetscFunctionBegin;
@@ -89,6 +90,8 @@ static PetscErrorCode PCSetFromOptions_SOR(PC pc, PetscOptionItems *PetscOptions
   if (flg) PetscCall(PCSORSetSymmetric(pc, SOR_LOCAL_BACKWARD_SWEEP));
   PetscCall(PetscOptionsBoolGroupEnd("-pc_sor_local_forward", "use forward sweep locally", "PCSORSetSymmetric", &flg));
   if (flg) PetscCall(PCSORSetSymmetric(pc, SOR_LOCAL_FORWARD_SWEEP));
+  PetscCall(PetscOptionsBool("-pc_sor_multicolor", "sweep in a multicolor ordering, threaded with OpenMP", "PCSORSetSymmetric", (jac->sym & SOR_MULTICOLOR) ? PETSC_TRUE : PETSC_FALSE, &flg, &set));
+  if (set) PetscCall(PCSORSetSymmetric(pc, (MatSORType)(flg ? (jac->sym | SOR_MULTICOLOR) : (jac->sym & ~SOR_MULTICOLOR))));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -115,6 +118,7 @@ static PetscErrorCode PCView_SOR(PC pc, PetscViewer viewer)
     else if (sym & SOR_LOCAL_BACKWARD_SWEEP) sortype = "local_backward";
     else sortype = "unknown";
     PetscCall(PetscViewerASCIIPrintf(viewer, "  type = %s, iterations = %" PetscInt_FMT ", local iterations = %" PetscInt_FMT ", omega = %g\n", sortype, jac->its, jac->lits, (double)jac->omega));
+    if (sym & SOR_MULTICOLOR) PetscCall(PetscViewerASCIIPrintf(viewer, "  using multicolor ordering\n"));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -297,19 +301,25 @@ PetscErrorCode PCSORGetIterations(PC pc, PetscInt *its, PetscInt *lits)
     SOR_LOCAL_BACKWARD_SWEEP
     SOR_LOCAL_SYMMETRIC_SWEEP
 .ve
+  possibly bitwise ORd with `SOR_MULTICOLOR`
 
   Options Database Keys:
 + -pc_sor_symmetric       - Activates symmetric version
 . -pc_sor_backward        - Activates backward version
 . -pc_sor_local_forward   - Activates local forward version
 . -pc_sor_local_symmetric - Activates local symmetric version
-- -pc_sor_local_backward  - Activates local backward version
+. -pc_sor_local_backward  - Activates local backward version
+- -pc_sor_multicolor      - Sweeps in a multicolor ordering of the rows
 
-  Note:
+  Notes:
   To use the Eisenstat trick with SSOR, employ the PCEISENSTAT preconditioner,
   which can be chosen with the option
 .  -pc_type eisenstat - Activates Eisenstat trick
 
+  With `SOR_MULTICOLOR` the rows of the local matrix are colored so that rows of the same color are not coupled, and each
+  sweep relaxes the colors one after the other; with OpenMP the rows of one color are relaxed concurrently. The ordering
+  differs from the natural one so the convergence differs as well. Only supported for `MATSEQAIJ` and `MATMPIAIJ`
+
   Level: intermediate
 
 .seealso: [](ch_ksp), `PCSOR`, `PCEisenstatSetOmega()`, `PCSORSetIterations()`, `PCSORSetOmega()`
@@ -396,7 +406,8 @@ PetscErrorCode PCSORSetIterations(PC pc, PetscInt its, PetscInt lits)
 .  -pc_sor_omega <omega> - Sets omega
 .  -pc_sor_diagonal_shift <shift> - shift the diagonal entries; useful if the matrix has zeros on the diagonal
 .  -pc_sor_its <its> - Sets number of iterations   (default 1)
--  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+.  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+-  -pc_sor_multicolor - Sweeps in a multicolor ordering so that the sweeps can run with OpenMP threads (`MATAIJ` only)
 
    Level: beginner
 
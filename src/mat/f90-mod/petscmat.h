@@ -71,7 +71,8 @@
       PetscEnum, parameter :: MAT_FORM_EXPLICIT_TRANSPOSE = 24
       PetscEnum, parameter :: MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25
       PetscEnum, parameter :: MAT_SPD_ETERNAL = 26
-      PetscEnum, parameter :: MAT_OPTION_MAX = 27
+      PetscEnum, parameter :: MAT_FROZEN_OFF_PROC_ENTRIES = 27
+      PetscEnum, parameter :: MAT_OPTION_MAX = 28
 !
 !  MatFactorShiftType
 !
@@ -146,6 +147,8 @@
       PetscEnum, parameter :: MAT_FACTORINFO_ZERO_PIVOT = 9
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_TYPE = 10
       PetscEnum, parameter :: MAT_FACTORINFO_SHIFT_AMOUNT = 11
+      PetscEnum, parameter :: MAT_FACTORINFO_FACTOR_SWEEPS = 12
+      PetscEnum, parameter :: MAT_FACTORINFO_SOLVE_SWEEPS = 13
 !
 !  Options for SOR and SSOR
 !  MatSorType may be bitwise ORd together, so do not change the numbers
@@ -160,6 +163,7 @@
       PetscEnum, parameter :: SOR_EISENSTAT=32
       PetscEnum, parameter :: SOR_APPLY_UPPER=64
       PetscEnum, parameter :: SOR_APPLY_LOWER=128
+      PetscEnum, parameter :: SOR_MULTICOLOR=256
 !
 !  MatOperation
 !
@@ -427,6 +431,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_NEW_NONZERO_LOCATIONS
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_NEW_NONZERO_ALLOCATION_ERR
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBSET_OFF_PROC_ENTRIES
+!DEC$ ATTRIBUTES DLLEXPORT::MAT_FROZEN_OFF_PROC_ENTRIES
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_SUBMAT_SINGLEIS
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_STRUCTURE_ONLY
 !DEC$ ATTRIBUTES DLLEXPORT::MAT_OPTION_MAX
@@ -485,6 +490,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_EISENSTAT
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_UPPER
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_LOWER
+!DEC$ ATTRIBUTES DLLEXPORT::SOR_MULTICOLOR
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_SET_VALUES
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_GET_ROWMATOP_RESTORE_ROW
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT
@@ -5,4 +5,4 @@
 ! in a separate include
 !
 
-      PetscEnum, parameter :: MAT_FACTORINFO_SIZE = 11
+      PetscEnum, parameter :: MAT_FACTORINFO_SIZE = 13
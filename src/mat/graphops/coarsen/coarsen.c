@@ -141,6 +141,46 @@ PetscErrorCode MatCoarsenSetStrictAggs(MatCoarsen agg, PetscBool str)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  MatCoarsenSetThreads - Set whether to use OpenMP threads in the local sweeps of the `MATCOARSENMIS` and `MATCOARSENMISK` coarseners
+
+  Logically Collective
+
+  Input Parameters:
++ agg - the coarsen context
+- flg - `PETSC_TRUE` to use threads
+
+  Options Database Key:
+. -mat_coarsen_threads <bool> - use OpenMP threads in the MIS sweeps
+
+  Level: advanced
+
+  Notes:
+  Each sweep selects the vertices of the rank in rounds in which every undecided vertex whose neighbors that come
+  earlier in the greedy ordering (see `MatCoarsenSetGreedyOrdering()`) are all decided is decided concurrently.
+  This selects the same independent set, and builds the same aggregates, as the sequential sweep. The exchange of the
+  states of the ghost vertices between the ranks is unchanged.
+
+  This requires the graph to be known to be (structurally) symmetric, see `MatSetOption()`, otherwise the sequential
+  sweep is used. It is ignored if PETSc was not configured with OpenMP; the number of threads is set with `-omp_num_threads`.
+
+  `PCGAMG` also uses threads to filter its graph when this is set.
+
+.seealso: `MatCoarsen`, `MatCoarsenCreate()`, `MatCoarsenSetFromOptions()`, `MatCoarsenSetGreedyOrdering()`
+@*/
+PetscErrorCode MatCoarsenSetThreads(MatCoarsen agg, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(agg, MAT_COARSEN_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(agg, flg, 2);
+  agg->threads = flg;
+#if !defined(PETSC_HAVE_OPENMP)
+  if (agg->threads) PetscCall(PetscInfo(agg, "Ignoring threads since PETSc was not configured with OpenMP\n"));
+  agg->threads = PETSC_FALSE;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   MatCoarsenDestroy - Destroys the coarsen context.
 
@@ -243,6 +283,7 @@ PetscErrorCode MatCoarsenView(MatCoarsen agg, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPopTab(viewer));
   }
   if (agg->strength_index_size > 0) PetscCall(PetscViewerASCIIPrintf(viewer, " Using scalar strength-of-connection index index[%d] = {%d, ..}\n", (int)agg->strength_index_size, (int)agg->strength_index[0]));
+  if (agg->threads) PetscCall(PetscViewerASCIIPrintf(viewer, " Using OpenMP threads in the MIS sweeps\n"));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -345,7 +386,8 @@ PetscErrorCode MatCoarsenGetData(MatCoarsen coarser, PetscCoarsenData **llist)
 . coarser - the coarsen context.
 
   Options Database Key:
-. -mat_coarsen_type  <type> - mis: maximal independent set based; misk: distance k MIS; hem: heavy edge matching
++ -mat_coarsen_type    <type> - mis: maximal independent set based; misk: distance k MIS; hem: heavy edge matching
+- -mat_coarsen_threads <bool> - use OpenMP threads in the MIS sweeps, see `MatCoarsenSetThreads()`
 
   Level: advanced
 
@@ -356,7 +398,7 @@ PetscErrorCode MatCoarsenGetData(MatCoarsen coarser, PetscCoarsenData **llist)
 @*/
 PetscErrorCode MatCoarsenSetFromOptions(MatCoarsen coarser)
 {
-  PetscBool   flag;
+  PetscBool   flag, set;
   char        type[256];
   const char *def;
 
@@ -374,6 +416,8 @@ PetscErrorCode MatCoarsenSetFromOptions(MatCoarsen coarser)
   PetscCall(PetscOptionsInt("-mat_coarsen_threshold", "Threshold (for HEM)", "MatCoarsenSetThreshold", coarser->max_it, &coarser->max_it, NULL));
   coarser->strength_index_size = MAT_COARSEN_STRENGTH_INDEX_SIZE;
   PetscCall(PetscOptionsIntArray("-mat_coarsen_strength_index", "Array of indices to use strength of connection measure (default is all indices)", "MatCoarsenSetStrengthIndex", coarser->strength_index, &coarser->strength_index_size, NULL));
+  PetscCall(PetscOptionsBool("-mat_coarsen_threads", "Use OpenMP threads in the MIS sweeps", "MatCoarsenSetThreads", coarser->threads, &flag, &set));
+  if (set) PetscCall(MatCoarsenSetThreads(coarser, flag));
   /*
    Set the type if it was never set.
    */
@@ -8,6 +8,112 @@
 #define MIS_REMOVED        -3
 #define MIS_IS_SELECTED(s) (s != MIS_DELETED && s != MIS_NOT_DONE && s != MIS_REMOVED)
 
+/*
+   MatCoarsenMISSweep_Private - greedy sweep over the local vertices in the order perm_ix, selecting a vertex when no neighbor
+   is selected and no ghost neighbor on a higher process is not done
+
+   Output Parameter:
+   . a_ndone - number of vertices selected, deleted or removed
+   . a_nremoved - number of singletons removed
+   . a_nselected - number of vertices selected
+*/
+static PetscErrorCode MatCoarsenMISSweep_Private(Mat Gmat, const PetscInt perm_ix[], PetscBool strict_aggs, const PetscInt lid_cprowID[], const PetscInt cpcol_gid[], const PetscInt cpcol_state[], PetscInt lid_state[], PetscBool lid_removed[], PetscCoarsenData *agg_lists, PetscInt *a_ndone, PetscInt *a_nremoved, PetscInt *a_nselected)
+{
+  Mat_SeqAIJ    *matA, *matB = NULL;
+  PetscInt       kk, n, ix, j, *idx, *ii, Iend, my0, gid, lid, cpid, lidj, state, statej, ndone = 0, nrm = 0, nsel = 0;
+  PetscBool      isMPI, isOK;
+  const PetscInt nloc = Gmat->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI));
+  if (isMPI) {
+    matA = (Mat_SeqAIJ *)((Mat_MPIAIJ *)Gmat->data)->A->data;
+    matB = (Mat_SeqAIJ *)((Mat_MPIAIJ *)Gmat->data)->B->data;
+  } else matA = (Mat_SeqAIJ *)Gmat->data;
+  PetscCall(MatGetOwnershipRange(Gmat, &my0, &Iend));
+  /* check all vertices */
+  for (kk = 0; kk < nloc; kk++) {
+    lid   = perm_ix[kk];
+    state = lid_state[lid];
+    if (lid_removed[lid]) continue;
+    if (state == MIS_NOT_DONE) {
+      /* parallel test, delete if selected ghost */
+      isOK = PETSC_TRUE;
+      if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
+        ii  = matB->compressedrow.i;
+        n   = ii[ix + 1] - ii[ix];
+        idx = matB->j + ii[ix];
+        for (j = 0; j < n; j++) {
+          cpid   = idx[j]; /* compressed row ID in B mat */
+          gid    = cpcol_gid[cpid];
+          statej = cpcol_state[cpid];
+          PetscCheck(!MIS_IS_SELECTED(statej), PETSC_COMM_SELF, PETSC_ERR_SUP, "selected ghost: %d", (int)gid);
+          if (statej == MIS_NOT_DONE && gid >= Iend) { /* should be (pe>rank), use gid as pe proxy */
+            isOK = PETSC_FALSE;                        /* can not delete */
+            break;
+          }
+        }
+      } /* parallel test */
+      if (isOK) { /* select or remove this vertex */
+        ndone++;
+        /* check for singleton */
+        ii = matA->i;
+        n  = ii[lid + 1] - ii[lid];
+        if (n < 2) {
+          /* if I have any ghost adj then not a sing */
+          ix = lid_cprowID[lid];
+          if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
+            nrm++;
+            lid_removed[lid] = PETSC_TRUE;
+            continue;
+            // lid_state[lidj] = MIS_REMOVED; /* add singleton to MIS (can cause low rank with elasticity on fine grid) */
+          }
+        }
+        /* SELECTED state encoded with global index */
+        lid_state[lid] = lid + my0;
+        nsel++;
+        if (strict_aggs) {
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+        } else {
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid));
+        }
+        /* delete local adj */
+        idx = matA->j + ii[lid];
+        for (j = 0; j < n; j++) {
+          lidj   = idx[j];
+          statej = lid_state[lidj];
+          if (statej == MIS_NOT_DONE) {
+            ndone++;
+            if (strict_aggs) {
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+            } else {
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj));
+            }
+            lid_state[lidj] = MIS_DELETED; /* delete this */
+          }
+        }
+        /* delete ghost adj of lid - deleted ghost done later for strict_aggs */
+        if (!strict_aggs) {
+          if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
+            ii  = matB->compressedrow.i;
+            n   = ii[ix + 1] - ii[ix];
+            idx = matB->j + ii[ix];
+            for (j = 0; j < n; j++) {
+              cpid   = idx[j]; /* compressed row ID in B mat */
+              statej = cpcol_state[cpid];
+              if (statej == MIS_NOT_DONE) PetscCall(PetscCDAppendID(agg_lists, lid, nloc + cpid));
+            }
+          }
+        }
+      } /* selected */
+    } /* not done vertex */
+  } /* vertex loop */
+  *a_ndone     = ndone;
+  *a_nremoved  = nrm;
+  *a_nselected = nsel;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    MatCoarsenApply_MIS_private - parallel maximal independent set (MIS) with data locality info. MatAIJ specific!!!
 
@@ -15,20 +121,21 @@
    . perm - serial permutation of rows of local to process in MIS
    . Gmat - global matrix of graph (data not defined)
    . strict_aggs - flag for whether to keep strict (non overlapping) aggregates in 'llist';
+   . threads - use the threaded sweep, see MatCoarsenSetThreads()
 
    Output Parameter:
    . a_selected - IS of selected vertices, includes 'ghost' nodes at end with natural local indices
    . a_locals_llist - array of list of nodes rooted at selected nodes
 */
-static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool strict_aggs, PetscCoarsenData **a_locals_llist)
+static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool strict_aggs, PetscBool threads, PetscCoarsenData **a_locals_llist)
 {
   Mat_SeqAIJ       *matA, *matB = NULL;
   Mat_MPIAIJ       *mpimat = NULL;
   MPI_Comm          comm;
   PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ii, Iend, my0, nremoved, gid, lid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state, statej;
-  PetscInt         *cpcol_gid, *cpcol_state, *lid_cprowID, *lid_gid, *cpcol_sel_gid, *icpcol_gid, *lid_state, *lid_parent_gid = NULL, nrm_tot = 0;
+  PetscInt         *cpcol_gid, *cpcol_state, *lid_cprowID, *lid_gid, *cpcol_sel_gid, *icpcol_gid, *lid_state, *lid_parent_gid = NULL, *lid_root = NULL, nrm_tot = 0;
   PetscBool        *lid_removed;
-  PetscBool         isMPI, isAIJ, isOK;
+  PetscBool         isMPI, isAIJ;
   const PetscInt   *perm_ix;
   const PetscInt    nloc = Gmat->rmap->n;
   PetscCoarsenData *agg_lists;
@@ -72,6 +179,8 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
   PetscCall(PetscMalloc1(nloc, &lid_removed)); /* explicit array needed */
   if (strict_aggs) PetscCall(PetscMalloc1(nloc, &lid_parent_gid));
   PetscCall(PetscMalloc1(nloc, &lid_state));
+  PetscCall(MatCoarsenMISUseThreads_Private(Gmat, threads, &threads));
+  if (threads) PetscCall(PetscMalloc1(nloc, &lid_root));
 
   /* has ghost nodes for !strict and uses local indexing (yuck) */
   PetscCall(PetscCDCreate(strict_aggs ? nloc : num_fine_ghosts + nloc, &agg_lists));
@@ -96,84 +205,57 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
 
   PetscCall(ISGetIndices(perm, &perm_ix));
   while (nDone < nloc || PETSC_TRUE) { /* asynchronous not implemented */
-    /* check all vertices */
-    for (kk = 0; kk < nloc; kk++) {
-      lid   = perm_ix[kk];
-      state = lid_state[lid];
-      if (lid_removed[lid]) continue;
-      if (state == MIS_NOT_DONE) {
-        /* parallel test, delete if selected ghost */
-        isOK = PETSC_TRUE;
-        if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
+    if (threads) {
+      PetscInt ndone, nrm;
+
+      PetscCall(MatCoarsenMISSelect_Threads(Gmat, perm_ix, lid_cprowID, cpcol_gid, cpcol_state, lid_state, lid_removed, PETSC_TRUE, lid_root, &ndone, &nrm));
+      nDone += ndone;
+      nremoved += nrm;
+      nrm_tot += nrm;
+      /* build the aggregates as the sequential sweep below does */
+      for (kk = 0; kk < nloc; kk++) {
+        lid = perm_ix[kk];
+        if (lid_root[lid] != lid) continue;
+        lid_state[lid] = lid + my0;
+        nselected++;
+        if (strict_aggs) {
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+        } else {
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid));
+        }
+        ii  = matA->i;
+        n   = ii[lid + 1] - ii[lid];
+        idx = matA->j + ii[lid];
+        for (j = 0; j < n; j++) {
+          lidj = idx[j];
+          if (lidj != lid && lid_root[lidj] == lid) {
+            if (strict_aggs) {
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+            } else {
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj));
+            }
+            lid_state[lidj] = MIS_DELETED;
+          }
+        }
+        if (!strict_aggs && (ix = lid_cprowID[lid]) != -1) {
           ii  = matB->compressedrow.i;
           n   = ii[ix + 1] - ii[ix];
           idx = matB->j + ii[ix];
           for (j = 0; j < n; j++) {
-            cpid   = idx[j]; /* compressed row ID in B mat */
-            gid    = cpcol_gid[cpid];
-            statej = cpcol_state[cpid];
-            PetscCheck(!MIS_IS_SELECTED(statej), PETSC_COMM_SELF, PETSC_ERR_SUP, "selected ghost: %d", (int)gid);
-            if (statej == MIS_NOT_DONE && gid >= Iend) { /* should be (pe>rank), use gid as pe proxy */
-              isOK = PETSC_FALSE;                        /* can not delete */
-              break;
-            }
-          }
-        } /* parallel test */
-        if (isOK) { /* select or remove this vertex */
-          nDone++;
-          /* check for singleton */
-          ii = matA->i;
-          n  = ii[lid + 1] - ii[lid];
-          if (n < 2) {
-            /* if I have any ghost adj then not a sing */
-            ix = lid_cprowID[lid];
-            if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
-              nremoved++;
-              nrm_tot++;
-              lid_removed[lid] = PETSC_TRUE;
-              continue;
-              // lid_state[lidj] = MIS_REMOVED; /* add singleton to MIS (can cause low rank with elasticity on fine grid) */
-            }
-          }
-          /* SELECTED state encoded with global index */
-          lid_state[lid] = lid + my0;
-          nselected++;
-          if (strict_aggs) {
-            PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
-          } else {
-            PetscCall(PetscCDAppendID(agg_lists, lid, lid));
+            cpid = idx[j];
+            if (cpcol_state[cpid] == MIS_NOT_DONE) PetscCall(PetscCDAppendID(agg_lists, lid, nloc + cpid));
           }
-          /* delete local adj */
-          idx = matA->j + ii[lid];
-          for (j = 0; j < n; j++) {
-            lidj   = idx[j];
-            statej = lid_state[lidj];
-            if (statej == MIS_NOT_DONE) {
-              nDone++;
-              if (strict_aggs) {
-                PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
-              } else {
-                PetscCall(PetscCDAppendID(agg_lists, lid, lidj));
-              }
-              lid_state[lidj] = MIS_DELETED; /* delete this */
-            }
-          }
-          /* delete ghost adj of lid - deleted ghost done later for strict_aggs */
-          if (!strict_aggs) {
-            if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
-              ii  = matB->compressedrow.i;
-              n   = ii[ix + 1] - ii[ix];
-              idx = matB->j + ii[ix];
-              for (j = 0; j < n; j++) {
-                cpid   = idx[j]; /* compressed row ID in B mat */
-                statej = cpcol_state[cpid];
-                if (statej == MIS_NOT_DONE) PetscCall(PetscCDAppendID(agg_lists, lid, nloc + cpid));
-              }
-            }
-          }
-        } /* selected */
-      } /* not done vertex */
-    } /* vertex loop */
+        }
+      }
+    } else {
+      PetscInt ndone = 0, nrm = 0, nsel = 0;
+
+      PetscCall(MatCoarsenMISSweep_Private(Gmat, perm_ix, strict_aggs, lid_cprowID, cpcol_gid, cpcol_state, lid_state, lid_removed, agg_lists, &ndone, &nrm, &nsel));
+      nDone += ndone;
+      nremoved += nrm;
+      nrm_tot += nrm;
+      nselected += nsel;
+    }
 
     /* update ghost states and count todos */
     if (mpimat) {
@@ -246,6 +328,7 @@ static PetscErrorCode MatCoarsenApply_MIS_private(IS perm, Mat Gmat, PetscBool s
   PetscCall(PetscFree(lid_removed));
   if (strict_aggs) PetscCall(PetscFree(lid_parent_gid));
   PetscCall(PetscFree(lid_state));
+  PetscCall(PetscFree(lid_root));
   if (strict_aggs) {
     // check sizes -- all vertices must get in graph
     PetscInt aa[2] = {0, nrm_tot}, bb[2], MM;
@@ -276,10 +359,10 @@ static PetscErrorCode MatCoarsenApply_MIS(MatCoarsen coarse)
     PetscCall(PetscObjectGetComm((PetscObject)mat, &comm));
     PetscCall(MatGetLocalSize(mat, &m, &n));
     PetscCall(ISCreateStride(comm, m, 0, 1, &perm));
-    PetscCall(MatCoarsenApply_MIS_private(perm, mat, coarse->strict_aggs, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MIS_private(perm, mat, coarse->strict_aggs, coarse->threads, &coarse->agg_lists));
     PetscCall(ISDestroy(&perm));
   } else {
-    PetscCall(MatCoarsenApply_MIS_private(coarse->perm, mat, coarse->strict_aggs, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MIS_private(coarse->perm, mat, coarse->strict_aggs, coarse->threads, &coarse->agg_lists));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
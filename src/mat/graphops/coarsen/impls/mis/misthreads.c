@@ -0,0 +1,179 @@
+/*
+  OpenMP threaded local sweep of the MATCOARSENMIS and MATCOARSENMISK coarseners.
+
+  The sequential sweep visits the vertices in the greedy ordering and selects every vertex that has not been deleted by
+  a neighbor selected before it, so a vertex is selected if and only if no neighbor that comes earlier in the ordering
+  is selected. This is the independent set computed by Jones-Plassmann (Luby with fixed priorities) when the priority
+  of a vertex is its position in the ordering: the rounds decide concurrently every vertex whose earlier neighbors are
+  all decided. The positions are split into one contiguous chunk per thread that is swept in order, so a chunk decides
+  the vertices that only depend on itself in a single round; the states of the other chunks are read from a copy that
+  is updated between the rounds so no thread reads an entry another thread writes.
+
+  The graph must be structurally symmetric: the neighbors that delete a vertex are then the vertices of its row.
+*/
+#include <petsc/private/matimpl.h> /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+/* same encoding of lid_state[] as in mis.c and misk.c */
+#define MIS_NOT_DONE -2
+
+/* states of a vertex during one threaded sweep */
+#define MIS_SWEEP_SKIP      0 /* not visited: done, removed, or waits for a ghost */
+#define MIS_SWEEP_SINGLETON 1 /* visited and removed as a singleton, unless it is deleted before */
+#define MIS_SWEEP_UNDECIDED 2
+#define MIS_SWEEP_SELECTED  3
+#define MIS_SWEEP_DELETED   4
+
+/*
+   MatCoarsenMISUseThreads_Private - whether the threaded sweep can be used on Gmat
+*/
+PetscErrorCode MatCoarsenMISUseThreads_Private(Mat Gmat, PetscBool threads, PetscBool *use)
+{
+  PetscBool set, flg;
+
+  PetscFunctionBegin;
+  *use = PETSC_FALSE;
+  if (!threads) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatIsStructurallySymmetricKnown(Gmat, &set, &flg));
+  if (!set || !flg) PetscCall(MatIsSymmetricKnown(Gmat, &set, &flg));
+  if (set && flg) *use = PETSC_TRUE;
+  else PetscCall(PetscInfo(Gmat, "Not using threads in the MIS since the graph is not known to be structurally symmetric\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatCoarsenMISSelect_Threads - one threaded sweep over the local vertices of the MIS
+
+   Input Parameters:
++  Gmat         - the (MPI)AIJ graph
+.  perm_ix      - the greedy ordering of the local vertices, NULL for the natural ordering
+.  lid_cprowID  - row of each local vertex in the compressed off-diagonal block, -1 if it has no ghost neighbor
+.  cpcol_gid    - global index of the ghosts
+.  cpcol_state  - state of the ghosts
+.  lid_state    - state of the local vertices at the beginning of the sweep
+.  lid_removed  - removed singletons, which are not visited
+-  mark_removed - add the singletons removed by this sweep to lid_removed
+
+   Output Parameters:
++  lid_root  - lid_root[lid] = lid if lid is selected, the local selected vertex that deletes lid, or -1
+.  ndone     - number of vertices done by this sweep, counted as the sequential sweep does
+-  nremoved  - number of singletons removed by this sweep, 0 if mark_removed is false
+
+   Note:
+   The caller builds the aggregates by visiting the selected vertices in the greedy ordering.
+*/
+PetscErrorCode MatCoarsenMISSelect_Threads(Mat Gmat, const PetscInt perm_ix[], const PetscInt lid_cprowID[], const PetscInt cpcol_gid[], const PetscInt cpcol_state[], const PetscInt lid_state[], PetscBool lid_removed[], PetscBool mark_removed, PetscInt lid_root[], PetscInt *ndone, PetscInt *nremoved)
+{
+  Mat_SeqAIJ     *matA, *matB = NULL;
+  const PetscInt  nloc = Gmat->rmap->n, Iend = Gmat->rmap->rend;
+  PetscInt        nt = 1, nrounds = 0, nundecided, nbad = 0, nselected = 0, nsingle = 0, ndeleted = 0, *prio, *cur, *old, *pstart;
+  const PetscInt *ai, *aj;
+  PetscBool       isMPI;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI));
+  if (isMPI) {
+    Mat_MPIAIJ *mpimat = (Mat_MPIAIJ *)Gmat->data;
+
+    matA = (Mat_SeqAIJ *)mpimat->A->data;
+    matB = (Mat_SeqAIJ *)mpimat->B->data;
+  } else matA = (Mat_SeqAIJ *)Gmat->data;
+  ai = matA->i;
+  aj = matA->j;
+  PetscCall(PetscMalloc3(nloc, &prio, nloc, &cur, nloc, &old));
+  PetscCall(PetscMalloc1(nt + 1, &pstart));
+  for (PetscInt t = 0; t <= nt; t++) pstart[t] = (PetscInt)(((PetscInt64)nloc * t) / nt);
+
+  /* candidates: not done, not removed, and no undecided ghost neighbor on a higher rank */
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static) reduction(+:nbad))
+  for (PetscInt kk = 0; kk < nloc; kk++) {
+    const PetscInt lid = perm_ix ? perm_ix[kk] : kk;
+    PetscInt       ix  = lid_cprowID[lid], s = MIS_SWEEP_SKIP;
+
+    prio[lid] = kk;
+    if (lid_state[lid] == MIS_NOT_DONE && !lid_removed[lid]) {
+      PetscBool isOK = PETSC_TRUE, hasghost = PETSC_FALSE;
+
+      if (ix != -1) {
+        const PetscInt *ii = matB->compressedrow.i, *idx = matB->j + ii[ix], n = ii[ix + 1] - ii[ix];
+
+        hasghost = (PetscBool)(n > 0);
+        for (PetscInt j = 0; j < n; j++) {
+          const PetscInt cpid = idx[j], statej = cpcol_state[cpid];
+
+          if (statej >= 0) nbad++; /* selected ghost */
+          if (statej == MIS_NOT_DONE && cpcol_gid[cpid] >= Iend) {
+            isOK = PETSC_FALSE;
+            break;
+          }
+        }
+      }
+      if (isOK) s = (ai[lid + 1] - ai[lid] < 2 && !hasghost) ? MIS_SWEEP_SINGLETON : MIS_SWEEP_UNDECIDED;
+    }
+    cur[lid] = old[lid] = s;
+  }
+  PetscCheck(!nbad, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Selected ghost neighbor of an undone vertex");
+
+  /* rounds: select a vertex when no earlier neighbor is selected or undecided */
+  do {
+    nundecided = 0;
+    nrounds++;
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static) reduction(+:nundecided))
+    for (PetscInt t = 0; t < nt; t++) {
+      for (PetscInt kk = pstart[t]; kk < pstart[t + 1]; kk++) {
+        const PetscInt lid = perm_ix ? perm_ix[kk] : kk;
+        PetscInt       s   = MIS_SWEEP_SELECTED;
+
+        if (cur[lid] != MIS_SWEEP_UNDECIDED) continue;
+        for (PetscInt j = ai[lid]; j < ai[lid + 1] && s != MIS_SWEEP_DELETED; j++) {
+          const PetscInt lidj = aj[j], pj = prio[lidj];
+          PetscInt       sj;
+
+          if (pj >= kk) continue;
+          sj = pj >= pstart[t] ? cur[lidj] : old[lidj];
+          if (sj == MIS_SWEEP_SELECTED) s = MIS_SWEEP_DELETED;
+          else if (sj == MIS_SWEEP_UNDECIDED) s = MIS_SWEEP_UNDECIDED;
+        }
+        cur[lid] = s;
+        if (s == MIS_SWEEP_UNDECIDED) nundecided++;
+      }
+    }
+    if (nundecided) {
+      PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+      for (PetscInt lid = 0; lid < nloc; lid++) old[lid] = cur[lid];
+    }
+  } while (nundecided);
+  PetscCall(PetscInfo(Gmat, "%" PetscInt_FMT " rounds with %" PetscInt_FMT " threads\n", nrounds, nt));
+
+  /* every undone vertex is deleted by its earliest selected neighbor, a singleton is removed if it was not deleted when visited */
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static) reduction(+:nselected,nsingle,ndeleted))
+  for (PetscInt lid = 0; lid < nloc; lid++) {
+    PetscInt root = -1;
+
+    if (cur[lid] == MIS_SWEEP_SELECTED) {
+      root = lid;
+      nselected++;
+    } else if (lid_state[lid] == MIS_NOT_DONE) {
+      for (PetscInt j = ai[lid]; j < ai[lid + 1]; j++) {
+        const PetscInt lidj = aj[j];
+
+        if (lidj != lid && cur[lidj] == MIS_SWEEP_SELECTED && (root == -1 || prio[lidj] < prio[root])) root = lidj;
+      }
+      if (root != -1) ndeleted++;
+      if (cur[lid] == MIS_SWEEP_SINGLETON && (root == -1 || prio[root] > prio[lid])) {
+        nsingle++;
+        if (mark_removed) lid_removed[lid] = PETSC_TRUE;
+      }
+    }
+    lid_root[lid] = root;
+  }
+  *ndone    = nselected + nsingle + ndeleted;
+  *nremoved = mark_removed ? nsingle : 0;
+  PetscCall(PetscFree3(prio, cur, old));
+  PetscCall(PetscFree(pstart));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -33,17 +33,109 @@ static PetscErrorCode PetscCoarsenDataView_private(PetscCoarsenData *agg_lists,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  MatCoarsenMISKSweep_Private - greedy sweep over the local vertices in the order perm_ix, or the natural order, selecting a vertex
+  when no neighbor is selected and no ghost neighbor on a higher process is not done
+
+  Input Parameter:
+   . iterIdx - the MIS iteration, singletons are only removed in the first one
+
+  Input/Output Parameter:
+   . nselected - the selected vertices are numbered from this value, which is incremented for each of them
+
+  Output Parameter:
+   . a_ndone - number of vertices selected, deleted or removed
+   . a_nremoved - number of singletons removed
+*/
+static PetscErrorCode MatCoarsenMISKSweep_Private(Mat cMat, const PetscInt perm_ix[], PetscInt iterIdx, const PetscInt lid_cprowID[], const PetscInt cpcol_gid[], const PetscInt cpcol_state[], PetscInt lid_state[], PetscBool lid_removed[], PetscCoarsenData *agg_lists, PetscInt *nselected, PetscInt *a_ndone, PetscInt *a_nremoved)
+{
+  Mat_SeqAIJ    *matA, *matB = NULL;
+  PetscInt       kk, n, ix, j, *idx, *ai, Iend, my0, gid, cpid, lidj, ndone = 0, nrm = 0;
+  PetscBool      isMPI, isOK;
+  const PetscInt nloc_inner = cMat->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATMPIAIJ, &isMPI));
+  if (isMPI) {
+    matA = (Mat_SeqAIJ *)((Mat_MPIAIJ *)cMat->data)->A->data;
+    matB = (Mat_SeqAIJ *)((Mat_MPIAIJ *)cMat->data)->B->data;
+  } else matA = (Mat_SeqAIJ *)cMat->data;
+  PetscCall(MatGetOwnershipRange(cMat, &my0, &Iend));
+  /* check all vertices */
+  for (kk = 0; kk < nloc_inner; kk++) {
+    const PetscInt lid   = perm_ix ? perm_ix[kk] : kk;
+    const PetscInt state = lid_state[lid];
+    if (iterIdx == 0 && lid_removed[lid]) continue;
+    if (state == MIS_NOT_DONE) {
+      /* parallel test, delete if selected ghost */
+      isOK = PETSC_TRUE;
+      /* parallel test */
+      if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
+        ai  = matB->compressedrow.i;
+        n   = ai[ix + 1] - ai[ix];
+        idx = matB->j + ai[ix];
+        for (j = 0; j < n; j++) {
+          cpid = idx[j]; /* compressed row ID in B mat */
+          gid  = cpcol_gid[cpid];
+          if (cpcol_state[cpid] == MIS_NOT_DONE && gid >= Iend) { /* or pe>rank */
+            isOK = PETSC_FALSE;                                   /* can not delete */
+            break;
+          }
+        }
+      }
+      if (isOK) { /* select or remove this vertex if it is a true singleton like a BC */
+        ndone++;
+        /* check for singleton */
+        ai = matA->i;
+        n  = ai[lid + 1] - ai[lid];
+        if (n < 2) {
+          /* if I have any ghost adj then not a singleton */
+          ix = lid_cprowID[lid];
+          if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
+            if (iterIdx == 0) {
+              lid_removed[lid] = PETSC_TRUE;
+              nrm++; // let it get selected
+            }
+            // PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+            // lid_state[lid] = nselected; // >= 0  is selected, cache for ordering coarse grid
+            /* should select this because it is technically in the MIS but lets not */
+            continue; /* one local adj (me) and no ghost - singleton */
+          }
+        }
+        /* SELECTED state encoded with global index */
+        lid_state[lid] = *nselected; // >= 0  is selected, cache for ordering coarse grid
+        (*nselected)++;
+        PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+        /* delete local adj */
+        idx = matA->j + ai[lid];
+        for (j = 0; j < n; j++) {
+          lidj = idx[j];
+          if (lid_state[lidj] == MIS_NOT_DONE) {
+            ndone++;
+            PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+            lid_state[lidj] = MIS_DELETED; /* delete this */
+          }
+        }
+      } /* selected */
+    } /* not done vertex */
+  } /* vertex loop */
+  *a_ndone    = ndone;
+  *a_nremoved = nrm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
   MatCoarsenApply_MISK_private - parallel heavy edge matching
 
   Input Parameter:
    . perm - permutation
    . Gmat - global matrix of graph (data not defined)
+   . threads - use the threaded sweep, see MatCoarsenSetThreads()
 
   Output Parameter:
    . a_locals_llist - array of list of local nodes rooted at local node
 */
-static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk, Mat Gmat, PetscCoarsenData **a_locals_llist)
+static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk, Mat Gmat, PetscBool threads, PetscCoarsenData **a_locals_llist)
 {
   PetscBool   isMPI;
   MPI_Comm    comm;
@@ -70,9 +162,9 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     const PetscInt   *perm_ix;
     const PetscInt    nloc_inner = cMat->rmap->n;
     PetscCoarsenData *agg_lists;
-    PetscInt         *cpcol_gid = NULL, *cpcol_state, *lid_cprowID, *lid_state, *lid_parent_gid = NULL;
+    PetscInt         *cpcol_gid = NULL, *cpcol_state, *lid_cprowID, *lid_state, *lid_parent_gid = NULL, *lid_root = NULL;
     PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ai, Iend, my0, nremoved, gid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state;
-    PetscBool        *lid_removed, isOK;
+    PetscBool        *lid_removed, use_threads;
     PetscLayout       layout;
     PetscSF           sf;
 
@@ -109,6 +201,8 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     PetscCall(PetscMalloc1(nloc_inner, &lid_removed)); /* explicit array needed */
     PetscCall(PetscMalloc1(nloc_inner, &lid_parent_gid));
     PetscCall(PetscMalloc1(nloc_inner, &lid_state));
+    PetscCall(MatCoarsenMISUseThreads_Private(cMat, threads, &use_threads));
+    if (use_threads) PetscCall(PetscMalloc1(nloc_inner, &lid_root));
 
     /* the data structure */
     PetscCall(PetscCDCreate(nloc_inner, &agg_lists));
@@ -131,64 +225,37 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     if (!iterIdx) PetscCall(ISGetIndices(perm, &perm_ix)); // use permutation on first MIS
     else perm_ix = NULL;
     while (nDone < nloc_inner || PETSC_TRUE) { /* asynchronous not implemented */
-      /* check all vertices */
-      for (kk = 0; kk < nloc_inner; kk++) {
-        const PetscInt lid = perm_ix ? perm_ix[kk] : kk;
-        state              = lid_state[lid];
-        if (iterIdx == 0 && lid_removed[lid]) continue;
-        if (state == MIS_NOT_DONE) {
-          /* parallel test, delete if selected ghost */
-          isOK = PETSC_TRUE;
-          /* parallel test */
-          if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
-            ai  = matB->compressedrow.i;
-            n   = ai[ix + 1] - ai[ix];
-            idx = matB->j + ai[ix];
-            for (j = 0; j < n; j++) {
-              cpid = idx[j]; /* compressed row ID in B mat */
-              gid  = cpcol_gid[cpid];
-              if (cpcol_state[cpid] == MIS_NOT_DONE && gid >= Iend) { /* or pe>rank */
-                isOK = PETSC_FALSE;                                   /* can not delete */
-                break;
-              }
+      if (use_threads) {
+        PetscInt ndone, nrm;
+
+        PetscCall(MatCoarsenMISSelect_Threads(cMat, perm_ix, lid_cprowID, cpcol_gid, cpcol_state, lid_state, lid_removed, iterIdx == 0 ? PETSC_TRUE : PETSC_FALSE, lid_root, &ndone, &nrm));
+        nDone += ndone;
+        nremoved += nrm;
+        /* build the aggregates, and number the selected vertices, as the sequential sweep below does */
+        for (kk = 0; kk < nloc_inner; kk++) {
+          const PetscInt lid = perm_ix ? perm_ix[kk] : kk;
+
+          if (lid_root[lid] != lid) continue;
+          lid_state[lid] = nselected++;
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+          ai  = matA->i;
+          n   = ai[lid + 1] - ai[lid];
+          idx = matA->j + ai[lid];
+          for (j = 0; j < n; j++) {
+            lidj = idx[j];
+            if (lidj != lid && lid_root[lidj] == lid) {
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+              lid_state[lidj] = MIS_DELETED;
             }
           }
-          if (isOK) { /* select or remove this vertex if it is a true singleton like a BC */
-            nDone++;
-            /* check for singleton */
-            ai = matA->i;
-            n  = ai[lid + 1] - ai[lid];
-            if (n < 2) {
-              /* if I have any ghost adj then not a singleton */
-              ix = lid_cprowID[lid];
-              if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
-                if (iterIdx == 0) {
-                  lid_removed[lid] = PETSC_TRUE;
-                  nremoved++; // let it get selected
-                }
-                // PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
-                // lid_state[lid] = nselected; // >= 0  is selected, cache for ordering coarse grid
-                /* should select this because it is technically in the MIS but lets not */
-                continue; /* one local adj (me) and no ghost - singleton */
-              }
-            }
-            /* SELECTED state encoded with global index */
-            lid_state[lid] = nselected; // >= 0  is selected, cache for ordering coarse grid
-            nselected++;
-            PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
-            /* delete local adj */
-            idx = matA->j + ai[lid];
-            for (j = 0; j < n; j++) {
-              lidj = idx[j];
-              if (lid_state[lidj] == MIS_NOT_DONE) {
-                nDone++;
-                PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
-                lid_state[lidj] = MIS_DELETED; /* delete this */
-              }
-            }
-          } /* selected */
-        } /* not done vertex */
-      } /* vertex loop */
+        }
+      } else {
+        PetscInt ndone = 0, nrm = 0;
+
+        PetscCall(MatCoarsenMISKSweep_Private(cMat, perm_ix, iterIdx, lid_cprowID, cpcol_gid, cpcol_state, lid_state, lid_removed, agg_lists, &nselected, &ndone, &nrm));
+        nDone += ndone;
+        nremoved += nrm;
+      }
 
       /* update ghost states and count todos */
       if (mpimat) {
@@ -253,6 +320,7 @@ static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk,
     PetscCall(PetscFree(lid_removed));
     PetscCall(PetscFree(lid_parent_gid));
     PetscCall(PetscFree(lid_state));
+    PetscCall(PetscFree(lid_root));
 
     /* MIS done - make projection matrix - P */
     MatType jtype;
@@ -366,10 +434,10 @@ static PetscErrorCode MatCoarsenApply_MISK(MatCoarsen coarse)
 
     PetscCall(MatGetLocalSize(mat, &m, &n));
     PetscCall(ISCreateStride(PetscObjectComm((PetscObject)mat), m, 0, 1, &perm));
-    PetscCall(MatCoarsenApply_MISK_private(perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MISK_private(perm, (PetscInt)k, mat, coarse->threads, &coarse->agg_lists));
     PetscCall(ISDestroy(&perm));
   } else {
-    PetscCall(MatCoarsenApply_MISK_private(coarse->perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenApply_MISK_private(coarse->perm, (PetscInt)k, mat, coarse->threads, &coarse->agg_lists));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
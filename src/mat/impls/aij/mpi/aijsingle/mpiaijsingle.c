@@ -0,0 +1,82 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+static PetscErrorCode MatMPIAIJSetPreallocation_MPIAIJSingle(Mat B, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetPreallocation_MPIAIJ(B, d_nz, d_nnz, o_nz, o_nnz));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingle(b->A, MATSEQAIJSINGLE, MAT_INPLACE_MATRIX, &b->A));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingle(b->B, MATSEQAIJSINGLE, MAT_INPLACE_MATRIX, &b->B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSingle(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat B = *newmat;
+
+  PetscFunctionBegin;
+  PetscCheck(!PetscDefined(USE_COMPLEX), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "MATMPIAIJSINGLE does not support complex scalars");
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  if (B->preallocated) {
+    Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+    PetscCall(MatConvert_SeqAIJ_SeqAIJSingle(b->A, MATSEQAIJSINGLE, MAT_INPLACE_MATRIX, &b->A));
+    PetscCall(MatConvert_SeqAIJ_SeqAIJSingle(b->B, MATSEQAIJSINGLE, MAT_INPLACE_MATRIX, &b->B));
+  }
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJSINGLE));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIAIJSingle));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSingle(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATMPIAIJ));
+  PetscCall(MatConvert_MPIAIJ_MPIAIJSingle(A, MATMPIAIJSINGLE, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATMPIAIJSINGLE - MATMPIAIJSINGLE = "mpiaijsingle" - A matrix type to be used for parallel sparse matrices whose
+   diagonal and off-diagonal blocks are `MATSEQAIJSINGLE` matrices.
+
+   Options Database Key:
+. -mat_type mpiaijsingle - sets the matrix type to `MATMPIAIJSINGLE` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+   Note:
+   The blocks are converted by `MatMPIAIJSetPreallocation()`, or by `MatConvert()` for a preallocated matrix.
+
+.seealso: [](ch_matrices), `Mat`, `MATAIJSINGLE`, `MATSEQAIJSINGLE`, `MATMPIAIJ`
+M*/
+
+/*MC
+   MATAIJSINGLE - "aijsingle" - A matrix type to be used for sparse matrices whose products and relaxations can be
+   computed with the values rounded to single precision, such as the preconditioning matrices and smoothers of a
+   multigrid hierarchy.
+
+   This matrix type is identical to `MATSEQAIJSINGLE` when constructed with a single process communicator,
+   and `MATMPIAIJSINGLE` otherwise.  As a result, for single process communicators,
+   `MatSeqAIJSetPreallocation()` is supported, and similarly `MatMPIAIJSetPreallocation()` is supported
+   for communicators controlling multiple processes.  It is recommended that you call both of
+   the above preallocation routines for simplicity.
+
+   Options Database Key:
+. -mat_type aijsingle - sets the matrix type to `MATAIJSINGLE`
+
+  Level: intermediate
+
+  Notes:
+  `MatMult()`, `MatMultAdd()` and the local sweeps of `MatSOR()` stream a single precision copy of the values and
+  accumulate in `PetscScalar`, see `MATSEQAIJSINGLE`.
+
+  For a multigrid preconditioner, pass a `MATAIJSINGLE` matrix as the preconditioning matrix of `KSPSetOperators()` or
+  convert the matrices of the levels with `MatConvert()`; the operator used by the outer Krylov method keeps its values
+  in `PetscScalar`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJSINGLE`, `MATMPIAIJSINGLE`, `MATSEQAIJ`, `MATMPIAIJ`, `MATAIJSELL`, `MATAIJPERM`
+M*/
@@ -68,6 +68,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIAIJSetUseScalableIncreaseOverlap_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsingle_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijmkl_C", NULL));
 #endif
@@ -124,7 +125,7 @@ static PetscErrorCode MatRestoreRowIJ_MPIAIJ(Mat A, PetscInt oshift, PetscBool s
   Developer Note:
   Level: beginner
 
-    Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJMKL`, `MATAIJCRL`, `MATAIJKOKKOS`,and also automatically switches over to use inodes when
+    Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJSINGLE`, `MATAIJMKL`, `MATAIJCRL`, `MATAIJKOKKOS`,and also automatically switches over to use inodes when
    enough exist.
 
 .seealso: [](ch_matrices), `Mat`, `MATMPIAIJ`, `MATSEQAIJ`, `MatCreateAIJ()`, `MatCreateSeqAIJ()`, `MATSEQAIJ`, `MATMPIAIJ`
@@ -1389,9 +1390,10 @@ PetscErrorCode MatView_MPIAIJ(Mat mat, PetscViewer viewer)
 
 static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
-  Mat_MPIAIJ *mat = (Mat_MPIAIJ *)matin->data;
-  Vec         bb1 = NULL;
-  PetscBool   hasop;
+  Mat_MPIAIJ      *mat = (Mat_MPIAIJ *)matin->data;
+  Vec              bb1 = NULL;
+  PetscBool        hasop;
+  const MatSORType mc = (MatSORType)(flag & SOR_MULTICOLOR); /* passed on to the local sweeps */
 
   PetscFunctionBegin;
   if (flag == SOR_APPLY_UPPER) {
@@ -1416,7 +1418,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_SYMMETRIC_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_SYMMETRIC_SWEEP | mc), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_LOCAL_FORWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1432,7 +1434,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_FORWARD_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_FORWARD_SWEEP | mc), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_LOCAL_BACKWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1448,7 +1450,7 @@ static PetscErrorCode MatSOR_MPIAIJ(Mat matin, Vec bb, PetscReal omega, MatSORTy
       PetscCall((*mat->B->ops->multadd)(mat->B, mat->lvec, bb, bb1));
 
       /* local sweep */
-      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, SOR_BACKWARD_SWEEP, fshift, lits, 1, xx));
+      PetscCall((*mat->A->ops->sor)(mat->A, bb1, omega, (MatSORType)(SOR_BACKWARD_SWEEP | mc), fshift, lits, 1, xx));
     }
   } else if (flag & SOR_EISENSTAT) {
     Vec xx1;
@@ -4401,6 +4403,8 @@ PetscErrorCode MatUpdateMPIAIJWithArray(Mat mat, const PetscScalar v[])
   Options Database Keys:
 + -mat_no_inode                     - Do not use inodes
 . -mat_inode_limit <limit>          - Sets inode limit (max limit=5)
+. -mat_aij_threads                  - Use OpenMP threads in the local `MatMult()` and `MatSetValuesCOO()` kernels, requires PETSc configured with OpenMP
+. -mat_aij_delta_indices            - Encode the local column indices as 16-bit deltas for `MatMult()` and `MatSOR()`
 - -matmult_vecscatter_view <viewer> - View the vecscatter (i.e., communication pattern) used in `MatMult()` of sparse parallel matrices.
         See viewer types in manual of `MatView()`. Of them, ascii_matlab, draw or binary cause the vecscatter be viewed as a matrix.
         Entry (i,j) is the size of message (in bytes) rank i sends to rank j in one `MatMult()` call.
@@ -6031,6 +6035,7 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSingle(Mat, MatType, MatReuse, Mat *);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat, MatType, MatReuse, Mat *);
 #endif
@@ -6797,6 +6802,23 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
   PetscCall(MatSeqAIJGetArray(A, &Aa)); /* Might read and write matrix values */
   PetscCall(MatSeqAIJGetArray(B, &Ba));
 
+#if defined(PETSC_HAVE_OPENMP)
+  if (((Mat_SeqAIJ *)A->data)->threads.use) { /* Same as below, with the segmented sums split between threads */
+    const PetscBool zero = imode == INSERT_VALUES ? PETSC_TRUE : PETSC_FALSE;
+
+    MatSeqAIJThreadsGatherCOO(coo->sendlen, Cperm1, v, sendbuf);
+    PetscCall(PetscSFReduceWithMemTypeBegin(coo->sf, MPIU_SCALAR, PETSC_MEMTYPE_HOST, sendbuf, PETSC_MEMTYPE_HOST, recvbuf, MPI_REPLACE));
+    MatSeqAIJThreadsSumCOO(coo->Annz, Ajmap1, Aperm1, NULL, v, zero, Aa);
+    MatSeqAIJThreadsSumCOO(coo->Bnnz, Bjmap1, Bperm1, NULL, v, zero, Ba);
+    PetscCall(PetscSFReduceEnd(coo->sf, MPIU_SCALAR, sendbuf, recvbuf, MPI_REPLACE));
+    MatSeqAIJThreadsSumCOO(coo->Annz2, Ajmap2, Aperm2, Aimap2, recvbuf, PETSC_FALSE, Aa);
+    MatSeqAIJThreadsSumCOO(coo->Bnnz2, Bjmap2, Bperm2, Bimap2, recvbuf, PETSC_FALSE, Ba);
+    PetscCall(MatSeqAIJRestoreArray(A, &Aa));
+    PetscCall(MatSeqAIJRestoreArray(B, &Ba));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+
   /* Pack entries to be sent to remote */
   for (PetscCount i = 0; i < coo->sendlen; i++) sendbuf[i] = v[Cperm1[i]];
 
@@ -6892,6 +6914,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatDiagonalScaleLocal_C", MatDiagonalScaleLocal_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijperm_C", MatConvert_MPIAIJ_MPIAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsell_C", MatConvert_MPIAIJ_MPIAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsingle_C", MatConvert_MPIAIJ_MPIAIJSingle));
 #if defined(PETSC_HAVE_CUDA)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijcusparse_C", MatConvert_MPIAIJ_MPIAIJCUSPARSE));
 #endif
@@ -1089,6 +1089,8 @@ PetscErrorCode MatView_SeqAIJ(Mat A, PetscViewer viewer)
   else if (isbinary) PetscCall(MatView_SeqAIJ_Binary(A, viewer));
   else if (isdraw) PetscCall(MatView_SeqAIJ_Draw(A, viewer));
   PetscCall(MatView_SeqAIJ_Inode(A, viewer));
+  PetscCall(MatView_SeqAIJ_Threads(A, viewer));
+  PetscCall(MatView_SeqAIJ_Delta(A, viewer));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1106,6 +1108,8 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
   if (A->was_assembled && A->ass_nonzerostate == A->nonzerostate) {
     /* we need to respect users asking to use or not the inodes routine in between matrix assemblies */
     PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
+    PetscCall(MatAssemblyEnd_SeqAIJ_Threads(A));
+    PetscCall(MatAssemblyEnd_SeqAIJ_Delta(A));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
@@ -1160,6 +1164,8 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
 
   if (!A->structure_only) PetscCall(MatCheckCompressedRow(A, a->nonzerorowcnt, &a->compressedrow, a->i, m, ratio));
   PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
+  PetscCall(MatAssemblyEnd_SeqAIJ_Threads(A));
+  PetscCall(MatAssemblyEnd_SeqAIJ_Delta(A));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1231,6 +1237,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
+  PetscCall(MatDestroy_SeqAIJ_Threads(A));
+  PetscCall(MatDestroy_SeqAIJ_Delta(A));
+  PetscCall(MatSeqAIJSupernodesReset(&a->supernodes));
   PetscCall(PetscFree(A->data));
 
   /* MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted may allocate this.
@@ -1250,6 +1259,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsingle_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmkl_C", NULL));
 #endif
@@ -1296,6 +1306,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   /* these calls do not belong here: the subclasses Duplicate/Destroy are wrong */
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsell_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijperm_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsingle_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijviennacl_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqdense_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqaij_C", NULL));
@@ -1416,6 +1427,12 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A, Vec xx, Vec zz, Vec yy)
 #endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    PetscCall(MatMultTransposeAdd_SeqAIJ_Threads(A, xx, zz, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   if (zz != yy) PetscCall(VecCopy(zz, yy));
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArray(yy, &y));
@@ -1477,10 +1494,20 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->delta.use) { /* threaded with a->threads.use, but without the inodes */
+    PetscCall(MatMult_SeqAIJ_Delta(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMult_SeqAIJ_Inode(A, xx, yy));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    PetscCall(MatMult_SeqAIJ_Threads(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArray(yy, &y));
@@ -1636,10 +1663,20 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   PetscBool          usecprow = a->compressedrow.use;
 
   PetscFunctionBegin;
+  if (a->delta.use) { /* threaded with a->threads.use, but without the inodes */
+    PetscCall(MatMultAdd_SeqAIJ_Delta(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMultAdd_SeqAIJ_Inode(A, xx, yy, zz));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    PetscCall(MatMultAdd_SeqAIJ_Threads(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArrayPair(yy, zz, &y, &z));
@@ -1884,7 +1921,7 @@ static PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A, PetscInt nblo
 /*
    Negative shift indicates do not generate an error if there is a zero diagonal, just invert it anyways
 */
-static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
+PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
   PetscInt         i, *diag, m = A->rmap->n;
@@ -1926,16 +1963,26 @@ static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscSc
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#define MatSeqAIJMinusDot_Private(sum, row, start, end) PetscSparseDenseMinusDot(sum, x, (aa + (start)), (a->j + (start)), ((end) - (start)))
+
 PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
   PetscScalar       *x, d, sum, *t, scale;
   const MatScalar   *v, *idiag = NULL, *mdiag, *aa;
-  const PetscScalar *b, *bs, *xb, *ts;
+  const PetscScalar *b, *bs, *ts;
   PetscInt           n, m = A->rmap->n, i;
   const PetscInt    *idx, *diag;
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) {
+    PetscCall(MatSOR_SeqAIJ_Multicolor(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (a->delta.use && !(flag & SOR_EISENSTAT) && flag != SOR_APPLY_UPPER && flag != SOR_APPLY_LOWER) {
+    PetscCall(MatSOR_SeqAIJ_Delta(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     PetscCall(MatSOR_SeqAIJ_Inode(A, bb, omega, flag, fshift, its, lits, xx));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -2019,82 +2066,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
     PetscCall(VecRestoreArrayRead(bb, &b));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
-  if (flag & SOR_ZERO_INITIAL_GUESS) {
-    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
-      for (i = 0; i < m; i++) {
-        n   = diag[i] - a->i[i];
-        idx = a->j + a->i[i];
-        v   = aa + a->i[i];
-        sum = b[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        t[i] = sum;
-        x[i] = sum * idiag[i];
-      }
-      xb = t;
-      PetscCall(PetscLogFlops(a->nz));
-    } else xb = b;
-    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
-      for (i = m - 1; i >= 0; i--) {
-        n   = a->i[i + 1] - diag[i] - 1;
-        idx = a->j + diag[i] + 1;
-        v   = aa + diag[i] + 1;
-        sum = xb[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        if (xb == b) {
-          x[i] = sum * idiag[i];
-        } else {
-          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-        }
-      }
-      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
-    }
-    its--;
-  }
-  while (its--) {
-    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
-      for (i = 0; i < m; i++) {
-        /* lower */
-        n   = diag[i] - a->i[i];
-        idx = a->j + a->i[i];
-        v   = aa + a->i[i];
-        sum = b[i];
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        t[i] = sum; /* save application of the lower-triangular part */
-        /* upper */
-        n   = a->i[i + 1] - diag[i] - 1;
-        idx = a->j + diag[i] + 1;
-        v   = aa + diag[i] + 1;
-        PetscSparseDenseMinusDot(sum, x, v, idx, n);
-        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-      }
-      xb = t;
-      PetscCall(PetscLogFlops(2.0 * a->nz));
-    } else xb = b;
-    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
-      for (i = m - 1; i >= 0; i--) {
-        sum = xb[i];
-        if (xb == b) {
-          /* whole matrix (no checkpointing available) */
-          n   = a->i[i + 1] - a->i[i];
-          idx = a->j + a->i[i];
-          v   = aa + a->i[i];
-          PetscSparseDenseMinusDot(sum, x, v, idx, n);
-          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
-        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
-          n   = a->i[i + 1] - diag[i] - 1;
-          idx = a->j + diag[i] + 1;
-          v   = aa + diag[i] + 1;
-          PetscSparseDenseMinusDot(sum, x, v, idx, n);
-          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
-        }
-      }
-      if (xb == b) {
-        PetscCall(PetscLogFlops(2.0 * a->nz));
-      } else {
-        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
-      }
-    }
-  }
+  MatSeqAIJSORLocalSweeps_Private(a, m, flag, its, omega, b, x, MatSeqAIJMinusDot_Private);
   PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
   PetscCall(VecRestoreArray(xx, &x));
   PetscCall(VecRestoreArrayRead(bb, &b));
@@ -3885,7 +3857,9 @@ PetscErrorCode MatRetrieveValues(Mat mat)
 
   Options Database Keys:
 + -mat_no_inode            - Do not use inodes
-- -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_aij_threads         - Use OpenMP threads in `MatMult()`, `MatMultAdd()`, `MatMultTranspose()` and `MatSetValuesCOO()`, requires PETSc configured with OpenMP
+- -mat_aij_delta_indices   - Encode the column indices as 16-bit deltas for `MatMult()`, `MatMultAdd()` and `MatSOR()`, these then do not use the inodes
 
   Level: intermediate
 
@@ -3936,7 +3910,9 @@ PetscErrorCode MatCreateSeqAIJ(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt n
 
   Options Database Keys:
 + -mat_no_inode            - Do not use inodes
-- -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_inode_limit <limit> - Sets inode limit (max limit=5)
+. -mat_aij_threads         - Use OpenMP threads in `MatMult()`, `MatMultAdd()`, `MatMultTranspose()` and `MatSetValuesCOO()`, requires PETSc configured with OpenMP
+- -mat_aij_delta_indices   - Encode the column indices as 16-bit deltas for `MatMult()`, `MatMultAdd()` and `MatSOR()`, these then do not use the inodes
 
   Level: intermediate
 
@@ -4369,7 +4345,7 @@ M*/
   Level: beginner
 
    Note:
-   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
+   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJSINGLE`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
    enough exist.
 
 .seealso: [](ch_matrices), `Mat`, `MatCreateAIJ()`, `MatCreateSeqAIJ()`, `MATSEQAIJ`, `MATMPIAIJ`, `MATSELL`, `MATSEQSELL`, `MATMPISELL`
@@ -4868,6 +4844,13 @@ static PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A, const PetscScalar v[], Inser
   perm = coo->perm;
   jmap = coo->jmap;
   PetscCall(MatSeqAIJGetArray(A, &Aa));
+#if defined(PETSC_HAVE_OPENMP)
+  if (aseq->threads.use) {
+    MatSeqAIJThreadsSumCOO(Annz, jmap, perm, NULL, v, imode == INSERT_VALUES ? PETSC_TRUE : PETSC_FALSE, Aa);
+    PetscCall(MatSeqAIJRestoreArray(A, &Aa));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
   for (i = 0; i < Annz; i++) {
     PetscScalar sum = 0.0;
     for (j = jmap[i]; j < jmap[i + 1]; j++) sum += v[perm[j]];
@@ -4934,6 +4917,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqbaij_C", MatConvert_SeqAIJ_SeqBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijperm_C", MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsell_C", MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsingle_C", MatConvert_SeqAIJ_SeqAIJSingle));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmkl_C", MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -4977,6 +4961,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetPreallocationCOO_C", MatSetPreallocationCOO_SeqAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetValuesCOO_C", MatSetValuesCOO_SeqAIJ));
   PetscCall(MatCreate_SeqAIJ_Inode(B));
+  PetscCall(MatCreate_SeqAIJ_Threads(B));
+  PetscCall(MatCreate_SeqAIJ_Delta(B));
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
   PetscCall(MatSeqAIJSetTypeFromOptions(B)); /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -5074,6 +5060,8 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C, Mat A, MatDuplicateOption cpva
     C->nonzerostate  = A->nonzerostate;
 
     PetscCall(MatDuplicate_SeqAIJ_Inode(A, cpvalues, &C));
+    PetscCall(MatDuplicate_SeqAIJ_Threads(A, C));
+    PetscCall(MatDuplicate_SeqAIJ_Delta(A, C));
   }
   PetscCall(PetscFunctionListDuplicate(((PetscObject)A)->qlist, &((PetscObject)C)->qlist));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -5584,6 +5572,7 @@ PetscErrorCode MatSeqAIJRegisterAll(void)
   PetscCall(MatSeqAIJRegister(MATSEQAIJCRL, MatConvert_SeqAIJ_SeqAIJCRL));
   PetscCall(MatSeqAIJRegister(MATSEQAIJPERM, MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(MatSeqAIJRegister(MATSEQAIJSELL, MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJSINGLE, MatConvert_SeqAIJ_SeqAIJSingle));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatSeqAIJRegister(MATSEQAIJMKL, MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -92,6 +92,22 @@ typedef struct { /* used by MatTransposeMatMult() */
   PetscErrorCode (*destroy)(void *);
 } Mat_MatTransMatMult;
 
+typedef struct { /* used by the threaded MatMatMult(), composed with C */
+  PetscInt     nt;     /* number of threads */
+  PetscInt    *rstart; /* thread t computes rows [rstart[t], rstart[t+1]) of C */
+  PetscInt     mask;   /* size of the hash accumulators minus one, -1 if the accumulators are dense */
+  PetscInt     size;   /* length of the accumulator of each thread */
+  PetscInt     lsize;  /* length of the list of used slots of each thread */
+  PetscInt    *keys;   /* column stored in each slot of the accumulators, -1 if the slot is empty */
+  PetscInt    *slots;  /* slots used by the current row of each thread */
+  PetscScalar *vals;   /* values of the accumulators */
+} Mat_MatMatMultThreads;
+
+typedef struct { /* used by the threaded MatPtAP() */
+  Mat Pt; /* transpose of P */
+  Mat AP; /* A*P */
+} Mat_PtAPThreads;
+
 typedef struct {
   PetscInt    *api, *apj; /* symbolic structure of A*P */
   PetscScalar *apa;       /* temporary array for storing one row of A*P */
@@ -134,6 +150,102 @@ typedef struct {
   PetscObjectState mat_nonzerostate; /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Level schedule of the triangular solves with a factored matrix, see aijthreads.c */
+typedef struct {
+  PetscBool    valid;      /* the levels were computed for the current nonzero structure of the factor, reset by the symbolic factorizations */
+  PetscInt     nlevels[2]; /* number of levels of the forward (0) and backward (1) substitutions */
+  PetscInt    *lstart[2];  /* rows lrows[s][lstart[s][l]], ..., lrows[s][lstart[s][l + 1] - 1] of level l of substitution s only depend on rows of lower levels */
+  PetscInt    *lrows[2];
+  PetscInt    *tstart;     /* Cholesky factors: the off-diagonal nonzeros of column k of U are tpos[tstart[k]], ..., tpos[tstart[k + 1] - 1] */
+  PetscInt    *tpos;
+  PetscInt    *trow;       /* Cholesky factors: trow[t] is the row of the nonzero tpos[t] */
+  PetscScalar *work;       /* Cholesky factors: result of the forward substitution before the scaling by the inverse diagonal */
+} Mat_SeqAIJ_Levels;
+
+/* Info about the OpenMP threaded kernels of SeqAIJ, see aijthreads.c */
+typedef struct {
+  PetscBool        use;          /* use the threaded MatMult(), MatMultAdd(), MatMultTranspose() and MatSetValuesCOO(), set with -mat_aij_threads */
+  PetscInt         nthreads;     /* number of threads the partitions below were computed for */
+  PetscInt        *rstart;       /* thread t handles rows [rstart[t], rstart[t+1]), of the compressed rows if compressedrow.use */
+  PetscInt        *nstart;       /* thread t handles inodes [nstart[t], nstart[t+1]) */
+  PetscInt        *nrow;         /* nrow[t] is the first row of inode nstart[t] */
+  PetscScalar     *work;         /* private slices of the result of MatMultTranspose(), one per thread */
+  PetscInt         worksize;     /* length of work */
+  PetscObjectState nonzerostate; /* nonzero state when the partitions were computed, -1 if they are out of date */
+
+  /* multicolor ordering used by MatSOR() with SOR_MULTICOLOR */
+  PetscInt         ncolors;       /* number of colors */
+  PetscInt        *cstart;        /* rows crows[cstart[c]], ..., crows[cstart[c+1]-1] have color c */
+  PetscInt        *crows;         /* rows sorted by color */
+  PetscObjectState cnonzerostate; /* nonzero state when the coloring was computed, -1 if it is out of date */
+
+  /* level schedule used by MatSolve() and MatMatSolve() of LU and ILU factors */
+  Mat_SeqAIJ_Levels levels;
+
+  /* Jacobi sweeps used by MatSolve() of ILU factors computed with MatFactorInfo.solvesweeps > 0 */
+  PetscInt     solvesweeps; /* number of Jacobi sweeps of each triangular solve, 0 for exact triangular solves */
+  PetscScalar *sweepwork;   /* three work vectors of the sweeps */
+} Mat_SeqAIJ_Threads;
+
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Threads(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Threads(Mat, PetscViewer);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJThreadsSetUp(Mat);
+PETSC_INTERN void           MatSeqAIJThreadsSplit(PetscInt, const PetscInt64[], PetscInt, PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsReset(Mat_SeqAIJ_Levels *);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpLevels_LU(Mat);
+PETSC_INTERN PetscErrorCode MatSeqSBAIJSetUpLevels_Cholesky(Mat);
+PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Sweeps(Mat, Mat, const MatFactorInfo *);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Sweeps(Mat, Vec, Vec);
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Threads(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat, Vec, Vec, Vec);
+PETSC_INTERN void           MatSeqAIJThreadsSumCOO(PetscCount, const PetscCount[], const PetscCount[], const PetscCount[], const PetscScalar[], PetscBool, PetscScalar[]);
+PETSC_INTERN void           MatSeqAIJThreadsGatherCOO(PetscCount, const PetscCount[], const PetscScalar[], PetscScalar[]);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Threads(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMatSolve_SeqAIJ_Threads(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1_Threads(Mat, Vec, Vec);
+#endif
+
+/* Supernodes of a LU or Cholesky factor, see aijsupernodal.c */
+typedef struct {
+  PetscInt  n;     /* number of supernodes, 0 if the factorization is not supernodal */
+  PetscInt *start; /* supernode s is made of the rows start[s], ..., start[s + 1] - 1 of the factor, the strictly upper part of each row is the next rows of the supernode followed by the same columns */
+  PetscInt  maxns; /* largest number of rows of a supernode */
+  PetscInt  maxnr; /* largest number of columns of U to the right of a supernode */
+} Mat_SeqAIJ_Supernodes;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJSupernodesReset(Mat_SeqAIJ_Supernodes *);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpSupernodes_LU(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSeqSBAIJSetUpSupernodes_Cholesky(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJSetUpSolve_LU(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSeqSBAIJSetUpSolve_Cholesky(Mat, Mat);
+
+/* Info about the column indices of SeqAIJ encoded as 16-bit deltas, see aijdelta.c */
+#define MAT_SEQAIJ_DELTA_BLOCK 64 /* rows are encoded, or not, by blocks of this many rows */
+typedef struct {
+  PetscBool        use;          /* use the encoded indices in MatMult(), MatMultAdd() and MatSOR(), set with -mat_aij_delta_indices */
+  PetscInt        *base;         /* base[i] is the smallest column of row i, if its block is encoded */
+  unsigned short  *delta;        /* delta[k] = j[k] - base[i] for the nonzeros k of the rows i of the encoded blocks */
+  PetscBool       *encoded;      /* encoded[b] tells if the rows of block b are encoded, each of them must span at most 65536 columns */
+  PetscInt         nzencoded;    /* number of nonzeros in the encoded blocks */
+  PetscObjectState nonzerostate; /* nonzero state when the indices were encoded, -1 if they are out of date */
+} Mat_SeqAIJ_Delta;
+
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Delta(Mat);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Delta(Mat);
+PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Delta(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Delta(Mat, PetscViewer);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Delta(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJDeltaSetUp(Mat);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Delta(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Delta(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Delta(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat, MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -147,8 +259,11 @@ PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat, PetscScalar **);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
-  Mat_SeqAIJ_Inode inode;
-  MatScalar       *saved_values; /* location for stashing nonzero values of matrix */
+  Mat_SeqAIJ_Inode   inode;
+  Mat_SeqAIJ_Threads    threads;
+  Mat_SeqAIJ_Delta      delta;
+  Mat_SeqAIJ_Supernodes supernodes;   /* supernodes of LU factors, used by the supernodal numeric factorization */
+  MatScalar            *saved_values; /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag, *mdiag, *ssor_work; /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
   PetscBool    idiagvalid;                /* current idiag[] and mdiag[] are valid */
@@ -308,6 +423,7 @@ PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Inode(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat, PetscScalar, PetscScalar);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat, MatOption, PetscBool);
 
@@ -360,6 +476,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat, Mat, Pets
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat, Mat, PetscReal, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads(Mat, Mat, PetscReal, Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat, Mat, PetscReal, Mat);
 #endif
@@ -369,10 +486,13 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat, Mat, Mat
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat, Mat, Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threads(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat, Mat, Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Threads(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ(Mat, Mat, PetscReal, Mat);
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ_matmattransposemult(Mat, Mat, PetscReal, Mat);
@@ -433,6 +553,7 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat, MatType, MatReuse, Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat, PetscReal, IS, IS);
@@ -679,3 +800,77 @@ static inline void PetscSparseDensePlusDot_AVX512_Private(PetscScalar *sum, cons
       } \
     } \
   } while (0)
+
+/*
+  The local forward and backward sweeps of MatSOR_SeqAIJ() with a nonzero pattern a, on the m rows of x and b, with its = its * lits.
+  The inverted diagonal must be up to date. MinusDot(sum, row, start, end) subtracts from sum the product of the entries start to end
+  of row with x, so that the variants that store the column indices or the values differently share the sweeps.
+*/
+#define MatSeqAIJSORLocalSweeps_Private(a, m, flag, its, omega, b, x, MinusDot) \
+  do { \
+    const PetscInt    *_ai = (a)->i, *_diag = (a)->diag; \
+    const MatScalar   *_idiag = (a)->idiag, *_mdiag = (a)->mdiag; \
+    PetscScalar       *_t     = (a)->ssor_work, _sum; \
+    const PetscScalar *_xb; \
+    PetscInt           _its = (its); \
+\
+    /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */ \
+    if ((flag) & SOR_ZERO_INITIAL_GUESS) { \
+      if ((flag) & SOR_FORWARD_SWEEP || (flag) & SOR_LOCAL_FORWARD_SWEEP) { \
+        for (PetscInt _i = 0; _i < (m); _i++) { \
+          _sum = (b)[_i]; \
+          MinusDot(_sum, _i, _ai[_i], _diag[_i]); \
+          _t[_i]  = _sum; \
+          (x)[_i] = _sum * _idiag[_i]; \
+        } \
+        _xb = _t; \
+        PetscCall(PetscLogFlops((a)->nz)); \
+      } else _xb = (b); \
+      if ((flag) & SOR_BACKWARD_SWEEP || (flag) & SOR_LOCAL_BACKWARD_SWEEP) { \
+        for (PetscInt _i = (m) - 1; _i >= 0; _i--) { \
+          _sum = _xb[_i]; \
+          MinusDot(_sum, _i, _diag[_i] + 1, _ai[_i + 1]); \
+          if (_xb == (b)) { \
+            (x)[_i] = _sum * _idiag[_i]; \
+          } else { \
+            (x)[_i] = (1 - (omega)) * (x)[_i] + _sum * _idiag[_i]; /* omega in idiag */ \
+          } \
+        } \
+        PetscCall(PetscLogFlops((a)->nz)); /* assumes 1/2 in upper */ \
+      } \
+      _its--; \
+    } \
+    while (_its--) { \
+      if ((flag) & SOR_FORWARD_SWEEP || (flag) & SOR_LOCAL_FORWARD_SWEEP) { \
+        for (PetscInt _i = 0; _i < (m); _i++) { \
+          /* lower */ \
+          _sum = (b)[_i]; \
+          MinusDot(_sum, _i, _ai[_i], _diag[_i]); \
+          _t[_i] = _sum; /* save application of the lower-triangular part */ \
+          /* upper */ \
+          MinusDot(_sum, _i, _diag[_i] + 1, _ai[_i + 1]); \
+          (x)[_i] = (1. - (omega)) * (x)[_i] + _sum * _idiag[_i]; /* omega in idiag */ \
+        } \
+        _xb = _t; \
+        PetscCall(PetscLogFlops(2.0 * (a)->nz)); \
+      } else _xb = (b); \
+      if ((flag) & SOR_BACKWARD_SWEEP || (flag) & SOR_LOCAL_BACKWARD_SWEEP) { \
+        for (PetscInt _i = (m) - 1; _i >= 0; _i--) { \
+          _sum = _xb[_i]; \
+          if (_xb == (b)) { \
+            /* whole matrix (no checkpointing available) */ \
+            MinusDot(_sum, _i, _ai[_i], _ai[_i + 1]); \
+            (x)[_i] = (1. - (omega)) * (x)[_i] + (_sum + _mdiag[_i] * (x)[_i]) * _idiag[_i]; \
+          } else { /* lower-triangular part has been saved, so only apply upper-triangular */ \
+            MinusDot(_sum, _i, _diag[_i] + 1, _ai[_i + 1]); \
+            (x)[_i] = (1. - (omega)) * (x)[_i] + _sum * _idiag[_i]; /* omega in idiag */ \
+          } \
+        } \
+        if (_xb == (b)) { \
+          PetscCall(PetscLogFlops(2.0 * (a)->nz)); \
+        } else { \
+          PetscCall(PetscLogFlops((a)->nz)); /* assumes 1/2 in upper */ \
+        } \
+      } \
+    } \
+  } while (0)
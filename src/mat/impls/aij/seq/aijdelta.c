@@ -0,0 +1,293 @@
+/*
+  MatMult(), MatMultAdd() and MatSOR() for MATSEQAIJ with the column indices encoded as 16-bit deltas.
+
+  The rows are grouped in blocks of MAT_SEQAIJ_DELTA_BLOCK rows. A block is encoded when each of its rows spans at most
+  65536 columns; the column j[k] of a nonzero of row i is then stored as delta[k] = j[k] - base[i], where base[i] is the
+  smallest column of the row, and the kernels read x + base[i] at the offsets delta[k]. The other blocks keep using j[].
+  The kernels read 2 bytes of index per nonzero instead of sizeof(PetscInt).
+
+  The indices are encoded at the end of the assemblies that change the nonzero structure, and j[] is kept for all the
+  other operations.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_SKIP_IMMINTRIN_H_CUDAWORKAROUND)
+  #define MAT_SEQAIJ_DELTA_AVX512
+  #include <immintrin.h>
+#endif
+
+PetscErrorCode MatCreate_SeqAIJ_Delta(Mat B)
+{
+  Mat_SeqAIJ *b = (Mat_SeqAIJ *)B->data;
+
+  PetscFunctionBegin;
+  b->delta.use          = PETSC_FALSE;
+  b->delta.base         = NULL;
+  b->delta.delta        = NULL;
+  b->delta.encoded      = NULL;
+  b->delta.nzencoded    = 0;
+  b->delta.nonzerostate = -1;
+
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsBool("-mat_aij_delta_indices", "Encode the column indices as 16-bit deltas for MatMult(), MatMultAdd() and MatSOR()", NULL, b->delta.use, &b->delta.use, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Delta(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(a->delta.base, a->delta.encoded));
+  PetscCall(PetscFree(a->delta.delta));
+  a->delta.nzencoded    = 0;
+  a->delta.nonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The encoded indices are not copied, C encodes its own the first time they are used */
+PetscErrorCode MatDuplicate_SeqAIJ_Delta(Mat A, Mat C)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data, *c = (Mat_SeqAIJ *)C->data;
+
+  PetscFunctionBegin;
+  c->delta.use          = a->delta.use;
+  c->delta.nonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatView_SeqAIJ_Delta(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ *)A->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->delta.use || a->delta.nonzerostate != A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerGetFormat(viewer, &format));
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL || format == PETSC_VIEWER_ASCII_INFO) PetscCall(PetscViewerASCIIPrintf(viewer, "using 16-bit delta column indices for %" PetscInt_FMT " of %" PetscInt_FMT " nonzeros\n", a->delta.nzencoded, a->nz));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The nonzero structure is final, encode it now rather than in the first MatMult() */
+PetscErrorCode MatAssemblyEnd_SeqAIJ_Delta(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (a->delta.use) PetscCall(MatSeqAIJDeltaSetUp(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJDeltaSetUp - encodes the column indices of the blocks of rows that can be encoded
+
+   The encoding is kept until the nonzero structure changes
+*/
+PetscErrorCode MatSeqAIJDeltaSetUp(Mat A)
+{
+  Mat_SeqAIJ     *a  = (Mat_SeqAIJ *)A->data;
+  const PetscInt  m  = A->rmap->n, nb = (m + MAT_SEQAIJ_DELTA_BLOCK - 1) / MAT_SEQAIJ_DELTA_BLOCK;
+  const PetscInt *ai = a->i, *aj = a->j;
+  PetscInt        nbencoded = 0;
+
+  PetscFunctionBegin;
+  if (a->delta.nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatDestroy_SeqAIJ_Delta(A));
+  PetscCall(PetscMalloc2(m, &a->delta.base, nb, &a->delta.encoded));
+  for (PetscInt b = 0; b < nb; b++) {
+    const PetscInt rend = PetscMin(m, (b + 1) * MAT_SEQAIJ_DELTA_BLOCK);
+    PetscBool      fits = PETSC_TRUE;
+
+    for (PetscInt i = b * MAT_SEQAIJ_DELTA_BLOCK; i < rend; i++) {
+      PetscInt lo = PETSC_INT_MAX, hi = 0;
+
+      for (PetscInt k = ai[i]; k < ai[i + 1]; k++) {
+        lo = PetscMin(lo, aj[k]);
+        hi = PetscMax(hi, aj[k]);
+      }
+      a->delta.base[i] = ai[i + 1] > ai[i] ? lo : 0;
+      if (ai[i + 1] > ai[i] && hi - lo > 65535) fits = PETSC_FALSE;
+    }
+    a->delta.encoded[b] = fits;
+    if (fits) {
+      a->delta.nzencoded += ai[rend] - ai[b * MAT_SEQAIJ_DELTA_BLOCK];
+      nbencoded++;
+    }
+  }
+  if (a->delta.nzencoded) {
+    PetscCall(PetscMalloc1(ai[m], &a->delta.delta));
+    for (PetscInt b = 0; b < nb; b++) {
+      if (!a->delta.encoded[b]) continue;
+      for (PetscInt i = b * MAT_SEQAIJ_DELTA_BLOCK; i < PetscMin(m, (b + 1) * MAT_SEQAIJ_DELTA_BLOCK); i++) {
+        for (PetscInt k = ai[i]; k < ai[i + 1]; k++) a->delta.delta[k] = (unsigned short)(aj[k] - a->delta.base[i]);
+      }
+    }
+  }
+  a->delta.nonzerostate = A->nonzerostate;
+  if (a->inode.use && a->inode.size) PetscCall(PetscInfo(A, "Not using the inode MatMult() and MatMultAdd() routines since the column indices are delta encoded\n"));
+  PetscCall(PetscInfo(A, "Encoded %" PetscInt_FMT " of %" PetscInt_FMT " nonzeros, in %" PetscInt_FMT " of %" PetscInt_FMT " blocks of rows, with 16-bit column deltas\n", a->delta.nzencoded, a->nz, nbencoded, nb));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sum_k v[k] x[delta[k]] */
+static inline PetscScalar MatSeqAIJDeltaDot_Private(const MatScalar *v, const unsigned short *delta, const PetscScalar *x, PetscInt n)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    k   = 0;
+
+#if defined(MAT_SEQAIJ_DELTA_AVX512)
+  __m512d vec_sum = _mm512_setzero_pd();
+
+  for (; k + 8 <= n; k += 8) {
+    __m256i vec_idx  = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const *)(delta + k)));
+    __m512d vec_x    = _mm512_i32gather_pd(vec_idx, x, 8);
+    __m512d vec_vals = _mm512_loadu_pd(v + k);
+
+    vec_sum = _mm512_fmadd_pd(vec_vals, vec_x, vec_sum);
+  }
+  sum = _mm512_reduce_add_pd(vec_sum);
+#endif
+  for (; k < n; k++) sum += v[k] * x[delta[k]];
+  return sum;
+}
+
+/* sum of aa[k] x[j[k]] for the nonzeros k in [start, end) of row i, with the encoded indices if the block of the row is encoded */
+static inline PetscScalar MatSeqAIJDeltaRowDot_Private(const Mat_SeqAIJ *a, const MatScalar *aa, const PetscScalar *x, PetscInt i, PetscInt start, PetscInt end)
+{
+  PetscScalar      sum = 0.0;
+  const PetscInt   n   = end - start;
+  const PetscInt  *idx = a->j + start;
+  const MatScalar *v   = aa + start;
+
+  if (a->delta.encoded[i / MAT_SEQAIJ_DELTA_BLOCK]) return MatSeqAIJDeltaDot_Private(v, a->delta.delta + start, x + a->delta.base[i], n);
+  PetscSparseDensePlusDot(sum, x, v, idx, n);
+  return sum;
+}
+
+/*
+  The rows (or the compressed rows) split between the threads with -mat_aij_threads, a single chunk otherwise.
+  Returns the number of chunks and their first rows.
+*/
+static PetscErrorCode MatSeqAIJDeltaGetChunks_Private(Mat A, PetscInt rstart1[2], PetscInt *nt, const PetscInt *rstart[])
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  rstart1[0] = 0;
+  rstart1[1] = a->compressedrow.use ? a->compressedrow.nrows : A->rmap->n;
+  *nt        = 1;
+  *rstart    = rstart1;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    PetscCall(MatSeqAIJThreadsSetUp(A));
+    *nt     = a->threads.nthreads;
+    *rstart = a->threads.rstart;
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMult_SeqAIJ_Delta(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  const PetscInt     m = A->rmap->n, *ii = a->i, *ridx = NULL, *rstart;
+  PetscInt           nt, rstart1[2];
+  const PetscBool    usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDeltaSetUp(A));
+  PetscCall(MatSeqAIJDeltaGetChunks_Private(A, rstart1, &nt, &rstart));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (usecprow) {
+    PetscCall(PetscArrayzero(y, m));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1) if (nt > 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt row = usecprow ? ridx[i] : i;
+
+      y[row] = MatSeqAIJDeltaRowDot_Private(a, aa, x, row, ii[i], ii[i + 1]);
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_Delta(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  const PetscInt     m = A->rmap->n, *ii = a->i, *ridx = NULL, *rstart;
+  PetscInt           nt, rstart1[2];
+  const PetscBool    usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDeltaSetUp(A));
+  PetscCall(MatSeqAIJDeltaGetChunks_Private(A, rstart1, &nt, &rstart));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (usecprow) {
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, m));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1) if (nt > 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt row = usecprow ? ridx[i] : i;
+
+      z[row] = y[row] + MatSeqAIJDeltaRowDot_Private(a, aa, x, row, ii[i], ii[i + 1]);
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#define MatSeqAIJDeltaMinusDot_Private(sum, row, start, end) sum -= MatSeqAIJDeltaRowDot_Private(a, aa, x, row, start, end)
+
+/* The local sweeps of MatSOR_SeqAIJ(), which handles SOR_EISENSTAT, SOR_APPLY_UPPER and SOR_MULTICOLOR itself */
+PetscErrorCode MatSOR_SeqAIJ_Delta(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *x;
+  const MatScalar   *aa;
+  const PetscScalar *b;
+  const PetscInt     m = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDeltaSetUp(A));
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  MatSeqAIJSORLocalSweeps_Private(a, m, flag, its * lits, omega, b, x, MatSeqAIJDeltaMinusDot_Private);
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
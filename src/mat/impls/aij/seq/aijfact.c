@@ -432,7 +432,9 @@ PetscErrorCode MatLUFactorSymbolic_SeqAIJ(Mat B, Mat A, IS isrow, IS iscol, cons
 #endif
   B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ;
   if (a->inode.size) B->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
+  PetscCall(MatSeqAIJLevelsReset(&b->threads.levels));
   PetscCall(MatSeqAIJCheckInode_FactorLU(B));
+  PetscCall(MatSeqAIJSetUpSupernodes_LU(B, A));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -457,6 +459,38 @@ PetscErrorCode MatFactorDumpMatrix(Mat A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Sets the triangular solves of the LU or ILU factor fact of A once its numeric factorization is computed */
+PetscErrorCode MatSeqAIJSetUpSolve_LU(Mat fact, Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)fact->data;
+  PetscBool   row_identity, col_identity;
+
+  PetscFunctionBegin;
+  PetscCall(ISIdentity(b->row, &row_identity));
+  PetscCall(ISIdentity(b->icol, &col_identity));
+  if (b->inode.size) {
+    fact->ops->solve = MatSolve_SeqAIJ_Inode;
+  } else if (row_identity && col_identity) {
+    fact->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+  } else {
+    fact->ops->solve = MatSolve_SeqAIJ;
+  }
+  fact->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  fact->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  fact->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  fact->ops->matsolve          = MatMatSolve_SeqAIJ;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use && PetscNumOMPThreads > 1) {
+    PetscCall(MatSeqAIJSetUpLevels_LU(fact));
+    fact->ops->solve    = MatSolve_SeqAIJ_Threads;
+    fact->ops->matsolve = MatMatSolve_SeqAIJ_Threads;
+  }
+#else
+  (void)a;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info)
 {
   Mat              C = B;
@@ -468,7 +502,6 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   const PetscInt  *ajtmp, *bjtmp;
   MatScalar       *rtmp, *pc, multiplier, *pv;
   const MatScalar *aa = a->a, *v;
-  PetscBool        row_identity, col_identity;
   FactorShiftCtx   sctx;
   const PetscInt  *ddiag;
   PetscReal        rs;
@@ -594,21 +627,9 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   PetscCall(ISRestoreIndices(isicol, &ic));
   PetscCall(ISRestoreIndices(isrow, &r));
 
-  PetscCall(ISIdentity(isrow, &row_identity));
-  PetscCall(ISIdentity(isicol, &col_identity));
-  if (b->inode.size) {
-    C->ops->solve = MatSolve_SeqAIJ_Inode;
-  } else if (row_identity && col_identity) {
-    C->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
-  } else {
-    C->ops->solve = MatSolve_SeqAIJ;
-  }
-  C->ops->solveadd          = MatSolveAdd_SeqAIJ;
-  C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
-  C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
-  C->ops->matsolve          = MatMatSolve_SeqAIJ;
-  C->assembled              = PETSC_TRUE;
-  C->preallocated           = PETSC_TRUE;
+  PetscCall(MatSeqAIJSetUpSolve_LU(C, A));
+  C->assembled    = PETSC_TRUE;
+  C->preallocated = PETSC_TRUE;
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -1644,6 +1665,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat fact, Mat A, IS isrow, IS is
   fact->info.fill_ratio_needed = 1.0;
   fact->ops->lufactornumeric   = MatLUFactorNumeric_SeqAIJ;
   PetscCall(MatSeqAIJCheckInode_FactorLU(fact));
+  PetscCall(MatSeqAIJLevelsReset(&b->threads.levels));
 
   b       = (Mat_SeqAIJ *)(fact)->data;
   b->row  = isrow;
@@ -1684,6 +1706,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol,
     /* special case: ilu(0) with natural ordering */
     PetscCall(MatILUFactorSymbolic_SeqAIJ_ilu0(fact, A, isrow, iscol, info));
     if (a->inode.size) fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
+    if (info->factorsweeps > 0 || info->solvesweeps > 0) fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Sweeps;
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
@@ -1819,6 +1842,8 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS isrow, IS iscol,
   (fact)->info.fill_ratio_needed = ((PetscReal)(bdiag[0] + 1)) / ((PetscReal)ai[n]);
   (fact)->ops->lufactornumeric   = MatLUFactorNumeric_SeqAIJ;
   if (a->inode.size) (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
+  if (info->factorsweeps > 0 || info->solvesweeps > 0) (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Sweeps;
+  PetscCall(MatSeqAIJLevelsReset(&b->threads.levels));
   PetscCall(MatSeqAIJCheckInode_FactorLU(fact));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2012,6 +2037,38 @@ static PetscErrorCode MatILUFactorSymbolic_SeqAIJ_inplace(Mat fact, Mat A, IS is
 }
 #endif
 
+/* Sets the triangular solves of the Cholesky factor fact of A once its numeric factorization is computed */
+PetscErrorCode MatSeqSBAIJSetUpSolve_Cholesky(Mat fact, Mat A)
+{
+  Mat_SeqAIJ   *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqSBAIJ *b = (Mat_SeqSBAIJ *)fact->data;
+  PetscBool     perm_identity;
+
+  PetscFunctionBegin;
+  PetscCall(ISIdentity(b->row, &perm_identity));
+  if (perm_identity) {
+    fact->ops->solve          = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+    fact->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+    fact->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1_NaturalOrdering;
+    fact->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1_NaturalOrdering;
+  } else {
+    fact->ops->solve          = MatSolve_SeqSBAIJ_1;
+    fact->ops->solvetranspose = MatSolve_SeqSBAIJ_1;
+    fact->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
+    fact->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
+  }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use && PetscNumOMPThreads > 1) {
+    PetscCall(MatSeqSBAIJSetUpLevels_Cholesky(fact));
+    fact->ops->solve          = MatSolve_SeqSBAIJ_1_Threads;
+    fact->ops->solvetranspose = MatSolve_SeqSBAIJ_1_Threads;
+  }
+#else
+  (void)a;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info)
 {
   Mat             C  = B;
@@ -2023,7 +2080,6 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo
   PetscInt       *ai = a->i, *aj = a->j;
   PetscInt        k, jmin, jmax, *c2r, *il, col, nexti, ili, nz;
   MatScalar      *rtmp, *ba = b->a, *bval, *aa = a->a, dk, uikdi;
-  PetscBool       perm_identity;
   FactorShiftCtx  sctx;
   PetscReal       rs;
   MatScalar       d, *v;
@@ -2143,19 +2199,7 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo
   PetscCall(ISRestoreIndices(ip, &rip));
   PetscCall(ISRestoreIndices(iip, &riip));
 
-  PetscCall(ISIdentity(ip, &perm_identity));
-  if (perm_identity) {
-    B->ops->solve          = MatSolve_SeqSBAIJ_1_NaturalOrdering;
-    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
-    B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1_NaturalOrdering;
-    B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1_NaturalOrdering;
-  } else {
-    B->ops->solve          = MatSolve_SeqSBAIJ_1;
-    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1;
-    B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
-    B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
-  }
-
+  PetscCall(MatSeqSBAIJSetUpSolve_Cholesky(B, A));
   C->assembled    = PETSC_TRUE;
   C->preallocated = PETSC_TRUE;
 
@@ -2551,6 +2595,7 @@ PetscErrorCode MatICCFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS perm, const MatFa
   }
 #endif
   fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ;
+  PetscCall(MatSeqAIJLevelsReset(&b->levels));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -2928,6 +2973,8 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact, Mat A, IS perm, const
   }
 #endif
   fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ;
+  PetscCall(MatSeqAIJLevelsReset(&b->levels));
+  PetscCall(MatSeqSBAIJSetUpSupernodes_Cholesky(fact, A));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
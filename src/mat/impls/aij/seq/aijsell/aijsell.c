@@ -11,9 +11,23 @@
 typedef struct {
   Mat              S; /* The SELL formatted "shadow" matrix. */
   PetscBool        eager_shadow;
-  PetscObjectState state; /* State of the matrix when shadow matrix was last constructed. */
+  PetscObjectState state;        /* State of the matrix when shadow matrix was last constructed. */
+  PetscObjectState nonzerostate; /* Nonzero state of the matrix when the nonzero pattern of the shadow matrix was last constructed. */
+  PetscInt         sliceheight;  /* Slice height of the shadow matrix. */
+  PetscInt         sigma;        /* Rows are sorted by length within windows of sigma rows, PETSC_DECIDE for an automatic choice, 1 for no sorting. */
+  PetscInt        *perm;         /* Row i of the shadow matrix is row perm[i] of the matrix, NULL if the rows are not sorted. */
+  Vec              work;         /* Work vector in the row ordering of the shadow matrix. */
 } Mat_SeqAIJSELL;
 
+static PetscErrorCode MatSeqAIJSELLDestroyShadow_Private(Mat_SeqAIJSELL *aijsell)
+{
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&aijsell->S));
+  PetscCall(PetscFree(aijsell->perm));
+  PetscCall(VecDestroy(&aijsell->work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSELL_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
 {
   /* This routine is only called to convert a MATAIJSELL to its base PETSc type, */
@@ -40,7 +54,7 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSELL_SeqAIJ(Mat A, MatType type, Ma
 
   /* Clean up the Mat_SeqAIJSELL data structure.
    * Note that MatDestroy() simply returns if passed a NULL value, so it's OK to call even if the shadow matrix was never constructed. */
-  PetscCall(MatDestroy(&aijsell->S));
+  PetscCall(MatSeqAIJSELLDestroyShadow_Private(aijsell));
   PetscCall(PetscFree(B->spptr));
 
   /* Change the type of B to MATSEQAIJ. */
@@ -59,7 +73,7 @@ static PetscErrorCode MatDestroy_SeqAIJSELL(Mat A)
    * spptr pointer. */
   if (aijsell) {
     /* Clean up everything in the Mat_SeqAIJSELL data structure, then free A->spptr. */
-    PetscCall(MatDestroy(&aijsell->S));
+    PetscCall(MatSeqAIJSELLDestroyShadow_Private(aijsell));
     PetscCall(PetscFree(A->spptr));
   }
 
@@ -74,12 +88,144 @@ static PetscErrorCode MatDestroy_SeqAIJSELL(Mat A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Sorts the rows by decreasing length within windows of sigma rows, a multiple of the slice height, so that rows of similar lengths
+  share the slices (SELL-C-sigma), and returns the number of entries of the slices including the padding
+*/
+static PetscErrorCode MatSeqAIJSELLSortRows_Private(PetscInt m, const PetscInt rlen[], PetscInt sliceheight, PetscInt sigma, PetscInt perm[], PetscInt key[], PetscCount *padded)
+{
+  PetscFunctionBegin;
+  *padded = 0;
+  for (PetscInt i = 0; i < m; i++) {
+    perm[i] = i;
+    key[i]  = -rlen[i];
+  }
+  for (PetscInt w = 0; w < m; w += sigma) PetscCall(PetscSortIntWithArray(PetscMin(sigma, m - w), key + w, perm + w));
+  for (PetscInt i = 0; i < m; i += sliceheight) {
+    PetscInt width = 0;
+
+    for (PetscInt j = i; j < PetscMin(i + sliceheight, m); j++) width = PetscMax(width, -key[j]);
+    *padded += sliceheight * (PetscCount)width;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Chooses the sorting window sigma. Sorting reduces the padding of the slices, but the rows of the products then have to be permuted,
+  and the larger the window the farther apart the rows of a slice are. No sorting is done when it cannot save a tenth of the storage,
+  otherwise the smallest window that gets nine tenths of the largest saving is used.
+*/
+static PetscErrorCode MatSeqAIJSELLChooseSigma_Private(PetscInt m, const PetscInt rlen[], PetscInt sliceheight, PetscInt *sigma)
+{
+  PetscInt  *perm, *key, nw = 0, sigmas[64];
+  PetscCount unsorted, padded[64], best;
+
+  PetscFunctionBegin;
+  *sigma = 1;
+  if (m <= sliceheight) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc2(m, &perm, m, &key));
+  PetscCall(MatSeqAIJSELLSortRows_Private(m, rlen, sliceheight, 1, perm, key, &unsorted));
+  best = unsorted;
+  for (PetscInt w = 2 * sliceheight; nw < 64; w *= 2) {
+    sigmas[nw] = PetscMin(w, m);
+    PetscCall(MatSeqAIJSELLSortRows_Private(m, rlen, sliceheight, sigmas[nw], perm, key, &padded[nw]));
+    best = PetscMin(best, padded[nw]);
+    nw++;
+    if (w >= m) break;
+  }
+  if (10 * (unsorted - best) >= unsorted) {
+    for (PetscInt k = 0; k < nw; k++) {
+      if (10 * (padded[k] - best) <= unsorted - best) {
+        *sigma = sigmas[k];
+        break;
+      }
+    }
+  }
+  PetscCall(PetscFree2(perm, key));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Creates the shadow matrix with the nonzero pattern of the matrix, with its rows sorted if a sorting window is used */
+static PetscErrorCode MatSeqAIJSELLCreateShadow_Private(Mat A)
+{
+  Mat_SeqAIJ        *a       = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSELL    *aijsell = (Mat_SeqAIJSELL *)A->spptr;
+  PetscInt           m = A->rmap->n, n = A->cmap->n, sigma = aijsell->sigma, *rlen, *key;
+  PetscCount         padded;
+  const PetscScalar *aa;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc2(m, &rlen, m, &key));
+  for (PetscInt i = 0; i < m; i++) rlen[i] = a->i[i + 1] - a->i[i];
+  if (sigma == PETSC_DECIDE) PetscCall(MatSeqAIJSELLChooseSigma_Private(m, rlen, aijsell->sliceheight, &sigma));
+  else if (sigma > 1) sigma = PetscCeilInt(sigma, aijsell->sliceheight) * aijsell->sliceheight;
+  if (sigma > 1) {
+    PetscCall(PetscMalloc1(m, &aijsell->perm));
+    PetscCall(MatSeqAIJSELLSortRows_Private(m, rlen, aijsell->sliceheight, sigma, aijsell->perm, key, &padded));
+    for (PetscInt i = 0; i < m; i++) key[i] = -key[i];
+    PetscCall(VecCreateSeq(PETSC_COMM_SELF, m, &aijsell->work));
+    PetscCall(PetscInfo(A, "Rows of the SELL shadow matrix are sorted by length within windows of %" PetscInt_FMT " rows, %" PetscCount_FMT " entries with the padding for %" PetscInt_FMT " nonzeros\n", sigma, padded, a->nz));
+  } else PetscCall(PetscArraycpy(key, rlen, m));
+
+  PetscCall(MatCreate(PETSC_COMM_SELF, &aijsell->S));
+  PetscCall(MatSetSizes(aijsell->S, m, n, m, n));
+  PetscCall(MatSetType(aijsell->S, MATSEQSELL));
+  PetscCall(MatSeqSELLSetSliceHeight(aijsell->S, aijsell->sliceheight));
+  PetscCall(MatSeqSELLSetPreallocation(aijsell->S, 0, key));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt i = 0; i < m; i++) {
+    PetscInt row = aijsell->perm ? aijsell->perm[i] : i;
+
+    PetscCall(MatSetValues_SeqSELL(aijsell->S, 1, &i, rlen[row], a->j + a->i[row], aa + a->i[row], INSERT_VALUES));
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatAssemblyBegin(aijsell->S, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(aijsell->S, MAT_FINAL_ASSEMBLY));
+  PetscCall(PetscFree2(rlen, key));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Copies the values of the matrix into the shadow matrix, whose nonzero pattern is the same. Returns PETSC_FALSE if the row lengths
+  show that the nonzero pattern changed after all.
+*/
+static PetscErrorCode MatSeqAIJSELLCopyValues_Private(Mat A, PetscBool *copied)
+{
+  Mat_SeqAIJ        *a       = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSELL    *aijsell = (Mat_SeqAIJSELL *)A->spptr;
+  Mat_SeqSELL       *s       = (Mat_SeqSELL *)aijsell->S->data;
+  PetscInt           m = A->rmap->n, sliceheight = s->sliceheight;
+  const PetscInt    *perm = aijsell->perm;
+  const PetscScalar *aa;
+
+  PetscFunctionBegin;
+  *copied = (PetscBool)(s->nz == a->nz);
+  for (PetscInt i = 0; i < m && *copied; i++) {
+    const PetscInt row = perm ? perm[i] : i;
+
+    *copied = (PetscBool)(s->rlen[i] == a->i[row + 1] - a->i[row]);
+  }
+  if (!*copied) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt i = 0; i < m; i++) {
+    const PetscScalar *v   = aa + a->i[perm ? perm[i] : i];
+    MatScalar         *val = s->val + s->sliidx[i / sliceheight] + i % sliceheight;
+
+    for (PetscInt k = 0; k < s->rlen[i]; k++) val[sliceheight * k] = v[k];
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatSeqSELLInvalidateDiagonal(aijsell->S));
+  PetscCall(PetscObjectStateIncrease((PetscObject)aijsell->S));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Build or update the shadow matrix if and only if needed.
- * We track the ObjectState to determine when this needs to be done. */
+ * We track the ObjectState to determine when this needs to be done, and the nonzero state to determine when only the values need updating. */
 PETSC_INTERN PetscErrorCode MatSeqAIJSELL_build_shadow(Mat A)
 {
   Mat_SeqAIJSELL  *aijsell = (Mat_SeqAIJSELL *)A->spptr;
-  PetscObjectState state;
+  PetscObjectState state, nonzerostate;
+  PetscBool        copied = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PetscObjectStateGet((PetscObject)A, &state));
@@ -89,10 +235,13 @@ PETSC_INTERN PetscErrorCode MatSeqAIJSELL_build_shadow(Mat A)
   }
 
   PetscCall(PetscLogEventBegin(MAT_Convert, A, 0, 0, 0));
-  if (aijsell->S) {
-    PetscCall(MatConvert_SeqAIJ_SeqSELL(A, MATSEQSELL, MAT_REUSE_MATRIX, &aijsell->S));
-  } else {
-    PetscCall(MatConvert_SeqAIJ_SeqSELL(A, MATSEQSELL, MAT_INITIAL_MATRIX, &aijsell->S));
+  PetscCall(MatGetNonzeroState(A, &nonzerostate));
+  /* After MatSetValues() into the existing nonzero pattern, the values are copied into the slices, without building them again */
+  if (aijsell->S && aijsell->nonzerostate == nonzerostate) PetscCall(MatSeqAIJSELLCopyValues_Private(A, &copied));
+  if (!copied) {
+    PetscCall(MatSeqAIJSELLDestroyShadow_Private(aijsell));
+    PetscCall(MatSeqAIJSELLCreateShadow_Private(A));
+    aijsell->nonzerostate = nonzerostate;
   }
   PetscCall(PetscLogEventEnd(MAT_Convert, A, 0, 0, 0));
 
@@ -101,6 +250,44 @@ PETSC_INTERN PetscErrorCode MatSeqAIJSELL_build_shadow(Mat A)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* work[i] = x[perm[i]] */
+static PetscErrorCode MatSeqAIJSELLPermuteIn_Private(Mat A, Vec xx)
+{
+  Mat_SeqAIJSELL    *aijsell = (Mat_SeqAIJSELL *)A->spptr;
+  const PetscScalar *x;
+  PetscScalar       *w;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(aijsell->work, &w));
+  for (PetscInt i = 0; i < A->rmap->n; i++) w[i] = x[aijsell->perm[i]];
+  PetscCall(VecRestoreArrayWrite(aijsell->work, &w));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y[perm[i]] = work[i] or y[perm[i]] += work[i] */
+static PetscErrorCode MatSeqAIJSELLPermuteOut_Private(Mat A, Vec yy, InsertMode mode)
+{
+  Mat_SeqAIJSELL    *aijsell = (Mat_SeqAIJSELL *)A->spptr;
+  const PetscScalar *w;
+  PetscScalar       *y;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(aijsell->work, &w));
+  if (mode == INSERT_VALUES) {
+    PetscCall(VecGetArrayWrite(yy, &y));
+    for (PetscInt i = 0; i < A->rmap->n; i++) y[aijsell->perm[i]] = w[i];
+    PetscCall(VecRestoreArrayWrite(yy, &y));
+  } else {
+    PetscCall(VecGetArray(yy, &y));
+    for (PetscInt i = 0; i < A->rmap->n; i++) y[aijsell->perm[i]] += w[i];
+    PetscCall(VecRestoreArray(yy, &y));
+  }
+  PetscCall(VecRestoreArrayRead(aijsell->work, &w));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatDuplicate_SeqAIJSELL(Mat A, MatDuplicateOption op, Mat *M)
 {
   Mat_SeqAIJSELL *aijsell;
@@ -112,7 +299,9 @@ static PetscErrorCode MatDuplicate_SeqAIJSELL(Mat A, MatDuplicateOption op, Mat
   aijsell_dest = (Mat_SeqAIJSELL *)(*M)->spptr;
   PetscCall(PetscArraycpy(aijsell_dest, aijsell, 1));
   /* We don't duplicate the shadow matrix -- that will be constructed as needed. */
-  aijsell_dest->S = NULL;
+  aijsell_dest->S    = NULL;
+  aijsell_dest->perm = NULL;
+  aijsell_dest->work = NULL;
   if (aijsell->eager_shadow) PetscCall(MatSeqAIJSELL_build_shadow(A));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -150,7 +339,10 @@ static PetscErrorCode MatMult_SeqAIJSELL(Mat A, Vec xx, Vec yy)
 
   PetscFunctionBegin;
   PetscCall(MatSeqAIJSELL_build_shadow(A));
-  PetscCall(MatMult_SeqSELL(aijsell->S, xx, yy));
+  if (aijsell->perm) {
+    PetscCall(MatMult_SeqSELL(aijsell->S, xx, aijsell->work));
+    PetscCall(MatSeqAIJSELLPermuteOut_Private(A, yy, INSERT_VALUES));
+  } else PetscCall(MatMult_SeqSELL(aijsell->S, xx, yy));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -160,7 +352,10 @@ static PetscErrorCode MatMultTranspose_SeqAIJSELL(Mat A, Vec xx, Vec yy)
 
   PetscFunctionBegin;
   PetscCall(MatSeqAIJSELL_build_shadow(A));
-  PetscCall(MatMultTranspose_SeqSELL(aijsell->S, xx, yy));
+  if (aijsell->perm) {
+    PetscCall(MatSeqAIJSELLPermuteIn_Private(A, xx));
+    PetscCall(MatMultTranspose_SeqSELL(aijsell->S, aijsell->work, yy));
+  } else PetscCall(MatMultTranspose_SeqSELL(aijsell->S, xx, yy));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -170,7 +365,11 @@ static PetscErrorCode MatMultAdd_SeqAIJSELL(Mat A, Vec xx, Vec yy, Vec zz)
 
   PetscFunctionBegin;
   PetscCall(MatSeqAIJSELL_build_shadow(A));
-  PetscCall(MatMultAdd_SeqSELL(aijsell->S, xx, yy, zz));
+  if (aijsell->perm) {
+    PetscCall(MatMult_SeqSELL(aijsell->S, xx, aijsell->work));
+    if (zz != yy) PetscCall(VecCopy(yy, zz));
+    PetscCall(MatSeqAIJSELLPermuteOut_Private(A, zz, ADD_VALUES));
+  } else PetscCall(MatMultAdd_SeqSELL(aijsell->S, xx, yy, zz));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -180,7 +379,10 @@ static PetscErrorCode MatMultTransposeAdd_SeqAIJSELL(Mat A, Vec xx, Vec yy, Vec
 
   PetscFunctionBegin;
   PetscCall(MatSeqAIJSELL_build_shadow(A));
-  PetscCall(MatMultTransposeAdd_SeqSELL(aijsell->S, xx, yy, zz));
+  if (aijsell->perm) {
+    PetscCall(MatSeqAIJSELLPermuteIn_Private(A, xx));
+    PetscCall(MatMultTransposeAdd_SeqSELL(aijsell->S, aijsell->work, yy, zz));
+  } else PetscCall(MatMultTransposeAdd_SeqSELL(aijsell->S, xx, yy, zz));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -190,7 +392,9 @@ static PetscErrorCode MatSOR_SeqAIJSELL(Mat A, Vec bb, PetscReal omega, MatSORTy
 
   PetscFunctionBegin;
   PetscCall(MatSeqAIJSELL_build_shadow(A));
-  PetscCall(MatSOR_SeqSELL(aijsell->S, bb, omega, flag, fshift, its, lits, xx));
+  /* the sweeps follow the ordering of the rows, so the shadow matrix is only used if its rows are not sorted */
+  if (aijsell->perm) PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+  else PetscCall(MatSOR_SeqSELL(aijsell->S, bb, omega, flag, fshift, its, lits, xx));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -229,11 +433,16 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat A, MatType type, Ma
 
   aijsell->S            = NULL;
   aijsell->eager_shadow = PETSC_FALSE;
+  aijsell->sliceheight  = 8;
+  aijsell->sigma        = 1;
 
   /* Parse command line options. */
   PetscOptionsBegin(PetscObjectComm((PetscObject)A), ((PetscObject)A)->prefix, "AIJSELL Options", "Mat");
   PetscCall(PetscOptionsBool("-mat_aijsell_eager_shadow", "Eager Shadowing", "None", (PetscBool)aijsell->eager_shadow, (PetscBool *)&aijsell->eager_shadow, &set));
+  PetscCall(PetscOptionsInt("-mat_aijsell_slice_height", "Slice height of the shadow matrix", "None", aijsell->sliceheight, &aijsell->sliceheight, NULL));
+  PetscCall(PetscOptionsInt("-mat_aijsell_sigma", "Window of rows sorted by length in the shadow matrix, 1 for no sorting, -1 for an automatic choice", "None", aijsell->sigma, &aijsell->sigma, NULL));
   PetscOptionsEnd();
+  PetscCheck(aijsell->sliceheight > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Slice height %" PetscInt_FMT " must be positive", aijsell->sliceheight);
 
   /* If A has already been assembled and eager shadowing is specified, build the shadow matrix. */
   if (A->assembled && aijsell->eager_shadow) PetscCall(MatSeqAIJSELL_build_shadow(A));
@@ -268,8 +477,11 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat A, MatType type, Ma
 . A - the matrix
 
   Options Database Keys:
-. -mat_aijsell_eager_shadow - Construct shadow matrix upon matrix assembly; default is to take a "lazy" approach,
++ -mat_aijsell_eager_shadow - Construct shadow matrix upon matrix assembly; default is to take a "lazy" approach,
                                performing this step the first time the matrix is applied
+. -mat_aijsell_slice_height - Slice height of the shadow matrix, 8 by default
+- -mat_aijsell_sigma        - Sort the rows of the shadow matrix by length within windows of this many rows, -1 to choose the window
+                               from the row lengths; 1 by default, the rows are not sorted
 
   Level: intermediate
 
@@ -279,6 +491,13 @@ PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat A, MatType type, Ma
   operation. Currently, `MATSEQSELL` format is used for `MatMult()`, `MatMultTranspose()`,
   `MatMultAdd()`, `MatMultTransposeAdd()`, and `MatSOR()` operations.
 
+  The shadow matrix is brought up to date when the matrix has changed. If its nonzero pattern is the same, for instance after
+  `MatSetValues()` into existing entries or `MatZeroEntries()`, only the values are copied into the shadow matrix.
+
+  Sorting the rows by length within windows of sigma rows (SELL-C-sigma) reduces the padding of the slices for matrices with
+  irregular row lengths, at the cost of a permutation of the vectors in the products. The automatic choice only sorts the rows
+  when this saves at least a tenth of the storage. `MatSOR()` uses the `MATSEQAIJ` code when the rows are sorted.
+
   If `nnz` is given then `nz` is ignored
 
   Because `MATSEQAIJSELL` is a subtype of `MATSEQAIJ`, the option `-mat_seqaij_type seqaijsell` can be used to make
@@ -0,0 +1,321 @@
+/*
+  Defines basic operations for the MATSEQAIJSINGLE matrix class.
+  This class is derived from the MATSEQAIJ class and keeps a copy of the values of the matrix
+  in single precision, which MatMult(), MatMultAdd() and MatSOR() stream instead of the values
+  in PetscScalar. The products and the relaxations are accumulated in PetscScalar.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState state; /* State of the matrix when the single precision values were last copied. */
+  PetscInt         nz;    /* Number of values allocated in aa. */
+  float           *aa;    /* Values of the matrix in single precision, in the order of the column indices of Mat_SeqAIJ. */
+} Mat_SeqAIJSingle;
+
+#if defined(PETSC_USE_AVX512_KERNELS) && defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_SKIP_IMMINTRIN_H_CUDAWORKAROUND)
+  #define MAT_SEQAIJSINGLE_AVX512
+  #include <immintrin.h>
+#endif
+
+/* sum_k v[k] x[idx[k]] with the products and the sum in PetscScalar */
+static inline PetscScalar MatSeqAIJSingleDot_Private(const float *v, const PetscInt *idx, const PetscScalar *x, PetscInt n)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    j   = 0;
+
+#if defined(MAT_SEQAIJSINGLE_AVX512) && !defined(PETSC_USE_64BIT_INDICES)
+  __m512d vec_sum = _mm512_setzero_pd();
+
+  for (; j + 8 <= n; j += 8) {
+    __m512d vec_vals = _mm512_cvtps_pd(_mm256_loadu_ps(v + j));
+    __m256i vec_idx  = _mm256_loadu_si256((__m256i const *)(idx + j));
+    __m512d vec_x    = _mm512_i32gather_pd(vec_idx, x, 8);
+
+    vec_sum = _mm512_fmadd_pd(vec_vals, vec_x, vec_sum);
+  }
+  sum = _mm512_reduce_add_pd(vec_sum);
+#endif
+  for (; j < n; j++) sum += (PetscScalar)v[j] * x[idx[j]];
+  return sum;
+}
+
+/* sum_k v[k] x[delta[k]] with the products and the sum in PetscScalar */
+static inline PetscScalar MatSeqAIJSingleDeltaDot_Private(const float *v, const unsigned short *delta, const PetscScalar *x, PetscInt n)
+{
+  PetscScalar sum = 0.0;
+  PetscInt    j   = 0;
+
+#if defined(MAT_SEQAIJSINGLE_AVX512)
+  __m512d vec_sum = _mm512_setzero_pd();
+
+  for (; j + 8 <= n; j += 8) {
+    __m512d vec_vals = _mm512_cvtps_pd(_mm256_loadu_ps(v + j));
+    __m256i vec_idx  = _mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const *)(delta + j)));
+    __m512d vec_x    = _mm512_i32gather_pd(vec_idx, x, 8);
+
+    vec_sum = _mm512_fmadd_pd(vec_vals, vec_x, vec_sum);
+  }
+  sum = _mm512_reduce_add_pd(vec_sum);
+#endif
+  for (; j < n; j++) sum += (PetscScalar)v[j] * x[delta[j]];
+  return sum;
+}
+
+/* the nonzeros [start, end) of row i, with the 16-bit column deltas of -mat_aij_delta_indices if the block of the row is encoded */
+static inline PetscScalar MatSeqAIJSingleRowDot_Private(const Mat_SeqAIJ *a, const float *aa, const PetscScalar *x, PetscInt i, PetscInt start, PetscInt end)
+{
+  if (a->delta.use && a->delta.encoded[i / MAT_SEQAIJ_DELTA_BLOCK]) return MatSeqAIJSingleDeltaDot_Private(aa + start, a->delta.delta + start, x + a->delta.base[i], end - start);
+  return MatSeqAIJSingleDot_Private(aa + start, a->j + start, x, end - start);
+}
+
+static PetscErrorCode MatSeqAIJSingleUpdate_Private(Mat A)
+{
+  Mat_SeqAIJ       *a    = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingle *aijs = (Mat_SeqAIJSingle *)A->spptr;
+  PetscInt          nz   = a->i[A->rmap->n];
+  const MatScalar  *aa;
+  PetscObjectState  state;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (aijs->state == state) PetscFunctionReturn(PETSC_SUCCESS);
+  if (nz > aijs->nz) {
+    PetscCall(PetscFree(aijs->aa));
+    PetscCall(PetscMalloc1(nz, &aijs->aa));
+    aijs->nz = nz;
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt k = 0; k < nz; k++) aijs->aa[k] = (float)PetscRealPart(aa[k]);
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  aijs->state = state;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJSingle_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATAIJSINGLE to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat               B = *newmat;
+  Mat_SeqAIJSingle *aijs;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  aijs = (Mat_SeqAIJSingle *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->destroy   = MatDestroy_SeqAIJ;
+  B->ops->duplicate = MatDuplicate_SeqAIJ;
+  B->ops->mult      = MatMult_SeqAIJ;
+  B->ops->multadd   = MatMultAdd_SeqAIJ;
+  B->ops->sor       = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijsingle_seqaij_C", NULL));
+
+  /* Free everything in the Mat_SeqAIJSingle data structure. */
+  PetscCall(PetscFree(aijs->aa));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJSingle(Mat A)
+{
+  Mat_SeqAIJSingle *aijs = (Mat_SeqAIJSingle *)A->spptr;
+
+  PetscFunctionBegin;
+  if (aijs) {
+    /* If MatHeaderMerge() was used then this SeqAIJSingle matrix will not have a spptr. */
+    PetscCall(PetscFree(aijs->aa));
+    PetscCall(PetscFree(A->spptr));
+  }
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ() to destroy everything that remains. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsingle_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJSingle(Mat A, MatDuplicateOption op, Mat *M)
+{
+  Mat_SeqAIJSingle *aijs_dest;
+
+  PetscFunctionBegin;
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  aijs_dest = (Mat_SeqAIJSingle *)(*M)->spptr;
+  /* The single precision values are copied from the new matrix the first time they are needed. */
+  PetscCall(PetscFree(aijs_dest->aa));
+  aijs_dest->nz    = 0;
+  aijs_dest->state = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJSingle(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a    = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingle  *aijs = (Mat_SeqAIJSingle *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const float       *aa;
+  PetscInt           m = A->rmap->n;
+  const PetscInt    *ii, *ridx;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSingleUpdate_Private(A));
+  if (a->delta.use) PetscCall(MatSeqAIJDeltaSetUp(A));
+  aa = aijs->aa;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (a->compressedrow.use) {
+    PetscCall(PetscArrayzero(y, m));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (PetscInt i = 0; i < a->compressedrow.nrows; i++) y[ridx[i]] = MatSeqAIJSingleRowDot_Private(a, aa, x, ridx[i], ii[i], ii[i + 1]);
+  } else {
+    ii = a->i;
+    for (PetscInt i = 0; i < m; i++) y[i] = MatSeqAIJSingleRowDot_Private(a, aa, x, i, ii[i], ii[i + 1]);
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJSingle(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a    = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingle  *aijs = (Mat_SeqAIJSingle *)A->spptr;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const float       *aa;
+  PetscInt           m = A->rmap->n;
+  const PetscInt    *ii, *ridx;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSingleUpdate_Private(A));
+  if (a->delta.use) PetscCall(MatSeqAIJDeltaSetUp(A));
+  aa = aijs->aa;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (a->compressedrow.use) {
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, m));
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (PetscInt i = 0; i < a->compressedrow.nrows; i++) z[ridx[i]] += MatSeqAIJSingleRowDot_Private(a, aa, x, ridx[i], ii[i], ii[i + 1]);
+  } else {
+    ii = a->i;
+    for (PetscInt i = 0; i < m; i++) z[i] = y[i] + MatSeqAIJSingleRowDot_Private(a, aa, x, i, ii[i], ii[i + 1]);
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#define MatSeqAIJSingleMinusDot_Private(sum, row, start, end) sum -= MatSeqAIJSingleRowDot_Private(a, aa, x, row, start, end)
+
+/*
+   The local sweeps of MatSOR_SeqAIJ() with the off-diagonal entries in single precision, the diagonal is inverted from the
+   PetscScalar values. The other variants use MatSOR_SeqAIJ().
+*/
+static PetscErrorCode MatSOR_SeqAIJSingle(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a    = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSingle  *aijs = (Mat_SeqAIJSingle *)A->spptr;
+  PetscScalar       *x;
+  const float       *aa;
+  const PetscScalar *b;
+  PetscInt           m = A->rmap->n;
+
+  PetscFunctionBegin;
+  if ((flag & SOR_EISENSTAT) || (flag & SOR_MULTICOLOR) || flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatSeqAIJSingleUpdate_Private(A));
+  if (a->delta.use) PetscCall(MatSeqAIJDeltaSetUp(A));
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+  aa        = aijs->aa;
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  MatSeqAIJSORLocalSweeps_Private(a, m, flag, its * lits, omega, b, x, MatSeqAIJSingleMinusDot_Private);
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJSingle converts a SeqAIJ matrix into a
+ * SeqAIJSingle matrix.  This routine is called by the MatCreate_SeqAIJSingle()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJSingle one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSingle(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat               B = *newmat;
+  Mat_SeqAIJSingle *aijs;
+  PetscBool         sametype;
+
+  PetscFunctionBegin;
+  PetscCheck(!PetscDefined(USE_COMPLEX), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "MATSEQAIJSINGLE does not support complex scalars");
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aijs));
+  aijs->state = -1; /* the single precision values are copied the first time they are used */
+  B->spptr    = (void *)aijs;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate = MatDuplicate_SeqAIJSingle;
+  B->ops->destroy   = MatDestroy_SeqAIJSingle;
+  B->ops->mult      = MatMult_SeqAIJSingle;
+  B->ops->multadd   = MatMultAdd_SeqAIJSingle;
+  B->ops->sor       = MatSOR_SeqAIJSingle;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijsingle_seqaij_C", MatConvert_SeqAIJSingle_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJSINGLE));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSingle(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJSingle(A, MATSEQAIJSINGLE, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJSINGLE - MATSEQAIJSINGLE = "seqaijsingle" - A matrix type to be used for sequential sparse matrices whose
+   products and relaxations can be computed with the values rounded to single precision, such as the preconditioning
+   matrices and smoothers of a multigrid hierarchy.
+
+   Options Database Key:
+. -mat_type seqaijsingle - sets the matrix type to `MATSEQAIJSINGLE` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+   Notes:
+   This type inherits from `MATSEQAIJ` and keeps a copy of the values of the matrix in single precision. `MatMult()`,
+   `MatMultAdd()` and the local sweeps of `MatSOR()` read this copy, which halves the memory traffic of the values, and
+   accumulate the products in `PetscScalar`. The diagonal that `MatSOR()` inverts is not rounded. All the other operations,
+   such as `MatMultTranspose()`, `MatGetValues()` or the factorizations, use the values in `PetscScalar`, so the matrix
+   stores its values twice.
+
+   The copy is refreshed when the values of the matrix have changed since it was made.
+
+   With `-mat_aij_delta_indices` these kernels also read the column indices as 16-bit deltas, see `MatCreateSeqAIJ()`.
+
+   This type is not available with complex scalars.
+
+.seealso: [](ch_matrices), `Mat`, `MATAIJSINGLE`, `MATMPIAIJSINGLE`, `MATSEQAIJ`, `MATSEQAIJSELL`, `MATSEQAIJPERM`
+M*/
@@ -0,0 +1,372 @@
+/*
+  Supernodal numeric LU and Cholesky factorizations of MATSEQAIJ matrices, used with -mat_factor_supernodal.
+
+  A supernode is a set of consecutive rows f, ..., l - 1 of the factor whose strictly upper parts are nested: the strictly
+  upper part of row k is column k + 1 followed by the strictly upper part of row k + 1. All the rows of a supernode thus
+  end with the same columns R, those of row l - 1. The supernodes play for the factor the role the inodes of inode.c play
+  for the matrix, they are found once after the symbolic factorization and have no size limit.
+
+  The numeric factorization is right-looking. The rows of a supernode (and for LU the columns below it) are gathered
+  into dense blocks, the diagonal block is factored, the off-diagonal blocks are computed with BLAS trsm and the update
+  of the rows R, a dense |R| x |R| block computed with BLAS gemm, is scattered into the factor. Most of the flops are
+  then done by dense level 3 BLAS kernels instead of the sparse row operations of aijfact.c.
+
+  LU factors are only supernodal when the nonzero structure of the factor is symmetric, which is the case for
+  structurally symmetric matrices factored with a symmetric ordering. Shifting the diagonal is not supported, the
+  scalar numeric factorizations of aijfact.c are used in that case.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+#include <petscblaslapack.h>
+
+PetscErrorCode MatSeqAIJSupernodesReset(Mat_SeqAIJ_Supernodes *sn)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(sn->start));
+  sn->n     = 0;
+  sn->maxns = 0;
+  sn->maxnr = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSupernodalFromOptions_Private(Mat fact, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  PetscOptionsBegin(PetscObjectComm((PetscObject)fact), ((PetscObject)fact)->prefix, "Options for SEQAIJ factorization", "Mat");
+  PetscCall(PetscOptionsBool("-mat_factor_supernodal", "Use the supernodal numeric factorization with dense BLAS kernels", "MatLUFactorNumeric()", *flg, flg, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the strictly upper part of row k of the factor is bj[ubeg[k]], ..., bj[uend[k] - 1] */
+static PetscErrorCode MatSeqAIJSupernodesDetect_Private(PetscInt n, const PetscInt bj[], const PetscInt ubeg[], const PetscInt uend[], Mat_SeqAIJ_Supernodes *sn)
+{
+  PetscInt  f, l;
+  PetscBool same;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(n + 1, &sn->start));
+  for (f = 0; f < n; f = l) {
+    for (l = f + 1; l < n; l++) {
+      const PetscInt nz = uend[l - 1] - ubeg[l - 1];
+
+      if (nz != uend[l] - ubeg[l] + 1 || bj[ubeg[l - 1]] != l) break;
+      PetscCall(PetscArraycmp(bj + ubeg[l - 1] + 1, bj + ubeg[l], nz - 1, &same));
+      if (!same) break;
+    }
+    sn->start[sn->n++] = f;
+    sn->maxns          = PetscMax(sn->maxns, l - f);
+    sn->maxnr          = PetscMax(sn->maxnr, uend[l - 1] - ubeg[l - 1]);
+  }
+  sn->start[sn->n] = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* position of column j in bj[lo], ..., bj[hi - 1], it must be there */
+static inline PetscInt MatSupernodalFind_Private(PetscInt j, PetscInt lo, PetscInt hi, const PetscInt bj[])
+{
+  while (hi - lo > 1) {
+    const PetscInt mid = lo + (hi - lo) / 2;
+
+    if (bj[mid] > j) hi = mid;
+    else lo = mid;
+  }
+  return lo;
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqAIJ_Supernodal(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJ_Supernodes *sn = &b->supernodes;
+  const PetscInt         n = A->rmap->n, *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt        *r, *ic;
+  const MatScalar       *aa = a->a;
+  MatScalar             *ba = b->a;
+  PetscScalar           *F, *L21, *W, one = 1.0, zero = 0.0;
+  PetscInt              *pos;
+  PetscLogDouble         flops = 0.0;
+  FactorShiftCtx         sctx;
+
+  PetscFunctionBegin;
+  if (info->shifttype != (PetscReal)MAT_SHIFT_NONE) {
+    PetscCall(PetscInfo(A, "Using the scalar numeric factorization since the diagonal may be shifted\n"));
+    if (a->inode.size) PetscCall(MatLUFactorNumeric_SeqAIJ_Inode(B, A, info));
+    else PetscCall(MatLUFactorNumeric_SeqAIJ(B, A, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMemzero(&sctx, sizeof(FactorShiftCtx)));
+  PetscCall(ISGetIndices(b->row, &r));
+  PetscCall(ISGetIndices(b->icol, &ic));
+
+  /* load the permuted matrix into the factor */
+  PetscCall(PetscArrayzero(ba, bdiag[0] + 1));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = ai[r[i]]; p < ai[r[i] + 1]; p++) {
+      const PetscInt j = ic[aj[p]];
+
+      if (j < i) ba[MatSupernodalFind_Private(j, bi[i], bi[i + 1], bj)] = aa[p];
+      else if (j > i) ba[MatSupernodalFind_Private(j, bdiag[i + 1] + 1, bdiag[i], bj)] = aa[p];
+      else ba[bdiag[i]] = aa[p];
+    }
+  }
+
+  PetscCall(PetscMalloc4(sn->maxns * (sn->maxns + sn->maxnr), &F, sn->maxnr * sn->maxns, &L21, sn->maxnr * sn->maxnr, &W, sn->maxnr, &pos));
+  for (PetscInt s = 0; s < sn->n; s++) {
+    const PetscInt  f = sn->start[s], l = sn->start[s + 1], ns = l - f, nr = bdiag[l - 1] - bdiag[l] - 1;
+    const PetscInt *R = bj + bdiag[l] + 1;
+    PetscScalar    *F12 = F + ns * ns;
+    PetscBLASInt    bns, bnr;
+
+    /* F = [F11 F12] are the rows of the supernode, the L part of row f + i ends with the columns f, ..., f + i - 1 */
+    for (PetscInt i = 0; i < ns; i++) {
+      const MatScalar *lv = ba + bi[f + i + 1] - i, *uv = ba + bdiag[f + i + 1] + 1;
+
+      for (PetscInt j = 0; j < i; j++) F[i + j * ns] = lv[j];
+      F[i + i * ns] = ba[bdiag[f + i]];
+      for (PetscInt j = i + 1; j < ns + nr; j++) F[i + j * ns] = uv[j - i - 1];
+    }
+    /* L21 are the columns of the supernode in the rows R, they are contiguous in their L parts */
+    for (PetscInt p = 0; p < nr; p++) {
+      pos[p] = MatSupernodalFind_Private(f, bi[R[p]], bi[R[p] + 1], bj);
+      for (PetscInt k = 0; k < ns; k++) L21[p + k * nr] = ba[pos[p] + k];
+    }
+
+    /* F11 = L11 U11 */
+    for (PetscInt k = 0; k < ns; k++) {
+      PetscScalar dinv;
+
+      sctx.pv = F[k + k * ns];
+      PetscCall(MatPivotCheck(B, A, info, &sctx, f + k));
+      dinv = 1.0 / F[k + k * ns];
+      for (PetscInt i = k + 1; i < ns; i++) F[i + k * ns] *= dinv;
+      for (PetscInt j = k + 1; j < ns; j++) {
+        for (PetscInt i = k + 1; i < ns; i++) F[i + j * ns] -= F[i + k * ns] * F[k + j * ns];
+      }
+    }
+    if (nr) {
+      /* U12 = L11^{-1} F12, L21 = F21 U11^{-1} and W = L21 U12 */
+      PetscCall(PetscBLASIntCast(ns, &bns));
+      PetscCall(PetscBLASIntCast(nr, &bnr));
+      PetscCallBLAS("BLAStrsm", BLAStrsm_("L", "L", "N", "U", &bns, &bnr, &one, F, &bns, F12, &bns));
+      PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "U", "N", "N", &bnr, &bns, &one, F, &bns, L21, &bnr));
+      PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bnr, &bnr, &bns, &one, L21, &bnr, F12, &bns, &zero, W, &bnr));
+    }
+    flops += 2.0 * ns * ns * ns / 3.0 + 2.0 * ns * ns * nr + 2.0 * ns * nr * nr;
+
+    /* store the factored supernode, the diagonal is inverted for the triangular solves */
+    for (PetscInt i = 0; i < ns; i++) {
+      MatScalar *lv = ba + bi[f + i + 1] - i, *uv = ba + bdiag[f + i + 1] + 1;
+
+      for (PetscInt j = 0; j < i; j++) lv[j] = F[i + j * ns];
+      ba[bdiag[f + i]] = 1.0 / F[i + i * ns];
+      for (PetscInt j = i + 1; j < ns + nr; j++) uv[j - i - 1] = F[i + j * ns];
+    }
+    for (PetscInt p = 0; p < nr; p++) {
+      for (PetscInt k = 0; k < ns; k++) ba[pos[p] + k] = L21[p + k * nr];
+    }
+
+    /* subtract W from the rows R, the symbolic factorization made room for all of its entries */
+    for (PetscInt p = 0; p < nr; p++) {
+      PetscInt t, q;
+
+      for (t = pos[p] + ns, q = 0; q < p; t++) {
+        if (bj[t] == R[q]) {
+          ba[t] -= W[p + q * nr];
+          q++;
+        }
+      }
+      ba[bdiag[R[p]]] -= W[p + p * nr];
+      for (t = bdiag[R[p] + 1] + 1, q = p + 1; q < nr; t++) {
+        if (bj[t] == R[q]) {
+          ba[t] -= W[p + q * nr];
+          q++;
+        }
+      }
+    }
+  }
+  PetscCall(PetscFree4(F, L21, W, pos));
+  PetscCall(ISRestoreIndices(b->icol, &ic));
+  PetscCall(ISRestoreIndices(b->row, &r));
+
+  PetscCall(MatSeqAIJSetUpSolve_LU(B, A));
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_Supernodal(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqSBAIJ          *b  = (Mat_SeqSBAIJ *)B->data;
+  Mat_SeqAIJ_Supernodes *sn = &b->supernodes;
+  const PetscInt         n = A->rmap->n, *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  const PetscInt        *rip, *riip;
+  const MatScalar       *aa = a->a;
+  MatScalar             *ba = b->a;
+  PetscScalar           *F, *T, *W, one = 1.0, zero = 0.0;
+  PetscLogDouble         flops = 0.0;
+  FactorShiftCtx         sctx;
+
+  PetscFunctionBegin;
+  if (info->shifttype != (PetscReal)MAT_SHIFT_NONE) {
+    PetscCall(PetscInfo(A, "Using the scalar numeric factorization since the diagonal may be shifted\n"));
+    PetscCall(MatCholeskyFactorNumeric_SeqAIJ(B, A, info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMemzero(&sctx, sizeof(FactorShiftCtx)));
+  PetscCall(ISGetIndices(b->row, &rip));
+  PetscCall(ISGetIndices(b->icol, &riip));
+
+  /* load the upper triangular part of the permuted matrix into the factor */
+  PetscCall(PetscArrayzero(ba, bi[n]));
+  for (PetscInt k = 0; k < n; k++) {
+    for (PetscInt p = ai[rip[k]]; p < ai[rip[k] + 1]; p++) {
+      const PetscInt j = riip[aj[p]];
+
+      if (j > k) ba[MatSupernodalFind_Private(j, bi[k], bdiag[k], bj)] = aa[p];
+      else if (j == k) ba[bdiag[k]] = aa[p];
+    }
+  }
+
+  PetscCall(PetscMalloc3(sn->maxns * (sn->maxns + sn->maxnr), &F, sn->maxns * sn->maxnr, &T, sn->maxnr * sn->maxnr, &W));
+  for (PetscInt s = 0; s < sn->n; s++) {
+    const PetscInt  f = sn->start[s], l = sn->start[s + 1], ns = l - f, nr = bdiag[l - 1] - bi[l - 1];
+    const PetscInt *R   = bj + bi[l - 1];
+    PetscScalar    *F12 = F + ns * ns;
+    PetscBLASInt    bns, bnr;
+
+    /* F = [F11 F12] are the upper triangular parts of the rows of the supernode */
+    for (PetscInt i = 0; i < ns; i++) {
+      const MatScalar *uv = ba + bi[f + i];
+
+      F[i + i * ns] = ba[bdiag[f + i]];
+      for (PetscInt j = i + 1; j < ns + nr; j++) F[i + j * ns] = uv[j - i - 1];
+    }
+
+    /* F11 = U11^T D U11 */
+    for (PetscInt k = 0; k < ns; k++) {
+      PetscScalar dinv;
+
+      sctx.pv = F[k + k * ns];
+      PetscCall(MatPivotCheck(B, A, info, &sctx, f + k));
+      dinv = 1.0 / F[k + k * ns];
+      for (PetscInt j = k + 1; j < ns; j++) {
+        const PetscScalar ukj = F[k + j * ns] * dinv;
+
+        for (PetscInt i = k + 1; i <= j; i++) F[i + j * ns] -= F[k + i * ns] * ukj;
+      }
+      for (PetscInt j = k + 1; j < ns; j++) F[k + j * ns] *= dinv;
+    }
+    if (nr) {
+      /* T = U11^{-T} F12 = D U12 and W = T^T U12 */
+      PetscCall(PetscBLASIntCast(ns, &bns));
+      PetscCall(PetscBLASIntCast(nr, &bnr));
+      PetscCallBLAS("BLAStrsm", BLAStrsm_("L", "U", "T", "U", &bns, &bnr, &one, F, &bns, F12, &bns));
+      PetscCall(PetscArraycpy(T, F12, ns * nr));
+      for (PetscInt i = 0; i < ns; i++) {
+        const PetscScalar dinv = 1.0 / F[i + i * ns];
+
+        for (PetscInt j = 0; j < nr; j++) F12[i + j * ns] *= dinv;
+      }
+      PetscCallBLAS("BLASgemm", BLASgemm_("T", "N", &bnr, &bnr, &bns, &one, T, &bns, F12, &bns, &zero, W, &bnr));
+    }
+    flops += 1.0 * ns * ns * ns / 3.0 + 1.0 * ns * ns * nr + 2.0 * ns * nr * nr;
+
+    /* store the factored supernode as the solves of sbaij expect it: -U off the diagonal and D^{-1} on it */
+    for (PetscInt i = 0; i < ns; i++) {
+      MatScalar *uv = ba + bi[f + i];
+
+      ba[bdiag[f + i]] = 1.0 / F[i + i * ns];
+      for (PetscInt j = i + 1; j < ns + nr; j++) uv[j - i - 1] = -F[i + j * ns];
+    }
+
+    /* subtract the upper triangular part of W from the rows R */
+    for (PetscInt p = 0; p < nr; p++) {
+      PetscInt t, q;
+
+      ba[bdiag[R[p]]] -= W[p + p * nr];
+      for (t = bi[R[p]], q = p + 1; q < nr; t++) {
+        if (bj[t] == R[q]) {
+          ba[t] -= W[p + q * nr];
+          q++;
+        }
+      }
+    }
+  }
+  PetscCall(PetscFree3(F, T, W));
+  PetscCall(ISRestoreIndices(b->icol, &riip));
+  PetscCall(ISRestoreIndices(b->row, &rip));
+
+  PetscCall(MatSeqSBAIJSetUpSolve_Cholesky(B, A));
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJSetUpSupernodes_LU - finds the supernodes of a LU factor after its symbolic factorization and selects the supernodal numeric
+   factorization if -mat_factor_supernodal is set and the nonzero structure of the factor is symmetric
+*/
+PetscErrorCode MatSeqAIJSetUpSupernodes_LU(Mat fact, Mat A)
+{
+  Mat_SeqAIJ    *b = (Mat_SeqAIJ *)fact->data;
+  const PetscInt n = fact->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  PetscInt      *ubeg, *next;
+  PetscBool      flg, symmetric = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSupernodesReset(&b->supernodes));
+  PetscCall(MatSupernodalFromOptions_Private(fact, &flg));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the L part of row i must be the transpose of the strictly upper part of column i, next[i] is the next entry of row i to be matched */
+  PetscCall(PetscMalloc2(n, &ubeg, n, &next));
+  for (PetscInt i = 0; i < n; i++) {
+    ubeg[i] = bdiag[i + 1] + 1;
+    next[i] = bi[i];
+  }
+  for (PetscInt k = 0; k < n && symmetric; k++) {
+    for (PetscInt p = ubeg[k]; p < bdiag[k]; p++) {
+      const PetscInt j = bj[p];
+
+      if (next[j] == bi[j + 1] || bj[next[j]] != k) {
+        symmetric = PETSC_FALSE;
+        break;
+      }
+      next[j]++;
+    }
+  }
+  for (PetscInt i = 0; i < n && symmetric; i++) symmetric = (PetscBool)(next[i] == bi[i + 1]);
+  if (symmetric) PetscCall(MatSeqAIJSupernodesDetect_Private(n, bj, ubeg, bdiag, &b->supernodes));
+  PetscCall(PetscFree2(ubeg, next));
+  if (!symmetric) {
+    PetscCall(PetscInfo(A, "Not using the supernodal factorization since the nonzero structure of the factor is not symmetric\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscInfo(A, "%" PetscInt_FMT " supernodes for %" PetscInt_FMT " rows, the largest has %" PetscInt_FMT " rows\n", b->supernodes.n, n, b->supernodes.maxns));
+  fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Supernodal;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqSBAIJSetUpSupernodes_Cholesky - finds the supernodes of a Cholesky factor of a MATSEQAIJ matrix after its symbolic factorization
+   and selects the supernodal numeric factorization if -mat_factor_supernodal is set
+*/
+PetscErrorCode MatSeqSBAIJSetUpSupernodes_Cholesky(Mat fact, Mat A)
+{
+  Mat_SeqSBAIJ *b = (Mat_SeqSBAIJ *)fact->data;
+  PetscBool     flg;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJSupernodesReset(&b->supernodes));
+  PetscCall(MatSupernodalFromOptions_Private(fact, &flg));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  /* the diagonal is the last entry of each row */
+  PetscCall(MatSeqAIJSupernodesDetect_Private(fact->rmap->n, b->j, b->i, b->diag, &b->supernodes));
+  PetscCall(PetscInfo(A, "%" PetscInt_FMT " supernodes for %" PetscInt_FMT " rows, the largest has %" PetscInt_FMT " rows\n", b->supernodes.n, fact->rmap->n, b->supernodes.maxns));
+  fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ_Supernodal;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
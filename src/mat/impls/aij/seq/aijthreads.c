@@ -0,0 +1,1023 @@
+/*
+  OpenMP threaded MatMult(), MatMultAdd(), MatMultTranspose(), MatSOR() and MatSetValuesCOO() for MATSEQAIJ.
+
+  The rows (or inodes) are split into one contiguous chunk per thread so that every chunk holds about the same
+  number of nonzeros. MatMultTranspose() accumulates each chunk into a private slice of the result that are summed
+  at the end, so no two threads ever write to the same entry.
+
+  MatSOR() with SOR_MULTICOLOR sweeps the rows color by color; rows of the same color are not coupled so they
+  are relaxed concurrently.
+
+  MatSetValuesCOO() is a segmented reduction over the jmap[] array of the COO struct: every nonzero is the sum of a
+  segment of the permuted COO values, and the nonzeros are split between the threads so that each thread sums about
+  the same number of COO values.
+
+  MatSolve() and MatMatSolve() with LU, ILU, Cholesky and ICC factors use a level schedule when more than one thread
+  is available: the rows of a level of the forward (or backward) substitution only depend on rows of the lower levels,
+  so they are solved concurrently and the threads synchronize between two levels. The levels only depend on the nonzero structure of the factor, so they
+  are computed by the first numeric factorization and kept until the next symbolic factorization. Every row is
+  computed with the same operations in the same order as in the sequential solves.
+
+  MatLUFactorNumeric_SeqAIJ_Sweeps() is the fine-grained parallel ILU of Chow and Patel: the entries of the ILU factors
+  are computed by fixed-point sweeps in which all the rows are updated concurrently, and its MatSolve() replaces the
+  triangular substitutions by Jacobi sweeps. These approximate the ILU preconditioner but have no sequential dependency
+  between the rows, they are used with PCFactorSetSweeps().
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+
+PetscErrorCode MatCreate_SeqAIJ_Threads(Mat B)
+{
+  Mat_SeqAIJ *b = (Mat_SeqAIJ *)B->data;
+
+  PetscFunctionBegin;
+  b->threads.use          = PETSC_FALSE;
+  b->threads.nthreads     = 0;
+  b->threads.rstart       = NULL;
+  b->threads.nstart       = NULL;
+  b->threads.nrow         = NULL;
+  b->threads.work         = NULL;
+  b->threads.worksize     = 0;
+  b->threads.nonzerostate = -1;
+  b->threads.ncolors       = 0;
+  b->threads.cstart        = NULL;
+  b->threads.crows         = NULL;
+  b->threads.cnonzerostate = -1;
+  PetscCall(PetscMemzero(&b->threads.levels, sizeof(Mat_SeqAIJ_Levels)));
+  b->threads.solvesweeps = 0;
+  b->threads.sweepwork   = NULL;
+
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsBool("-mat_aij_threads", "Use OpenMP threads in MatMult(), MatMultAdd(), MatMultTranspose() and MatSetValuesCOO()", NULL, b->threads.use, &b->threads.use, NULL));
+  PetscOptionsEnd();
+#if !defined(PETSC_HAVE_OPENMP)
+  if (b->threads.use) PetscCall(PetscInfo(B, "Ignoring -mat_aij_threads since PETSc was not configured with OpenMP\n"));
+  b->threads.use = PETSC_FALSE;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(a->threads.rstart, a->threads.nstart, a->threads.nrow));
+  PetscCall(PetscFree(a->threads.work));
+  PetscCall(PetscFree2(a->threads.cstart, a->threads.crows));
+  PetscCall(MatSeqAIJLevelsReset(&a->threads.levels));
+  PetscCall(PetscFree(a->threads.sweepwork));
+  a->threads.worksize      = 0;
+  a->threads.nonzerostate  = -1;
+  a->threads.ncolors       = 0;
+  a->threads.cnonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The partitions and the coloring are not copied, C computes its own the first time they are used */
+PetscErrorCode MatDuplicate_SeqAIJ_Threads(Mat A, Mat C)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data, *c = (Mat_SeqAIJ *)C->data;
+
+  PetscFunctionBegin;
+  c->threads.use           = a->threads.use;
+  c->threads.nonzerostate  = -1;
+  c->threads.cnonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatView_SeqAIJ_Threads(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ *)A->data;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->threads.use) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerGetFormat(viewer, &format));
+    if (format == PETSC_VIEWER_ASCII_INFO_DETAIL || format == PETSC_VIEWER_ASCII_INFO) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "using OpenMP threaded MatMult() routines\n"));
+      if (a->threads.levels.valid) PetscCall(PetscViewerASCIIPrintf(viewer, "level scheduled triangular solves with %" PetscInt_FMT " forward and %" PetscInt_FMT " backward levels\n", a->threads.levels.nlevels[0], a->threads.levels.nlevels[1]));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The nonzero structure, the compressed row information or the inodes may have changed */
+PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  a->threads.nonzerostate  = -1;
+  a->threads.cnonzerostate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJThreadsSplit - splits the nrows entries of the monotone weight array w[] (for example the CSR row offsets)
+   into nt contiguous chunks [start[t], start[t+1]) of about the same weight. Each row also counts as one unit of
+   weight so that long stretches of empty rows are distributed as well.
+*/
+void MatSeqAIJThreadsSplit(PetscInt nrows, const PetscInt64 w[], PetscInt nt, PetscInt start[])
+{
+  const PetscInt64 total = (w[nrows] - w[0]) + nrows;
+
+  start[0]  = 0;
+  start[nt] = nrows;
+  for (PetscInt t = 1; t < nt; t++) {
+    const PetscInt64 target = (total * t) / nt;
+    PetscInt         lo = start[t - 1], hi = nrows;
+
+    /* smallest r with weight of [0, r) at least target */
+    while (lo < hi) {
+      const PetscInt mid = lo + (hi - lo) / 2;
+
+      if ((w[mid] - w[0]) + mid < target) lo = mid + 1;
+      else hi = mid;
+    }
+    start[t] = lo;
+  }
+}
+
+/*
+   MatSeqAIJThreadsSetUp - computes the nonzero-balanced partitions of the rows and inodes used by the threaded kernels
+
+   The partitions are kept until the nonzero structure or the number of threads changes
+*/
+PetscErrorCode MatSeqAIJThreadsSetUp(Mat A)
+{
+  Mat_SeqAIJ *a  = (Mat_SeqAIJ *)A->data;
+  PetscInt    nt = 1;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  if (a->threads.nonzerostate == A->nonzerostate && a->threads.nthreads == nt) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree3(a->threads.rstart, a->threads.nstart, a->threads.nrow));
+  PetscCall(PetscMalloc3(nt + 1, &a->threads.rstart, nt + 1, &a->threads.nstart, nt + 1, &a->threads.nrow));
+  {
+    const PetscInt  nrows = a->compressedrow.use ? a->compressedrow.nrows : A->rmap->n;
+    const PetscInt *ii    = a->compressedrow.use ? a->compressedrow.i : a->i;
+    PetscInt64     *w;
+
+    PetscCall(PetscMalloc1(nrows + 1, &w));
+    for (PetscInt i = 0; i <= nrows; i++) w[i] = ii[i];
+    MatSeqAIJThreadsSplit(nrows, w, nt, a->threads.rstart);
+    PetscCall(PetscFree(w));
+  }
+  if (a->inode.size) {
+    const PetscInt  node_count = a->inode.node_count;
+    const PetscInt *ns         = a->inode.size;
+    PetscInt64     *w;
+
+    /* w[k] is the offset of the first nonzero of inode k, inodes share their column indices but not their values */
+    PetscCall(PetscMalloc1(node_count + 1, &w));
+    w[0] = 0;
+    for (PetscInt k = 0, row = 0; k < node_count; k++) {
+      w[k + 1] = w[k] + a->i[row + ns[k]] - a->i[row];
+      row += ns[k];
+    }
+    MatSeqAIJThreadsSplit(node_count, w, nt, a->threads.nstart);
+    for (PetscInt t = 0, k = 0, row = 0; t < nt; t++) {
+      for (; k < a->threads.nstart[t]; k++) row += ns[k];
+      a->threads.nrow[t] = row;
+    }
+    a->threads.nrow[nt] = A->rmap->n;
+    PetscCall(PetscFree(w));
+  }
+  a->threads.nthreads     = nt;
+  a->threads.nonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Partitioned %" PetscInt_FMT " rows with %" PetscInt_FMT " nonzeros for %" PetscInt_FMT " threads\n", A->rmap->n, a->nz, nt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes a distance-one coloring of the symmetrized nonzero structure of A with MatColoring, so rows of the same
+   color never reference each other in either direction, and stores the rows sorted by color
+*/
+static PetscErrorCode MatSeqAIJThreadsSetUpColoring_Private(Mat A)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data;
+  Mat                    G;
+  MatColoring            mc;
+  ISColoring             iscoloring;
+  const ISColoringValue *colors;
+  PetscInt               m = A->rmap->n, nc, *cnt;
+  PetscBool              set, flg;
+
+  PetscFunctionBegin;
+  if (a->threads.cnonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCheck(A->rmap->n == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_SUP, "Multicolor SOR requires a square matrix");
+  PetscCall(MatIsStructurallySymmetricKnown(A, &set, &flg));
+  if (set && flg) {
+    PetscCall(PetscObjectReference((PetscObject)A));
+    G = A;
+  } else {
+    Mat At;
+
+    PetscCall(MatTranspose(A, MAT_INITIAL_MATRIX, &At));
+    PetscCall(MatDuplicate(A, MAT_DO_NOT_COPY_VALUES, &G));
+    PetscCall(MatAXPY(G, 1.0, At, DIFFERENT_NONZERO_PATTERN));
+    PetscCall(MatDestroy(&At));
+  }
+  PetscCall(MatColoringCreate(G, &mc));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetType(mc, MATCOLORINGGREEDY));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  PetscCall(MatDestroy(&G));
+
+  PetscCall(ISColoringGetColors(iscoloring, NULL, &nc, &colors));
+  PetscCall(PetscFree2(a->threads.cstart, a->threads.crows));
+  PetscCall(PetscMalloc2(nc + 1, &a->threads.cstart, m, &a->threads.crows));
+  PetscCall(PetscCalloc1(nc + 1, &cnt));
+  for (PetscInt i = 0; i < m; i++) cnt[colors[i] + 1]++;
+  for (PetscInt c = 0; c < nc; c++) cnt[c + 1] += cnt[c];
+  PetscCall(PetscArraycpy(a->threads.cstart, cnt, nc + 1));
+  for (PetscInt i = 0; i < m; i++) a->threads.crows[cnt[colors[i]]++] = i;
+  PetscCall(PetscFree(cnt));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  a->threads.ncolors       = nc;
+  a->threads.cnonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Multicolor SOR ordering uses %" PetscInt_FMT " colors for %" PetscInt_FMT " rows\n", nc, m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* relaxes the rows of color c, they are independent so the loop is run by all threads */
+static inline void MatSOR_SeqAIJ_Multicolor_Private(Mat_SeqAIJ *a, const MatScalar *aa, PetscInt c, PetscReal omega, const PetscScalar *b, PetscScalar *x)
+{
+  const PetscInt    *ai = a->i, *aj = a->j, *crows = a->threads.crows;
+  const PetscScalar *idiag = a->idiag, *mdiag = a->mdiag;
+#if defined(PETSC_HAVE_OPENMP)
+  const PetscInt nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscInt k = a->threads.cstart[c]; k < a->threads.cstart[c + 1]; k++) {
+    const PetscInt   i   = crows[k];
+    const PetscInt   n   = ai[i + 1] - ai[i];
+    const PetscInt  *idx = aj + ai[i];
+    const MatScalar *v   = aa + ai[i];
+    PetscScalar      sum = b[i];
+
+    PetscSparseDenseMinusDot(sum, x, v, idx, n);
+    x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i]; /* omega in idiag */
+  }
+}
+
+/*
+   Gauss-Seidel/SOR in the multicolor ordering: the forward sweep visits the colors in increasing order, the backward
+   sweep in decreasing order. This is the lexicographic SOR of the symmetrically permuted matrix, so its convergence
+   generally differs from the one of the natural ordering.
+*/
+PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  const MatScalar   *aa;
+  PetscInt           nc;
+
+  PetscFunctionBegin;
+  PetscCheck(!(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER)), PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_MULTICOLOR cannot be combined with SOR_EISENSTAT, SOR_APPLY_UPPER or SOR_APPLY_LOWER");
+  PetscCall(MatSeqAIJThreadsSetUpColoring_Private(A));
+  nc  = a->threads.ncolors;
+  its = its * lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(VecSet(xx, 0.0));
+  PetscCall(VecGetArray(xx, &x));
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (PetscInt c = 0; c < nc; c++) MatSOR_SeqAIJ_Multicolor_Private(a, aa, c, omega, b, x);
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (PetscInt c = nc - 1; c >= 0; c--) MatSOR_SeqAIJ_Multicolor_Private(a, aa, c, omega, b, x);
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSeqAIJLevelsReset(Mat_SeqAIJ_Levels *lv)
+{
+  PetscFunctionBegin;
+  for (PetscInt s = 0; s < 2; s++) {
+    PetscCall(PetscFree2(lv->lstart[s], lv->lrows[s]));
+    lv->nlevels[s] = 0;
+  }
+  PetscCall(PetscFree3(lv->tstart, lv->tpos, lv->trow));
+  PetscCall(PetscFree(lv->work));
+  lv->valid = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the levels of one substitution of a triangular solve with n rows, visited in increasing order if forward
+   and in decreasing order otherwise. Row i depends on the rows dep[beg[i]], ..., dep[end[i] - 1], which are all
+   visited before i. The rows of a level are stored in increasing order.
+*/
+static PetscErrorCode MatSeqAIJLevelsCreate_Private(PetscInt n, PetscBool forward, const PetscInt beg[], const PetscInt end[], const PetscInt dep[], PetscInt *nlevels, PetscInt **lstart, PetscInt **lrows)
+{
+  PetscInt *level, *cnt, nl = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(n, &level));
+  for (PetscInt k = 0; k < n; k++) {
+    const PetscInt i = forward ? k : n - 1 - k;
+    PetscInt       l = 0;
+
+    for (PetscInt j = beg[i]; j < end[i]; j++) l = PetscMax(l, level[dep[j]] + 1);
+    level[i] = l;
+    nl       = PetscMax(nl, l + 1);
+  }
+  PetscCall(PetscMalloc2(nl + 1, lstart, n, lrows));
+  PetscCall(PetscCalloc1(nl + 1, &cnt));
+  for (PetscInt i = 0; i < n; i++) cnt[level[i] + 1]++;
+  for (PetscInt l = 0; l < nl; l++) cnt[l + 1] += cnt[l];
+  PetscCall(PetscArraycpy(*lstart, cnt, nl + 1));
+  for (PetscInt i = 0; i < n; i++) (*lrows)[cnt[level[i]]++] = i;
+  PetscCall(PetscFree(cnt));
+  PetscCall(PetscFree(level));
+  *nlevels = nl;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqAIJSetUpLevels_LU - computes the level schedule of the solves with a LU or ILU factor in the MATSEQAIJ factor format
+
+   Row i of L is ai[i], ..., ai[i + 1] - 1 and row i of U is adiag[i + 1] + 1, ..., adiag[i] - 1 followed by the inverse of the
+   diagonal at adiag[i]
+*/
+PetscErrorCode MatSeqAIJSetUpLevels_LU(Mat fact)
+{
+  Mat_SeqAIJ        *b  = (Mat_SeqAIJ *)fact->data;
+  Mat_SeqAIJ_Levels *lv = &b->threads.levels;
+  const PetscInt     n  = fact->rmap->n, *bdiag = b->diag;
+  PetscInt          *ubeg, *uend;
+
+  PetscFunctionBegin;
+  if (lv->valid) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJLevelsReset(lv));
+  PetscCall(MatSeqAIJLevelsCreate_Private(n, PETSC_TRUE, b->i, b->i + 1, b->j, &lv->nlevels[0], &lv->lstart[0], &lv->lrows[0]));
+  PetscCall(PetscMalloc2(n, &ubeg, n, &uend));
+  for (PetscInt i = 0; i < n; i++) {
+    ubeg[i] = bdiag[i + 1] + 1;
+    uend[i] = bdiag[i];
+  }
+  PetscCall(MatSeqAIJLevelsCreate_Private(n, PETSC_FALSE, ubeg, uend, b->j, &lv->nlevels[1], &lv->lstart[1], &lv->lrows[1]));
+  PetscCall(PetscFree2(ubeg, uend));
+  lv->valid = PETSC_TRUE;
+  PetscCall(PetscInfo(fact, "Level schedule of the triangular solves with %" PetscInt_FMT " rows has %" PetscInt_FMT " forward and %" PetscInt_FMT " backward levels\n", n, lv->nlevels[0], lv->nlevels[1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   MatSeqSBAIJSetUpLevels_Cholesky - computes the level schedule of the solves with a Cholesky or ICC factor of a MATSEQAIJ matrix
+
+   The factor is a MATSEQSBAIJ matrix with block size 1 whose row k holds the off-diagonal entries of row k of U at ai[k], ..., ai[k + 1] - 2
+   followed by the inverse of the diagonal at adiag[k] = ai[k + 1] - 1. The forward substitution with U^T gathers along the columns of U, so
+   the positions of the nonzeros of each column are stored as well.
+*/
+PetscErrorCode MatSeqSBAIJSetUpLevels_Cholesky(Mat fact)
+{
+  Mat_SeqSBAIJ      *b  = (Mat_SeqSBAIJ *)fact->data;
+  Mat_SeqAIJ_Levels *lv = &b->levels;
+  const PetscInt     n = fact->rmap->n, *bi = b->i, *bj = b->j;
+  PetscInt          *cnt;
+
+  PetscFunctionBegin;
+  if (lv->valid) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJLevelsReset(lv));
+  PetscCall(PetscMalloc3(n + 1, &lv->tstart, bi[n] - n, &lv->tpos, bi[n] - n, &lv->trow));
+  PetscCall(PetscMalloc1(n, &lv->work));
+  PetscCall(PetscCalloc1(n + 1, &cnt));
+  for (PetscInt i = 0; i < n; i++)
+    for (PetscInt p = bi[i]; p < bi[i + 1] - 1; p++) cnt[bj[p] + 1]++;
+  for (PetscInt k = 0; k < n; k++) cnt[k + 1] += cnt[k];
+  PetscCall(PetscArraycpy(lv->tstart, cnt, n + 1));
+  for (PetscInt i = 0; i < n; i++) {
+    for (PetscInt p = bi[i]; p < bi[i + 1] - 1; p++) {
+      lv->tpos[cnt[bj[p]]]   = p;
+      lv->trow[cnt[bj[p]]++] = i;
+    }
+  }
+  PetscCall(PetscFree(cnt));
+  {
+    PetscInt *uend;
+
+    PetscCall(PetscMalloc1(n, &uend));
+    for (PetscInt i = 0; i < n; i++) uend[i] = bi[i + 1] - 1;
+    PetscCall(MatSeqAIJLevelsCreate_Private(n, PETSC_TRUE, lv->tstart, lv->tstart + 1, lv->trow, &lv->nlevels[0], &lv->lstart[0], &lv->lrows[0]));
+    PetscCall(MatSeqAIJLevelsCreate_Private(n, PETSC_FALSE, bi, uend, bj, &lv->nlevels[1], &lv->lstart[1], &lv->lrows[1]));
+    PetscCall(PetscFree(uend));
+  }
+  lv->valid = PETSC_TRUE;
+  PetscCall(PetscInfo(fact, "Level schedule of the triangular solves with %" PetscInt_FMT " rows has %" PetscInt_FMT " forward and %" PetscInt_FMT " backward levels\n", n, lv->nlevels[0], lv->nlevels[1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* rows [start, end) of the chunk t of nt chunks of n rows */
+static inline void MatSeqAIJSweepsChunk_Private(PetscInt n, PetscInt nt, PetscInt t, PetscInt *start, PetscInt *end)
+{
+  *start = (PetscInt)(((PetscInt64)n * t) / nt);
+  *end   = (PetscInt)(((PetscInt64)n * (t + 1)) / nt);
+}
+
+/*
+   One fixed-point sweep of the rows [rs, re) of the ILU factor, see MatLUFactorNumeric_SeqAIJ() for the storage of the factor.
+   Row i of A - L U is formed in the dense work array w with the values o[] of the previous sweep, restricted to the
+   nonzero pattern of row i of the factor, and gives the new values v[] of row i of L and U:
+     l_ij = (a_ij - sum_{k < j} l_ik u_kj) / u_jj   for j < i
+     u_ij =  a_ij - sum_{k < i} l_ik u_kj           for j >= i
+   The inverse of the diagonal of U is stored, as in the exact factorization. Returns the first row of the chunk with a zero pivot, or -1.
+*/
+static PetscInt MatLUFactorSweep_SeqAIJ_Private(Mat_SeqAIJ *a, const MatScalar *aa, Mat_SeqAIJ *b, const PetscInt r[], const PetscInt ic[], PetscReal zeropivot, PetscInt rs, PetscInt re, const MatScalar *o, MatScalar *v, PetscScalar *w)
+{
+  const PetscInt *ai = a->i, *aj = a->j, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  PetscInt        zrow = -1;
+
+  for (PetscInt i = rs; i < re; i++) {
+    PetscScalar d;
+
+    for (PetscInt p = bi[i]; p < bi[i + 1]; p++) w[bj[p]] = 0.0;
+    for (PetscInt p = bdiag[i + 1] + 1; p <= bdiag[i]; p++) w[bj[p]] = 0.0;
+    for (PetscInt p = ai[r[i]]; p < ai[r[i] + 1]; p++) w[ic[aj[p]]] = aa[p];
+    for (PetscInt q = bi[i]; q < bi[i + 1]; q++) {
+      const PetscInt  k   = bj[q];
+      const MatScalar lik = o[q];
+
+      if (lik == 0.0) continue;
+      for (PetscInt p = bdiag[k + 1] + 1; p < bdiag[k]; p++) w[bj[p]] -= lik * o[p];
+    }
+    for (PetscInt q = bi[i]; q < bi[i + 1]; q++) v[q] = w[bj[q]] * o[bdiag[bj[q]]];
+    for (PetscInt p = bdiag[i + 1] + 1; p < bdiag[i]; p++) v[p] = w[bj[p]];
+    d = w[i];
+    if (PetscAbsScalar(d) <= zeropivot && zrow < 0) zrow = i;
+    v[bdiag[i]] = d != 0.0 ? 1.0 / d : 0.0; /* a zero pivot of an intermediate sweep drops the column of L instead of producing infinities */
+  }
+  return zrow;
+}
+
+/*
+   Fine-grained parallel ILU of Chow and Patel: the factor with the nonzero pattern computed by MatILUFactorSymbolic_SeqAIJ() is
+   the fixed point of MatLUFactorSweep_SeqAIJ_Private(). The initial guess is l_ij = a_ij / a_jj and u_ij = a_ij, then
+   info->factorsweeps sweeps update all the rows from the values of the previous sweep, so the rows of a sweep are
+   computed concurrently and the result does not depend on the number of threads. The sweeps converge to the exact ILU
+   factor after at most as many sweeps as the depth of the elimination tree of the factor.
+
+   With info->solvesweeps > 0, MatSolve() of the factor is MatSolve_SeqAIJ_Sweeps().
+*/
+PetscErrorCode MatLUFactorNumeric_SeqAIJ_Sweeps(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  const PetscInt   n = A->rmap->n, nsweeps = (PetscInt)info->factorsweeps, *bdiag = b->diag;
+  const PetscInt  *r, *ic;
+  const MatScalar *aa;
+  MatScalar       *o, *v = b->a;
+  PetscScalar     *w;
+  PetscInt        *zrow, zr = -1, nt = 1;
+
+  PetscFunctionBegin;
+  if (nsweeps <= 0) {
+    if (a->inode.size) PetscCall(MatLUFactorNumeric_SeqAIJ_Inode(B, A, info));
+    else PetscCall(MatLUFactorNumeric_SeqAIJ(B, A, info));
+  } else {
+#if defined(PETSC_HAVE_OPENMP)
+    nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+    PetscCall(ISGetIndices(b->row, &r));
+    PetscCall(ISGetIndices(b->icol, &ic));
+    PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+    PetscCall(PetscMalloc3(bdiag[0] + 1, &o, nt * n, &w, nt, &zrow));
+    PetscPragmaOMP(parallel num_threads(nt))
+    {
+      /* the initial guess is the sweep from L = U = 0 with the inverse of the diagonal of the permuted A */
+      PetscPragmaOMP(for schedule(static, 1))
+      for (PetscInt t = 0; t < nt; t++) {
+        PetscInt rs, re;
+
+        MatSeqAIJSweepsChunk_Private(n, nt, t, &rs, &re);
+        for (PetscInt i = rs; i < re; i++) {
+          PetscScalar d = 0.0;
+
+          for (PetscInt p = b->i[i]; p < b->i[i + 1]; p++) o[p] = 0.0;
+          for (PetscInt p = bdiag[i + 1] + 1; p < bdiag[i]; p++) o[p] = 0.0;
+          for (PetscInt p = a->i[r[i]]; p < a->i[r[i] + 1]; p++)
+            if (ic[a->j[p]] == i) d = aa[p];
+          o[bdiag[i]] = d != 0.0 ? 1.0 / d : 0.0;
+        }
+      }
+      for (PetscInt s = 0; s <= nsweeps; s++) {
+        PetscPragmaOMP(for schedule(static, 1))
+        for (PetscInt t = 0; t < nt; t++) {
+          PetscInt rs, re;
+
+          MatSeqAIJSweepsChunk_Private(n, nt, t, &rs, &re);
+          if (s) { /* the values of the previous sweep, rows [rs, re) of L and U are contiguous */
+            for (PetscInt p = b->i[rs]; p < b->i[re]; p++) o[p] = v[p];
+            for (PetscInt p = bdiag[re] + 1; p <= bdiag[rs]; p++) o[p] = v[p];
+          }
+        }
+        PetscPragmaOMP(for schedule(static, 1))
+        for (PetscInt t = 0; t < nt; t++) {
+          PetscInt rs, re;
+
+          MatSeqAIJSweepsChunk_Private(n, nt, t, &rs, &re);
+          zrow[t] = MatLUFactorSweep_SeqAIJ_Private(a, aa, b, r, ic, info->zeropivot, rs, re, o, v, w + t * n);
+        }
+      }
+    }
+    for (PetscInt t = 0; t < nt && zr < 0; t++) zr = zrow[t];
+    PetscCall(PetscFree3(o, w, zrow));
+    PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+    PetscCall(ISRestoreIndices(b->row, &r));
+    PetscCall(ISRestoreIndices(b->icol, &ic));
+    PetscCall(PetscLogFlops((nsweeps + 1.0) * 2.0 * b->nz));
+    if (zr >= 0) {
+      PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot row %" PetscInt_FMT " after %" PetscInt_FMT " sweeps, tolerance %g", zr, nsweeps, (double)info->zeropivot);
+      PetscCall(PetscInfo(A, "Detected zero pivot in row %" PetscInt_FMT " after %" PetscInt_FMT " sweeps, tolerance %g\n", zr, nsweeps, (double)info->zeropivot));
+      B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+      B->factorerror_zeropivot_value = PetscAbsScalar(v[bdiag[zr]]) > 0.0 ? 1.0 / PetscAbsScalar(v[bdiag[zr]]) : 0.0;
+      B->factorerror_zeropivot_row   = zr;
+    }
+    PetscCall(MatSeqAIJSetUpSolve_LU(B, A));
+    B->assembled    = PETSC_TRUE;
+    B->preallocated = PETSC_TRUE;
+  }
+  b->threads.solvesweeps = (PetscInt)info->solvesweeps;
+  if (b->threads.solvesweeps > 0) {
+    if (!b->threads.sweepwork) PetscCall(PetscMalloc1(3 * n, &b->threads.sweepwork));
+    B->ops->solve    = MatSolve_SeqAIJ_Sweeps;
+    B->ops->matsolve = NULL;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Approximate triangular solves with Jacobi sweeps: L y = b with y^0 = b, y^{m+1} = b - (L - I) y^m, then U x = y with
+   x^0 = D^{-1} y, x^{m+1} = D^{-1} (y - (U - D) x^m), where D is the diagonal of U. Each sweep is a sparse matrix-vector
+   product so the rows are computed concurrently.
+*/
+PetscErrorCode MatSolve_SeqAIJ_Sweeps(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt     n = A->rmap->n, nsweeps = a->threads.solvesweeps, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const MatScalar   *aa = a->a;
+  PetscScalar       *x, *t = a->threads.sweepwork, *y0 = t + n, *y1 = t + 2 * n;
+  const PetscScalar *b;
+  const PetscInt    *r, *c;
+#if defined(PETSC_HAVE_OPENMP)
+  const PetscInt nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
+  PetscPragmaOMP(parallel num_threads(nt))
+  {
+    PetscScalar *yo = t, *yn = y0;
+
+    PetscPragmaOMP(for schedule(static))
+    for (PetscInt i = 0; i < n; i++) t[i] = b[r[i]];
+    for (PetscInt s = 0; s < nsweeps; s++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt i = 0; i < n; i++) {
+        const PetscInt   nz  = ai[i + 1] - ai[i];
+        const PetscInt  *vi  = aj + ai[i];
+        const MatScalar *v   = aa + ai[i];
+        PetscScalar      sum = t[i];
+
+        PetscSparseDenseMinusDot(sum, yo, v, vi, nz);
+        yn[i] = sum;
+      }
+      yo = yn;
+      yn = (yn == y0) ? y1 : y0;
+    }
+    /* yo is y, yn and t (if y is not t) are free for the backward sweeps */
+    {
+      const PetscScalar *y  = yo;
+      PetscScalar       *xo = yn, *xn = (yo == t) ? y1 : t;
+
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt i = 0; i < n; i++) xo[i] = y[i] * aa[adiag[i]];
+      for (PetscInt s = 0; s < nsweeps; s++) {
+        PetscPragmaOMP(for schedule(static))
+        for (PetscInt i = 0; i < n; i++) {
+          const PetscInt   nz  = adiag[i] - adiag[i + 1] - 1;
+          const PetscInt  *vi  = aj + adiag[i + 1] + 1;
+          const MatScalar *v   = aa + adiag[i + 1] + 1;
+          PetscScalar      sum = y[i];
+
+          PetscSparseDenseMinusDot(sum, xo, v, vi, nz);
+          xn[i] = sum * v[nz]; /* v[nz] = aa[adiag[i]] */
+        }
+        {
+          PetscScalar *tmp = xo;
+
+          xo = xn;
+          xn = tmp;
+        }
+      }
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt i = 0; i < n; i++) x[c[i]] = xo[i];
+    }
+  }
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(nsweeps * (2.0 * a->nz - n) + n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Level scheduled solve of the nrhs right-hand sides b with a LU factor, see MatSolve_SeqAIJ(). The forward substitution is stored
+   in t; with the natural ordering (r and c NULL) t is x, otherwise x is gathered from t with the column permutation.
+*/
+static void MatSolve_SeqAIJ_Levels_Private(Mat_SeqAIJ *a, PetscInt nt, PetscInt nrhs, const PetscInt r[], const PetscInt c[], const PetscScalar *b, PetscInt ldb, PetscScalar *t, PetscInt ldt, PetscScalar *x, PetscInt ldx)
+{
+  const Mat_SeqAIJ_Levels *lv = &a->threads.levels;
+  const PetscInt          *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const MatScalar         *aa = a->a;
+
+  PetscPragmaOMP(parallel num_threads(nt))
+  {
+    /* forward solve the lower triangular */
+    for (PetscInt l = 0; l < lv->nlevels[0]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt k = lv->lstart[0][l]; k < lv->lstart[0][l + 1]; k++) {
+        const PetscInt   i  = lv->lrows[0][k];
+        const PetscInt   nz = ai[i + 1] - ai[i];
+        const PetscInt  *vi = aj + ai[i];
+        const MatScalar *v  = aa + ai[i];
+
+        for (PetscInt q = 0; q < nrhs; q++) {
+          PetscScalar *tq  = t + q * ldt;
+          PetscScalar  sum = b[q * ldb + (r ? r[i] : i)];
+
+          PetscSparseDenseMinusDot(sum, tq, v, vi, nz);
+          tq[i] = sum;
+        }
+      }
+    }
+    /* backward solve the upper triangular */
+    for (PetscInt l = 0; l < lv->nlevels[1]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt k = lv->lstart[1][l]; k < lv->lstart[1][l + 1]; k++) {
+        const PetscInt   i  = lv->lrows[1][k];
+        const PetscInt   nz = adiag[i] - adiag[i + 1] - 1;
+        const PetscInt  *vi = aj + adiag[i + 1] + 1;
+        const MatScalar *v  = aa + adiag[i + 1] + 1;
+
+        for (PetscInt q = 0; q < nrhs; q++) {
+          PetscScalar *tq  = t + q * ldt;
+          PetscScalar  sum = tq[i];
+
+          PetscSparseDenseMinusDot(sum, tq, v, vi, nz);
+          tq[i] = sum * v[nz]; /* v[nz] = aa[adiag[i]] */
+          if (c) x[q * ldx + c[i]] = tq[i];
+        }
+      }
+    }
+  }
+}
+
+PetscErrorCode MatSolve_SeqAIJ_Threads(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt     n = A->rmap->n, nt = PetscMax(PetscNumOMPThreads, 1);
+  const PetscInt    *r = NULL, *c = NULL;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  PetscBool          identity = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJSetUpLevels_LU(A));
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  if (a->row && a->col) {
+    PetscBool ridentity, cidentity;
+
+    PetscCall(ISIdentity(a->row, &ridentity));
+    PetscCall(ISIdentity(a->col, &cidentity));
+    identity = (PetscBool)(ridentity && cidentity);
+  }
+  if (identity) MatSolve_SeqAIJ_Levels_Private(a, nt, 1, NULL, NULL, b, n, x, n, x, n);
+  else {
+    PetscCall(ISGetIndices(a->row, &r));
+    PetscCall(ISGetIndices(a->col, &c));
+    MatSolve_SeqAIJ_Levels_Private(a, nt, 1, r, c, b, n, a->solve_work, n, x, n);
+    PetscCall(ISRestoreIndices(a->row, &r));
+    PetscCall(ISRestoreIndices(a->col, &c));
+  }
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* every row of the factor is applied to all the right-hand sides before moving to the next row */
+PetscErrorCode MatMatSolve_SeqAIJ_Threads(Mat A, Mat B, Mat X)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt     n = A->rmap->n, nt = PetscMax(PetscNumOMPThreads, 1);
+  const PetscInt    *r, *c;
+  PetscInt           nrhs = B->cmap->n, ldb, ldx;
+  PetscScalar       *x, *t;
+  const PetscScalar *b;
+  PetscBool          isdense;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)B, MATSEQDENSE, &isdense));
+  PetscCheck(isdense, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "B matrix must be a SeqDense matrix");
+  if (X != B) {
+    PetscCall(PetscObjectTypeCompare((PetscObject)X, MATSEQDENSE, &isdense));
+    PetscCheck(isdense, PETSC_COMM_SELF, PETSC_ERR_ARG_INCOMP, "X matrix must be a SeqDense matrix");
+  }
+  PetscCall(MatSeqAIJSetUpLevels_LU(A));
+  PetscCall(MatDenseGetArrayRead(B, &b));
+  PetscCall(MatDenseGetLDA(B, &ldb));
+  PetscCall(MatDenseGetArray(X, &x));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
+  PetscCall(PetscMalloc1(n * nrhs, &t));
+  MatSolve_SeqAIJ_Levels_Private(a, nt, nrhs, r, c, b, ldb, t, n, x, ldx);
+  PetscCall(PetscFree(t));
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(MatDenseRestoreArrayRead(B, &b));
+  PetscCall(MatDenseRestoreArray(X, &x));
+  PetscCall(PetscLogFlops(nrhs * (2.0 * a->nz - n)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Level scheduled solve with a Cholesky or ICC factor, see MatSolve_SeqSBAIJ_1() */
+PetscErrorCode MatSolve_SeqSBAIJ_1_Threads(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqSBAIJ            *a  = (Mat_SeqSBAIJ *)A->data;
+  const Mat_SeqAIJ_Levels *lv = &a->levels;
+  const PetscInt           n = A->rmap->n, nt = PetscMax(PetscNumOMPThreads, 1), *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt          *rp = NULL;
+  const MatScalar         *aa = a->a;
+  PetscScalar             *x, *t, *z;
+  const PetscScalar       *b;
+  PetscBool                identity;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqSBAIJSetUpLevels_Cholesky(A));
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISIdentity(a->row, &identity));
+  if (!identity) PetscCall(ISGetIndices(a->row, &rp));
+  t = rp ? a->solve_work : x;
+  z = lv->work;
+  PetscPragmaOMP(parallel num_threads(nt))
+  {
+    /* solve U^T*D*y = perm(b) by forward substitution, z is U^T*D*y */
+    for (PetscInt l = 0; l < lv->nlevels[0]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt k = lv->lstart[0][l]; k < lv->lstart[0][l + 1]; k++) {
+        const PetscInt i   = lv->lrows[0][k];
+        PetscScalar    sum = b[rp ? rp[i] : i];
+
+        for (PetscInt p = lv->tstart[i]; p < lv->tstart[i + 1]; p++) sum += aa[lv->tpos[p]] * z[lv->trow[p]];
+        z[i] = sum;
+        t[i] = sum * aa[adiag[i]]; /* aa[adiag[i]] = 1/D(i) */
+      }
+    }
+    /* solve U*perm(x) = y by back substitution */
+    for (PetscInt l = 0; l < lv->nlevels[1]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt k = lv->lstart[1][l]; k < lv->lstart[1][l + 1]; k++) {
+        const PetscInt i   = lv->lrows[1][k];
+        PetscScalar    sum = t[i];
+
+        for (PetscInt p = adiag[i] - 1; p >= ai[i]; p--) sum += aa[p] * t[aj[p]];
+        t[i] = sum;
+        if (rp) x[rp[i]] = sum;
+      }
+    }
+  }
+  if (rp) PetscCall(ISRestoreIndices(a->row, &rp));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(4.0 * a->nz - 3.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMult_SeqAIJ_Threads(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+  const PetscInt    *ii, *ridx = NULL, *rstart;
+  PetscInt           m = A->rmap->n, nt;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp(A));
+  nt     = a->threads.nthreads;
+  rstart = a->threads.rstart;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  ii = a->i;
+  if (usecprow) {
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+    for (PetscInt i = 0; i < m; i++) y[i] = 0.0;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt   n   = ii[i + 1] - ii[i];
+      const PetscInt  *aj  = a->j + ii[i];
+      const MatScalar *aa  = a_a + ii[i];
+      PetscScalar      sum = 0.0;
+
+      PetscSparseDensePlusDot(sum, x, aa, aj, n);
+      y[usecprow ? ridx[i] : i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+  const PetscInt    *ii, *ridx = NULL, *rstart;
+  PetscInt           m = A->rmap->n, nt;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp(A));
+  nt     = a->threads.nthreads;
+  rstart = a->threads.rstart;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  ii = a->i;
+  if (usecprow) {
+    if (zz != yy) {
+      PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+      for (PetscInt i = 0; i < m; i++) z[i] = y[i];
+    }
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt   n   = ii[i + 1] - ii[i];
+      const PetscInt  *aj  = a->j + ii[i];
+      const MatScalar *aa  = a_a + ii[i];
+      const PetscInt   row = usecprow ? ridx[i] : i;
+      PetscScalar      sum = y[row];
+
+      PetscSparseDensePlusDot(sum, x, aa, aj, n);
+      z[row] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat A, Vec xx, Vec zz, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *y, *work;
+  const PetscScalar *x;
+  const MatScalar   *a_a;
+  const PetscInt    *ii, *ridx = NULL, *rstart;
+  PetscInt           n = A->cmap->n, nt;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp(A));
+  nt     = a->threads.nthreads;
+  rstart = a->threads.rstart;
+  if (a->threads.worksize < nt * n) {
+    PetscCall(PetscFree(a->threads.work));
+    a->threads.worksize = nt * n;
+    PetscCall(PetscMalloc1(a->threads.worksize, &a->threads.work));
+  }
+  work = a->threads.work;
+  if (zz != yy) PetscCall(VecCopy(zz, yy));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  ii = a->i;
+  if (usecprow) {
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscScalar *yt = work + t * n;
+
+    for (PetscInt j = 0; j < n; j++) yt[j] = 0.0;
+    for (PetscInt i = rstart[t]; i < rstart[t + 1]; i++) {
+      const PetscInt    nz    = ii[i + 1] - ii[i];
+      const PetscInt   *idx   = a->j + ii[i];
+      const MatScalar  *v     = a_a + ii[i];
+      const PetscScalar alpha = x[usecprow ? ridx[i] : i];
+
+      for (PetscInt j = 0; j < nz; j++) yt[idx[j]] += alpha * v[j];
+    }
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscInt j = 0; j < n; j++) {
+    PetscScalar sum = y[j];
+
+    for (PetscInt t = 0; t < nt; t++) sum += work[t * n + j];
+    y[j] = sum;
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz + (nt - 1) * n));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* first i with (jmap[i] - jmap[0]) + i >= t/nt of the total, so that chunk t of the segments is [i(t), i(t+1)) */
+static inline PetscCount MatSeqAIJThreadsCOOChunk_Private(PetscCount n, const PetscCount jmap[], PetscInt nt, PetscInt t)
+{
+  const PetscCount target = (((jmap[n] - jmap[0]) + n) * t) / nt;
+  PetscCount       lo = 0, hi = n;
+
+  while (lo < hi) {
+    const PetscCount mid = lo + (hi - lo) / 2;
+
+    if ((jmap[mid] - jmap[0]) + mid < target) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/*
+   MatSeqAIJThreadsSumCOO - a[imap[i]] = (zero ? 0 : a[imap[i]]) + sum of v[perm[k]] for k in [jmap[i], jmap[i+1]), for i < n
+
+   A NULL imap[] is the identity. The a[imap[i]] are distinct, so the threads never write to the same entry
+*/
+void MatSeqAIJThreadsSumCOO(PetscCount n, const PetscCount jmap[], const PetscCount perm[], const PetscCount imap[], const PetscScalar v[], PetscBool zero, PetscScalar a[])
+{
+  const PetscInt nt = PetscMax(PetscNumOMPThreads, 1);
+
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    const PetscCount start = MatSeqAIJThreadsCOOChunk_Private(n, jmap, nt, t), end = MatSeqAIJThreadsCOOChunk_Private(n, jmap, nt, t + 1);
+
+    for (PetscCount i = start; i < end; i++) {
+      const PetscCount l   = imap ? imap[i] : i;
+      PetscScalar      sum = 0.0;
+
+      for (PetscCount k = jmap[i]; k < jmap[i + 1]; k++) sum += v[perm[k]];
+      a[l] = (zero ? 0.0 : a[l]) + sum;
+    }
+  }
+}
+
+/* buf[i] = v[perm[i]] for i < n */
+void MatSeqAIJThreadsGatherCOO(PetscCount n, const PetscCount perm[], const PetscScalar v[], PetscScalar buf[])
+{
+  const PetscInt nt = PetscMax(PetscNumOMPThreads, 1);
+
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscCount i = 0; i < n; i++) buf[i] = v[perm[i]];
+}
+#endif
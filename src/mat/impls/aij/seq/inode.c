@@ -346,31 +346,27 @@ static PetscErrorCode MatRestoreColumnIJ_SeqAIJ_Inode(Mat A, PetscInt oshift, Pe
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-PetscErrorCode MatMult_SeqAIJ_Inode(Mat A, Vec xx, Vec yy)
+/*
+   Computes y = A x for the inodes [nstart, nend) of A, where row is the first row of inode nstart.
+   Returns PETSC_FALSE if an unsupported inode size is encountered. It does not use PetscCall() so it
+   can be called by several threads at once on disjoint inode ranges.
+*/
+static inline PetscBool MatMult_SeqAIJ_Inode_Private(const Mat_SeqAIJ *a, PetscInt nstart, PetscInt nend, PetscInt row, const PetscScalar *x, PetscScalar *y, PetscInt *nonzerorows)
 {
-  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
-  PetscScalar        sum1, sum2, sum3, sum4, sum5, tmp0, tmp1;
-  PetscScalar       *y;
-  const PetscScalar *x;
-  const MatScalar   *v1, *v2, *v3, *v4, *v5;
-  PetscInt           i1, i2, n, i, row, node_max, nsz, sz, nonzerorow = 0;
-  const PetscInt    *idx, *ns, *ii;
+  PetscScalar      sum1, sum2, sum3, sum4, sum5, tmp0, tmp1;
+  const MatScalar *v1, *v2, *v3, *v4, *v5;
+  PetscInt         i1, i2, n, i, nsz, sz, nonzerorow = 0;
+  const PetscInt  *idx, *ns = a->inode.size, *ii;
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
   #pragma disjoint(*x, *y, *v1, *v2, *v3, *v4, *v5)
 #endif
 
-  PetscFunctionBegin;
-  PetscCheck(a->inode.size, PETSC_COMM_SELF, PETSC_ERR_COR, "Missing Inode Structure");
-  node_max = a->inode.node_count;
-  ns       = a->inode.size; /* Node Size array */
-  PetscCall(VecGetArrayRead(xx, &x));
-  PetscCall(VecGetArray(yy, &y));
-  idx = a->j;
-  v1  = a->a;
-  ii  = a->i;
+  idx = a->j + a->i[row];
+  v1  = a->a + a->i[row];
+  ii  = a->i + row;
 
-  for (i = 0, row = 0; i < node_max; ++i) {
+  for (i = nstart; i < nend; ++i) {
     nsz = ns[i];
     n   = ii[1] - ii[0];
     nonzerorow += (n > 0) * nsz;
@@ -540,40 +536,65 @@ PetscErrorCode MatMult_SeqAIJ_Inode(Mat A, Vec xx, Vec yy)
       idx += 4 * sz;
       break;
     default:
-      SETERRQ(PETSC_COMM_SELF, PETSC_ERR_COR, "Node size not yet supported");
+      return PETSC_FALSE;
     }
   }
-  PetscCall(VecRestoreArrayRead(xx, &x));
-  PetscCall(VecRestoreArray(yy, &y));
-  PetscCall(PetscLogFlops(2.0 * a->nz - nonzerorow));
-  PetscFunctionReturn(PETSC_SUCCESS);
+  *nonzerorows = nonzerorow;
+  return PETSC_TRUE;
 }
 
-/* Almost same code as the MatMult_SeqAIJ_Inode() */
-PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A, Vec xx, Vec zz, Vec yy)
+PetscErrorCode MatMult_SeqAIJ_Inode(Mat A, Vec xx, Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
-  PetscScalar        sum1, sum2, sum3, sum4, sum5, tmp0, tmp1;
-  const MatScalar   *v1, *v2, *v3, *v4, *v5;
+  PetscScalar       *y;
   const PetscScalar *x;
-  PetscScalar       *y, *z, *zt;
-  PetscInt           i1, i2, n, i, row, node_max, nsz, sz;
-  const PetscInt    *idx, *ns, *ii;
+  PetscInt           nonzerorow = 0, unsupported = 0;
 
   PetscFunctionBegin;
   PetscCheck(a->inode.size, PETSC_COMM_SELF, PETSC_ERR_COR, "Missing Inode Structure");
-  node_max = a->inode.node_count;
-  ns       = a->inode.size; /* Node Size array */
-
   PetscCall(VecGetArrayRead(xx, &x));
-  PetscCall(VecGetArrayPair(zz, yy, &z, &y));
-  zt = z;
+  PetscCall(VecGetArray(yy, &y));
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    const PetscInt *nstart, *nrow;
+    PetscInt        nt;
+
+    PetscCall(MatSeqAIJThreadsSetUp(A));
+    nt     = a->threads.nthreads;
+    nstart = a->threads.nstart;
+    nrow   = a->threads.nrow;
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1) reduction(+ : nonzerorow, unsupported))
+    for (PetscInt t = 0; t < nt; t++) {
+      PetscInt nzr = 0;
+
+      unsupported += !MatMult_SeqAIJ_Inode_Private(a, nstart[t], nstart[t + 1], nrow[t], x, y, &nzr);
+      nonzerorow += nzr;
+    }
+  } else
+#endif
+    unsupported = !MatMult_SeqAIJ_Inode_Private(a, 0, a->inode.node_count, 0, x, y, &nonzerorow);
+  PetscCheck(!unsupported, PETSC_COMM_SELF, PETSC_ERR_COR, "Node size not yet supported");
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(PetscLogFlops(2.0 * a->nz - nonzerorow));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  idx = a->j;
-  v1  = a->a;
-  ii  = a->i;
+/* Almost same code as the MatMult_SeqAIJ_Inode_Private(), computes y = z + A x for the inodes [nstart, nend) */
+static inline PetscBool MatMultAdd_SeqAIJ_Inode_Private(const Mat_SeqAIJ *a, PetscInt nstart, PetscInt nend, PetscInt row, const PetscScalar *x, const PetscScalar *z, PetscScalar *y)
+{
+  PetscScalar        sum1, sum2, sum3, sum4, sum5, tmp0, tmp1;
+  const MatScalar   *v1, *v2, *v3, *v4, *v5;
+  const PetscScalar *zt;
+  PetscInt           i1, i2, n, i, nsz, sz;
+  const PetscInt    *idx, *ns = a->inode.size, *ii;
 
-  for (i = 0, row = 0; i < node_max; ++i) {
+  zt  = z + row;
+  idx = a->j + a->i[row];
+  v1  = a->a + a->i[row];
+  ii  = a->i + row;
+
+  for (i = nstart; i < nend; ++i) {
     nsz = ns[i];
     n   = ii[1] - ii[0];
     ii += nsz;
@@ -740,9 +761,38 @@ PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A, Vec xx, Vec zz, Vec yy)
       idx += 4 * sz;
       break;
     default:
-      SETERRQ(PETSC_COMM_SELF, PETSC_ERR_COR, "Node size not yet supported");
+      return PETSC_FALSE;
     }
   }
+  return PETSC_TRUE;
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat A, Vec xx, Vec zz, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y, *z;
+  PetscInt           unsupported = 0;
+
+  PetscFunctionBegin;
+  PetscCheck(a->inode.size, PETSC_COMM_SELF, PETSC_ERR_COR, "Missing Inode Structure");
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(zz, yy, &z, &y));
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use) {
+    const PetscInt *nstart, *nrow;
+    PetscInt        nt;
+
+    PetscCall(MatSeqAIJThreadsSetUp(A));
+    nt     = a->threads.nthreads;
+    nstart = a->threads.nstart;
+    nrow   = a->threads.nrow;
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1) reduction(+ : unsupported))
+    for (PetscInt t = 0; t < nt; t++) unsupported += !MatMultAdd_SeqAIJ_Inode_Private(a, nstart[t], nstart[t + 1], nrow[t], x, z, y);
+  } else
+#endif
+    unsupported = !MatMultAdd_SeqAIJ_Inode_Private(a, 0, a->inode.node_count, 0, x, z, y);
+  PetscCheck(!unsupported, PETSC_COMM_SELF, PETSC_ERR_COR, "Node size not yet supported");
   PetscCall(VecRestoreArrayRead(xx, &x));
   PetscCall(VecRestoreArrayPair(zz, yy, &z, &y));
   PetscCall(PetscLogFlops(2.0 * a->nz));
@@ -1945,8 +1995,15 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
-  C->assembled              = PETSC_TRUE;
-  C->preallocated           = PETSC_TRUE;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->threads.use && PetscNumOMPThreads > 1) {
+    PetscCall(MatSeqAIJSetUpLevels_LU(C));
+    C->ops->solve    = MatSolve_SeqAIJ_Threads;
+    C->ops->matsolve = MatMatSolve_SeqAIJ_Threads;
+  }
+#endif
+  C->assembled    = PETSC_TRUE;
+  C->preallocated = PETSC_TRUE;
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -137,6 +137,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A, Mat B, PetscReal fill, Ma
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* threaded */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads(A, B, fill, C));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
   if (flg) {
@@ -1210,6 +1217,309 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Sorted(Mat A, Mat B, PetscReal f
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   OpenMP threaded C = A*B
+
+   The rows of C are split into one contiguous chunk per thread with about the same number of multiply-adds. Each
+   thread gathers its rows of C in a private accumulator: a dense array of length B->cmap->n or, when such arrays
+   would be much longer than the rows of C, an open addressing hash table sized after the longest row. The symbolic
+   phase first counts the nonzeros of every row of C and then fills the column indices in place.
+*/
+static PetscErrorCode MatDestroy_MatMatMultThreads(void *data)
+{
+  Mat_MatMatMultThreads *mm = (Mat_MatMatMultThreads *)data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(mm->rstart));
+  PetscCall(PetscFree3(mm->keys, mm->slots, mm->vals));
+  PetscCall(PetscFree(mm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatMultThreadsCreate_Private(Mat A, Mat B, Mat_MatMatMultThreads **mmt)
+{
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  const PetscInt        *ai = a->i, *aj = a->j, *bi = b->i;
+  PetscInt               am = A->rmap->n, bn = B->cmap->n, nt = 1, fmax = 1, hsize;
+  PetscInt64            *w;
+  Mat_MatMatMultThreads *mm;
+
+  PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  nt = PetscMax(PetscNumOMPThreads, 1);
+#endif
+  PetscCall(PetscNew(&mm));
+  PetscCall(PetscMalloc1(nt + 1, &mm->rstart));
+  /* w[i] is the number of multiply-adds of the rows before i, the ones of a row also bound its number of nonzeros */
+  PetscCall(PetscMalloc1(am + 1, &w));
+  w[0] = 0;
+  for (PetscInt i = 0; i < am; i++) {
+    PetscInt f = 0;
+
+    for (PetscInt k = ai[i]; k < ai[i + 1]; k++) f += bi[aj[k] + 1] - bi[aj[k]];
+    w[i + 1] = w[i] + f;
+    fmax     = PetscMax(fmax, f + 1); /* one more for C->force_diagonals */
+  }
+  MatSeqAIJThreadsSplit(am, w, nt, mm->rstart);
+  PetscCall(PetscFree(w));
+
+  /* the hash tables are at most half full */
+  for (hsize = 16; hsize < 2 * fmax; hsize *= 2);
+  mm->nt    = nt;
+  mm->lsize = fmax;
+  if (4 * hsize < bn) {
+    mm->mask = hsize - 1;
+    mm->size = hsize;
+  } else {
+    mm->mask = -1;
+    mm->size = bn;
+  }
+  PetscCall(PetscMalloc3(nt * mm->size, &mm->keys, nt * mm->lsize, &mm->slots, nt * mm->size, &mm->vals));
+  /* each thread touches its own accumulator first */
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    for (PetscInt k = t * mm->size; k < (t + 1) * mm->size; k++) {
+      mm->keys[k] = -1;
+      mm->vals[k] = 0.0;
+    }
+  }
+  PetscCall(PetscInfo(A, "Threaded MatMatMult() on %" PetscInt_FMT " threads with %s accumulators of length %" PetscInt_FMT "\n", nt, mm->mask < 0 ? "dense" : "hash", mm->size));
+  *mmt = mm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline PetscInt MatMatMultThreadsHash_Private(PetscInt mask, PetscInt col)
+{
+  return mask < 0 ? col : (PetscInt)(((size_t)col * 2654435761U) & (size_t)mask);
+}
+
+/* returns the slot of column col in the accumulator, col is inserted if it is not there yet */
+static inline PetscInt MatMatMultThreadsInsert_Private(PetscInt mask, PetscInt keys[], PetscInt col, PetscBool *isnew)
+{
+  PetscInt s = MatMatMultThreadsHash_Private(mask, col);
+
+  if (mask >= 0)
+    while (keys[s] >= 0 && keys[s] != col) s = (s + 1) & mask;
+  *isnew  = keys[s] < 0 ? PETSC_TRUE : PETSC_FALSE;
+  keys[s] = col;
+  return s;
+}
+
+/* returns the slot of column col in the accumulator, -1 if col is not there */
+static inline PetscInt MatMatMultThreadsFind_Private(PetscInt mask, const PetscInt keys[], PetscInt col)
+{
+  PetscInt s = MatMatMultThreadsHash_Private(mask, col);
+
+  if (mask >= 0)
+    while (keys[s] >= 0 && keys[s] != col) s = (s + 1) & mask;
+  return keys[s] == col ? s : -1;
+}
+
+/* PetscSortInt() cannot be called by several threads at once since it pushes on the PETSc stack */
+static inline void MatMatMultThreadsSortInt_Private(PetscInt n, PetscInt X[])
+{
+  if (n < 32) { /* insertion sort */
+    for (PetscInt i = 1; i < n; i++) {
+      const PetscInt x = X[i];
+      PetscInt       j = i;
+
+      for (; j > 0 && X[j - 1] > x; j--) X[j] = X[j - 1];
+      X[j] = x;
+    }
+  } else { /* heap sort */
+    for (PetscInt end = n, start = n / 2 - 1; end > 1;) {
+      PetscInt root, x;
+
+      if (start >= 0) root = start--;
+      else {
+        x      = X[--end];
+        X[end] = X[0];
+        X[0]   = x;
+        root   = 0;
+      }
+      x = X[root];
+      for (PetscInt child; (child = 2 * root + 1) < end; root = child) {
+        if (child + 1 < end && X[child + 1] > X[child]) child++;
+        if (X[child] <= x) break;
+        X[root] = X[child];
+      }
+      X[root] = x;
+    }
+  }
+}
+
+/* gathers the distinct columns of row i of A*B in cols[] when it is not NULL, unsorted, and returns their number */
+static inline PetscInt MatMatMultSymbolicRow_Threads_Private(const Mat_SeqAIJ *a, const Mat_SeqAIJ *b, PetscInt i, PetscBool diag, PetscInt mask, PetscInt keys[], PetscInt slots[], PetscInt cols[])
+{
+  PetscInt  n = 0, s;
+  PetscBool isnew;
+
+  for (PetscInt k = a->i[i]; k < a->i[i + 1]; k++) {
+    const PetscInt brow = a->j[k];
+
+    for (PetscInt l = b->i[brow]; l < b->i[brow + 1]; l++) {
+      s = MatMatMultThreadsInsert_Private(mask, keys, b->j[l], &isnew);
+      if (isnew) slots[n++] = s;
+    }
+  }
+  if (diag) {
+    s = MatMatMultThreadsInsert_Private(mask, keys, i, &isnew);
+    if (isnew) slots[n++] = s;
+  }
+  for (PetscInt k = 0; k < n; k++) {
+    if (cols) cols[k] = keys[slots[k]];
+    keys[slots[k]] = -1;
+  }
+  return n;
+}
+
+/* computes the cnz values ca[] of row i of A*B, with column indices cj[], and returns the number of flops */
+static inline PetscLogDouble MatMatMultNumericRow_Threads_Private(const Mat_SeqAIJ *a, const PetscScalar aa[], const Mat_SeqAIJ *b, const PetscScalar ba[], PetscInt i, PetscInt cnz, const PetscInt cj[], PetscScalar ca[], PetscInt mask, PetscInt keys[], PetscInt slots[], PetscScalar vals[])
+{
+  const PetscInt *bi = b->i, *bj = b->j;
+  PetscLogDouble  flops = 0.0;
+  PetscInt        n     = 0, s;
+  PetscBool       isnew;
+
+  for (PetscInt k = a->i[i]; k < a->i[i + 1]; k++) {
+    const PetscInt    brow = a->j[k];
+    const PetscScalar av   = aa[k];
+
+    if (mask < 0) {
+      for (PetscInt l = bi[brow]; l < bi[brow + 1]; l++) vals[bj[l]] += av * ba[l];
+    } else {
+      for (PetscInt l = bi[brow]; l < bi[brow + 1]; l++) {
+        s = MatMatMultThreadsInsert_Private(mask, keys, bj[l], &isnew);
+        if (isnew) slots[n++] = s;
+        vals[s] += av * ba[l];
+      }
+    }
+    flops += 2 * (bi[brow + 1] - bi[brow]);
+  }
+  if (mask < 0) {
+    for (PetscInt k = 0; k < cnz; k++) {
+      ca[k]        = vals[cj[k]];
+      vals[cj[k]] = 0.0;
+    }
+  } else {
+    for (PetscInt k = 0; k < cnz; k++) {
+      s     = MatMatMultThreadsFind_Private(mask, keys, cj[k]);
+      ca[k] = s < 0 ? 0.0 : vals[s];
+    }
+    for (PetscInt k = 0; k < n; k++) {
+      keys[slots[k]] = -1;
+      vals[slots[k]] = 0.0;
+    }
+  }
+  return flops;
+}
+
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads(Mat A, Mat B, PetscReal fill, Mat C)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c;
+  PetscInt               am = A->rmap->n, bn = B->cmap->n, bm = B->rmap->n, nt, *ci, *cj;
+  const PetscBool        diag = (C->force_diagonals && am <= bn) ? PETSC_TRUE : PETSC_FALSE;
+  Mat_MatMatMultThreads *mm   = NULL;
+  PetscContainer         container;
+  PetscReal              afill;
+
+  PetscFunctionBegin;
+  PetscCall(MatMatMultThreadsCreate_Private(A, B, &mm));
+  nt = mm->nt;
+
+  /* count the nonzeros of each row of C */
+  PetscCall(PetscMalloc1(am + 1, &ci));
+  ci[0] = 0;
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt *keys = mm->keys + t * mm->size, *slots = mm->slots + t * mm->lsize;
+
+    for (PetscInt i = mm->rstart[t]; i < mm->rstart[t + 1]; i++) ci[i + 1] = MatMatMultSymbolicRow_Threads_Private(a, b, i, diag, mm->mask, keys, slots, NULL);
+  }
+  for (PetscInt i = 0; i < am; i++) ci[i + 1] += ci[i];
+
+  /* fill in the column indices */
+  PetscCall(PetscMalloc1(ci[am], &cj));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt *keys = mm->keys + t * mm->size, *slots = mm->slots + t * mm->lsize;
+
+    for (PetscInt i = mm->rstart[t]; i < mm->rstart[t + 1]; i++) {
+      PetscInt n = MatMatMultSymbolicRow_Threads_Private(a, b, i, diag, mm->mask, keys, slots, cj + ci[i]);
+
+      MatMatMultThreadsSortInt_Private(n, cj + ci[i]);
+    }
+  }
+
+  /* put together the new symbolic matrix */
+  PetscCall(MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A), am, bn, ci, cj, NULL, ((PetscObject)A)->type_name, C));
+  PetscCall(MatSetBlockSizesFromMats(C, A, B));
+
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ *)C->data;
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCall(PetscContainerSetPointer(container, mm));
+  PetscCall(PetscContainerSetUserDestroy(container, MatDestroy_MatMatMultThreads));
+  PetscCall(PetscObjectCompose((PetscObject)C, "__PETSc__ab_threads", (PetscObject)container));
+  PetscCall(PetscObjectDereference((PetscObject)container));
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am] / PetscMax(a->i[am] + b->i[bm], 1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads(Mat A, Mat B, Mat C)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data, *c = (Mat_SeqAIJ *)C->data;
+  const PetscInt        *ci = c->i, *cj = c->j;
+  PetscInt               cm = C->rmap->n, nt;
+  PetscLogDouble         flops = 0.0;
+  PetscScalar           *ca;
+  const PetscScalar     *aa, *ba;
+  Mat_MatMatMultThreads *mm;
+  PetscContainer         container;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectQuery((PetscObject)C, "__PETSc__ab_threads", (PetscObject *)&container));
+  PetscCheck(container, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Missing data structure, C was not created by MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads()");
+  PetscCall(PetscContainerGetPointer(container, (void **)&mm));
+  nt = mm->nt;
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(MatSeqAIJGetArrayRead(B, &ba));
+  if (!c->a) { /* first call of MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads() */
+    PetscCall(PetscMalloc1(ci[cm] + 1, &ca));
+    c->a      = ca;
+    c->free_a = PETSC_TRUE;
+  } else ca = c->a;
+
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1) reduction(+ : flops))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt    *keys = mm->keys + t * mm->size, *slots = mm->slots + t * mm->lsize;
+    PetscScalar *vals = mm->vals + t * mm->size;
+
+    for (PetscInt i = mm->rstart[t]; i < mm->rstart[t + 1]; i++) flops += MatMatMultNumericRow_Threads_Private(a, aa, b, ba, i, ci[i + 1] - ci[i], cj + ci[i], ca + ci[i], mm->mask, keys, slots, vals);
+  }
+#if defined(PETSC_HAVE_DEVICE)
+  if (C->offloadmask != PETSC_OFFLOAD_UNALLOCATED) C->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  PetscCall(MatAssemblyBegin(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(C, MAT_FINAL_ASSEMBLY));
+  PetscCall(PetscLogFlops(flops));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(MatSeqAIJRestoreArrayRead(B, &ba));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatDestroy_SeqAIJ_MatMatMultTrans(void *data)
 {
   Mat_MatMatTransMult *abt = (Mat_MatMatTransMult *)data;
@@ -1991,26 +2301,27 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt     alg     = 0; /* default algorithm */
   PetscBool    flg     = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[7] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge"};
-  PetscInt    nalg        = 7;
-#else
-  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "hypre"};
+  const char *algTypes[8] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded"};
   PetscInt    nalg        = 8;
+#else
+  const char *algTypes[9] = {"sorted", "scalable", "scalable_fast", "heap", "btheap", "llcondensed", "rowmerge", "threaded", "hypre"};
+  PetscInt    nalg        = 9;
 #endif
 
   PetscFunctionBegin;
-  /* Set default algorithm */
+  /* Set default algorithm, the threaded one if A uses the threaded MatMult() */
+  if (((Mat_SeqAIJ *)product->A->data)->threads.use) alg = 7;
   PetscCall(PetscStrcmp(C->product->alg, "default", &flg));
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
 
   /* Get runtime option */
   if (product->api_user) {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatMatMult", "Mat");
-    PetscCall(PetscOptionsEList("-matmatmult_via", "Algorithmic approach", "MatMatMult", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-matmatmult_via", "Algorithmic approach", "MatMatMult", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   } else {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatProduct_AB", "Mat");
-    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_AB", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_AB", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   }
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
@@ -2084,26 +2395,27 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool    flg     = PETSC_FALSE;
   PetscInt     alg     = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char *algTypes[2] = {"scalable", "rap"};
-  PetscInt    nalg        = 2;
-#else
-  const char *algTypes[3] = {"scalable", "rap", "hypre"};
+  const char *algTypes[3] = {"scalable", "rap", "threaded"};
   PetscInt    nalg        = 3;
+#else
+  const char *algTypes[4] = {"scalable", "rap", "threaded", "hypre"};
+  PetscInt    nalg        = 4;
 #endif
 
   PetscFunctionBegin;
-  /* Set default algorithm */
+  /* Set default algorithm, the threaded one if A uses the threaded MatMult() */
+  if (((Mat_SeqAIJ *)product->A->data)->threads.use) alg = 2;
   PetscCall(PetscStrcmp(product->alg, "default", &flg));
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
 
   /* Get runtime option */
   if (product->api_user) {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatPtAP", "Mat");
-    PetscCall(PetscOptionsEList("-matptap_via", "Algorithmic approach", "MatPtAP", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-matptap_via", "Algorithmic approach", "MatPtAP", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   } else {
     PetscOptionsBegin(PetscObjectComm((PetscObject)C), ((PetscObject)C)->prefix, "MatProduct_PtAP", "Mat");
-    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_PtAP", algTypes, nalg, algTypes[0], &alg, &flg));
+    PetscCall(PetscOptionsEList("-mat_product_algorithm", "Algorithmic approach", "MatProduct_PtAP", algTypes, nalg, algTypes[alg], &alg, &flg));
     PetscOptionsEnd();
   }
   if (flg) PetscCall(MatProductSetAlgorithm(C, (MatProductAlgorithm)algTypes[alg]));
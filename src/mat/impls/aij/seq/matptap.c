@@ -49,6 +49,14 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(PETSC_SUCCESS);
   }
 
+  /* "threaded" */
+  PetscCall(PetscStrcmp(alg, "threaded", &flg));
+  if (flg) {
+    PetscCall(MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threads(A, P, fill, C));
+    C->ops->productnumeric = MatProductNumeric_PtAP;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* hypre */
 #if defined(PETSC_HAVE_HYPRE)
   PetscCall(PetscStrcmp(alg, "hypre", &flg));
@@ -291,3 +299,51 @@ PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat A, Mat P, Mat C)
   C->product->data = atb;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+static PetscErrorCode MatDestroy_SeqAIJ_PtAPThreads(void *data)
+{
+  Mat_PtAPThreads *ptap = (Mat_PtAPThreads *)data;
+
+  PetscFunctionBegin;
+  PetscCall(MatDestroy(&ptap->Pt));
+  PetscCall(MatDestroy(&ptap->AP));
+  PetscCall(PetscFree(ptap));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  OpenMP threaded C = P^T*A*P, computed as the threaded products A*P and P^T*(A*P) so that each row of C is
+  assembled by a single thread. P^T and A*P are kept for the numeric phase.
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Threads(Mat A, Mat P, PetscReal fill, Mat C)
+{
+  Mat_PtAPThreads *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 4);
+  PetscCheck(!C->product->data, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Extra product struct not empty");
+  PetscCall(PetscNew(&ptap));
+  PetscCall(MatTranspose(P, MAT_INITIAL_MATRIX, &ptap->Pt));
+  PetscCall(MatCreate(PETSC_COMM_SELF, &ptap->AP));
+  PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads(A, P, fill, ptap->AP));
+  PetscCall(MatMatMultSymbolic_SeqAIJ_SeqAIJ_Threads(ptap->Pt, ptap->AP, fill, C));
+
+  C->product->data    = ptap;
+  C->product->destroy = MatDestroy_SeqAIJ_PtAPThreads;
+  C->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_Threads;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Threads(Mat A, Mat P, Mat C)
+{
+  Mat_PtAPThreads *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  ptap = (Mat_PtAPThreads *)C->product->data;
+  PetscCheck(ptap, PetscObjectComm((PetscObject)C), PETSC_ERR_PLIB, "Missing data structure");
+  PetscCall(MatTranspose(P, MAT_REUSE_MATRIX, &ptap->Pt));
+  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads(A, P, ptap->AP));
+  PetscCall(MatMatMultNumeric_SeqAIJ_SeqAIJ_Threads(ptap->Pt, ptap->AP, C));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
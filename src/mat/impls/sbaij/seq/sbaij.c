@@ -196,6 +196,8 @@ PetscErrorCode MatDestroy_SeqSBAIJ(Mat A)
   PetscCall(PetscFree(a->solve_work));
   PetscCall(PetscFree(a->sor_work));
   PetscCall(PetscFree(a->solves_work));
+  PetscCall(MatSeqAIJLevelsReset(&a->levels));
+  PetscCall(MatSeqAIJSupernodesReset(&a->supernodes));
   PetscCall(PetscFree(a->mult_work));
   PetscCall(PetscFree(a->saved_values));
   if (a->free_jshort) PetscCall(PetscFree(a->jshort));
@@ -22,6 +22,9 @@ typedef struct {
   Mat_SeqAIJ_Inode inode;
   unsigned short  *jshort;
   PetscBool        free_jshort;
+
+  Mat_SeqAIJ_Levels     levels;     /* level schedule used by MatSolve() of Cholesky and ICC factors computed from MATSEQAIJ */
+  Mat_SeqAIJ_Supernodes supernodes; /* supernodes of Cholesky factors computed from MATSEQAIJ, used by the supernodal numeric factorization */
 } Mat_SeqSBAIJ;
 
 PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqSBAIJ(Mat, Mat, IS, const MatFactorInfo *);
@@ -39,8 +39,228 @@ static const char citation[] = "@inproceedings{ZhangELLPACK2018,\n"
       vec_x    = _mm256_i32gather_pd(x, vec_idx, _MM_SCALE_8); \
       vec_y    = _mm256_fmadd_pd(vec_x, vec_vals, vec_y)
   #endif
+
+  #if defined(__AVX512F__)
+/*
+  z = y + A x with y = NULL for z = A x, for slice heights that are a multiple of 8 other than 8. A slice is processed as strips
+  of 8 rows, each strip reads 8 contiguous entries out of every slice column, with two accumulators for alternate columns.
+*/
+static PetscErrorCode MatMultAdd_SeqSELL_AVX512_Private(Mat A, const PetscScalar *x, const PetscScalar *y, PetscScalar *z)
+{
+  Mat_SeqSELL *a           = (Mat_SeqSELL *)A->data;
+  PetscInt     sliceheight = a->sliceheight, m = A->rmap->n;
+  __m512d      vec_x, vec_y, vec_vals, vec_x2, vec_y2, vec_vals2;
+  __m256i      vec_idx, vec_idx2;
+  __mmask8     mask;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < a->totalslices; i++) { /* loop over slices */
+    const PetscInt ncol = (a->sliidx[i + 1] - a->sliidx[i]) / sliceheight;
+
+    for (PetscInt row = sliceheight * i; row < PetscMin(sliceheight * (i + 1), m); row += 8) { /* loop over strips */
+      const MatScalar *aval    = a->val + a->sliidx[i] + row % sliceheight;
+      const PetscInt  *acolidx = a->colidx + a->sliidx[i] + row % sliceheight;
+      PetscInt         j;
+
+      mask   = (__mmask8)(m - row < 8 ? 0xff >> (8 - (m - row)) : 0xff); /* the last slice may have padding rows */
+      vec_y  = y ? _mm512_maskz_loadu_pd(mask, &y[row]) : _mm512_setzero_pd();
+      vec_y2 = _mm512_setzero_pd();
+      for (j = 0; j < ncol - 1; j += 2) {
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += sliceheight;
+        aval += sliceheight;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += sliceheight;
+        aval += sliceheight;
+      }
+      if (j < ncol) { AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y); }
+      _mm512_mask_storeu_pd(&z[row], mask, _mm512_add_pd(vec_y, vec_y2));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  y = y + A^T x, for slice heights that are a multiple of 8. The products of a strip of 8 rows with a slice column are scattered
+  at once when their column indices are distinct, which needs AVX512CD, and one by one otherwise.
+*/
+static PetscErrorCode MatMultTransposeAdd_SeqSELL_AVX512_Private(Mat A, const PetscScalar *x, PetscScalar *y)
+{
+  Mat_SeqSELL *a           = (Mat_SeqSELL *)A->data;
+  PetscInt     sliceheight = a->sliceheight, m = A->rmap->n;
+  __m512d      vec_x;
+  __mmask8     mask;
+  PetscScalar  t[8];
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < a->totalslices; i++) { /* loop over slices */
+    const PetscInt ncol = (a->sliidx[i + 1] - a->sliidx[i]) / sliceheight;
+
+    for (PetscInt row = sliceheight * i; row < PetscMin(sliceheight * (i + 1), m); row += 8) { /* loop over strips */
+      const MatScalar *aval    = a->val + a->sliidx[i] + row % sliceheight;
+      const PetscInt  *acolidx = a->colidx + a->sliidx[i] + row % sliceheight;
+
+      /* the padding rows of the last slice get x = 0 and the padding entries of a row have zero values, so they add nothing */
+      mask  = (__mmask8)(m - row < 8 ? 0xff >> (8 - (m - row)) : 0xff);
+      vec_x = _mm512_maskz_loadu_pd(mask, &x[row]);
+      for (PetscInt j = 0; j < ncol; j++, acolidx += sliceheight, aval += sliceheight) {
+    #if defined(__AVX512CD__) && defined(__AVX512VL__)
+        __m256i vec_idx = _mm256_loadu_si256((__m256i const *)acolidx);
+
+        if (_mm256_testz_si256(_mm256_conflict_epi32(vec_idx), _mm256_set1_epi32(-1))) {
+          __m512d vec_y = _mm512_i32gather_pd(vec_idx, y, _MM_SCALE_8);
+
+          vec_y = _mm512_fmadd_pd(_mm512_loadu_pd(aval), vec_x, vec_y);
+          _mm512_i32scatter_pd(y, vec_idx, vec_y, _MM_SCALE_8);
+          continue;
+        }
+    #endif
+        _mm512_storeu_pd(t, _mm512_mul_pd(_mm512_loadu_pd(aval), vec_x));
+        for (PetscInt l = 0; l < 8; l++) y[acolidx[l]] += t[l];
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+  #elif defined(__AVX2__) && defined(__FMA__)
+/*
+  z = y + A x with y = NULL for z = A x, for slice heights that are a multiple of 4. A slice is processed as strips of 4 rows,
+  each strip reads 4 contiguous entries out of every slice column, with two accumulators for alternate columns.
+*/
+static PetscErrorCode MatMultAdd_SeqSELL_AVX2_Private(Mat A, const PetscScalar *x, const PetscScalar *y, PetscScalar *z)
+{
+  Mat_SeqSELL *a           = (Mat_SeqSELL *)A->data;
+  PetscInt     sliceheight = a->sliceheight, m = A->rmap->n;
+  __m256d      vec_x, vec_y, vec_vals, vec_y2;
+  __m128i      vec_idx;
+  PetscScalar  t[4];
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < a->totalslices; i++) { /* loop over slices */
+    const PetscInt ncol = (a->sliidx[i + 1] - a->sliidx[i]) / sliceheight;
+
+    for (PetscInt row = sliceheight * i; row < PetscMin(sliceheight * (i + 1), m); row += 4) { /* loop over strips */
+      const MatScalar *aval    = a->val + a->sliidx[i] + row % sliceheight;
+      const PetscInt  *acolidx = a->colidx + a->sliidx[i] + row % sliceheight;
+      const PetscInt   nrows   = PetscMin(4, m - row); /* the last slice may have padding rows */
+      PetscInt         j;
+
+      if (!y) vec_y = _mm256_setzero_pd();
+      else if (nrows == 4) vec_y = _mm256_loadu_pd(&y[row]);
+      else {
+        for (j = 0; j < 4; j++) t[j] = j < nrows ? y[row + j] : 0.0;
+        vec_y = _mm256_loadu_pd(t);
+      }
+      vec_y2 = _mm256_setzero_pd();
+      for (j = 0; j < ncol - 1; j += 2) {
+        AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += sliceheight;
+        aval += sliceheight;
+        AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y2);
+        acolidx += sliceheight;
+        aval += sliceheight;
+      }
+      if (j < ncol) { AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y); }
+      vec_y = _mm256_add_pd(vec_y, vec_y2);
+      if (nrows == 4) _mm256_storeu_pd(&z[row], vec_y);
+      else {
+        _mm256_storeu_pd(t, vec_y);
+        for (j = 0; j < nrows; j++) z[row + j] = t[j];
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y = y + A^T x, for slice heights that are a multiple of 4. AVX2 has no scatter, so only the products are vectorized. */
+static PetscErrorCode MatMultTransposeAdd_SeqSELL_AVX2_Private(Mat A, const PetscScalar *x, PetscScalar *y)
+{
+  Mat_SeqSELL *a           = (Mat_SeqSELL *)A->data;
+  PetscInt     sliceheight = a->sliceheight, m = A->rmap->n;
+  __m256d      vec_x;
+  PetscScalar  t[4];
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < a->totalslices; i++) { /* loop over slices */
+    const PetscInt ncol = (a->sliidx[i + 1] - a->sliidx[i]) / sliceheight;
+
+    for (PetscInt row = sliceheight * i; row < PetscMin(sliceheight * (i + 1), m); row += 4) { /* loop over strips */
+      const MatScalar *aval    = a->val + a->sliidx[i] + row % sliceheight;
+      const PetscInt  *acolidx = a->colidx + a->sliidx[i] + row % sliceheight;
+
+      /* the padding rows of the last slice get x = 0 and the padding entries of a row have zero values, so they add nothing */
+      for (PetscInt l = 0; l < 4; l++) t[l] = row + l < m ? x[row + l] : 0.0;
+      vec_x = _mm256_loadu_pd(t);
+      for (PetscInt j = 0; j < ncol; j++, acolidx += sliceheight, aval += sliceheight) {
+        _mm256_storeu_pd(t, _mm256_mul_pd(_mm256_loadu_pd(aval), vec_x));
+        for (PetscInt l = 0; l < 4; l++) y[acolidx[l]] += t[l];
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+  #endif
 #endif /* PETSC_HAVE_IMMINTRIN_H */
 
+/* z = y + A x with y = NULL for z = A x, for the slice heights that the SIMD kernels do not handle */
+static PetscErrorCode MatMultAdd_SeqSELL_Private(Mat A, const PetscScalar *x, const PetscScalar *y, PetscScalar *z)
+{
+  Mat_SeqSELL     *a           = (Mat_SeqSELL *)A->data;
+  const MatScalar *aval        = a->val;
+  const PetscInt  *acolidx     = a->colidx;
+  PetscInt         totalslices = a->totalslices, sliceheight = a->sliceheight, i, j, k, nrows;
+  PetscScalar     *sum;
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+  #pragma disjoint(*x, *y, *z, *aval)
+#endif
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(sliceheight, &sum));
+  for (i = 0; i < totalslices; i++) { /* loop over slices */
+    for (j = 0; j < sliceheight; j++) {
+      sum[j] = 0.0;
+      for (k = a->sliidx[i] + j; k < a->sliidx[i + 1]; k += sliceheight) sum[j] += aval[k] * x[acolidx[k]];
+    }
+    nrows = PetscMin(sliceheight, A->rmap->n - sliceheight * i); /* the last slice may have padding rows */
+    if (y) {
+      for (j = 0; j < nrows; j++) z[sliceheight * i + j] = y[sliceheight * i + j] + sum[j];
+    } else {
+      for (j = 0; j < nrows; j++) z[sliceheight * i + j] = sum[j];
+    }
+  }
+  PetscCall(PetscFree(sum));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y = y + A^T x, for the slice heights that the SIMD kernels do not handle */
+static PetscErrorCode MatMultTransposeAdd_SeqSELL_Private(Mat A, const PetscScalar *x, PetscScalar *y)
+{
+  Mat_SeqSELL     *a       = (Mat_SeqSELL *)A->data;
+  const MatScalar *aval    = a->val;
+  const PetscInt  *acolidx = a->colidx;
+  PetscInt         i, j, r, row, nnz_in_row, totalslices = a->totalslices, sliceheight = a->sliceheight;
+
+#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
+  #pragma disjoint(*x, *y, *aval)
+#endif
+
+  PetscFunctionBegin;
+  for (i = 0; i < a->totalslices; i++) { /* loop over slices */
+    if (i == totalslices - 1 && (A->rmap->n % sliceheight)) {
+      for (r = 0; r < (A->rmap->n % sliceheight); ++r) {
+        row        = sliceheight * i + r;
+        nnz_in_row = a->rlen[row];
+        for (j = 0; j < nnz_in_row; ++j) y[acolidx[a->sliidx[i] + sliceheight * j + r]] += aval[a->sliidx[i] + sliceheight * j + r] * x[row];
+      }
+      break;
+    }
+    for (r = 0; r < sliceheight; ++r)
+      for (j = a->sliidx[i] + r; j < a->sliidx[i + 1]; j += sliceheight) y[acolidx[j]] += aval[j] * x[sliceheight * i + r];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   MatSeqSELLSetPreallocation - For good matrix assembly performance
   the user should preallocate the matrix storage by setting the parameter `nz`
@@ -319,10 +539,12 @@ PetscErrorCode MatMult_SeqSELL(Mat A, Vec xx, Vec yy)
   Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
   PetscScalar       *y;
   const PetscScalar *x;
-  const MatScalar   *aval        = a->val;
-  PetscInt           totalslices = a->totalslices;
-  const PetscInt    *acolidx     = a->colidx;
-  PetscInt           i, j;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__)) || defined(__AVX__)) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  const MatScalar *aval        = a->val;
+  PetscInt         totalslices = a->totalslices;
+  const PetscInt  *acolidx     = a->colidx;
+  PetscInt         i, j;
+#endif
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d  vec_x, vec_y, vec_vals;
   __m256i  vec_idx;
@@ -339,187 +561,177 @@ PetscErrorCode MatMult_SeqSELL(Mat A, Vec xx, Vec yy)
   __m256d   vec_x, vec_y, vec_y2, vec_vals;
   MatScalar yval;
   PetscInt  r, rows_left, row, nnz_in_row;
-#else
-  PetscInt     k, sliceheight = a->sliceheight;
-  PetscScalar *sum;
 #endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-  #pragma disjoint(*x, *y, *aval)
+  #pragma disjoint(*x, *y)
 #endif
 
   PetscFunctionBegin;
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArray(yy, &y));
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  PetscCheck(a->sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, a->sliceheight);
-  for (i = 0; i < totalslices; i++) { /* loop over slices */
-    PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-
-    vec_y  = _mm512_setzero_pd();
-    vec_y2 = _mm512_setzero_pd();
-    vec_y3 = _mm512_setzero_pd();
-    vec_y4 = _mm512_setzero_pd();
-
-    j = a->sliidx[i] >> 3; /* 8 bytes are read at each time, corresponding to a slice column */
-    switch ((a->sliidx[i + 1] - a->sliidx[i]) / 8 & 3) {
-    case 3:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
-      acolidx += 8;
-      aval += 8;
-      j += 3;
-      break;
-    case 2:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      j += 2;
-      break;
-    case 1:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      j += 1;
-      break;
-    }
+  if (a->sliceheight == 8) {
+    for (i = 0; i < totalslices; i++) { /* loop over slices */
+      PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+      PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+
+      vec_y  = _mm512_setzero_pd();
+      vec_y2 = _mm512_setzero_pd();
+      vec_y3 = _mm512_setzero_pd();
+      vec_y4 = _mm512_setzero_pd();
+
+      j = a->sliidx[i] >> 3; /* 8 bytes are read at each time, corresponding to a slice column */
+      switch ((a->sliidx[i + 1] - a->sliidx[i]) / 8 & 3) {
+      case 3:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
+        acolidx += 8;
+        aval += 8;
+        j += 3;
+        break;
+      case 2:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        j += 2;
+        break;
+      case 1:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        j += 1;
+        break;
+      }
   #pragma novector
-    for (; j < (a->sliidx[i + 1] >> 3); j += 4) {
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx4, vec_x4, vec_vals4, vec_y4);
-      acolidx += 8;
-      aval += 8;
-    }
+      for (; j < (a->sliidx[i + 1] >> 3); j += 4) {
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx4, vec_x4, vec_vals4, vec_y4);
+        acolidx += 8;
+        aval += 8;
+      }
 
-    vec_y = _mm512_add_pd(vec_y, vec_y2);
-    vec_y = _mm512_add_pd(vec_y, vec_y3);
-    vec_y = _mm512_add_pd(vec_y, vec_y4);
-    if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask = (__mmask8)(0xff >> (8 - (A->rmap->n & 0x07)));
-      _mm512_mask_storeu_pd(&y[8 * i], mask, vec_y);
-    } else {
-      _mm512_storeu_pd(&y[8 * i], vec_y);
+      vec_y = _mm512_add_pd(vec_y, vec_y2);
+      vec_y = _mm512_add_pd(vec_y, vec_y3);
+      vec_y = _mm512_add_pd(vec_y, vec_y4);
+      if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
+        mask = (__mmask8)(0xff >> (8 - (A->rmap->n & 0x07)));
+        _mm512_mask_storeu_pd(&y[8 * i], mask, vec_y);
+      } else {
+        _mm512_storeu_pd(&y[8 * i], vec_y);
+      }
     }
-  }
+  } else if (a->sliceheight % 8 == 0) PetscCall(MatMultAdd_SeqSELL_AVX512_Private(A, x, NULL, y));
+  else PetscCall(MatMultAdd_SeqSELL_Private(A, x, NULL, y));
 #elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  PetscCheck(a->sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, a->sliceheight);
-  for (i = 0; i < totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8 * i;
-      for (r = 0; r < rows_left; ++r) {
-        yval       = (MatScalar)0;
-        row        = 8 * i + r;
-        nnz_in_row = a->rlen[row];
-        for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
-        y[row] = yval;
+  if (a->sliceheight == 8) {
+    for (i = 0; i < totalslices; i++) { /* loop over full slices */
+      PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+      PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+
+      /* last slice may have padding rows. Don't use vectorization. */
+      if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
+        rows_left = A->rmap->n - 8 * i;
+        for (r = 0; r < rows_left; ++r) {
+          yval       = (MatScalar)0;
+          row        = 8 * i + r;
+          nnz_in_row = a->rlen[row];
+          for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
+          y[row] = yval;
+        }
+        break;
       }
-      break;
-    }
 
-    vec_y  = _mm256_setzero_pd();
-    vec_y2 = _mm256_setzero_pd();
+      vec_y  = _mm256_setzero_pd();
+      vec_y2 = _mm256_setzero_pd();
 
-  /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
+    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
   #pragma novector
   #pragma unroll(2)
-    for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
-      AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      aval += 4;
-      acolidx += 4;
-      AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y2);
-      aval += 4;
-      acolidx += 4;
-    }
+      for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
+        AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        aval += 4;
+        acolidx += 4;
+        AVX2_Mult_Private(vec_idx, vec_x, vec_vals, vec_y2);
+        aval += 4;
+        acolidx += 4;
+      }
 
-    _mm256_storeu_pd(y + i * 8, vec_y);
-    _mm256_storeu_pd(y + i * 8 + 4, vec_y2);
-  }
+      _mm256_storeu_pd(y + i * 8, vec_y);
+      _mm256_storeu_pd(y + i * 8 + 4, vec_y2);
+    }
+  } else if (a->sliceheight % 4 == 0) PetscCall(MatMultAdd_SeqSELL_AVX2_Private(A, x, NULL, y));
+  else PetscCall(MatMultAdd_SeqSELL_Private(A, x, NULL, y));
 #elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  PetscCheck(a->sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, a->sliceheight);
-  for (i = 0; i < totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-
-    vec_y  = _mm256_setzero_pd();
-    vec_y2 = _mm256_setzero_pd();
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
-      rows_left = A->rmap->n - 8 * i;
-      for (r = 0; r < rows_left; ++r) {
-        yval       = (MatScalar)0;
-        row        = 8 * i + r;
-        nnz_in_row = a->rlen[row];
-        for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
-        y[row] = yval;
+  if (a->sliceheight == 8) {
+    for (i = 0; i < totalslices; i++) { /* loop over full slices */
+      PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+      PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+
+      vec_y  = _mm256_setzero_pd();
+      vec_y2 = _mm256_setzero_pd();
+
+      /* last slice may have padding rows. Don't use vectorization. */
+      if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
+        rows_left = A->rmap->n - 8 * i;
+        for (r = 0; r < rows_left; ++r) {
+          yval       = (MatScalar)0;
+          row        = 8 * i + r;
+          nnz_in_row = a->rlen[row];
+          for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
+          y[row] = yval;
+        }
+        break;
       }
-      break;
-    }
 
-  /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
+    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
   #pragma novector
   #pragma unroll(2)
-    for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_setzero_pd();
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
-      vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y);
-      aval += 4;
-
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
-      vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y2);
-      aval += 4;
-    }
+      for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
+        vec_vals  = _mm256_loadu_pd(aval);
+        vec_x_tmp = _mm_setzero_pd();
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
+        vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y);
+        aval += 4;
+
+        vec_vals  = _mm256_loadu_pd(aval);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
+        vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y2);
+        aval += 4;
+      }
 
-    _mm256_storeu_pd(y + i * 8, vec_y);
-    _mm256_storeu_pd(y + i * 8 + 4, vec_y2);
-  }
-#else
-  PetscCall(PetscMalloc1(sliceheight, &sum));
-  for (i = 0; i < totalslices; i++) { /* loop over slices */
-    for (j = 0; j < sliceheight; j++) {
-      sum[j] = 0.0;
-      for (k = a->sliidx[i] + j; k < a->sliidx[i + 1]; k += sliceheight) sum[j] += aval[k] * x[acolidx[k]];
+      _mm256_storeu_pd(y + i * 8, vec_y);
+      _mm256_storeu_pd(y + i * 8 + 4, vec_y2);
     }
-    if (i == totalslices - 1 && (A->rmap->n % sliceheight)) { /* if last slice has padding rows */
-      for (j = 0; j < (A->rmap->n % sliceheight); j++) y[sliceheight * i + j] = sum[j];
-    } else {
-      for (j = 0; j < sliceheight; j++) y[sliceheight * i + j] = sum[j];
-    }
-  }
-  PetscCall(PetscFree(sum));
+  } else PetscCall(MatMultAdd_SeqSELL_Private(A, x, NULL, y));
+#else
+  PetscCall(MatMultAdd_SeqSELL_Private(A, x, NULL, y));
 #endif
 
   PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt)); /* theoretical minimal FLOPs */
@@ -534,28 +746,27 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz)
   Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
   PetscScalar       *y, *z;
   const PetscScalar *x;
-  const MatScalar   *aval        = a->val;
-  PetscInt           totalslices = a->totalslices;
-  const PetscInt    *acolidx     = a->colidx;
-  PetscInt           i, j;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && (defined(__AVX512F__) || (defined(__AVX__) && !(defined(__AVX2__) && defined(__FMA__)))) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  const MatScalar *aval        = a->val;
+  PetscInt         totalslices = a->totalslices;
+  const PetscInt  *acolidx     = a->colidx;
+  PetscInt         i, j;
+#endif
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m512d  vec_x, vec_y, vec_vals;
   __m256i  vec_idx;
   __mmask8 mask = 0;
   __m512d  vec_x2, vec_y2, vec_vals2, vec_x3, vec_y3, vec_vals3, vec_x4, vec_y4, vec_vals4;
   __m256i  vec_idx2, vec_idx3, vec_idx4;
-#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && !(defined(__AVX2__) && defined(__FMA__)) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
   __m128d   vec_x_tmp;
   __m256d   vec_x, vec_y, vec_y2, vec_vals;
   MatScalar yval;
   PetscInt  r, row, nnz_in_row;
-#else
-  PetscInt     k, sliceheight = a->sliceheight;
-  PetscScalar *sum;
 #endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-  #pragma disjoint(*x, *y, *aval)
+  #pragma disjoint(*x, *y)
 #endif
 
   PetscFunctionBegin;
@@ -566,139 +777,133 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz)
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArrayPair(yy, zz, &y, &z));
 #if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  PetscCheck(a->sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, a->sliceheight);
-  for (i = 0; i < totalslices; i++) { /* loop over slices */
-    PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-
-    if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      mask  = (__mmask8)(0xff >> (8 - (A->rmap->n & 0x07)));
-      vec_y = _mm512_mask_loadu_pd(vec_y, mask, &y[8 * i]);
-    } else {
-      vec_y = _mm512_loadu_pd(&y[8 * i]);
-    }
-    vec_y2 = _mm512_setzero_pd();
-    vec_y3 = _mm512_setzero_pd();
-    vec_y4 = _mm512_setzero_pd();
-
-    j = a->sliidx[i] >> 3; /* 8 bytes are read at each time, corresponding to a slice column */
-    switch ((a->sliidx[i + 1] - a->sliidx[i]) / 8 & 3) {
-    case 3:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
-      acolidx += 8;
-      aval += 8;
-      j += 3;
-      break;
-    case 2:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      j += 2;
-      break;
-    case 1:
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      j += 1;
-      break;
-    }
+  if (a->sliceheight == 8) {
+    for (i = 0; i < totalslices; i++) { /* loop over slices */
+      PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+      PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+
+      if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
+        mask  = (__mmask8)(0xff >> (8 - (A->rmap->n & 0x07)));
+        vec_y = _mm512_mask_loadu_pd(vec_y, mask, &y[8 * i]);
+      } else {
+        vec_y = _mm512_loadu_pd(&y[8 * i]);
+      }
+      vec_y2 = _mm512_setzero_pd();
+      vec_y3 = _mm512_setzero_pd();
+      vec_y4 = _mm512_setzero_pd();
+
+      j = a->sliidx[i] >> 3; /* 8 bytes are read at each time, corresponding to a slice column */
+      switch ((a->sliidx[i + 1] - a->sliidx[i]) / 8 & 3) {
+      case 3:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
+        acolidx += 8;
+        aval += 8;
+        j += 3;
+        break;
+      case 2:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        j += 2;
+        break;
+      case 1:
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        j += 1;
+        break;
+      }
   #pragma novector
-    for (; j < (a->sliidx[i + 1] >> 3); j += 4) {
-      AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
-      acolidx += 8;
-      aval += 8;
-      AVX512_Mult_Private(vec_idx4, vec_x4, vec_vals4, vec_y4);
-      acolidx += 8;
-      aval += 8;
-    }
+      for (; j < (a->sliidx[i + 1] >> 3); j += 4) {
+        AVX512_Mult_Private(vec_idx, vec_x, vec_vals, vec_y);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx2, vec_x2, vec_vals2, vec_y2);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx3, vec_x3, vec_vals3, vec_y3);
+        acolidx += 8;
+        aval += 8;
+        AVX512_Mult_Private(vec_idx4, vec_x4, vec_vals4, vec_y4);
+        acolidx += 8;
+        aval += 8;
+      }
 
-    vec_y = _mm512_add_pd(vec_y, vec_y2);
-    vec_y = _mm512_add_pd(vec_y, vec_y3);
-    vec_y = _mm512_add_pd(vec_y, vec_y4);
-    if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
-      _mm512_mask_storeu_pd(&z[8 * i], mask, vec_y);
-    } else {
-      _mm512_storeu_pd(&z[8 * i], vec_y);
+      vec_y = _mm512_add_pd(vec_y, vec_y2);
+      vec_y = _mm512_add_pd(vec_y, vec_y3);
+      vec_y = _mm512_add_pd(vec_y, vec_y4);
+      if (i == totalslices - 1 && A->rmap->n & 0x07) { /* if last slice has padding rows */
+        _mm512_mask_storeu_pd(&z[8 * i], mask, vec_y);
+      } else {
+        _mm512_storeu_pd(&z[8 * i], vec_y);
+      }
     }
-  }
+  } else if (a->sliceheight % 8 == 0) PetscCall(MatMultAdd_SeqSELL_AVX512_Private(A, x, y, z));
+  else PetscCall(MatMultAdd_SeqSELL_Private(A, x, y, z));
+#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  if (a->sliceheight % 4 == 0) PetscCall(MatMultAdd_SeqSELL_AVX2_Private(A, x, y, z));
+  else PetscCall(MatMultAdd_SeqSELL_Private(A, x, y, z));
 #elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
-  PetscCheck(a->sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, a->sliceheight);
-  for (i = 0; i < totalslices; i++) { /* loop over full slices */
-    PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-    PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
-
-    /* last slice may have padding rows. Don't use vectorization. */
-    if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
-      for (r = 0; r < (A->rmap->n & 0x07); ++r) {
-        row        = 8 * i + r;
-        yval       = (MatScalar)0.0;
-        nnz_in_row = a->rlen[row];
-        for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
-        z[row] = y[row] + yval;
+  if (a->sliceheight == 8) {
+    for (i = 0; i < totalslices; i++) { /* loop over full slices */
+      PetscPrefetchBlock(acolidx, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+      PetscPrefetchBlock(aval, a->sliidx[i + 1] - a->sliidx[i], 0, PETSC_PREFETCH_HINT_T0);
+
+      /* last slice may have padding rows. Don't use vectorization. */
+      if (i == totalslices - 1 && (A->rmap->n & 0x07)) {
+        for (r = 0; r < (A->rmap->n & 0x07); ++r) {
+          row        = 8 * i + r;
+          yval       = (MatScalar)0.0;
+          nnz_in_row = a->rlen[row];
+          for (j = 0; j < nnz_in_row; ++j) yval += aval[8 * j + r] * x[acolidx[8 * j + r]];
+          z[row] = y[row] + yval;
+        }
+        break;
       }
-      break;
-    }
 
-    vec_y  = _mm256_loadu_pd(y + 8 * i);
-    vec_y2 = _mm256_loadu_pd(y + 8 * i + 4);
+      vec_y  = _mm256_loadu_pd(y + 8 * i);
+      vec_y2 = _mm256_loadu_pd(y + 8 * i + 4);
+
+      /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
+      for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
+        vec_vals  = _mm256_loadu_pd(aval);
+        vec_x_tmp = _mm_setzero_pd();
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_setzero_pd();
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
+        vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y);
+        aval += 4;
+
+        vec_vals  = _mm256_loadu_pd(aval);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
+        vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
+        vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
+        vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
+        vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y2);
+        aval += 4;
+      }
 
-    /* Process slice of height 8 (512 bits) via two subslices of height 4 (256 bits) via AVX */
-    for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_setzero_pd();
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_setzero_pd();
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
-      vec_y     = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y);
-      aval += 4;
-
-      vec_vals  = _mm256_loadu_pd(aval);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 0);
-      vec_x_tmp = _mm_loadl_pd(vec_x_tmp, x + *acolidx++);
-      vec_x_tmp = _mm_loadh_pd(vec_x_tmp, x + *acolidx++);
-      vec_x     = _mm256_insertf128_pd(vec_x, vec_x_tmp, 1);
-      vec_y2    = _mm256_add_pd(_mm256_mul_pd(vec_x, vec_vals), vec_y2);
-      aval += 4;
+      _mm256_storeu_pd(z + i * 8, vec_y);
+      _mm256_storeu_pd(z + i * 8 + 4, vec_y2);
     }
-
-    _mm256_storeu_pd(z + i * 8, vec_y);
-    _mm256_storeu_pd(z + i * 8 + 4, vec_y2);
-  }
+  } else PetscCall(MatMultAdd_SeqSELL_Private(A, x, y, z));
 #else
-  PetscCall(PetscMalloc1(sliceheight, &sum));
-  for (i = 0; i < totalslices; i++) { /* loop over slices */
-    for (j = 0; j < sliceheight; j++) {
-      sum[j] = 0.0;
-      for (k = a->sliidx[i] + j; k < a->sliidx[i + 1]; k += sliceheight) sum[j] += aval[k] * x[acolidx[k]];
-    }
-    if (i == totalslices - 1 && (A->rmap->n % sliceheight)) {
-      for (j = 0; j < (A->rmap->n % sliceheight); j++) z[sliceheight * i + j] = y[sliceheight * i + j] + sum[j];
-    } else {
-      for (j = 0; j < sliceheight; j++) z[sliceheight * i + j] = y[sliceheight * i + j] + sum[j];
-    }
-  }
-  PetscCall(PetscFree(sum));
+  PetscCall(MatMultAdd_SeqSELL_Private(A, x, y, z));
 #endif
 
   PetscCall(PetscLogFlops(2.0 * a->nz));
@@ -712,13 +917,6 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A, Vec xx, Vec zz, Vec yy)
   Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
   PetscScalar       *y;
   const PetscScalar *x;
-  const MatScalar   *aval    = a->val;
-  const PetscInt    *acolidx = a->colidx;
-  PetscInt           i, j, r, row, nnz_in_row, totalslices = a->totalslices, sliceheight = a->sliceheight;
-
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-  #pragma disjoint(*x, *y, *aval)
-#endif
 
   PetscFunctionBegin;
   if (A->symmetric == PETSC_BOOL3_TRUE) {
@@ -730,18 +928,15 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A, Vec xx, Vec zz, Vec yy)
   if (a->nz) {
     PetscCall(VecGetArrayRead(xx, &x));
     PetscCall(VecGetArray(yy, &y));
-    for (i = 0; i < a->totalslices; i++) { /* loop over slices */
-      if (i == totalslices - 1 && (A->rmap->n % sliceheight)) {
-        for (r = 0; r < (A->rmap->n % sliceheight); ++r) {
-          row        = sliceheight * i + r;
-          nnz_in_row = a->rlen[row];
-          for (j = 0; j < nnz_in_row; ++j) y[acolidx[sliceheight * j + r]] += aval[sliceheight * j + r] * x[row];
-        }
-        break;
-      }
-      for (r = 0; r < sliceheight; ++r)
-        for (j = a->sliidx[i] + r; j < a->sliidx[i + 1]; j += sliceheight) y[acolidx[j]] += aval[j] * x[sliceheight * i + r];
-    }
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+    if (a->sliceheight % 8 == 0) PetscCall(MatMultTransposeAdd_SeqSELL_AVX512_Private(A, x, y));
+    else PetscCall(MatMultTransposeAdd_SeqSELL_Private(A, x, y));
+#elif defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+    if (a->sliceheight % 4 == 0) PetscCall(MatMultTransposeAdd_SeqSELL_AVX2_Private(A, x, y));
+    else PetscCall(MatMultTransposeAdd_SeqSELL_Private(A, x, y));
+#else
+    PetscCall(MatMultTransposeAdd_SeqSELL_Private(A, x, y));
+#endif
     PetscCall(PetscLogFlops(2.0 * a->nz));
     PetscCall(VecRestoreArrayRead(xx, &x));
     PetscCall(VecRestoreArray(yy, &y));
@@ -2112,6 +2307,8 @@ PetscErrorCode MatSeqSELLGetAvgSliceWidth(Mat A, PetscReal *slicewidth)
 
   The slice height must be set before MatSetUp() or MatXXXSetPreallocation() is called.
 
+  The SIMD kernels handle slice heights that are a multiple of 8 with AVX-512 and a multiple of 4 with AVX2.
+
   Level: intermediate
 
 .seealso: `MATSEQSELL`, `MatSeqSELLGetVarSliceSize()`
@@ -2338,6 +2535,8 @@ M*/
 
   Developer Notes:
   On Intel (and AMD) systems some of the matrix operations use SIMD (AVX) instructions to achieve higher performance.
+  `MatMult()` and `MatMultAdd()` use AVX-512 for slice heights that are a multiple of 8 and AVX2 for multiples of 4, `MatMultTranspose()`
+  and `MatMultTransposeAdd()` as well; other slice heights use scalar code. See `MatSeqSELLSetSliceHeight()`.
 
   The sparse matrix format is as follows. For simplicity we assume a slice size of 2, it is actually 8
 .vb
@@ -4138,6 +4138,7 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat, Vec b, Vec y, Vec x)
 .     `SOR_APPLY_UPPER`, `SOR_APPLY_LOWER` - applies
   upper/lower triangular part of matrix to
   vector (with omega)
+.     `SOR_MULTICOLOR` - sweep in a multicolor ordering of the rows, may be combined with the sweep types above
 -     `SOR_ZERO_INITIAL_GUESS` - zero initial guess
 
   Level: developer
@@ -4152,6 +4153,10 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat, Vec b, Vec y, Vec x)
 
   For `MATBAIJ`, `MATSBAIJ`, and `MATAIJ` matrices with Inodes this does a block SOR smoothing, otherwise it does a pointwise smoothing
 
+  `SOR_MULTICOLOR` is supported by `MATSEQAIJ` and `MATMPIAIJ` (for the local sweeps); it is ignored by other matrix types. The coloring is
+  computed on first use and kept until the nonzero structure of the matrix changes. With OpenMP the rows of each color are
+  relaxed by all threads
+
   Most users should employ the `KSP` interface for linear solvers
   instead of working directly with matrix algebra routines such as this.
   See, e.g., `KSPCreate()`.
@@ -5903,9 +5908,13 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
 . `MAT_NO_OFF_PROC_ENTRIES`         - you know each process will only set values for its own rows, will generate an error if
         any process sets values for another process. This avoids all reductions in the MatAssembly routines and thus improves
         performance for very large process counts.
-- `MAT_SUBSET_OFF_PROC_ENTRIES`     - you know that the first assembly after setting this flag will set a superset
+. `MAT_SUBSET_OFF_PROC_ENTRIES`     - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
         functions, instead sending only neighbor messages.
+- `MAT_FROZEN_OFF_PROC_ENTRIES`     - you know that all the assemblies after setting this flag will set the same off-process
+        entries in the same order, for example because the same element loop is run each time. The first assembly records
+        the communication pattern and where each stashed value is packed, the following ones pack the values directly into
+        the recorded send buffers and communicate with persistent requests, skipping the sorting of the stash.
 
   Level: intermediate
 
@@ -6004,6 +6013,10 @@ PetscErrorCode MatSetOption(Mat mat, MatOption op, PetscBool flg)
       mat->stash.first_assembly_done = PETSC_FALSE;
     }
     PetscFunctionReturn(PETSC_SUCCESS);
+  case MAT_FROZEN_OFF_PROC_ENTRIES:
+    mat->assembly_frozen = flg;
+    mat->assembly_frozen_state++; /* the stashes record the pattern again in their next assembly */
+    PetscFunctionReturn(PETSC_SUCCESS);
   case MAT_NO_OFF_PROC_ZERO_ROWS:
     mat->nooffproczerorows = flg;
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -6099,6 +6112,9 @@ PetscErrorCode MatGetOption(Mat mat, MatOption op, PetscBool *flg)
   case MAT_NO_OFF_PROC_ENTRIES:
     *flg = mat->nooffprocentries;
     break;
+  case MAT_FROZEN_OFF_PROC_ENTRIES:
+    *flg = mat->assembly_frozen;
+    break;
   case MAT_NO_OFF_PROC_ZERO_ROWS:
     *flg = mat->nooffproczerorows;
     break;
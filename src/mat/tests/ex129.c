@@ -291,4 +291,9 @@ PetscErrorCode ComputeMatrix(DM da, Mat B)
       args: -dm_mat_type aij -dof 1 -inplacelu
       output_file: output/ex129.out
 
+   test:
+      suffix: threads
+      args: -dm_mat_type aij -dof {{1 2}} -nrhs 3 -mat_aij_threads -omp_num_threads 3
+      output_file: output/ex129.out
+
 TEST*/
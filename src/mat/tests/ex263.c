@@ -0,0 +1,130 @@
+static char help[] = "Tests repeated assemblies of a finite element matrix with MAT_FROZEN_OFF_PROC_ENTRIES.\n\n\
+  -n <n>   : number of elements in each direction\n\
+  -bs <bs> : number of unknowns per node\n\n";
+
+#include <petscmat.h>
+
+/*
+   Assembles the matrix of a structured mesh of n x n bilinear elements with bs unknowns per node. The elements are split
+   between the processes independently of the rows, so the rows of the nodes on the interfaces are set by several
+   processes. The entries only depend on their location, so INSERT_VALUES gives the same matrix in any order.
+*/
+static PetscErrorCode AssembleMatrix(Mat A, PetscInt n, PetscInt bs, PetscScalar scale, InsertMode mode)
+{
+  PetscInt     nelem = PETSC_DECIDE, N = n * n, estart, eend, idx[4];
+  PetscScalar *v;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSplitOwnership(PetscObjectComm((PetscObject)A), &nelem, &N));
+  PetscCallMPI(MPI_Scan(&nelem, &eend, 1, MPIU_INT, MPI_SUM, PetscObjectComm((PetscObject)A)));
+  estart = eend - nelem;
+  PetscCall(PetscMalloc1(16 * bs * bs, &v));
+  /* go through the elements backwards so that the rows are not stashed in order */
+  for (PetscInt e = eend - 1; e >= estart; e--) {
+    const PetscInt i = e % n, j = e / n;
+
+    idx[0] = j * (n + 1) + i;
+    idx[1] = idx[0] + 1;
+    idx[2] = idx[0] + n + 1;
+    idx[3] = idx[2] + 1;
+    for (PetscInt r = 0; r < 4 * bs; r++) {
+      for (PetscInt c = 0; c < 4 * bs; c++) {
+        const PetscInt row = idx[r / bs] * bs + r % bs, col = idx[c / bs] * bs + c % bs;
+
+        v[r * 4 * bs + c] = scale * (row == col ? 4.0 : -1.0 / (1.0 + row + col));
+      }
+    }
+    PetscCall(MatSetValuesBlocked(A, 4, idx, 4, idx, v, mode));
+  }
+  PetscCall(PetscFree(v));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CreateMatrix(PetscInt M, PetscInt bs, Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PETSC_COMM_WORLD, A));
+  PetscCall(MatSetSizes(*A, PETSC_DECIDE, PETSC_DECIDE, M, M));
+  PetscCall(MatSetBlockSize(*A, bs));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(MatSeqAIJSetPreallocation(*A, 9 * bs, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(*A, 9 * bs, NULL, 9 * bs, NULL));
+  PetscCall(MatSeqBAIJSetPreallocation(*A, bs, 9, NULL));
+  PetscCall(MatMPIBAIJSetPreallocation(*A, bs, 9, NULL, 9, NULL));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* assembles A, which may use MAT_FROZEN_OFF_PROC_ENTRIES, and B, which does not, and compares them */
+static PetscErrorCode AssembleAndCompare(Mat A, Mat B, PetscInt n, PetscInt bs, PetscScalar scale, InsertMode mode, PetscInt step)
+{
+  Mat       C;
+  PetscReal norm;
+
+  PetscFunctionBegin;
+  if (mode == ADD_VALUES) {
+    PetscCall(MatZeroEntries(A));
+    PetscCall(MatZeroEntries(B));
+  }
+  PetscCall(AssembleMatrix(A, n, bs, scale, mode));
+  PetscCall(AssembleMatrix(B, n, bs, scale, mode));
+  PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &C));
+  PetscCall(MatAXPY(C, -1.0, A, SAME_NONZERO_PATTERN));
+  PetscCall(MatNorm(C, NORM_FROBENIUS, &norm));
+  PetscCall(MatDestroy(&C));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Assembly %" PetscInt_FMT " with %s: %s\n", step, mode == ADD_VALUES ? "ADD_VALUES" : "INSERT_VALUES", norm < 100 * PETSC_MACHINE_EPSILON ? "same matrix" : "different matrices"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat       A, B;
+  PetscInt  n = 5, bs = 1, M, step = 0;
+  PetscBool flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  M = (n + 1) * (n + 1) * bs;
+
+  PetscCall(CreateMatrix(M, bs, &A));
+  PetscCall(CreateMatrix(M, bs, &B));
+
+  PetscCall(MatSetOption(A, MAT_FROZEN_OFF_PROC_ENTRIES, PETSC_TRUE));
+  PetscCall(MatGetOption(A, MAT_FROZEN_OFF_PROC_ENTRIES, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MAT_FROZEN_OFF_PROC_ENTRIES was not set");
+  /* the first assembly records the pattern, the following ones reuse it */
+  PetscCall(AssembleAndCompare(A, B, n, bs, 1.0, ADD_VALUES, step++));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 2.0, ADD_VALUES, step++));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 3.0, INSERT_VALUES, step++));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 4.0, ADD_VALUES, step++));
+  /* record the pattern again */
+  PetscCall(MatSetOption(A, MAT_FROZEN_OFF_PROC_ENTRIES, PETSC_TRUE));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 5.0, INSERT_VALUES, step++));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 6.0, ADD_VALUES, step++));
+  /* back to the usual assembly */
+  PetscCall(MatSetOption(A, MAT_FROZEN_OFF_PROC_ENTRIES, PETSC_FALSE));
+  PetscCall(AssembleAndCompare(A, B, n, bs, 7.0, ADD_VALUES, step++));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      args: -mat_type {{aij baij}} -bs {{1 2}}
+      output_file: output/ex263_1.out
+
+   test:
+      suffix: 2
+      nsize: 4
+      args: -n 7 -bs 3 -mat_type baij -matstash_initial_size 3
+      output_file: output/ex263_1.out
+
+TEST*/
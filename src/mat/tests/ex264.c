@@ -0,0 +1,124 @@
+static char help[] = "Compares MatSetValuesCOO() with MatSetValues() for the repeated assembly of a 3D finite element stiffness matrix.\n\n\
+  -n <n>      : number of elements in each direction\n\
+  -repeat <r> : number of assemblies timed\n\n\
+Use -log_view to compare the stages and -mat_aij_threads -omp_num_threads <nt> for the threaded MatSetValuesCOO().\n";
+
+#include <petscmat.h>
+
+/* nodes of element e of the n x n x n mesh of hexahedra, in the natural ordering of the (n+1)^3 nodes */
+static void ElementNodes(PetscInt n, PetscInt e, PetscInt idx[])
+{
+  const PetscInt i = e % n, j = (e / n) % n, k = e / (n * n);
+
+  for (PetscInt c = 0; c < 8; c++) idx[c] = ((k + c / 4) * (n + 1) + j + (c / 2) % 2) * (n + 1) + i + c % 2;
+}
+
+/*
+   Stiffness matrices of the Laplacian with trilinear elements, h/12 (4, 0, -1, -1) for nodes that differ in 0, 1, 2 or 3
+   coordinates, scaled by a coefficient that depends on the element
+*/
+static void ElementMatrix(PetscInt n, PetscInt e, PetscScalar scale, PetscScalar K[])
+{
+  const PetscReal   h       = 1.0 / n;
+  const PetscScalar entry[] = {4.0, 0.0, -1.0, -1.0};
+
+  for (PetscInt a = 0; a < 8; a++) {
+    for (PetscInt b = 0; b < 8; b++) {
+      const PetscInt d = (a % 2 != b % 2) + ((a / 2) % 2 != (b / 2) % 2) + (a / 4 != b / 4);
+
+      K[a * 8 + b] = scale * (1.0 + e % 3) * h / 12.0 * entry[d];
+    }
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Mat           A, B;
+  PetscInt      n = 4, repeat = 3, N, nelem = PETSC_DECIDE, estart, eend, *coo_i, *coo_j;
+  PetscScalar  *v;
+  PetscReal     norm, normB;
+  PetscLogStage stagecoo, stagesv;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-repeat", &repeat, NULL));
+  PetscCall(PetscLogStageRegister("MatSetValuesCOO", &stagecoo));
+  PetscCall(PetscLogStageRegister("MatSetValues", &stagesv));
+
+  /* split the elements between the processes independently of the rows, as a mesh partitioner would */
+  N = n * n * n;
+  PetscCall(PetscSplitOwnership(PETSC_COMM_WORLD, &nelem, &N));
+  PetscCallMPI(MPI_Scan(&nelem, &eend, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  estart = eend - nelem;
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, (n + 1) * (n + 1) * (n + 1), (n + 1) * (n + 1) * (n + 1)));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatSetSizes(B, PETSC_DECIDE, PETSC_DECIDE, (n + 1) * (n + 1) * (n + 1), (n + 1) * (n + 1) * (n + 1)));
+  PetscCall(MatSetType(B, MATAIJ));
+  PetscCall(MatSetFromOptions(B));
+
+  /* the COO pattern is set once, the matrix then takes the element matrices one after the other */
+  PetscCall(PetscMalloc3(64 * nelem, &coo_i, 64 * nelem, &coo_j, 64 * nelem, &v));
+  for (PetscInt e = estart; e < eend; e++) {
+    PetscInt idx[8];
+
+    ElementNodes(n, e, idx);
+    for (PetscInt a = 0; a < 64; a++) {
+      coo_i[64 * (e - estart) + a] = idx[a / 8];
+      coo_j[64 * (e - estart) + a] = idx[a % 8];
+    }
+  }
+  PetscCall(MatSetPreallocationCOO(A, 64 * nelem, coo_i, coo_j));
+  PetscCall(PetscLogStagePush(stagecoo));
+  for (PetscInt r = 0; r < repeat; r++) {
+    for (PetscInt e = estart; e < eend; e++) ElementMatrix(n, e, r + 1.0, &v[64 * (e - estart)]);
+    PetscCall(MatSetValuesCOO(A, v, INSERT_VALUES));
+  }
+  PetscCall(PetscLogStagePop());
+
+  PetscCall(MatSeqAIJSetPreallocation(B, 27, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(B, 27, NULL, 27, NULL));
+  PetscCall(PetscLogStagePush(stagesv));
+  for (PetscInt r = 0; r < repeat; r++) {
+    if (r) PetscCall(MatZeroEntries(B));
+    for (PetscInt e = estart; e < eend; e++) {
+      PetscInt idx[8];
+
+      ElementNodes(n, e, idx);
+      ElementMatrix(n, e, r + 1.0, v);
+      PetscCall(MatSetValues(B, 8, idx, 8, idx, v, ADD_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(PetscLogStagePop());
+
+  PetscCall(MatNorm(B, NORM_FROBENIUS, &normB));
+  PetscCall(MatAXPY(B, -1.0, A, DIFFERENT_NONZERO_PATTERN));
+  PetscCall(MatNorm(B, NORM_FROBENIUS, &norm));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "MatSetValuesCOO() and MatSetValues() give %s\n", norm <= 100 * PETSC_MACHINE_EPSILON * normB ? "the same matrix" : "different matrices"));
+
+  PetscCall(PetscFree3(coo_i, coo_j, v));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      output_file: output/ex264_1.out
+
+   test:
+      suffix: threads
+      nsize: {{1 3}}
+      args: -n 6 -mat_aij_threads -omp_num_threads {{1 3}}
+      output_file: output/ex264_1.out
+
+TEST*/
@@ -0,0 +1,168 @@
+static char help[] = "Compares the products and SOR of MATAIJSINGLE with those of MATAIJ, for values that are exact in single precision,\n\
+after assembly, after a change of the values, after MatScale() and after a change of the nonzero pattern.\n\
+  -m <m> : number of rows\n\n";
+
+#include <petscmat.h>
+
+/* row i has 1 + (5 i) % 11 entries, every 16th row 40 more, the diagonal is the largest entry; the values are rounded to single precision */
+static PetscErrorCode FillMatrix(Mat A, PetscReal scale)
+{
+  PetscInt rstart, rend, N, cols[64];
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(MatGetSize(A, &N, NULL));
+  for (PetscInt i = rstart; i < rend; i++) {
+    PetscInt    ncols = PetscMin(1 + (5 * i) % 11 + (i % 16 ? 0 : 40), N);
+    PetscScalar vals[64];
+
+    for (PetscInt k = 0; k < ncols; k++) {
+      cols[k] = (i + 3 * k) % N;
+      vals[k] = (float)(cols[k] == i ? scale * 50.0 : scale * (1.0 + 0.01 * ((i + k) % 17)) * (k % 2 ? -1.0 : 0.5));
+    }
+    PetscCall(MatSetValues(A, 1, &i, ncols, cols, vals, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckProducts(Mat A, Mat B, const char *stage)
+{
+  Vec       x, y, z, yref;
+  PetscReal nrm, nrmref;
+  PetscBool ok = PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &yref));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(z, NULL));
+  for (PetscInt op = 0; op < 5; op++) {
+    switch (op) {
+    case 0:
+      PetscCall(MatMult(A, x, yref));
+      PetscCall(MatMult(B, x, y));
+      break;
+    case 1:
+      PetscCall(MatMultAdd(A, x, z, yref));
+      PetscCall(MatMultAdd(B, x, z, y));
+      break;
+    case 2:
+      PetscCall(VecCopy(z, yref));
+      PetscCall(VecCopy(z, y));
+      PetscCall(MatMultAdd(A, x, yref, yref));
+      PetscCall(MatMultAdd(B, x, y, y));
+      break;
+    case 3:
+      PetscCall(VecSet(yref, 0.0));
+      PetscCall(VecSet(y, 0.0));
+      PetscCall(MatSOR(A, z, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP), 0.0, 2, 1, yref));
+      PetscCall(MatSOR(B, z, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP), 0.0, 2, 1, y));
+      break;
+    case 4:
+      PetscCall(VecCopy(x, yref));
+      PetscCall(VecCopy(x, y));
+      PetscCall(MatSOR(A, z, 0.8, SOR_LOCAL_BACKWARD_SWEEP, 0.0, 1, 2, yref));
+      PetscCall(MatSOR(B, z, 0.8, SOR_LOCAL_BACKWARD_SWEEP, 0.0, 1, 2, y));
+      break;
+    }
+    PetscCall(VecNorm(yref, NORM_2, &nrmref));
+    PetscCall(VecAXPY(y, -1.0, yref));
+    PetscCall(VecNorm(y, NORM_2, &nrm));
+    if (nrm > 100 * PETSC_MACHINE_EPSILON * nrmref) {
+      ok = PETSC_FALSE;
+      PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: operation %" PetscInt_FMT " has error %g\n", stage, op, (double)nrm));
+    }
+  }
+  if (ok) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: the products and SOR agree with MATAIJ\n", stage));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&yref));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B;
+  PetscInt    m = 203, rstart;
+  PetscScalar v = 0.25;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetOptionsPrefix(A, "ref_")); /* the options of B do not apply to the reference matrix */
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m, m));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(A, 52, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 52, NULL, 52, NULL));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatSetSizes(B, PETSC_DECIDE, PETSC_DECIDE, m, m));
+  PetscCall(MatSetType(B, MATAIJSINGLE));
+  PetscCall(MatSetFromOptions(B));
+  PetscCall(MatSeqAIJSetPreallocation(B, 52, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(B, 52, NULL, 52, NULL));
+  PetscCall(MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+
+  PetscCall(FillMatrix(A, 1.0));
+  PetscCall(FillMatrix(B, 1.0));
+  PetscCall(CheckProducts(A, B, "Assembled"));
+
+  /* new values in the same nonzero pattern */
+  PetscCall(FillMatrix(A, -2.0));
+  PetscCall(FillMatrix(B, -2.0));
+  PetscCall(CheckProducts(A, B, "Values changed"));
+
+  /* new values without an assembly */
+  PetscCall(MatScale(A, 0.5));
+  PetscCall(MatScale(B, 0.5));
+  PetscCall(CheckProducts(A, B, "Scaled"));
+
+  /* a new nonzero in the first local row */
+  PetscCall(MatGetOwnershipRange(A, &rstart, NULL));
+  PetscCall(MatSetValue(A, rstart, (rstart + 1) % m, v, ADD_VALUES));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatSetValue(B, rstart, (rstart + 1) % m, v, ADD_VALUES));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(CheckProducts(A, B, "Nonzero pattern changed"));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+      requires: !complex
+
+   test:
+      suffix: 1
+      nsize: {{1 2}}
+      output_file: output/ex266_1.out
+
+   test:
+      suffix: no_inode
+      args: -mat_no_inode
+      output_file: output/ex266_1.out
+
+   test:
+      suffix: delta
+      args: -mat_aij_delta_indices -m {{203 70000}}
+      output_file: output/ex266_1.out
+
+   test:
+      suffix: delta_threads
+      requires: openmp
+      args: -mat_aij_delta_indices -mat_aij_threads -omp_num_threads 3
+      output_file: output/ex266_1.out
+
+TEST*/
@@ -245,4 +245,9 @@ int main(int argc, char **args)
    test:
       args: -mat_block_size {{1 2 3 4 5 6 7 8}}
 
+   test:
+      suffix: threads
+      args: -mat_block_size {{1 2 5}} -mat_aij_threads -omp_num_threads 3
+      output_file: output/ex48_1.out
+
 TEST*/
@@ -208,6 +208,11 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via heap
       output_file: output/ex93_1.out
 
+   test:
+      suffix: threaded
+      args: -matmatmult_via threaded -matptap_via threaded -omp_num_threads 3
+      output_file: output/ex93_1.out
+
    #HYPRE PtAP is broken for complex numbers
    test:
       suffix: hypre
@@ -289,6 +289,17 @@ int main(int argc, char **argv)
      args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm scalable -inner_offdiag_mat_product_algorithm scalable
      output_file: output/ex96_1.out
 
+   test:
+     suffix: seq_threaded
+     nsize: 3
+     args: -Mx 10 -My 5 -Mz 10 -matmatmult_via scalable -matptap_via scalable -inner_diag_mat_product_algorithm threaded -inner_offdiag_mat_product_algorithm threaded -omp_num_threads 2
+     output_file: output/ex96_1.out
+
+   test:
+     suffix: threaded
+     args: -Mx 20 -My 20 -Mz 20 -matmatmult_via threaded -matptap_via threaded -omp_num_threads 3
+     output_file: output/ex96_1.out
+
    test:
      suffix: seq_sorted
      nsize: 3
@@ -76,6 +76,13 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
 
+  stash->freeze            = PETSC_FALSE;
+  stash->frozen            = PETSC_FALSE;
+  stash->frozen_n          = 0;
+  stash->frozen_block      = NULL;
+  stash->frozen_sendblocks = NULL;
+  stash->frozen_nblocks    = 0;
+
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_reproduce", &stash->reproduce, NULL));
 #if !defined(PETSC_HAVE_MPIUNI)
   flg = PETSC_FALSE;
@@ -677,10 +684,14 @@ typedef struct {
   PetscScalar vals[1]; /* Actually an array of length bs2 */
 } MatStashBlock;
 
-static PetscErrorCode MatStashSortCompress_Private(MatStash *stash, InsertMode insertmode)
+/*
+   Sorts the stashed blocks by row and column and packs them in segsendblocks, combining the ones at the same location.
+   If block_index is not NULL, block_index[k] is set to the index of the send block the k-th stashed block is packed into.
+*/
+static PetscErrorCode MatStashSortCompress_Private(MatStash *stash, InsertMode insertmode, PetscInt block_index[])
 {
   PetscMatStashSpace space;
-  PetscInt           n = stash->n, bs = stash->bs, bs2 = bs * bs, cnt, *row, *col, *perm, rowstart, i;
+  PetscInt           n = stash->n, bs = stash->bs, bs2 = bs * bs, cnt, *row, *col, *perm, rowstart, i, nblocks = 0;
   PetscScalar      **valptr;
 
   PetscFunctionBegin;
@@ -708,14 +719,17 @@ static PetscErrorCode MatStashSortCompress_Private(MatStash *stash, InsertMode i
         block->row = row[rowstart];
         block->col = col[colstart];
         PetscCall(PetscArraycpy(block->vals, valptr[perm[colstart]], bs2));
+        if (block_index) block_index[perm[colstart]] = nblocks;
         for (j = colstart + 1; j < i && col[j] == col[colstart]; j++) { /* Add any extra stashed blocks at the same (row,col) */
           if (insertmode == ADD_VALUES) {
             for (l = 0; l < bs2; l++) block->vals[l] += valptr[perm[j]][l];
           } else {
             PetscCall(PetscArraycpy(block->vals, valptr[perm[j]], bs2));
           }
+          if (block_index) block_index[perm[j]] = nblocks;
         }
         colstart = j;
+        nblocks++;
       }
       rowstart = i;
     }
@@ -811,6 +825,82 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm, const PetscMPIInt t
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Called at the end of the assembly that recorded the pattern with MAT_FROZEN_OFF_PROC_ENTRIES: the send blocks are kept
+   in place, the received blocks are consolidated in a single buffer and persistent requests are created on them
+*/
+static PetscErrorCode MatStashFreeze_Private(MatStash *stash)
+{
+  char       *recvblocks;
+  size_t      offset = 0;
+  PetscMPIInt tag;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSegBufferExtractInPlace(stash->segrecvblocks, &recvblocks));
+  PetscCall(PetscCommGetNewTag(stash->comm, &tag));
+  for (PetscMPIInt i = 0; i < stash->nrecvranks; i++) { /* The blocks were received in the order of the frames */
+    stash->recvframes[i].buffer = &recvblocks[offset];
+    offset += stash->recvframes[i].count * stash->blocktype_size;
+    PetscCallMPI(MPI_Recv_init(stash->recvframes[i].buffer, stash->recvframes[i].count, stash->blocktype, stash->recvranks[i], tag, stash->comm, &stash->recvreqs[i]));
+  }
+  for (PetscMPIInt i = 0; i < stash->nsendranks; i++) PetscCallMPI(MPI_Send_init(stash->sendframes[i].buffer, stash->sendhdr[i].count, stash->blocktype, stash->sendranks[i], tag, stash->comm, &stash->sendreqs[i]));
+  stash->freeze = PETSC_FALSE;
+  stash->frozen = PETSC_TRUE;
+  PetscCall(PetscInfo(NULL, "Froze the stash pattern: %" PetscInt_FMT " entries packed in %" PetscInt_FMT " blocks sent to %d ranks, receiving from %d ranks\n", stash->frozen_n, (PetscInt)stash->frozen_nblocks, stash->nsendranks, stash->nrecvranks));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Assembly with a recorded pattern: the stashed values are packed directly into the send blocks, whose rows and
+   columns are those of the recorded assembly, and the persistent requests are started
+*/
+static PetscErrorCode MatStashScatterBeginFrozen_Private(Mat mat, MatStash *stash)
+{
+  const PetscInt     bs2    = stash->bs * stash->bs;
+  const size_t       size   = stash->blocktype_size;
+  const PetscBool    insert = mat->insertmode == INSERT_VALUES ? PETSC_TRUE : PETSC_FALSE;
+  PetscMatStashSpace space;
+  PetscInt           k = 0;
+
+  PetscFunctionBegin;
+  PetscCheck(stash->n == stash->frozen_n, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "MAT_FROZEN_OFF_PROC_ENTRIES set, but %" PetscInt_FMT " off-process entries were set instead of %" PetscInt_FMT " in the recorded assembly", stash->n, stash->frozen_n);
+  if (insert != (stash->frozen_insertmode == INSERT_VALUES ? PETSC_TRUE : PETSC_FALSE)) { /* Change the insertmode encoded in the rows */
+    for (size_t b = 0; b < stash->frozen_nblocks; b++) {
+      MatStashBlock *block = (MatStashBlock *)&stash->frozen_sendblocks[b * size];
+      block->row           = -(block->row + 1);
+    }
+    stash->frozen_insertmode = mat->insertmode;
+  }
+  if (!insert) {
+    for (size_t b = 0; b < stash->frozen_nblocks; b++) PetscCall(PetscArrayzero(((MatStashBlock *)&stash->frozen_sendblocks[b * size])->vals, bs2));
+  }
+  for (space = stash->space_head; space; space = space->next) {
+    for (PetscInt i = 0; i < space->local_used; i++, k++) {
+      MatStashBlock     *block = (MatStashBlock *)&stash->frozen_sendblocks[stash->frozen_block[k] * size];
+      const PetscInt     row   = block->row < 0 ? -(block->row + 1) : block->row;
+      const PetscScalar *v     = &space->val[i * bs2];
+
+      PetscCheck(space->idx[i] == row && space->idy[i] == block->col, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "MAT_FROZEN_OFF_PROC_ENTRIES set, but off-process entry %" PetscInt_FMT " is (%" PetscInt_FMT ", %" PetscInt_FMT ") instead of (%" PetscInt_FMT ", %" PetscInt_FMT ") in the recorded assembly", k, space->idx[i], space->idy[i], row, block->col);
+      if (insert) {
+        PetscCall(PetscArraycpy(block->vals, v, bs2));
+      } else {
+        for (PetscInt l = 0; l < bs2; l++) block->vals[l] += v[l];
+      }
+    }
+  }
+
+  if (stash->nrecvranks) PetscCallMPI(MPI_Startall(stash->nrecvranks, stash->recvreqs));
+  if (stash->nsendranks) PetscCallMPI(MPI_Startall(stash->nsendranks, stash->sendreqs));
+  stash->use_status       = PETSC_FALSE; /* The counts of the recorded assembly are exact */
+  stash->recvframe_active = NULL;
+  stash->recvframe_i      = 0;
+  stash->some_i           = 0;
+  stash->some_count       = 0;
+  stash->recvcount        = 0;
+  stash->insertmode       = &mat->insertmode;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -826,10 +916,32 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat, MatStash *stash, PetscIn
     PetscCheck(addv != (ADD_VALUES | INSERT_VALUES), PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Some processors inserted others added");
   }
 
+  if (stash->frozen && (!mat->assembly_frozen || stash->frozen_state != mat->assembly_frozen_state)) { /* Forget the recorded pattern */
+    PetscCall(MatStashScatterDestroy_BTS(stash));
+    stash->first_assembly_done = PETSC_FALSE;
+  }
+  if (stash->frozen) {
+    PetscCall(MatStashScatterBeginFrozen_Private(mat, stash));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  stash->freeze = mat->assembly_frozen;
+  if (stash->freeze) { /* Record the pattern of this assembly, starting from scratch */
+    if (stash->first_assembly_done) PetscCall(MatStashScatterDestroy_BTS(stash));
+    stash->first_assembly_done = PETSC_FALSE;
+    stash->frozen_n            = stash->n;
+    stash->frozen_state        = mat->assembly_frozen_state;
+    stash->frozen_insertmode   = mat->insertmode;
+    PetscCall(PetscMalloc1(stash->n, &stash->frozen_block));
+  }
+
   PetscCall(MatStashBlockTypeSetUp(stash));
-  PetscCall(MatStashSortCompress_Private(stash, mat->insertmode));
+  PetscCall(MatStashSortCompress_Private(stash, mat->insertmode, stash->freeze ? stash->frozen_block : NULL));
   PetscCall(PetscSegBufferGetSize(stash->segsendblocks, &nblocks));
   PetscCall(PetscSegBufferExtractInPlace(stash->segsendblocks, &sendblocks));
+  if (stash->freeze) {
+    stash->frozen_sendblocks = sendblocks;
+    stash->frozen_nblocks    = nblocks;
+  }
   if (stash->first_assembly_done) { /* Set up sendhdrs and sendframes for each rank that we sent before */
     PetscInt i;
     size_t   b;
@@ -960,7 +1072,10 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 {
   PetscFunctionBegin;
   PetscCallMPI(MPI_Waitall(stash->nsendranks, stash->sendreqs, MPI_STATUSES_IGNORE));
-  if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
+  if (stash->frozen) { /* Keep the buffers and the persistent requests */
+  } else if (stash->freeze) { /* This assembly recorded the pattern, make it persistent */
+    PetscCall(MatStashFreeze_Private(stash));
+  } else if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
     PetscCall(PetscSegBufferExtractInPlace(stash->segrecvblocks, NULL));
   } else { /* No reuse, so collect everything. */
     PetscCall(MatStashScatterDestroy_BTS(stash));
@@ -989,6 +1104,16 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 PetscErrorCode MatStashScatterDestroy_BTS(MatStash *stash)
 {
   PetscFunctionBegin;
+  if (stash->frozen) {
+    for (PetscMPIInt i = 0; i < stash->nsendranks; i++) PetscCallMPI(MPI_Request_free(&stash->sendreqs[i]));
+    for (PetscMPIInt i = 0; i < stash->nrecvranks; i++) PetscCallMPI(MPI_Request_free(&stash->recvreqs[i]));
+  }
+  PetscCall(PetscFree(stash->frozen_block));
+  stash->freeze            = PETSC_FALSE;
+  stash->frozen            = PETSC_FALSE;
+  stash->frozen_n          = 0;
+  stash->frozen_sendblocks = NULL;
+  stash->frozen_nblocks    = 0;
   PetscCall(PetscSegBufferDestroy(&stash->segsendblocks));
   PetscCall(PetscSegBufferDestroy(&stash->segrecvframe));
   stash->recvframes = NULL;
@@ -543,6 +543,35 @@ int main(int argc, char **argv)
     # Using -dm_refine 2 -convest_num_refine 3 we get L_2 convergence rate: 3.9
     suffix: 2d_q3_conv
     args: -dm_plex_simplex 0 -potential_petscspace_degree 3 -snes_convergence_estimate -convest_num_refine 2
+  test:
+    suffix: 2d_q3_cldof_conv
+    output_file: output/ex13_2d_q3_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 3 -snes_convergence_estimate -convest_num_refine 2 -dm_plex_closure_dof_index
+  test:
+    suffix: 2d_q3_threads_conv
+    output_file: output/ex13_2d_q3_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 3 -snes_convergence_estimate -convest_num_refine 2 -dm_plex_assembly_threads -omp_num_threads 3
+  test:
+    suffix: 2d_q3_nosumfact_conv
+    output_file: output/ex13_2d_q3_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 3 -snes_convergence_estimate -convest_num_refine 2 -potential_petscfe_sum_factorization_degree -1
+  test:
+    suffix: 2d_q2_sumfact_conv
+    output_file: output/ex13_2d_q2_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 2 -snes_convergence_estimate -convest_num_refine 2 -potential_petscfe_sum_factorization_degree 2
+  test:
+    suffix: 2d_q2_mf_conv
+    output_file: output/ex13_2d_q2_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 2 -snes_convergence_estimate -convest_num_refine 2 -dm_mat_type shell -ksp_type cg -ksp_rtol 1e-10 -pc_type jacobi
+  test:
+    suffix: 2d_q2_hilbert_conv
+    output_file: output/ex13_2d_q2_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 2 -snes_convergence_estimate -convest_num_refine 2 -dm_plex_reorder_sfc hilbert
+  test:
+    suffix: 2d_q2_morton_conv_parallel
+    nsize: 3
+    output_file: output/ex13_2d_q2_conv.out
+    args: -dm_plex_simplex 0 -potential_petscspace_degree 2 -snes_convergence_estimate -convest_num_refine 2 -dm_plex_reorder_sfc morton -petscpartitioner_type simple
   test:
     # Using -dm_refine 2 -convest_num_refine 3 we get L_2 convergence rate: 1.9
     suffix: 2d_q1_ceed_conv
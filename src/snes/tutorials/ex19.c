@@ -710,6 +710,11 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       args: -da_refine 3 -snes_converged_reason -pc_type mg -mat_fd_type ds
       requires: !single
 
+   test:
+      suffix: 2_supernodal
+      args: -da_refine 3 -snes_converged_reason -pc_type lu -mat_factor_supernodal
+      output_file: output/ex19_2.out
+
    test:
       suffix: 2_bcols1
       nsize: 4
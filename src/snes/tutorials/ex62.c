@@ -501,10 +501,30 @@ int main(int argc, char **argv)
     suffix: 2d_q2_q1_check
     args: -sol quadratic -dm_plex_simplex 0 -vel_petscspace_degree 2 -pres_petscspace_degree 1 -dmsnes_check 0.0001
 
+  test:
+    # The velocity has more nodes than quadrature points along an edge, so the work array of the pressure must fit the velocity
+    suffix: 2d_q2_q1_sumfact_check
+    output_file: output/ex62_2d_q2_q1_check.out
+    args: -sol quadratic -dm_plex_simplex 0 -vel_petscspace_degree 2 -pres_petscspace_degree 1 -vel_petscfe_default_quadrature_order 1 \
+      -vel_petscfe_sum_factorization_degree 1 -pres_petscfe_sum_factorization_degree 1 -dmsnes_check 0.0001
+
+  test:
+    suffix: 2d_q2_q1_sumfact_shell_check
+    output_file: output/ex62_2d_q2_q1_check.out
+    args: -sol quadratic -dm_plex_simplex 0 -vel_petscspace_degree 2 -pres_petscspace_degree 1 -vel_petscfe_default_quadrature_order 1 \
+      -vel_petscfe_sum_factorization_degree 1 -pres_petscfe_sum_factorization_degree 1 -dmsnes_check 0.0001 -dm_mat_type shell
+
   test:
     suffix: 3d_q2_q1_check
     args: -sol quadratic -dm_plex_simplex 0 -dm_plex_dim 3 -dm_plex_box_faces 2,2,2 -vel_petscspace_degree 2 -pres_petscspace_degree 1 -dmsnes_check 0.0001
 
+  test:
+    suffix: 3d_q2_q1_cldof_check
+    output_file: output/ex62_3d_q2_q1_check.out
+    nsize: 2
+    args: -sol quadratic -dm_plex_simplex 0 -dm_plex_dim 3 -dm_plex_box_faces 2,2,2 -vel_petscspace_degree 2 -pres_petscspace_degree 1 -dmsnes_check 0.0001 \
+      -petscpartitioner_type simple -dm_plex_closure_dof_index
+
   test:
     suffix: 2d_q2_q1_conv
     # Using -dm_refine 3 -convest_num_refine 1 gives L_2 convergence rate: [3.0, 2.1]
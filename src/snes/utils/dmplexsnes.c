@@ -471,6 +471,79 @@ PetscErrorCode DMPlexSNESComputeBoundaryFEM(DM dm, Vec X, void *user)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Get the unique (label, value) keys of the Jacobian pointwise functions in ds */
+static PetscErrorCode DMSNESGetJacobianKeys_Private(PetscDS ds, PetscInt *Nkeys, PetscFormKey *keys[])
+{
+  PetscWeakFormKind jacmap[4] = {PETSC_WF_G0, PETSC_WF_G1, PETSC_WF_G2, PETSC_WF_G3};
+  PetscInt          Nm = 4, m, Nk = 0, k, kp, off = 0;
+  PetscFormKey     *jackeys;
+
+  PetscFunctionBegin;
+  for (m = 0; m < Nm; ++m) {
+    PetscInt Nkm;
+    PetscCall(PetscHMapFormGetSize(ds->wf->form[jacmap[m]], &Nkm));
+    Nk += Nkm;
+  }
+  PetscCall(PetscMalloc1(Nk, &jackeys));
+  for (m = 0; m < Nm; ++m) PetscCall(PetscHMapFormGetKeys(ds->wf->form[jacmap[m]], &off, jackeys));
+  PetscCheck(off == Nk, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Number of keys %" PetscInt_FMT " should be %" PetscInt_FMT, off, Nk);
+  PetscCall(PetscFormKeySort(Nk, jackeys));
+  for (k = 0, kp = 1; kp < Nk; ++kp) {
+    if ((jackeys[k].label != jackeys[kp].label) || (jackeys[k].value != jackeys[kp].value)) {
+      ++k;
+      if (kp != k) jackeys[k] = jackeys[kp];
+    }
+  }
+  *Nkeys = Nk ? k + 1 : 0;
+  *keys  = jackeys;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Apply DMPlexComputeJacobian_Action_Internal(), or DMPlexComputeJacobian_Diagonal_Internal() when Y is NULL, on the cells of each Jacobian key */
+static PetscErrorCode DMSNESComputeJacobianLocal_Private(DM dm, Vec X, Vec Y, Vec F, void *user)
+{
+  DM       plex;
+  IS       allcellIS;
+  PetscInt Nds, s;
+
+  PetscFunctionBegin;
+  PetscCall(DMSNESConvertPlex(dm, &plex, PETSC_TRUE));
+  PetscCall(DMPlexGetAllCells_Internal(plex, &allcellIS));
+  PetscCall(DMGetNumDS(dm, &Nds));
+  PetscCall(VecSet(F, 0.0));
+  for (s = 0; s < Nds; ++s) {
+    PetscDS       ds;
+    IS            cellIS;
+    PetscFormKey *jackeys = NULL;
+    PetscInt      Nk      = 0, k;
+
+    PetscCall(DMGetRegionNumDS(dm, s, NULL, NULL, &ds, NULL));
+    PetscCall(DMSNESGetJacobianKeys_Private(ds, &Nk, &jackeys));
+    for (k = 0; k < Nk; ++k) {
+      DMLabel  label = jackeys[k].label;
+      PetscInt val   = jackeys[k].value;
+
+      if (!label) {
+        PetscCall(PetscObjectReference((PetscObject)allcellIS));
+        cellIS = allcellIS;
+      } else {
+        IS pointIS;
+
+        PetscCall(DMLabelGetStratumIS(label, val, &pointIS));
+        PetscCall(ISIntersect_Caching_Internal(allcellIS, pointIS, &cellIS));
+        PetscCall(ISDestroy(&pointIS));
+      }
+      if (Y) PetscCall(DMPlexComputeJacobian_Action_Internal(plex, jackeys[k], cellIS, 0.0, 0.0, X, NULL, Y, F, user));
+      else PetscCall(DMPlexComputeJacobian_Diagonal_Internal(plex, jackeys[k], cellIS, 0.0, 0.0, X, NULL, F, user));
+      PetscCall(ISDestroy(&cellIS));
+    }
+    PetscCall(PetscFree(jackeys));
+  }
+  PetscCall(ISDestroy(&allcellIS));
+  PetscCall(DMDestroy(&plex));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   DMSNESComputeJacobianAction - Compute the action of the Jacobian J(`X`) on `Y`
 
@@ -493,71 +566,174 @@ PetscErrorCode DMPlexSNESComputeBoundaryFEM(DM dm, Vec X, void *user)
   Developer Note:
   This should be called `DMPlexSNESComputeJacobianAction()`
 
-.seealso: [](ch_snes), `DM`, ``DMSNESCreateJacobianMF()`, `DMPlexSNESComputeResidualFEM()`
+.seealso: [](ch_snes), `DM`, ``DMSNESCreateJacobianMF()`, `DMPlexSNESComputeResidualFEM()`, `DMSNESComputeJacobianDiagonal()`
 @*/
 PetscErrorCode DMSNESComputeJacobianAction(DM dm, Vec X, Vec Y, Vec F, void *user)
 {
-  DM       plex;
-  IS       allcellIS;
-  PetscInt Nds, s;
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(Y, VEC_CLASSID, 3);
+  PetscCall(DMSNESComputeJacobianLocal_Private(dm, X, Y, F, user));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
+/*@
+  DMSNESComputeJacobianDiagonal - Compute the diagonal of the Jacobian J(`X`) without forming the Jacobian
+
+  Input Parameters:
++ dm   - The `DM`
+. X    - Local solution vector
+- user - The user context
+
+  Output Parameter:
+. D - local output vector
+
+  Level: developer
+
+  Note:
+  The element matrices of the diagonal blocks of the fields are formed one batch of cells at a time.
+
+  This only works with `DMPLEX`
+
+.seealso: [](ch_snes), `DM`, `DMSNESComputeJacobianAction()`, `DMPlexSNESComputeJacobianFEM()`
+@*/
+PetscErrorCode DMSNESComputeJacobianDiagonal(DM dm, Vec X, Vec D, void *user)
+{
   PetscFunctionBegin;
-  PetscCall(DMSNESConvertPlex(dm, &plex, PETSC_TRUE));
-  PetscCall(DMPlexGetAllCells_Internal(plex, &allcellIS));
-  PetscCall(DMGetNumDS(dm, &Nds));
-  for (s = 0; s < Nds; ++s) {
-    PetscDS ds;
-    DMLabel label;
-    IS      cellIS;
+  PetscCall(DMSNESComputeJacobianLocal_Private(dm, X, NULL, D, user));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-    PetscCall(DMGetRegionNumDS(dm, s, &label, NULL, &ds, NULL));
-    {
-      PetscWeakFormKind jacmap[4] = {PETSC_WF_G0, PETSC_WF_G1, PETSC_WF_G2, PETSC_WF_G3};
-      PetscWeakForm     wf;
-      PetscInt          Nm = 4, m, Nk = 0, k, kp, off = 0;
-      PetscFormKey     *jackeys;
+struct _DMPlexSNESJacobianShellCtx {
+  DM    dm;
+  Vec   X; /* Local evaluation point */
+  void *ctx;
+};
 
-      /* Get unique Jacobian keys */
-      for (m = 0; m < Nm; ++m) {
-        PetscInt Nkm;
-        PetscCall(PetscHMapFormGetSize(ds->wf->form[jacmap[m]], &Nkm));
-        Nk += Nkm;
-      }
-      PetscCall(PetscMalloc1(Nk, &jackeys));
-      for (m = 0; m < Nm; ++m) PetscCall(PetscHMapFormGetKeys(ds->wf->form[jacmap[m]], &off, jackeys));
-      PetscCheck(off == Nk, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Number of keys %" PetscInt_FMT " should be %" PetscInt_FMT, off, Nk);
-      PetscCall(PetscFormKeySort(Nk, jackeys));
-      for (k = 0, kp = 1; kp < Nk; ++kp) {
-        if ((jackeys[k].label != jackeys[kp].label) || (jackeys[k].value != jackeys[kp].value)) {
-          ++k;
-          if (kp != k) jackeys[k] = jackeys[kp];
-        }
-      }
-      Nk = k;
+static PetscErrorCode DMPlexSNESJacobianShell_Destroy_Private(Mat A)
+{
+  struct _DMPlexSNESJacobianShellCtx *ctx;
 
-      PetscCall(PetscDSGetWeakForm(ds, &wf));
-      for (k = 0; k < Nk; ++k) {
-        DMLabel  label = jackeys[k].label;
-        PetscInt val   = jackeys[k].value;
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &ctx));
+  PetscCall(MatShellSetContext(A, NULL));
+  PetscCall(VecDestroy(&ctx->X));
+  PetscCall(PetscFree(ctx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-        if (!label) {
-          PetscCall(PetscObjectReference((PetscObject)allcellIS));
-          cellIS = allcellIS;
-        } else {
-          IS pointIS;
+static PetscErrorCode DMPlexSNESJacobianShell_Mult_Private(Mat A, Vec Y, Vec Z)
+{
+  struct _DMPlexSNESJacobianShellCtx *ctx;
+  Vec                                 Yloc, Zloc;
 
-          PetscCall(DMLabelGetStratumIS(label, val, &pointIS));
-          PetscCall(ISIntersect_Caching_Internal(allcellIS, pointIS, &cellIS));
-          PetscCall(ISDestroy(&pointIS));
-        }
-        PetscCall(DMPlexComputeJacobian_Action_Internal(plex, jackeys[k], cellIS, 0.0, 0.0, X, NULL, Y, F, user));
-        PetscCall(ISDestroy(&cellIS));
-      }
-      PetscCall(PetscFree(jackeys));
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &ctx));
+  PetscCall(DMGetLocalVector(ctx->dm, &Yloc));
+  PetscCall(DMGetLocalVector(ctx->dm, &Zloc));
+  /* Constrained dofs are not in the global vector and stay zero */
+  PetscCall(VecZeroEntries(Yloc));
+  PetscCall(DMGlobalToLocalBegin(ctx->dm, Y, INSERT_VALUES, Yloc));
+  PetscCall(DMGlobalToLocalEnd(ctx->dm, Y, INSERT_VALUES, Yloc));
+  PetscCall(DMSNESComputeJacobianAction(ctx->dm, ctx->X, Yloc, Zloc, ctx->ctx));
+  PetscCall(VecZeroEntries(Z));
+  PetscCall(DMLocalToGlobalBegin(ctx->dm, Zloc, ADD_VALUES, Z));
+  PetscCall(DMLocalToGlobalEnd(ctx->dm, Zloc, ADD_VALUES, Z));
+  PetscCall(DMRestoreLocalVector(ctx->dm, &Yloc));
+  PetscCall(DMRestoreLocalVector(ctx->dm, &Zloc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode DMPlexSNESJacobianShell_GetDiagonal_Private(Mat A, Vec D)
+{
+  struct _DMPlexSNESJacobianShellCtx *ctx;
+  Vec                                 Dloc;
+
+  PetscFunctionBegin;
+  PetscCall(MatShellGetContext(A, &ctx));
+  PetscCall(DMGetLocalVector(ctx->dm, &Dloc));
+  PetscCall(DMSNESComputeJacobianDiagonal(ctx->dm, ctx->X, Dloc, ctx->ctx));
+  PetscCall(VecZeroEntries(D));
+  PetscCall(DMLocalToGlobalBegin(ctx->dm, Dloc, ADD_VALUES, D));
+  PetscCall(DMLocalToGlobalEnd(ctx->dm, Dloc, ADD_VALUES, D));
+  PetscCall(DMRestoreLocalVector(ctx->dm, &Dloc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The matrix-free Jacobian only applies the cell terms of FE fields, so reject the terms that DMPlexComputeJacobian_Internal() adds on top */
+static PetscErrorCode DMPlexSNESCheckJacobianShell_Private(DM dm)
+{
+  PetscInt Nds, s;
+
+  PetscFunctionBegin;
+  PetscCall(DMGetNumDS(dm, &Nds));
+  for (s = 0; s < Nds; ++s) {
+    PetscDS   ds;
+    PetscBool isCohesive, hasBdJac;
+    PetscInt  Nf, f, numBd, bd;
+
+    PetscCall(DMGetRegionNumDS(dm, s, NULL, NULL, &ds, NULL));
+    PetscCall(PetscDSIsCohesive(ds, &isCohesive));
+    PetscCheck(!isCohesive, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "The matrix-free Jacobian does not support cohesive cells");
+    PetscCall(PetscDSGetNumFields(ds, &Nf));
+    for (f = 0; f < Nf; ++f) {
+      PetscObject  obj;
+      PetscClassId id;
+
+      PetscCall(PetscDSGetDiscretization(ds, f, &obj));
+      PetscCall(PetscObjectGetClassId(obj, &id));
+      PetscCheck(id == PETSCFE_CLASSID, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "The matrix-free Jacobian only supports PetscFE discretizations, not field %" PetscInt_FMT, f);
+    }
+    PetscCall(PetscDSGetNumBoundary(ds, &numBd));
+    for (bd = 0; bd < numBd; ++bd) {
+      PetscWeakForm           wf;
+      DMBoundaryConditionType type;
+      const char             *name;
+
+      PetscCall(PetscDSGetBoundary(ds, bd, &wf, &type, &name, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL));
+      if (type & DM_BC_ESSENTIAL) continue;
+      PetscCall(PetscWeakFormHasBdJacobian(wf, &hasBdJac));
+      PetscCheck(!hasBdJac, PetscObjectComm((PetscObject)dm), PETSC_ERR_SUP, "The matrix-free Jacobian does not support the boundary Jacobian of %s", name);
     }
   }
-  PetscCall(ISDestroy(&allcellIS));
-  PetscCall(DMDestroy(&plex));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  DMPlexSNESSetUpJacobianShell_Private - Turn a `MATSHELL` made by `DMCreateMatrix()` for a `DMPLEX`, which has no context yet,
+  into a matrix-free Jacobian evaluated at the local solution X, or update the evaluation point of one made before
+
+  Output Parameter:
+. isMF - `PETSC_TRUE` if J is a matrix-free Jacobian
+*/
+static PetscErrorCode DMPlexSNESSetUpJacobianShell_Private(DM dm, Vec X, Mat J, void *user, PetscBool *isMF)
+{
+  struct _DMPlexSNESJacobianShellCtx *ctx;
+  PetscObject                         dmShell;
+  PetscBool                           isShell;
+  void (*destroy)(void);
+
+  PetscFunctionBegin;
+  *isMF = PETSC_FALSE;
+  PetscCall(PetscObjectTypeCompare((PetscObject)J, MATSHELL, &isShell));
+  if (!isShell) PetscFunctionReturn(PETSC_SUCCESS);
+  /* Leave alone the shells made by users */
+  PetscCall(PetscObjectQuery((PetscObject)J, "__PETSc_DMPlex_MatShell", &dmShell));
+  if (!dmShell) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatShellGetContext(J, &ctx));
+  PetscCall(MatShellGetOperation(J, MATOP_DESTROY, &destroy));
+  if (!ctx) {
+    PetscCall(DMPlexSNESCheckJacobianShell_Private(dm));
+    PetscCall(PetscNew(&ctx));
+    ctx->dm  = dm;
+    ctx->ctx = user;
+    PetscCall(VecDuplicate(X, &ctx->X));
+    PetscCall(MatShellSetContext(J, ctx));
+    PetscCall(MatShellSetOperation(J, MATOP_DESTROY, (void (*)(void))DMPlexSNESJacobianShell_Destroy_Private));
+    PetscCall(MatShellSetOperation(J, MATOP_MULT, (void (*)(void))DMPlexSNESJacobianShell_Mult_Private));
+    PetscCall(MatShellSetOperation(J, MATOP_GET_DIAGONAL, (void (*)(void))DMPlexSNESJacobianShell_GetDiagonal_Private));
+  } else if (destroy != (void (*)(void))DMPlexSNESJacobianShell_Destroy_Private) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecCopy(X, ctx->X));
+  *isMF = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -575,20 +751,30 @@ PetscErrorCode DMSNESComputeJacobianAction(DM dm, Vec X, Vec Y, Vec F, void *use
 
   Level: developer
 
-  Note:
+  Notes:
   We form the residual one batch of elements at a time. This allows us to offload work onto an accelerator,
   like a GPU, or vectorize on a multicore machine.
 
-.seealso: [](ch_snes), `DMPLEX`, `Mat`
+  A `MATSHELL` from `DMCreateMatrix()`, for example with `-dm_mat_type shell`, becomes a matrix-free Jacobian. Its `MatMult()`
+  applies the pointwise Jacobian at the quadrature points with `DMSNESComputeJacobianAction()`, and `MatGetDiagonal()` uses
+  `DMSNESComputeJacobianDiagonal()`, so that it can be used with `PCJACOBI` and Chebyshev smoothers. Only the evaluation point `X` is stored.
+  When `JacP` is a different matrix, the Jacobian is assembled into it. A `MATSHELL` created by the user is left alone. The matrix-free
+  Jacobian only supports the cell terms of `PetscFE` fields, so finite volume fields, cohesive cells and boundary Jacobians raise an error.
+
+.seealso: [](ch_snes), `DMPLEX`, `Mat`, `DMSNESComputeJacobianAction()`, `DMSNESComputeJacobianDiagonal()`
 @*/
 PetscErrorCode DMPlexSNESComputeJacobianFEM(DM dm, Vec X, Mat Jac, Mat JacP, void *user)
 {
   DM        plex;
   IS        allcellIS;
-  PetscBool hasJac, hasPrec;
+  PetscBool hasJac, hasPrec, isMF, isMFP = PETSC_TRUE;
   PetscInt  Nds, s;
 
   PetscFunctionBegin;
+  PetscCall(DMPlexSNESSetUpJacobianShell_Private(dm, X, Jac, user, &isMF));
+  if (JacP != Jac) PetscCall(DMPlexSNESSetUpJacobianShell_Private(dm, X, JacP, user, &isMFP));
+  if (isMF && isMFP) PetscFunctionReturn(PETSC_SUCCESS);
+  if (isMF) Jac = JacP;
   PetscCall(DMSNESConvertPlex(dm, &plex, PETSC_TRUE));
   PetscCall(DMPlexGetAllCells_Internal(plex, &allcellIS));
   PetscCall(DMGetNumDS(dm, &Nds));
@@ -61,6 +61,13 @@ PetscErrorCode PetscSectionCreate(MPI_Comm comm, PetscSection *s)
   (*s)->clHash              = NULL;
   (*s)->clSection           = NULL;
   (*s)->clPoints            = NULL;
+  (*s)->clDofObj            = NULL;
+  (*s)->clDofSection        = NULL;
+  (*s)->clDofOff            = NULL;
+  (*s)->clDofs              = NULL;
+  (*s)->clDofNumColors      = 0;
+  (*s)->clDofColorOff       = NULL;
+  (*s)->clDofColorPoints    = NULL;
   PetscCall(PetscSectionInvalidateMaxDof_Internal(*s));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2637,6 +2644,7 @@ PetscErrorCode PetscSectionReset(PetscSection s)
   PetscCall(PetscSectionSymDestroy(&s->sym));
   PetscCall(PetscSectionDestroy(&s->clSection));
   PetscCall(ISDestroy(&s->clPoints));
+  PetscCall(PetscSectionResetClosureDofIndex_Internal(s));
   PetscCall(PetscSectionInvalidateMaxDof_Internal(s));
   s->pStart    = -1;
   s->pEnd      = -1;
@@ -3099,6 +3107,113 @@ PetscErrorCode PetscSectionSetClosurePermutation_Internal(PetscSection section,
   } else SETERRQ(PetscObjectComm(obj), PETSC_ERR_SUP, "Do not support borrowed arrays");
   PetscCall(PetscMalloc1(clSize, &val->invPerm));
   for (i = 0; i < clSize; ++i) val->invPerm[clPerm[i]] = i;
+  /* The closure dof index follows the closure permutation */
+  PetscCall(PetscSectionResetClosureDofIndex_Internal(section));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  PetscSectionSetClosureDofIndex_Internal - Cache the dof indices of the closures of the points [pStart, pEnd), so that closure
+  operations can gather and scatter directly instead of traversing the closure.
+
+  Input Parameters:
++ s         - The `PetscSection` giving the indices, which is section for local indices
+. obj       - A `PetscObject` which serves as the key for this index (usually a `DM`)
+. section   - The local `PetscSection` laying out the closures
+. useClPerm - Whether the indices follow the closure permutation
+. pStart    - The first indexed point
+. pEnd      - One past the last indexed point
+. off       - The offset of the closure of each point in dofs, or `NULL`
+- dofs      - The dof indices of each closure, or `NULL` to record that the closures of obj cannot be indexed
+
+  Note:
+  The section takes ownership of off and dofs. Local indices of constrained dofs are stored as -(idx+1).
+*/
+PetscErrorCode PetscSectionSetClosureDofIndex_Internal(PetscSection s, PetscObject obj, PetscSection section, PetscBool useClPerm, PetscInt pStart, PetscInt pEnd, PetscInt off[], PetscInt dofs[])
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSectionResetClosureDofIndex_Internal(s));
+  if (section != s) {
+    PetscCall(PetscObjectReference((PetscObject)section));
+    s->clDofSection = section;
+  }
+  s->clDofObj       = obj;
+  s->clDofUseClPerm = useClPerm;
+  s->clDofStart     = pStart;
+  s->clDofEnd       = pEnd;
+  s->clDofOff       = off;
+  s->clDofs         = dofs;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSectionResetClosureDofIndex_Internal(PetscSection s)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSectionDestroy(&s->clDofSection));
+  PetscCall(PetscFree(s->clDofOff));
+  PetscCall(PetscFree(s->clDofs));
+  PetscCall(PetscFree(s->clDofColorOff));
+  PetscCall(PetscFree(s->clDofColorPoints));
+  s->clDofObj       = NULL;
+  s->clDofStart     = s->clDofEnd = 0;
+  s->clDofNumColors = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  PetscSectionGetClosureDofColoring_Internal - Color the points of the local closure dof index, so that the closures of the points
+  of one color share no dof and can be updated concurrently
+
+  Output Parameters:
++ numColors   - The number of colors
+. colorOff    - The offset of each color in colorPoints, of length numColors+1
+- colorPoints - The indexed points sorted by color, counted from the first indexed point
+
+  Note:
+  The coloring is computed greedily on first use, one color per sweep over the uncolored points, and kept until the index is reset.
+*/
+PetscErrorCode PetscSectionGetClosureDofColoring_Internal(PetscSection s, PetscInt *numColors, const PetscInt *colorOff[], const PetscInt *colorPoints[])
+{
+  PetscFunctionBegin;
+  PetscCheck(s->clDofs && !s->clDofSection, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Section has no local closure dof index");
+  if (!s->clDofColorOff) {
+    const PetscInt n = s->clDofEnd - s->clDofStart;
+    PetscInt      *mark, *color, *cnt, size, ncolors = 0, ncolored = 0;
+
+    PetscCall(PetscSectionGetStorageSize(s, &size));
+    PetscCall(PetscMalloc2(size, &mark, n, &color));
+    for (PetscInt d = 0; d < size; ++d) mark[d] = -1;
+    for (PetscInt p = 0; p < n; ++p) color[p] = -1;
+    while (ncolored < n) {
+      for (PetscInt p = 0; p < n; ++p) {
+        PetscBool avail = PETSC_TRUE;
+
+        if (color[p] >= 0) continue;
+        for (PetscInt k = s->clDofOff[p]; k < s->clDofOff[p + 1] && avail; ++k) {
+          const PetscInt d = s->clDofs[k] >= 0 ? s->clDofs[k] : -(s->clDofs[k] + 1);
+
+          if (mark[d] == ncolors) avail = PETSC_FALSE;
+        }
+        if (!avail) continue;
+        for (PetscInt k = s->clDofOff[p]; k < s->clDofOff[p + 1]; ++k) mark[s->clDofs[k] >= 0 ? s->clDofs[k] : -(s->clDofs[k] + 1)] = ncolors;
+        color[p] = ncolors;
+        ++ncolored;
+      }
+      ++ncolors;
+    }
+    PetscCall(PetscCalloc1(ncolors + 1, &s->clDofColorOff));
+    PetscCall(PetscMalloc1(n, &s->clDofColorPoints));
+    for (PetscInt p = 0; p < n; ++p) ++s->clDofColorOff[color[p] + 1];
+    for (PetscInt c = 0; c < ncolors; ++c) s->clDofColorOff[c + 1] += s->clDofColorOff[c];
+    PetscCall(PetscCalloc1(ncolors, &cnt));
+    for (PetscInt p = 0; p < n; ++p) s->clDofColorPoints[s->clDofColorOff[color[p]] + cnt[color[p]]++] = p;
+    PetscCall(PetscFree(cnt));
+    PetscCall(PetscFree2(mark, color));
+    s->clDofNumColors = ncolors;
+  }
+  *numColors   = s->clDofNumColors;
+  *colorOff    = s->clDofColorOff;
+  *colorPoints = s->clDofColorPoints;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
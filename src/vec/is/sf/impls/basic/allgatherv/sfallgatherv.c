@@ -88,6 +88,7 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Allgatherv(PetscSF sf)
     PetscCall(PetscSFLinkDestroy(sf, link));
   }
   dat->avail = NULL;
+  PetscCall(PetscSFResetPackFields(sf)); /* thread plans may have been cached by the pack/unpack routines */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
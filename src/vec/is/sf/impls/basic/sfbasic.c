@@ -252,13 +252,30 @@ PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode PetscSFBatchDestroyList_Basic(PetscSFBatch *list)
+{
+  PetscSFBatch batch = *list, next;
+
+  PetscFunctionBegin;
+  for (; batch; batch = next) {
+    next = batch->next;
+    PetscCall(PetscFree(batch->links));
+    PetscCall(PetscFree(batch->reqs));
+    PetscCall(PetscFree(batch->sbuf));
+    PetscCall(PetscFree(batch->rbuf));
+    PetscCall(PetscFree(batch));
+  }
+  *list = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 {
   PetscSF_Basic *bas  = (PetscSF_Basic *)sf->data;
   PetscSFLink    link = bas->avail, next;
 
   PetscFunctionBegin;
-  PetscCheck(!bas->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  PetscCheck(!bas->inuse && !bas->batchinuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
   PetscCall(PetscFree2(bas->iranks, bas->ioffset));
   PetscCall(PetscFree(bas->irootloc));
 
@@ -275,6 +292,7 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
     PetscCall(PetscSFLinkDestroy(sf, link));
   }
   bas->avail = NULL;
+  PetscCall(PetscSFBatchDestroyList_Basic(&bas->batchavail));
   PetscCall(PetscSFResetPackFields(sf));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -443,6 +461,259 @@ PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*===================================================================================*/
+/*              Batched Bcast/Reduce with aggregated messages                        */
+/*===================================================================================*/
+static PetscErrorCode PetscSFBatchCreate_Basic(PetscSF sf, PetscInt n, PetscSFBatch *out)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFBatch   batch;
+
+  PetscFunctionBegin;
+  if (bas->batchavail) {
+    batch           = bas->batchavail;
+    bas->batchavail = batch->next;
+  } else {
+    PetscCall(PetscNew(&batch));
+    PetscCall(PetscMalloc1(bas->nrootreqs + sf->nleafreqs, &batch->reqs));
+    PetscCall(PetscCommGetNewTag(PetscObjectComm((PetscObject)sf), &batch->tag));
+  }
+  if (batch->nalloc < n) {
+    PetscCall(PetscFree(batch->links));
+    PetscCall(PetscMalloc1(n, &batch->links));
+    batch->nalloc = n;
+  }
+  batch->n         = n;
+  batch->unitbytes = 0;
+  batch->next      = bas->batchinuse;
+  bas->batchinuse  = batch;
+  *out             = batch;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Find the batch of the given tuples, remove it and its links from the in-use lists. Return NULL if there is none.
+   We match all tuples and take the batch's own links, since tuples may legitimately share keys, e.g., NULL data on empty ranks */
+static PetscErrorCode PetscSFBatchGetInUse_Basic(PetscSF sf, PetscInt n, const MPI_Datatype *unit, const void *const *rootdata, const void *const *leafdata, PetscSFBatch *out)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFBatch   batch, *p;
+  PetscSFLink    link, *q;
+  PetscInt       i;
+  PetscBool      match;
+
+  PetscFunctionBegin;
+  *out = NULL;
+  for (p = &bas->batchinuse; (batch = *p); p = &batch->next) {
+    match = (PetscBool)(batch->n == n);
+    for (i = 0; i < n && match; i++) {
+      link = batch->links[i];
+      PetscCall(MPIPetsc_Type_compare(unit[i], link->unit, &match));
+      match = (PetscBool)(match && link->rootdata == rootdata[i] && link->leafdata == leafdata[i]);
+    }
+    if (match) break;
+  }
+  if (!batch) PetscFunctionReturn(PETSC_SUCCESS);
+  *p = batch->next;
+  for (i = 0; i < n; i++) {
+    for (q = &bas->inuse; *q && *q != batch->links[i]; q = &(*q)->next);
+    PetscCheck(*q, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Link of a batch is not in use");
+    *q = batch->links[i]->next;
+  }
+  *out = batch;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBatchReclaim_Basic(PetscSF sf, PetscSFBatch *batch)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  (*batch)->next  = bas->batchavail;
+  bas->batchavail = *batch;
+  *batch          = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the send and receive sides of a batch in the given direction */
+static PetscErrorCode PetscSFBatchGetSides_Basic(PetscSF sf, PetscSFDirection direction, PetscInt *nsranks, PetscInt *ndsranks, const PetscMPIInt **sranks, const PetscInt **soffset, PetscInt *nrranks, PetscInt *ndrranks, const PetscMPIInt **rranks, const PetscInt **roffset)
+{
+  PetscFunctionBegin;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFGetRootInfo_Basic(sf, nsranks, ndsranks, sranks, soffset, NULL));
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, nrranks, ndrranks, rranks, roffset, NULL, NULL));
+  } else {
+    PetscCall(PetscSFGetLeafInfo_Basic(sf, nsranks, ndsranks, sranks, soffset, NULL, NULL));
+    PetscCall(PetscSFGetRootInfo_Basic(sf, nrranks, ndrranks, rranks, roffset, NULL));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Gather the packed remote data of all links into one buffer per destination rank and post the sends and receives */
+static PetscErrorCode PetscSFBatchStartCommunication_Basic(PetscSF sf, PetscSFBatch batch, PetscSFDirection direction)
+{
+  PetscSF_Basic     *bas  = (PetscSF_Basic *)sf->data;
+  MPI_Comm           comm = PetscObjectComm((PetscObject)sf);
+  PetscInt           k, r, nsranks, ndsranks, nrranks, ndrranks, nreqs = 0;
+  const PetscMPIInt *sranks, *rranks;
+  const PetscInt    *soffset, *roffset;
+  size_t             ssize, rsize;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchGetSides_Basic(sf, direction, &nsranks, &ndsranks, &sranks, &soffset, &nrranks, &ndrranks, &rranks, &roffset));
+  for (k = 0; k < batch->n; k++) batch->unitbytes += (size_t)batch->links[k]->unitbytes;
+  ssize = (size_t)(soffset[nsranks] - soffset[ndsranks]) * batch->unitbytes;
+  rsize = (size_t)(roffset[nrranks] - roffset[ndrranks]) * batch->unitbytes;
+  if (batch->sbufsize < ssize) {
+    PetscCall(PetscFree(batch->sbuf));
+    PetscCall(PetscMalloc(ssize, &batch->sbuf));
+    batch->sbufsize = ssize;
+  }
+  if (batch->rbufsize < rsize) {
+    PetscCall(PetscFree(batch->rbuf));
+    PetscCall(PetscMalloc(rsize, &batch->rbuf));
+    batch->rbufsize = rsize;
+  }
+
+  for (r = ndrranks; r < nrranks; r++) {
+    PetscInt cnt = roffset[r + 1] - roffset[r];
+    PetscCallMPI(MPIU_Irecv(batch->rbuf + (roffset[r] - roffset[ndrranks]) * batch->unitbytes, cnt * batch->unitbytes, MPI_BYTE, rranks[r], batch->tag, comm, &batch->reqs[nreqs++]));
+  }
+  for (r = ndsranks; r < nsranks; r++) {
+    PetscInt cnt = soffset[r + 1] - soffset[r], disp = soffset[r] - soffset[ndsranks];
+    char    *buf = batch->sbuf + disp * batch->unitbytes;
+
+    for (k = 0; k < batch->n; k++) {
+      PetscSFLink link = batch->links[k];
+      const char *src  = (direction == PETSCSF_ROOT2LEAF ? link->rootbuf : link->leafbuf)[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + disp * link->unitbytes;
+
+      PetscCall(PetscMemcpy(buf, src, cnt * link->unitbytes));
+      buf += cnt * link->unitbytes;
+    }
+    PetscCallMPI(MPIU_Isend(batch->sbuf + disp * batch->unitbytes, cnt * batch->unitbytes, MPI_BYTE, sranks[r], batch->tag, comm, &batch->reqs[nreqs++]));
+  }
+  PetscCheck(nreqs == bas->nrootreqs + sf->nleafreqs, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Number of batch requests does not match the SF setup");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Wait for the aggregated messages and scatter them into the remote buffers of the links */
+static PetscErrorCode PetscSFBatchFinishCommunication_Basic(PetscSF sf, PetscSFBatch batch, PetscSFDirection direction)
+{
+  PetscSF_Basic     *bas = (PetscSF_Basic *)sf->data;
+  PetscInt           k, r, nsranks, ndsranks, nrranks, ndrranks;
+  const PetscMPIInt *sranks, *rranks;
+  const PetscInt    *soffset, *roffset;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchGetSides_Basic(sf, direction, &nsranks, &ndsranks, &sranks, &soffset, &nrranks, &ndrranks, &rranks, &roffset));
+  PetscCallMPI(MPI_Waitall(bas->nrootreqs + sf->nleafreqs, batch->reqs, MPI_STATUSES_IGNORE));
+  for (r = ndrranks; r < nrranks; r++) {
+    PetscInt    cnt = roffset[r + 1] - roffset[r], disp = roffset[r] - roffset[ndrranks];
+    const char *buf = batch->rbuf + disp * batch->unitbytes;
+
+    for (k = 0; k < batch->n; k++) {
+      PetscSFLink link = batch->links[k];
+      char       *dst  = (direction == PETSCSF_ROOT2LEAF ? link->leafbuf : link->rootbuf)[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + disp * link->unitbytes;
+
+      PetscCall(PetscMemcpy(dst, buf, cnt * link->unitbytes));
+      buf += cnt * link->unitbytes;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline PetscBool PetscSFBatchAllHost_Private(PetscInt n, const PetscMemType *rootmtype, const PetscMemType *leafmtype)
+{
+  for (PetscInt i = 0; i < n; i++) {
+    if (!PetscMemTypeHost(rootmtype[i]) || !PetscMemTypeHost(leafmtype[i])) return PETSC_FALSE;
+  }
+  return PETSC_TRUE;
+}
+
+PETSC_INTERN PetscErrorCode PetscSFBcastManyBegin_Basic(PetscSF sf, PetscInt n, const MPI_Datatype *unit, const PetscMemType *rootmtype, const void *const *rootdata, const PetscMemType *leafmtype, void *const *leafdata, const MPI_Op *op)
+{
+  PetscSFBatch batch;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  /* Device data goes through the usual path, which knows about streams and GPU-aware MPI */
+  if (!PetscSFBatchAllHost_Private(n, rootmtype, leafmtype)) {
+    for (i = 0; i < n; i++) PetscCall(PetscSFBcastBegin_Basic(sf, unit[i], rootmtype[i], rootdata[i], leafmtype[i], leafdata[i], op[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFBatchCreate_Basic(sf, n, &batch));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscSFLinkCreate(sf, unit[i], rootmtype[i], rootdata[i], leafmtype[i], leafdata[i], op[i], PETSCSF_BCAST, &batch->links[i]));
+    PetscCall(PetscSFLinkPackRootData(sf, batch->links[i], PETSCSF_REMOTE, rootdata[i]));
+  }
+  PetscCall(PetscSFBatchStartCommunication_Basic(sf, batch, PETSCSF_ROOT2LEAF));
+  for (i = 0; i < n; i++) PetscCall(PetscSFLinkScatterLocal(sf, batch->links[i], PETSCSF_ROOT2LEAF, (void *)rootdata[i], leafdata[i], op[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFBcastManyEnd_Basic(PetscSF sf, PetscInt n, const MPI_Datatype *unit, const void *const *rootdata, void *const *leafdata, const MPI_Op *op)
+{
+  PetscSFLink  link;
+  PetscSFBatch batch;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchGetInUse_Basic(sf, n, unit, (const void *const *)rootdata, (const void *const *)leafdata, &batch));
+  if (!batch) { /* Begin went through the usual path */
+    for (i = 0; i < n; i++) PetscCall(PetscSFBcastEnd_Basic(sf, unit[i], rootdata[i], leafdata[i], op[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFBatchFinishCommunication_Basic(sf, batch, PETSCSF_ROOT2LEAF));
+  for (i = 0; i < n; i++) {
+    link = batch->links[i];
+    PetscCall(PetscSFLinkUnpackLeafData(sf, link, PETSCSF_REMOTE, leafdata[i], op[i]));
+    PetscCall(PetscSFLinkReclaim(sf, &link));
+  }
+  PetscCall(PetscSFBatchReclaim_Basic(sf, &batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFReduceManyBegin_Basic(PetscSF sf, PetscInt n, const MPI_Datatype *unit, const PetscMemType *leafmtype, const void *const *leafdata, const PetscMemType *rootmtype, void *const *rootdata, const MPI_Op *op)
+{
+  PetscSFBatch batch;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  if (!PetscSFBatchAllHost_Private(n, rootmtype, leafmtype)) {
+    for (i = 0; i < n; i++) PetscCall(PetscSFReduceBegin_Basic(sf, unit[i], leafmtype[i], leafdata[i], rootmtype[i], rootdata[i], op[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFBatchCreate_Basic(sf, n, &batch));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscSFLinkCreate(sf, unit[i], rootmtype[i], rootdata[i], leafmtype[i], leafdata[i], op[i], PETSCSF_REDUCE, &batch->links[i]));
+    PetscCall(PetscSFLinkPackLeafData(sf, batch->links[i], PETSCSF_REMOTE, leafdata[i]));
+  }
+  PetscCall(PetscSFBatchStartCommunication_Basic(sf, batch, PETSCSF_LEAF2ROOT));
+  for (i = 0; i < n; i++) PetscCall(PetscSFLinkScatterLocal(sf, batch->links[i], PETSCSF_LEAF2ROOT, rootdata[i], (void *)leafdata[i], op[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFReduceManyEnd_Basic(PetscSF sf, PetscInt n, const MPI_Datatype *unit, const void *const *leafdata, void *const *rootdata, const MPI_Op *op)
+{
+  PetscSFLink  link;
+  PetscSFBatch batch;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBatchGetInUse_Basic(sf, n, unit, (const void *const *)rootdata, leafdata, &batch));
+  if (!batch) {
+    for (i = 0; i < n; i++) PetscCall(PetscSFReduceEnd_Basic(sf, unit[i], leafdata[i], rootdata[i], op[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFBatchFinishCommunication_Basic(sf, batch, PETSCSF_LEAF2ROOT));
+  for (i = 0; i < n; i++) {
+    link = batch->links[i];
+    PetscCall(PetscSFLinkUnpackRootData(sf, link, PETSCSF_REMOTE, rootdata[i], op[i]));
+    PetscCall(PetscSFLinkReclaim(sf, &link));
+  }
+  PetscCall(PetscSFBatchReclaim_Basic(sf, &batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF sf, PetscInt *niranks, const PetscMPIInt **iranks, const PetscInt **ioffset, const PetscInt **irootloc)
 {
   PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
@@ -614,6 +885,10 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
   sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
+  sf->ops->BcastManyBegin       = PetscSFBcastManyBegin_Basic;
+  sf->ops->BcastManyEnd         = PetscSFBcastManyEnd_Basic;
+  sf->ops->ReduceManyBegin      = PetscSFReduceManyBegin_Basic;
+  sf->ops->ReduceManyEnd        = PetscSFReduceManyEnd_Basic;
   sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
   sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
   sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
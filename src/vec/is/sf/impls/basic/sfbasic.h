@@ -2,6 +2,20 @@
 
 #include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
 
+/* A batch of host Bcasts or Reduces on one SF whose remote data is sent in one aggregated message per neighbor rank.
+   For a given rank, the message holds the rank's segment of every link's buffer, one after another in link order. */
+typedef struct _n_PetscSFBatch *PetscSFBatch;
+struct _n_PetscSFBatch {
+  PetscInt     n, nalloc;          /* Number of links in the batch and capacity of links[] */
+  PetscSFLink *links;              /* One link per (unit, rootdata, leafdata, op) tuple */
+  size_t       unitbytes;          /* Sum of unitbytes of the links, i.e., bytes sent per SF edge */
+  char        *sbuf, *rbuf;        /* Aggregated send and receive buffers on host */
+  size_t       sbufsize, rbufsize; /* Allocated sizes of sbuf[] and rbuf[] in bytes */
+  MPI_Request *reqs;               /* nrootreqs + nleafreqs requests */
+  PetscMPIInt  tag;
+  PetscSFBatch next;
+};
+
 #define SFBASICHEADER \
   PetscMPIInt    niranks;          /* Number of incoming ranks (ranks accessing my roots) */ \
   PetscMPIInt    ndiranks;         /* Number of incoming ranks (ranks accessing my roots) in distinguished set */ \
@@ -16,9 +30,12 @@
   PetscSFPackOpt rootpackopt[2];   /* Pack optimization plans based on patterns in irootloc[]. NULL for no optimizations */ \
   PetscSFPackOpt rootpackopt_d[2]; /* Copy of rootpackopt[] on device if needed */ \
   PetscBool      rootdups[2];      /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */ \
+  PetscSFThreadPlan rootthreadplan[2]; /* Split of irootloc[local/remote] among OpenMP threads for host (un)packing, built on demand */ \
   PetscInt       nrootreqs;        /* Number of MPI requests */ \
   PetscSFLink    avail;            /* One or more entries per MPI Datatype, lazily constructed */ \
-  PetscSFLink    inuse             /* Buffers being used for transactions that have not yet completed */
+  PetscSFLink    inuse;            /* Buffers being used for transactions that have not yet completed */ \
+  PetscSFBatch   batchavail;       /* Batches not in use, lazily constructed */ \
+  PetscSFBatch   batchinuse        /* Batches of PetscSFBcastManyBegin() etc. that have not yet completed */
 
 typedef struct {
   SFBASICHEADER;
@@ -70,6 +87,10 @@ PETSC_INTERN PetscErrorCode PetscSFBcastBegin_Basic(PetscSF, MPI_Datatype, Petsc
 PETSC_INTERN PetscErrorCode PetscSFBcastEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFReduceBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFReduceEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFBcastManyBegin_Basic(PetscSF, PetscInt, const MPI_Datatype *, const PetscMemType *, const void *const *, const PetscMemType *, void *const *, const MPI_Op *);
+PETSC_INTERN PetscErrorCode PetscSFBcastManyEnd_Basic(PetscSF, PetscInt, const MPI_Datatype *, const void *const *, void *const *, const MPI_Op *);
+PETSC_INTERN PetscErrorCode PetscSFReduceManyBegin_Basic(PetscSF, PetscInt, const MPI_Datatype *, const PetscMemType *, const void *const *, const PetscMemType *, void *const *, const MPI_Op *);
+PETSC_INTERN PetscErrorCode PetscSFReduceManyEnd_Basic(PetscSF, PetscInt, const MPI_Datatype *, const void *const *, void *const *, const MPI_Op *);
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF, PetscInt, const PetscInt *, PetscSF *);
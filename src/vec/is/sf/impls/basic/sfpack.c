@@ -35,6 +35,27 @@
     else if (!((s).u op(t).u)) s = t; \
   } while (0)
 
+/* Threaded unpack used by DEF_UnpackFunc and DEF_UnpackAndOp when the caller set link->tplan. On host, idx[] is available whenever opt is.
+   With duplicated indices, every thread only updates the entries of its own range of the index space, see PetscSFThreadPlan */
+#define SF_UNPACK_THREADED(BS, Op, OpApply) \
+  if (link->tplan) { \
+    const PetscSFThreadPlan tp = link->tplan; \
+    if (tp->perm) { \
+      PetscPragmaOMP(parallel for num_threads(tp->nthreads) private(i, j, k, l) schedule(static, 1)) \
+      for (t = 0; t < tp->nthreads; t++) \
+        for (l = tp->offset[t]; l < tp->offset[t + 1]; l++) { \
+          i = tp->perm[l]; \
+          for (j = 0; j < M; j++) \
+            for (k = 0; k < BS; k++) OpApply(Op, u[idx[i] * MBS + j * BS + k], p[i * MBS + j * BS + k]); \
+        } \
+    } else { \
+      PetscPragmaOMP(parallel for num_threads(tp->nthreads) private(j, k) schedule(static)) \
+      for (i = 0; i < count; i++) \
+        for (j = 0; j < M; j++) \
+          for (k = 0; k < BS; k++) OpApply(Op, u[(idx ? idx[i] : start + i) * MBS + j * BS + k], p[i * MBS + j * BS + k]); \
+    } \
+  } else
+
 /* DEF_PackFunc - macro defining a Pack routine
 
    Arguments of the macro:
@@ -60,7 +81,12 @@
     const PetscInt M   = (EQ) ? 1 : bs / BS; /* If EQ, then M=1 enables compiler's const-propagation */ \
     const PetscInt MBS = M * BS;             /* MBS=bs. We turn MBS into a compile time const when EQ=1. */ \
     PetscFunctionBegin; \
-    if (!idx) PetscCall(PetscArraycpy(p, u + start * MBS, MBS * count)); /* idx[] are contiguous */ \
+    if (link->tplan) { /* threaded, see SF_UNPACK_THREADED */ \
+      PetscPragmaOMP(parallel for num_threads(link->tplan->nthreads) private(j, k) schedule(static)) \
+      for (i = 0; i < count; i++) \
+        for (j = 0; j < M; j++) \
+          for (k = 0; k < BS; k++) p[i * MBS + j * BS + k] = u[(idx ? idx[i] : start + i) * MBS + j * BS + k]; \
+    } else if (!idx) PetscCall(PetscArraycpy(p, u + start * MBS, MBS * count)); /* idx[] are contiguous */ \
     else if (opt) { /* has optimizations available */ p2 = p; \
       for (r = 0; r < opt->n; r++) { \
         u2 = u + opt->start[r] * MBS; \
@@ -97,10 +123,11 @@
   { \
     Type          *u = (Type *)unpacked, *u2; \
     const Type    *p = (const Type *)packed; \
-    PetscInt       i, j, k, X, Y, r, bs = link->bs; \
+    PetscInt       i, j, k, X, Y, r, t, l, bs = link->bs; \
     const PetscInt M   = (EQ) ? 1 : bs / BS; /* If EQ, then M=1 enables compiler's const-propagation */ \
     const PetscInt MBS = M * BS;             /* MBS=bs. We turn MBS into a compile time const when EQ=1. */ \
     PetscFunctionBegin; \
+    SF_UNPACK_THREADED(BS, =, OP_ASSIGN) \
     if (!idx) { \
       u += start * MBS; \
       if (u != p) PetscCall(PetscArraycpy(u, p, count *MBS)); \
@@ -138,10 +165,11 @@
   { \
     Type          *u = (Type *)unpacked, *u2; \
     const Type    *p = (const Type *)packed; \
-    PetscInt       i, j, k, X, Y, r, bs = link->bs; \
+    PetscInt       i, j, k, X, Y, r, t, l, bs = link->bs; \
     const PetscInt M   = (EQ) ? 1 : bs / BS; /* If EQ, then M=1 enables compiler's const-propagation */ \
     const PetscInt MBS = M * BS;             /* MBS=bs. We turn MBS into a compile time const when EQ=1. */ \
     PetscFunctionBegin; \
+    SF_UNPACK_THREADED(BS, Op, OpApply) \
     if (!idx) { \
       u += start * MBS; \
       for (i = 0; i < count; i++) \
@@ -192,11 +220,32 @@
   { \
     const Type    *u = (const Type *)src; \
     Type          *v = (Type *)dst; \
-    PetscInt       i, j, k, s, t, X, Y, bs = link->bs; \
+    PetscInt       i, j, k, s, t, l, th, X, Y, bs = link->bs; \
     const PetscInt M   = (EQ) ? 1 : bs / BS; \
     const PetscInt MBS = M * BS; \
     PetscFunctionBegin; \
-    if (!srcIdx) { /* src is contiguous */ \
+    if (link->tplan) { /* threaded, with the plan of the destination indices. See SF_UNPACK_THREADED */ \
+      const PetscSFThreadPlan tp = link->tplan; \
+      if (tp->perm) { \
+        PetscPragmaOMP(parallel for num_threads(tp->nthreads) private(i, j, k, l, s, t) schedule(static, 1)) \
+        for (th = 0; th < tp->nthreads; th++) \
+          for (l = tp->offset[th]; l < tp->offset[th + 1]; l++) { \
+            i = tp->perm[l]; \
+            s = (!srcIdx ? srcStart + i : srcIdx[i]) * MBS; \
+            t = dstIdx[i] * MBS; \
+            for (j = 0; j < M; j++) \
+              for (k = 0; k < BS; k++) OpApply(Op, v[t + j * BS + k], u[s + j * BS + k]); \
+          } \
+      } else { \
+        PetscPragmaOMP(parallel for num_threads(tp->nthreads) private(j, k, s, t) schedule(static)) \
+        for (i = 0; i < count; i++) { \
+          s = (!srcIdx ? srcStart + i : srcIdx[i]) * MBS; \
+          t = (!dstIdx ? dstStart + i : dstIdx[i]) * MBS; \
+          for (j = 0; j < M; j++) \
+            for (k = 0; k < BS; k++) OpApply(Op, v[t + j * BS + k], u[s + j * BS + k]); \
+        } \
+      } \
+    } else if (!srcIdx) { /* src is contiguous */ \
       u += srcStart * MBS; \
       PetscCall(CPPJoin4(UnpackAnd##Opname, Type, BS, EQ)(link, count, dstStart, dstOpt, dstIdx, dst, u)); \
     } else if (srcOpt && !dstIdx) { /* src is 3D, dst is contiguous */ \
@@ -906,6 +955,80 @@ static inline PetscErrorCode PetscSFLinkScatterDataWithMPIReduceLocal(PetscSF sf
               Pack/Unpack/Fetch/Scatter routines
  ============================================================================*/
 
+#if defined(PETSC_HAVE_OPENMP)
+/* Which thread owns index v, i.e., the largest t with bound[t] <= v */
+static inline PetscInt PetscSFThreadPlanOwner_Private(PetscInt nt, const PetscInt *bound, PetscInt v)
+{
+  PetscInt lo = 0, hi = nt, mid;
+
+  while (hi - lo > 1) {
+    mid = (lo + hi) / 2;
+    if (bound[mid] <= v) lo = mid;
+    else hi = mid;
+  }
+  return lo;
+}
+
+/* Create the thread plan of <count> entries with indices idx[] (NULL for contiguous indices). Set checkdups to false if idx[] is known to have no dups */
+static PetscErrorCode PetscSFThreadPlanCreate_Private(PetscInt count, const PetscInt *idx, PetscBool checkdups, PetscSFThreadPlan *out)
+{
+  PetscSFThreadPlan plan;
+  PetscInt          nt   = 1, t, i, *sorted, *bound, *next;
+  PetscBool         dups = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  nt = PetscMax(PetscNumOMPThreads, 1);
+  PetscCall(PetscNew(&plan));
+  plan->nthreads = nt;
+  if (idx && checkdups) PetscCall(PetscCheckDupsInt(count, idx, &dups));
+  if (dups) {
+    /* Split the index space at quantiles of the indices, so that each thread gets about count/nt entries */
+    PetscCall(PetscMalloc2(nt + 1, &plan->offset, count, &plan->perm));
+    PetscCall(PetscMalloc3(count, &sorted, nt, &bound, nt, &next));
+    PetscCall(PetscArraycpy(sorted, idx, count));
+    PetscCall(PetscSortInt(count, sorted));
+    bound[0] = PETSC_MIN_INT;
+    for (t = 1; t < nt; t++) bound[t] = sorted[(PetscInt)(((PetscInt64)count * t) / nt)];
+    PetscCall(PetscArrayzero(plan->offset, nt + 1));
+    for (i = 0; i < count; i++) plan->offset[PetscSFThreadPlanOwner_Private(nt, bound, idx[i]) + 1]++;
+    for (t = 0; t < nt; t++) {
+      plan->offset[t + 1] += plan->offset[t];
+      next[t] = plan->offset[t];
+    }
+    for (i = 0; i < count; i++) plan->perm[next[PetscSFThreadPlanOwner_Private(nt, bound, idx[i])]++] = i;
+    PetscCall(PetscFree3(sorted, bound, next));
+  }
+  *out = plan;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+static PetscErrorCode PetscSFThreadPlanDestroy_Private(PetscSFThreadPlan *plan)
+{
+  PetscFunctionBegin;
+  if (*plan) PetscCall(PetscFree2((*plan)->offset, (*plan)->perm));
+  PetscCall(PetscFree(*plan));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the thread plan for a pack/unpack of <count> entries with indices idx[] in memory of <mtype>, or NULL if the pack/unpack
+   should be done by a single thread. The plan is built at first use and cached in <cache> */
+static PetscErrorCode PetscSFLinkGetThreadPlan_Private(PetscSF sf, PetscSFLink link, PetscMemType mtype, PetscInt count, const PetscInt *idx, PetscSFThreadPlan *cache, PetscSFThreadPlan *plan)
+{
+  PetscFunctionBegin;
+  *plan = NULL;
+#if defined(PETSC_HAVE_OPENMP)
+  if (!sf->pack_threads || !PetscMemTypeHost(mtype) || PetscNumOMPThreads < 2 || (PetscInt64)count * (PetscInt64)link->unitbytes < (PetscInt64)sf->pack_threads_threshold) PetscFunctionReturn(PETSC_SUCCESS);
+  if (*cache && (*cache)->nthreads != PetscNumOMPThreads) PetscCall(PetscSFThreadPlanDestroy_Private(cache));
+  if (!*cache) {
+    PetscCall(PetscSFThreadPlanCreate_Private(count, idx, sf->multi == sf ? PETSC_FALSE : PETSC_TRUE, cache));
+    PetscCall(PetscInfo(sf, "Split %" PetscInt_FMT " entries among %" PetscInt_FMT " threads%s\n", count, (*cache)->nthreads, (*cache)->perm ? " by ranges of their duplicated indices" : ""));
+  }
+  *plan = *cache;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Pack rootdata to rootbuf
   Input Parameters:
   + sf       - The SF this packing works on.
@@ -921,6 +1044,7 @@ static PetscErrorCode PetscSFLinkPackRootData_Private(PetscSF sf, PetscSFLink li
 {
   const PetscInt *rootindices = NULL;
   PetscInt        count, start;
+  PetscSF_Basic  *bas = (PetscSF_Basic *)sf->data;
   PetscErrorCode (*Pack)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, const void *, void *) = NULL;
   PetscMemType   rootmtype                                                                                        = link->rootmtype;
   PetscSFPackOpt opt                                                                                              = NULL;
@@ -929,7 +1053,9 @@ static PetscErrorCode PetscSFLinkPackRootData_Private(PetscSF sf, PetscSFLink li
   if (!link->rootdirect[scope]) { /* If rootdata works directly as rootbuf, skip packing */
     PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, rootmtype, scope, &count, &start, &opt, &rootindices));
     PetscCall(PetscSFLinkGetPack(link, rootmtype, &Pack));
+    PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, rootmtype, count, rootindices, &bas->rootthreadplan[scope], &link->tplan));
     PetscCall((*Pack)(link, count, start, opt, rootindices, rootdata, link->rootbuf[scope][rootmtype]));
+    link->tplan = NULL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -947,7 +1073,9 @@ static PetscErrorCode PetscSFLinkPackLeafData_Private(PetscSF sf, PetscSFLink li
   if (!link->leafdirect[scope]) { /* If leafdata works directly as rootbuf, skip packing */
     PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, leafmtype, scope, &count, &start, &opt, &leafindices));
     PetscCall(PetscSFLinkGetPack(link, leafmtype, &Pack));
+    PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, leafmtype, count, leafindices, &sf->leafthreadplan[scope], &link->tplan));
     PetscCall((*Pack)(link, count, start, opt, leafindices, leafdata, link->leafbuf[scope][leafmtype]));
+    link->tplan = NULL;
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -995,7 +1123,9 @@ static PetscErrorCode PetscSFLinkUnpackRootData_Private(PetscSF sf, PetscSFLink
     PetscCall(PetscSFLinkGetUnpackAndOp(link, rootmtype, op, bas->rootdups[scope], &UnpackAndOp));
     if (UnpackAndOp) {
       PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, rootmtype, scope, &count, &start, &opt, &rootindices));
+      PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, rootmtype, count, rootindices, &bas->rootthreadplan[scope], &link->tplan));
       PetscCall((*UnpackAndOp)(link, count, start, opt, rootindices, rootdata, link->rootbuf[scope][rootmtype]));
+      link->tplan = NULL;
     } else {
       PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, scope, &count, &start, &opt, &rootindices));
       PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, link, count, start, rootindices, rootdata, link->rootbuf[scope][rootmtype], op));
@@ -1018,7 +1148,9 @@ static PetscErrorCode PetscSFLinkUnpackLeafData_Private(PetscSF sf, PetscSFLink
     PetscCall(PetscSFLinkGetUnpackAndOp(link, leafmtype, op, sf->leafdups[scope], &UnpackAndOp));
     if (UnpackAndOp) {
       PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, leafmtype, scope, &count, &start, &opt, &leafindices));
+      PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, leafmtype, count, leafindices, &sf->leafthreadplan[scope], &link->tplan));
       PetscCall((*UnpackAndOp)(link, count, start, opt, leafindices, leafdata, link->leafbuf[scope][leafmtype]));
+      link->tplan = NULL;
     } else {
       PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, scope, &count, &start, &opt, &leafindices));
       PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, link, count, start, leafindices, leafdata, link->leafbuf[scope][leafmtype], op));
@@ -1123,11 +1255,16 @@ PetscErrorCode PetscSFLinkScatterLocal(PetscSF sf, PetscSFLink link, PetscSFDire
     if (ScatterAndOp) {
       PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, rootmtype, PETSCSF_LOCAL, &count, &rootstart, &rootopt, &rootindices));
       PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, leafmtype, PETSCSF_LOCAL, &count, &leafstart, &leafopt, &leafindices));
+      if (rootdata != leafdata) { /* Threads are split by the destination indices */
+        if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, leafmtype, count, leafindices, &sf->leafthreadplan[PETSCSF_LOCAL], &link->tplan));
+        else PetscCall(PetscSFLinkGetThreadPlan_Private(sf, link, rootmtype, count, rootindices, &bas->rootthreadplan[PETSCSF_LOCAL], &link->tplan));
+      }
       if (direction == PETSCSF_ROOT2LEAF) {
         PetscCall((*ScatterAndOp)(link, count, rootstart, rootopt, rootindices, rootdata, leafstart, leafopt, leafindices, leafdata));
       } else {
         PetscCall((*ScatterAndOp)(link, count, leafstart, leafopt, leafindices, leafdata, rootstart, rootopt, rootindices, rootdata));
       }
+      link->tplan = NULL;
     } else {
       PetscCall(PetscSFLinkGetRootPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_LOCAL, &count, &rootstart, &rootopt, &rootindices));
       PetscCall(PetscSFLinkGetLeafPackOptAndIndices(sf, link, PETSC_MEMTYPE_HOST, PETSCSF_LOCAL, &count, &leafstart, &leafopt, &leafindices));
@@ -1361,6 +1498,8 @@ PetscErrorCode PetscSFResetPackFields(PetscSF sf)
   for (i = PETSCSF_LOCAL; i <= PETSCSF_REMOTE; i++) {
     PetscCall(PetscSFDestroyPackOpt(sf, PETSC_MEMTYPE_HOST, &sf->leafpackopt[i]));
     PetscCall(PetscSFDestroyPackOpt(sf, PETSC_MEMTYPE_HOST, &bas->rootpackopt[i]));
+    PetscCall(PetscSFThreadPlanDestroy_Private(&sf->leafthreadplan[i]));
+    PetscCall(PetscSFThreadPlanDestroy_Private(&bas->rootthreadplan[i]));
 #if defined(PETSC_HAVE_DEVICE)
     PetscCall(PetscSFDestroyPackOpt(sf, PETSC_MEMTYPE_DEVICE, &sf->leafpackopt_d[i]));
     PetscCall(PetscSFDestroyPackOpt(sf, PETSC_MEMTYPE_DEVICE, &bas->rootpackopt_d[i]));
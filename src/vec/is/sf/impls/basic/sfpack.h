@@ -49,6 +49,19 @@ struct _n_PetscSFPackOpt {
   PetscInt *X, *Y;        /* [n] Lengths of the outer matrix in X, Y. We do not care Z. */
 };
 
+/* Split of the entries of a host pack/unpack among OpenMP threads.
+
+   Without duplicated indices (perm = NULL), the entries are simply split in nthreads chunks. Otherwise, the index space of
+   the unpacked data is split in nthreads ranges holding about the same number of entries, and thread t unpacks entries
+   perm[offset[t]..offset[t+1]), i.e., those whose index is in its range. perm[] keeps the original order of the entries,
+   so a reduction on a duplicated index is done in the same order as in the serial kernel.
+ */
+struct _n_PetscSFThreadPlan {
+  PetscInt  nthreads; /* Number of threads the plan is built for */
+  PetscInt *offset;   /* [nthreads+1] */
+  PetscInt *perm;     /* [count] Positions of the entries in the buffer, grouped by thread. NULL if there are no duplicated indices */
+};
+
 /* An abstract class that defines a communication link, which includes how to pack/unpack data and send/recv buffers
  */
 struct _n_PetscSFLink {
@@ -168,6 +181,7 @@ struct _n_PetscSFLink {
   cupmStream_t stream;                   /* stream on which input/output root/leafdata is computed on (default is PetscDefaultCudaStream) */
   #endif
 #endif
+  PetscSFThreadPlan tplan;           /* Set by callers of the host kernels for the duration of a threaded call, NULL otherwise */
   PetscMPIInt  tag;                  /* Each link has a tag so we can perform multiple SF ops at the same time */
   MPI_Datatype unit;                 /* The MPI datatype this PetscSFLink is built for */
   MPI_Datatype basicunit;            /* unit is made of MPI builtin dataype basicunit */
@@ -0,0 +1,967 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/*
+   PETSCSFHYBRID splits the graph in two PETSCSFBASIC star forests:
+
+   offsf  - the edges whose roots are on this rank or on another node. They are communicated with MPI by SFBasic.
+   nodesf - the edges whose roots are on another rank of this node. Only its setup (ranks, offsets and pack indices)
+            is used on host memory: roots (in Bcast) or leaves (in Reduce) are packed into a buffer in an MPI-3
+            shared memory window, and the ranks on the other end unpack directly from that buffer. On device memory,
+            or for ops without a host unpack kernel, nodesf falls back to MPI.
+
+   Each rank owns one segment of the window, laid out as
+
+     header | post[2][nslots] | ack[ROOT2LEAF][nslots][nreaders[ROOT2LEAF]] | ack[LEAF2ROOT][nslots][nreaders[LEAF2ROOT]] | rootbuf[nslots] | leafbuf[nslots]
+
+   The n-th shared memory operation in a direction uses slot n % nslots. The sender packs into the slot once all its
+   readers have acknowledged the operation n - nslots in ack[], then publishes n in post[]. A reader waits on post[] of
+   the sender, unpacks, and writes n into its entry of ack[] of the sender. A counter is only written by one rank, so
+   MPI_Win_sync() is the only synchronization needed.
+
+   With -sf_hybrid_aggregate, the edges whose roots are on another node are moved from offsf to farsf, and on host
+   memory they are routed through the leader (rank 0 of the shared memory communicator) of each node:
+
+     roots --rootaggsf--> A on the leader of the root node --leadersf--> B on the leader of the leaf node --leafaggsf--> leaves
+
+   A and B have one entry per routed edge, so that the intermediate steps are copies and any op can be applied on the
+   last step. rootaggsf and leafaggsf are PETSCSFHYBRID star forests within a node; leadersf is a PETSCSFBASIC whose
+   roots are B and leaves are A, so that each leader sends one message per node it talks to. On device memory, farsf
+   is used instead.
+*/
+
+typedef struct {
+  PetscInt nreaders[2];  /* [PetscSFDirection] Number of on-node ranks reading my root (ROOT2LEAF) or leaf (LEAF2ROOT) buffer */
+  size_t   slotbytes[2]; /* [PetscSFDirection] Bytes of one slot of my root or leaf buffer */
+  size_t   bufoff[2];    /* [PetscSFDirection] Offset in bytes of my root or leaf buffer from the start of my segment */
+} PetscSFHybridHeader;
+
+typedef struct {
+  PetscSFLink      link; /* Provides the pack/unpack kernels of the unit */
+  PetscSFDirection direction;
+  const void      *rootdata, *leafdata; /* Keys to look up the operation in XxxEnd() */
+  PetscInt         seq;
+} PetscSFHybridOp;
+
+/* Buffers of an aggregated operation in flight */
+typedef struct _n_PetscSFHybridAgg *PetscSFHybridAgg;
+struct _n_PetscSFHybridAgg {
+  PetscSFLink      link; /* Unit of the buffers */
+  PetscSFDirection direction;
+  const void      *rootdata, *leafdata; /* Keys to look up the operation in XxxEnd() */
+  char            *abuf, *bbuf;         /* A and B, only non-empty on leaders */
+  PetscSFHybridAgg next;
+};
+
+typedef struct {
+  PetscSF          offsf;  /* Edges to roots on this rank, and on other nodes unless they are aggregated */
+  PetscSF          nodesf; /* Edges to roots on other ranks of this node */
+  PetscShmComm     pshmcomm;
+  MPI_Comm         shmcomm;
+  MPI_Win          win;
+  char            *seg;       /* My segment of the window */
+  char           **rootseg;   /* [nrootpeers] Segments of the on-node ranks owning roots of my leaves, i.e., nodesf->ranks[] */
+  char           **leafseg;   /* [nleafpeers] Segments of the on-node ranks with leaves on my roots, i.e., iranks[] of nodesf */
+  PetscInt        *rootdisp;  /* [nrootpeers] Offset (in units) of the data for my leaves in the root buffer of the peer */
+  PetscInt        *rootslot;  /* [nrootpeers] My index among the readers of the root buffer of the peer */
+  PetscInt        *leafdisp;  /* [nleafpeers] Offset (in units) of the data for my roots in the leaf buffer of the peer */
+  PetscInt        *leafslot;  /* [nleafpeers] My index among the readers of the leaf buffer of the peer */
+  PetscInt         nslots;    /* Number of operations in each direction that can be in flight at the same time */
+  size_t           unitbytes; /* Largest unit the window is sized for */
+  PetscInt         seq[2];    /* [PetscSFDirection] Number of shared memory operations started */
+  PetscInt         nops;      /* Number of shared memory operations in flight */
+  PetscSFHybridOp *ops;       /* [2*nslots] */
+  PetscSFLink      links;     /* Pack/unpack kernels, one per unit seen */
+
+  /* Routing of the edges to other nodes through node leaders */
+  PetscBool        aggregate;
+  PetscSF          farsf;     /* Edges to roots on other nodes */
+  PetscSF          rootaggsf; /* Roots of the node -> A on its leader, whose leaves are the routed edges */
+  PetscSF          leadersf;  /* B on this leader (roots) <- A on the leaders of the root nodes (leaves) */
+  PetscSF          leafaggsf; /* B on the leader of my node -> my leaves with roots on other nodes */
+  PetscSFHybridAgg aggavail, agginuse;
+
+  /* Leaf ranks of the whole graph for PetscSFGetLeafRanks(), merged from offsf and nodesf */
+  PetscInt     niranks;
+  PetscMPIInt *iranks;
+  PetscInt    *ioffset, *irootloc;
+} PetscSF_Hybrid;
+
+static inline size_t PetscSFHybridAlign(size_t bytes)
+{
+  return (bytes + PETSC_MEMALIGN - 1) / PETSC_MEMALIGN * PETSC_MEMALIGN;
+}
+
+static inline volatile PetscInt *PetscSFHybridPost(char *seg, PetscInt nslots, PetscSFDirection direction, PetscInt s)
+{
+  return (volatile PetscInt *)(seg + sizeof(PetscSFHybridHeader)) + direction * nslots + s;
+}
+
+static inline volatile PetscInt *PetscSFHybridAck(char *seg, PetscInt nslots, PetscSFDirection direction, PetscInt s, PetscInt r)
+{
+  PetscSFHybridHeader *hdr = (PetscSFHybridHeader *)seg;
+  PetscInt             off = 2 * nslots + (direction == PETSCSF_ROOT2LEAF ? 0 : nslots * hdr->nreaders[PETSCSF_ROOT2LEAF]) + s * hdr->nreaders[direction] + r;
+
+  return (volatile PetscInt *)(seg + sizeof(PetscSFHybridHeader)) + off;
+}
+
+static inline char *PetscSFHybridBuffer(char *seg, PetscSFDirection direction, PetscInt s)
+{
+  PetscSFHybridHeader *hdr = (PetscSFHybridHeader *)seg;
+
+  return seg + hdr->bufoff[direction] + s * hdr->slotbytes[direction];
+}
+
+/* Spin until another rank of the node has written a value no less than <value> to <flag> */
+static inline PetscErrorCode PetscSFHybridWait_Private(MPI_Win win, volatile PetscInt *flag, PetscInt value)
+{
+  PetscFunctionBegin;
+  while (*flag < value) PetscCallMPI(MPI_Win_sync(win));
+  PetscCallMPI(MPI_Win_sync(win));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFHybridFreeWindow_Private(PetscSF sf)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+
+  PetscFunctionBegin;
+  if (hyb->win != MPI_WIN_NULL) {
+    PetscCallMPI(MPI_Win_unlock_all(hyb->win));
+    PetscCallMPI(MPI_Win_free(&hyb->win));
+  }
+  hyb->seg       = NULL;
+  hyb->unitbytes = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* (Re)allocate the shared memory window when a unit larger than the window is sized for shows up. Collective on the
+   node, which is fine since all ranks do the same sequence of operations on the SF */
+static PetscErrorCode PetscSFHybridSetUpWindow_Private(PetscSF sf, size_t unitbytes)
+{
+  PetscSF_Hybrid      *hyb    = (PetscSF_Hybrid *)sf->data;
+  PetscSF              nodesf = hyb->nodesf;
+  PetscSF_Basic       *nbas   = (PetscSF_Basic *)nodesf->data;
+  PetscInt             i, s, d, nflags, K = hyb->nslots;
+  PetscMPIInt          lrank, dispunit;
+  size_t               hdrbytes, total;
+  MPI_Aint             size;
+  MPI_Info             info;
+  PetscSFHybridHeader *hdr;
+
+  PetscFunctionBegin;
+  if (hyb->win != MPI_WIN_NULL && unitbytes <= hyb->unitbytes) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCheck(!hyb->nops, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Cannot resize the shared memory window of a PETSCSFHYBRID with operations in flight; start with the operation on the largest unit");
+  PetscCall(PetscSFHybridFreeWindow_Private(sf));
+
+  PetscCall(PetscNew(&hdr));
+  hdr->nreaders[PETSCSF_ROOT2LEAF]  = nbas->niranks - nbas->ndiranks;
+  hdr->nreaders[PETSCSF_LEAF2ROOT]  = nodesf->nranks - nodesf->ndranks;
+  hdr->slotbytes[PETSCSF_ROOT2LEAF] = PetscSFHybridAlign(nbas->rootbuflen[PETSCSF_REMOTE] * unitbytes);
+  hdr->slotbytes[PETSCSF_LEAF2ROOT] = PetscSFHybridAlign(nodesf->leafbuflen[PETSCSF_REMOTE] * unitbytes);
+  nflags                            = 2 * K + K * (hdr->nreaders[PETSCSF_ROOT2LEAF] + hdr->nreaders[PETSCSF_LEAF2ROOT]);
+  hdrbytes                          = PetscSFHybridAlign(sizeof(PetscSFHybridHeader) + nflags * sizeof(PetscInt));
+  hdr->bufoff[PETSCSF_ROOT2LEAF]    = hdrbytes;
+  hdr->bufoff[PETSCSF_LEAF2ROOT]    = hdrbytes + K * hdr->slotbytes[PETSCSF_ROOT2LEAF];
+  total                             = hdr->bufoff[PETSCSF_LEAF2ROOT] + K * hdr->slotbytes[PETSCSF_LEAF2ROOT];
+
+  /* Let MPI place each segment in memory local to its owner */
+  PetscCallMPI(MPI_Info_create(&info));
+  PetscCallMPI(MPI_Info_set(info, "alloc_shared_noncontig", "true"));
+  PetscCallMPI(MPI_Win_allocate_shared((MPI_Aint)total, 1, info, hyb->shmcomm, &hyb->seg, &hyb->win));
+  PetscCallMPI(MPI_Info_free(&info));
+  PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, hyb->win));
+  PetscCall(PetscMemcpy(hyb->seg, hdr, sizeof(PetscSFHybridHeader)));
+  PetscCall(PetscFree(hdr));
+  /* Counters start at the current sequence numbers, so that the next nslots operations need not wait for acks */
+  for (d = PETSCSF_ROOT2LEAF; d <= PETSCSF_LEAF2ROOT; d++) {
+    for (s = 0; s < K; s++) {
+      *PetscSFHybridPost(hyb->seg, K, (PetscSFDirection)d, s) = hyb->seq[d];
+      for (i = 0; i < ((PetscSFHybridHeader *)hyb->seg)->nreaders[d]; i++) *PetscSFHybridAck(hyb->seg, K, (PetscSFDirection)d, s, i) = hyb->seq[d];
+    }
+  }
+  PetscCallMPI(MPI_Win_sync(hyb->win));
+  PetscCallMPI(MPI_Barrier(hyb->shmcomm));
+
+  for (i = nodesf->ndranks; i < nodesf->nranks; i++) {
+    PetscCall(PetscShmCommGlobalToLocal(hyb->pshmcomm, nodesf->ranks[i], &lrank));
+    PetscCallMPI(MPI_Win_shared_query(hyb->win, lrank, &size, &dispunit, &hyb->rootseg[i - nodesf->ndranks]));
+  }
+  for (i = nbas->ndiranks; i < nbas->niranks; i++) {
+    PetscCall(PetscShmCommGlobalToLocal(hyb->pshmcomm, nbas->iranks[i], &lrank));
+    PetscCallMPI(MPI_Win_shared_query(hyb->win, lrank, &size, &dispunit, &hyb->leafseg[i - nbas->ndiranks]));
+  }
+  hyb->unitbytes = unitbytes;
+  PetscCall(PetscInfo(sf, "Allocated %zu bytes of shared memory for units of %zu bytes\n", total, unitbytes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get the pack/unpack kernels of <unit>. We only need the host kernels of a link, not its buffers or MPI requests */
+static PetscErrorCode PetscSFHybridGetLink_Private(PetscSF sf, MPI_Datatype unit, PetscSFLink *mylink)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFLink     link;
+  PetscBool       match;
+
+  PetscFunctionBegin;
+  for (link = hyb->links; link; link = link->next) {
+    PetscCall(MPIPetsc_Type_compare(unit, link->unit, &match));
+    if (match) {
+      *mylink = link;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  PetscCall(PetscNew(&link));
+  PetscCall(PetscSFLinkSetUp_Host(hyb->nodesf, link, unit));
+  link->next = hyb->links;
+  hyb->links = link;
+  *mylink    = link;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Can the nodesf part of the operation go through shared memory? All ranks reach the same answer since they pass the same unit and op */
+static PetscErrorCode PetscSFHybridUseShm_Private(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, PetscMemType leafmtype, MPI_Op op, PetscSFLink *link, PetscBool *useshm)
+{
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  *useshm = PETSC_FALSE;
+  if (!PetscMemTypeHost(rootmtype) || !PetscMemTypeHost(leafmtype)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFHybridGetLink_Private(sf, unit, link));
+  PetscCall(PetscSFLinkGetUnpackAndOp(*link, PETSC_MEMTYPE_HOST, op, PETSC_FALSE, &UnpackAndOp));
+  *useshm = UnpackAndOp ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack roots (ROOT2LEAF) or leaves (LEAF2ROOT) of nodesf into my next slot and publish it */
+static PetscErrorCode PetscSFHybridBegin_Private(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *rootdata, const void *leafdata)
+{
+  PetscSF_Hybrid  *hyb    = (PetscSF_Hybrid *)sf->data;
+  PetscSF          nodesf = hyb->nodesf;
+  PetscInt         i, n, s, count, start, K = hyb->nslots;
+  PetscSFPackOpt   opt = NULL;
+  const PetscInt  *indices;
+  PetscSFHybridOp *hop;
+
+  PetscFunctionBegin;
+  PetscCheck(hyb->nops < 2 * K, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Too many PETSCSFHYBRID operations in flight; increase -sf_hybrid_slots");
+  for (i = 0; i < hyb->nops; i++) {
+    PetscCheck(hyb->ops[i].direction != direction || hyb->ops[i].seq > hyb->seq[direction] - K + 1, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "More than %" PetscInt_FMT " PETSCSFHYBRID operations in flight in the same direction; increase -sf_hybrid_slots", K);
+    PetscCheck(hyb->ops[i].rootdata != rootdata || hyb->ops[i].leafdata != leafdata || !(rootdata || leafdata), PETSC_COMM_SELF, PETSC_ERR_SUP, "Overlapped PetscSF with the same rootdata(%p), leafdata(%p). Undo the overlapping to avoid the error.", rootdata, leafdata);
+  }
+  PetscCall(PetscSFHybridSetUpWindow_Private(sf, link->unitbytes));
+  n = ++hyb->seq[direction];
+  s = n % K;
+
+  /* The slot is free once every reader has consumed the operation that used it last */
+  for (i = 0; i < ((PetscSFHybridHeader *)hyb->seg)->nreaders[direction]; i++) PetscCall(PetscSFHybridWait_Private(hyb->win, PetscSFHybridAck(hyb->seg, K, direction, s, i), n - K));
+
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFLinkGetRootPackOptAndIndices(nodesf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &count, &start, &opt, &indices));
+    if (count) PetscCall((*link->h_Pack)(link, count, start, opt, indices, rootdata, PetscSFHybridBuffer(hyb->seg, direction, s)));
+  } else {
+    PetscCall(PetscSFLinkGetLeafPackOptAndIndices(nodesf, link, PETSC_MEMTYPE_HOST, PETSCSF_REMOTE, &count, &start, &opt, &indices));
+    if (count) PetscCall((*link->h_Pack)(link, count, start, opt, indices, leafdata, PetscSFHybridBuffer(hyb->seg, direction, s)));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscCallMPI(MPI_Win_sync(hyb->win));
+  *PetscSFHybridPost(hyb->seg, K, direction, s) = n;
+
+  hop            = &hyb->ops[hyb->nops++];
+  hop->link      = link;
+  hop->direction = direction;
+  hop->rootdata  = rootdata;
+  hop->leafdata  = leafdata;
+  hop->seq       = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Look up a shared memory operation started by PetscSFHybridBegin_Private(). Returns PETSC_FALSE if nodesf used MPI for it */
+static PetscErrorCode PetscSFHybridGetOp_Private(PetscSF sf, MPI_Datatype unit, PetscSFDirection direction, const void *rootdata, const void *leafdata, PetscSFHybridOp *op, PetscBool *found)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscBool       match;
+
+  PetscFunctionBegin;
+  *found = PETSC_FALSE;
+  for (PetscInt i = 0; i < hyb->nops; i++) {
+    if (hyb->ops[i].direction != direction || hyb->ops[i].rootdata != rootdata || hyb->ops[i].leafdata != leafdata) continue;
+    PetscCall(MPIPetsc_Type_compare(unit, hyb->ops[i].link->unit, &match));
+    if (!match) continue;
+    *op    = hyb->ops[i];
+    *found = PETSC_TRUE;
+    for (PetscInt j = i + 1; j < hyb->nops; j++) hyb->ops[j - 1] = hyb->ops[j];
+    hyb->nops--;
+    break;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the data of the peers from their slots into leafdata (ROOT2LEAF) or rootdata (LEAF2ROOT) and acknowledge */
+static PetscErrorCode PetscSFHybridEnd_Private(PetscSF sf, PetscSFHybridOp *hop, void *data, MPI_Op op)
+{
+  PetscSF_Hybrid  *hyb       = (PetscSF_Hybrid *)sf->data;
+  PetscSF          nodesf    = hyb->nodesf;
+  PetscSF_Basic   *nbas      = (PetscSF_Basic *)nodesf->data;
+  PetscSFLink      link      = hop->link;
+  PetscSFDirection direction = hop->direction;
+  PetscInt         i, j, npeers, n = hop->seq, s = hop->seq % hyb->nslots, K = hyb->nslots;
+  const PetscInt  *offset, *indices, *disp, *slot;
+  char           **peerseg;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    j       = nodesf->ndranks;
+    npeers  = nodesf->nranks - nodesf->ndranks;
+    offset  = nodesf->roffset;
+    indices = nodesf->rmine;
+    peerseg = hyb->rootseg;
+    disp    = hyb->rootdisp;
+    slot    = hyb->rootslot;
+  } else {
+    j       = nbas->ndiranks;
+    npeers  = nbas->niranks - nbas->ndiranks;
+    offset  = nbas->ioffset;
+    indices = nbas->irootloc;
+    peerseg = hyb->leafseg;
+    disp    = hyb->leafdisp;
+    slot    = hyb->leafslot;
+  }
+  PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, PETSC_FALSE, &UnpackAndOp));
+  for (i = 0; i < npeers; i++, j++) {
+    PetscInt count = offset[j + 1] - offset[j];
+
+    PetscCall(PetscSFHybridWait_Private(hyb->win, PetscSFHybridPost(peerseg[i], K, direction, s), n));
+    PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+    if (count) PetscCall((*UnpackAndOp)(link, count, 0, NULL, indices + offset[j], data, PetscSFHybridBuffer(peerseg[i], direction, s) + disp[i] * link->unitbytes));
+    PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+    PetscCallMPI(MPI_Win_sync(hyb->win));
+    *PetscSFHybridAck(peerseg[i], K, direction, s, slot[i]) = n;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Merge the leaf ranks of offsf, nodesf and farsf, in the order PETSCSFBASIC uses: the distinguished (self) rank first, then increasing ranks */
+static PetscErrorCode PetscSFHybridSetUpLeafRanks_Private(PetscSF sf)
+{
+  PetscSF_Hybrid    *hyb    = (PetscSF_Hybrid *)sf->data;
+  PetscSF            sfs[3] = {hyb->offsf, hyb->nodesf, hyb->farsf};
+  PetscInt           nsf    = hyb->farsf ? 3 : 2, ni[3], i, k, p[3] = {0, 0, 0}, c, n, nleaves = 0;
+  const PetscMPIInt *ir[3];
+  const PetscInt    *io[3], *il[3];
+
+  PetscFunctionBegin;
+  hyb->niranks = 0;
+  for (k = 0; k < nsf; k++) {
+    PetscCall(PetscSFGetLeafRanks_Basic(sfs[k], &ni[k], &ir[k], &io[k], &il[k]));
+    hyb->niranks += ni[k];
+    nleaves += io[k][ni[k]];
+  }
+  PetscCall(PetscMalloc3(hyb->niranks, &hyb->iranks, hyb->niranks + 1, &hyb->ioffset, nleaves, &hyb->irootloc));
+  hyb->ioffset[0] = 0;
+  for (k = 0; k < hyb->niranks; k++) {
+    if (!k && ((PetscSF_Basic *)hyb->offsf->data)->ndiranks) c = 0; /* self */
+    else {
+      for (c = -1, i = 0; i < nsf; i++) {
+        if (p[i] < ni[i] && (c < 0 || ir[i][p[i]] < ir[c][p[c]])) c = i;
+      }
+    }
+    n                   = io[c][p[c] + 1] - io[c][p[c]];
+    hyb->iranks[k]      = ir[c][p[c]];
+    hyb->ioffset[k + 1] = hyb->ioffset[k] + n;
+    for (i = 0; i < n; i++) hyb->irootloc[hyb->ioffset[k] + i] = il[c][io[c][p[c]] + i];
+    p[c]++;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Like PetscSFDuplicate(sf, PETSCSF_DUPLICATE_CONFONLY, newsf) but with type PETSCSFBASIC or PETSCSFHYBRID (without aggregation) */
+static PetscErrorCode PetscSFHybridCreateSubSF_Private(PetscSF sf, PetscSFType type, PetscSF *newsf)
+{
+  PetscBool ishybrid;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)sf), newsf));
+  PetscCall(PetscSFSetType(*newsf, type));
+  PetscCall(PetscStrcmp(type, PETSCSFHYBRID, &ishybrid));
+  if (ishybrid) ((PetscSF_Hybrid *)(*newsf)->data)->nslots = ((PetscSF_Hybrid *)sf->data)->nslots;
+  (*newsf)->allow_multi_leaves     = sf->allow_multi_leaves;
+  (*newsf)->pack_threads           = sf->pack_threads;
+  (*newsf)->pack_threads_threshold = sf->pack_threads_threshold;
+#if defined(PETSC_HAVE_DEVICE)
+  (*newsf)->backend              = sf->backend;
+  (*newsf)->unknown_input_stream = sf->unknown_input_stream;
+  (*newsf)->use_gpu_aware_mpi    = sf->use_gpu_aware_mpi;
+  (*newsf)->use_stream_aware_mpi = sf->use_stream_aware_mpi;
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Which sub star forest the edges to the i-th root rank of sf go to: 0 for offsf, 1 for nodesf and 2 for farsf */
+static PetscErrorCode PetscSFHybridRankClass_Private(PetscSF sf, PetscInt i, PetscInt *c)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscMPIInt     lrank;
+
+  PetscFunctionBegin;
+  *c = 0;
+  if (i < sf->ndranks) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscShmCommGlobalToLocal(hyb->pshmcomm, sf->ranks[i], &lrank));
+  if (lrank != MPI_PROC_NULL) *c = 1;
+  else if (hyb->aggregate) *c = 2;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Build rootaggsf, leadersf and leafaggsf from farsf. The edges of the ranks of a node are gathered on its leader,
+   which sorts them by the leader of the node of their roots into B and tells the leaders on the other end where the
+   edges are in B. Those leaders keep the edges in A in the order they arrive */
+static PetscErrorCode PetscSFHybridSetUpAggregation_Private(PetscSF sf)
+{
+  PetscSF_Hybrid    *hyb   = (PetscSF_Hybrid *)sf->data;
+  PetscSF            farsf = hyb->farsf;
+  MPI_Comm           comm  = PetscObjectComm((PetscObject)sf);
+  PetscMPIInt        lrank, lsize, leader, nsend, nrecv, nto = 0, nfrom, *toranks = NULL, *fromranks, *counts = NULL, *displs = NULL, tag;
+  PetscInt           i, k, d, nroots, maxleaf, nranks, nedges, nB = 0, nA = 0, ndest = 0, *rootleader, *leafleader, *mine, *gathered = NULL, *boff = NULL, *myboff, *dests = NULL, *bstart = NULL, *next = NULL, *todata = NULL, *fromdata, *ilocal;
+  const PetscMPIInt *ranks;
+  const PetscInt    *roffset, *rmine, *rremote;
+  PetscSFNode       *bremote = NULL, *aremote, *lremote, *iremote;
+  MPI_Request       *reqs;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(hyb->shmcomm, &lrank));
+  PetscCallMPI(MPI_Comm_size(hyb->shmcomm, &lsize));
+  PetscCall(PetscShmCommLocalToGlobal(hyb->pshmcomm, 0, &leader));
+
+  /* Leader of the node of the root of each edge */
+  PetscCall(PetscSFGetGraph(sf, &nroots, NULL, NULL, NULL));
+  PetscCall(PetscSFGetLeafRange(sf, NULL, &maxleaf));
+  PetscCall(PetscMalloc2(nroots, &rootleader, maxleaf + 1, &leafleader));
+  for (i = 0; i < nroots; i++) rootleader[i] = leader;
+  PetscCall(PetscSFBcastBegin(farsf, MPIU_INT, rootleader, leafleader, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(farsf, MPIU_INT, rootleader, leafleader, MPI_REPLACE));
+
+  /* Gather (leader of the root, root rank, root index) of the edges of the node on its leader */
+  PetscCall(PetscSFGetRootRanks(farsf, &nranks, &ranks, &roffset, &rmine, &rremote));
+  nedges = roffset[nranks];
+  PetscCall(PetscMalloc2(3 * nedges, &mine, nedges, &myboff));
+  for (i = 0; i < nranks; i++) {
+    for (k = roffset[i]; k < roffset[i + 1]; k++) {
+      mine[3 * k]     = leafleader[rmine[k]];
+      mine[3 * k + 1] = ranks[i];
+      mine[3 * k + 2] = rremote[k];
+    }
+  }
+  PetscCall(PetscFree2(rootleader, leafleader));
+  PetscCall(PetscMPIIntCast(3 * nedges, &nsend));
+  if (!lrank) PetscCall(PetscMalloc2(lsize, &counts, lsize + 1, &displs));
+  PetscCallMPI(MPI_Gather(&nsend, 1, MPI_INT, counts, 1, MPI_INT, 0, hyb->shmcomm));
+  if (!lrank) {
+    displs[0] = 0;
+    for (i = 0; i < lsize; i++) PetscCall(PetscMPIIntCast((PetscInt)displs[i] + counts[i], &displs[i + 1]));
+    nB = displs[lsize] / 3;
+    PetscCall(PetscMalloc1(3 * nB, &gathered));
+  }
+  PetscCallMPI(MPI_Gatherv(mine, nsend, MPIU_INT, gathered, counts, displs, MPIU_INT, 0, hyb->shmcomm));
+
+  /* On the leader, order B by destination leader, keeping the order of the edges for each of them */
+  if (!lrank) {
+    PetscCall(PetscMalloc3(nB, &dests, nB, &boff, nB, &bremote));
+    for (k = 0; k < nB; k++) dests[k] = gathered[3 * k];
+    ndest = nB;
+    PetscCall(PetscSortRemoveDupsInt(&ndest, dests));
+    PetscCall(PetscCalloc3(ndest + 1, &bstart, ndest, &next, 2 * ndest, &todata));
+    for (k = 0; k < nB; k++) {
+      PetscCall(PetscFindInt(gathered[3 * k], ndest, dests, &d));
+      bstart[d + 1]++;
+    }
+    for (d = 0; d < ndest; d++) {
+      bstart[d + 1] += bstart[d];
+      next[d] = bstart[d];
+    }
+    for (k = 0; k < nB; k++) {
+      PetscCall(PetscFindInt(gathered[3 * k], ndest, dests, &d));
+      boff[k]                = next[d]++;
+      bremote[boff[k]].rank  = gathered[3 * k + 1];
+      bremote[boff[k]].index = gathered[3 * k + 2];
+    }
+    PetscCall(PetscMPIIntCast(ndest, &nto));
+    PetscCall(PetscMalloc1(ndest, &toranks));
+    for (d = 0; d < ndest; d++) {
+      PetscCall(PetscMPIIntCast(dests[d], &toranks[d]));
+      todata[2 * d]     = bstart[d + 1] - bstart[d];
+      todata[2 * d + 1] = bstart[d];
+    }
+    for (i = 0; i < lsize; i++) {
+      counts[i] /= 3;
+      displs[i] /= 3;
+    }
+  }
+  PetscCallMPI(MPI_Scatterv(boff, counts, displs, MPIU_INT, myboff, nsend / 3, MPIU_INT, 0, hyb->shmcomm));
+
+  /* My leaves with roots on other nodes get their data from B on my leader */
+  PetscCall(PetscMalloc1(nedges, &ilocal));
+  PetscCall(PetscMalloc1(nedges, &iremote));
+  for (k = 0; k < nedges; k++) {
+    ilocal[k]        = rmine[k];
+    iremote[k].rank  = leader;
+    iremote[k].index = myboff[k];
+  }
+  PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFHYBRID, &hyb->leafaggsf));
+  PetscCall(PetscSFSetGraph(hyb->leafaggsf, nB, nedges, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscFree2(mine, myboff));
+
+  /* Tell the leaders of the root nodes how many edges they get and where they are in B, then send the roots of the edges */
+  PetscCall(PetscCommBuildTwoSided(comm, 2, MPIU_INT, nto, toranks, todata, &nfrom, &fromranks, &fromdata));
+  for (i = 0; i < nfrom; i++) nA += fromdata[2 * i];
+  PetscCall(PetscMalloc1(nA, &aremote));
+  PetscCall(PetscMalloc1(nA, &lremote));
+  PetscCall(PetscMalloc1(nto + nfrom, &reqs));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag));
+  for (i = 0, k = 0; i < nfrom; k += fromdata[2 * i], i++) {
+    PetscCallMPI(MPIU_Irecv(aremote + k, 2 * fromdata[2 * i], MPIU_INT, fromranks[i], tag, comm, &reqs[i]));
+    for (d = 0; d < fromdata[2 * i]; d++) {
+      lremote[k + d].rank  = fromranks[i];
+      lremote[k + d].index = fromdata[2 * i + 1] + d;
+    }
+  }
+  for (d = 0; d < nto; d++) PetscCallMPI(MPIU_Isend(bremote + bstart[d], 2 * (bstart[d + 1] - bstart[d]), MPIU_INT, toranks[d], tag, comm, &reqs[nfrom + d]));
+  PetscCall(PetscMPIIntCast(nto + nfrom, &nrecv));
+  PetscCallMPI(MPI_Waitall(nrecv, reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscFree(reqs));
+  PetscCall(PetscFree(fromranks));
+  PetscCall(PetscFree(fromdata));
+
+  PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFHYBRID, &hyb->rootaggsf));
+  PetscCall(PetscSFSetGraph(hyb->rootaggsf, nroots, nA, NULL, PETSC_OWN_POINTER, aremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFBASIC, &hyb->leadersf));
+  PetscCall(PetscSFSetGraph(hyb->leadersf, nB, nA, NULL, PETSC_OWN_POINTER, lremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(hyb->rootaggsf));
+  PetscCall(PetscSFSetUp(hyb->leadersf));
+  PetscCall(PetscSFSetUp(hyb->leafaggsf));
+  PetscCall(PetscInfo(sf, "Aggregating %" PetscInt_FMT " leaves with roots on other nodes through leader %d; %" PetscInt_FMT " edges sent to %d leaders and %" PetscInt_FMT " received from %d leaders\n", nedges, leader, nB, nto, nA, nfrom));
+  if (!lrank) {
+    PetscCall(PetscFree2(counts, displs));
+    PetscCall(PetscFree(gathered));
+    PetscCall(PetscFree3(dests, boff, bremote));
+    PetscCall(PetscFree3(bstart, next, todata));
+    PetscCall(PetscFree(toranks));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetUp_Hybrid(PetscSF sf)
+{
+  PetscSF_Hybrid    *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSF_Basic     *nbas;
+  PetscSF            nodesf;
+  MPI_Comm           comm = PetscObjectComm((PetscObject)sf);
+  MPI_Group          group;
+  PetscMPIInt        tag[2];
+  PetscInt           i, j, c, nroots, n[3] = {0, 0, 0}, *ilocal[3], npeers[2], *sbuf, *rbuf;
+  PetscSFNode       *iremote[3];
+  MPI_Request       *reqs;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_group(PETSC_COMM_SELF, &group));
+  PetscCall(PetscSFSetUpRanks(sf, group));
+  PetscCallMPI(MPI_Group_free(&group));
+  PetscCall(PetscShmCommGet(comm, &hyb->pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(hyb->pshmcomm, &hyb->shmcomm));
+
+  /* Split the edges by the location of their roots: 0 for offsf, 1 for nodesf and 2 for farsf */
+  PetscCall(PetscSFGetGraph(sf, &nroots, NULL, NULL, NULL));
+  for (c = 0; c < 3; c++) {
+    for (i = 0; i < sf->nranks; i++) {
+      PetscCall(PetscSFHybridRankClass_Private(sf, i, &j));
+      if (j == c) n[c] += sf->roffset[i + 1] - sf->roffset[i];
+    }
+    PetscCall(PetscMalloc1(n[c], &ilocal[c]));
+    PetscCall(PetscMalloc1(n[c], &iremote[c]));
+    n[c] = 0;
+  }
+  for (i = 0; i < sf->nranks; i++) {
+    PetscCall(PetscSFHybridRankClass_Private(sf, i, &c));
+    for (j = sf->roffset[i]; j < sf->roffset[i + 1]; j++) {
+      ilocal[c][n[c]]        = sf->rmine[j];
+      iremote[c][n[c]].rank  = sf->ranks[i];
+      iremote[c][n[c]].index = sf->rremote[j];
+      n[c]++;
+    }
+  }
+  PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFBASIC, &hyb->offsf));
+  PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFBASIC, &hyb->nodesf));
+  PetscCall(PetscSFSetGraph(hyb->offsf, nroots, n[0], ilocal[0], PETSC_OWN_POINTER, iremote[0], PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetGraph(hyb->nodesf, nroots, n[1], ilocal[1], PETSC_OWN_POINTER, iremote[1], PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(hyb->offsf));
+  PetscCall(PetscSFSetUp(hyb->nodesf));
+  if (hyb->aggregate) {
+    PetscCall(PetscSFHybridCreateSubSF_Private(sf, PETSCSFBASIC, &hyb->farsf));
+    PetscCall(PetscSFSetGraph(hyb->farsf, nroots, n[2], ilocal[2], PETSC_OWN_POINTER, iremote[2], PETSC_OWN_POINTER));
+    PetscCall(PetscSFSetUp(hyb->farsf));
+    PetscCall(PetscSFHybridSetUpAggregation_Private(sf));
+  } else {
+    PetscCall(PetscFree(ilocal[2]));
+    PetscCall(PetscFree(iremote[2]));
+  }
+  PetscCall(PetscSFHybridSetUpLeafRanks_Private(sf));
+
+  /* Tell each on-node peer where its data is in my buffers and which reader it is */
+  nodesf    = hyb->nodesf;
+  nbas      = (PetscSF_Basic *)nodesf->data;
+  npeers[0] = nodesf->nranks - nodesf->ndranks; /* Ranks owning roots of my leaves */
+  npeers[1] = nbas->niranks - nbas->ndiranks;   /* Ranks with leaves on my roots */
+  PetscCall(PetscMalloc4(npeers[0], &hyb->rootseg, npeers[0], &hyb->rootdisp, npeers[0], &hyb->rootslot, npeers[1], &hyb->leafseg));
+  PetscCall(PetscMalloc2(npeers[1], &hyb->leafdisp, npeers[1], &hyb->leafslot));
+  PetscCall(PetscMalloc3(2 * (npeers[0] + npeers[1]), &sbuf, 2 * (npeers[0] + npeers[1]), &rbuf, npeers[0] + npeers[1], &reqs));
+  PetscCall(PetscObjectGetNewTag((PetscObject)nodesf, &tag[0]));
+  PetscCall(PetscObjectGetNewTag((PetscObject)nodesf, &tag[1]));
+  for (i = 0; i < npeers[0]; i++) PetscCallMPI(MPIU_Irecv(rbuf + 2 * i, 2, MPIU_INT, nodesf->ranks[nodesf->ndranks + i], tag[0], comm, &reqs[i]));
+  for (i = 0; i < npeers[1]; i++) PetscCallMPI(MPIU_Irecv(rbuf + 2 * (npeers[0] + i), 2, MPIU_INT, nbas->iranks[nbas->ndiranks + i], tag[1], comm, &reqs[npeers[0] + i]));
+  for (i = 0; i < npeers[1]; i++) { /* As a root owner: the reader index of the leaf rank, and the offset of its data in my root buffer */
+    sbuf[2 * i]     = i;
+    sbuf[2 * i + 1] = nbas->ioffset[nbas->ndiranks + i] - nbas->ioffset[nbas->ndiranks];
+    PetscCallMPI(MPIU_Send(sbuf + 2 * i, 2, MPIU_INT, nbas->iranks[nbas->ndiranks + i], tag[0], comm));
+  }
+  for (i = 0; i < npeers[0]; i++) { /* As a leaf owner: the reader index of the root rank, and the offset of its data in my leaf buffer */
+    sbuf[2 * (npeers[1] + i)]     = i;
+    sbuf[2 * (npeers[1] + i) + 1] = nodesf->roffset[nodesf->ndranks + i] - nodesf->roffset[nodesf->ndranks];
+    PetscCallMPI(MPIU_Send(sbuf + 2 * (npeers[1] + i), 2, MPIU_INT, nodesf->ranks[nodesf->ndranks + i], tag[1], comm));
+  }
+  PetscCallMPI(MPI_Waitall((PetscMPIInt)(npeers[0] + npeers[1]), reqs, MPI_STATUSES_IGNORE));
+  for (i = 0; i < npeers[0]; i++) {
+    hyb->rootslot[i] = rbuf[2 * i];
+    hyb->rootdisp[i] = rbuf[2 * i + 1];
+  }
+  for (i = 0; i < npeers[1]; i++) {
+    hyb->leafslot[i] = rbuf[2 * (npeers[0] + i)];
+    hyb->leafdisp[i] = rbuf[2 * (npeers[0] + i) + 1];
+  }
+  PetscCall(PetscFree3(sbuf, rbuf, reqs));
+  PetscCall(PetscMalloc1(2 * hyb->nslots, &hyb->ops));
+  PetscCall(PetscInfo(sf, "%" PetscInt_FMT " of %" PetscInt_FMT " remote leaves and %" PetscInt_FMT " of %" PetscInt_FMT " remote root ranks are on this node\n", n[1], sf->roffset[sf->nranks] - sf->roffset[sf->ndranks], npeers[0], sf->nranks - sf->ndranks));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReset_Hybrid(PetscSF sf)
+{
+  PetscSF_Hybrid  *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFLink      link, next;
+  PetscSFHybridAgg agg, anext;
+
+  PetscFunctionBegin;
+  PetscCheck(!hyb->nops && !hyb->agginuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  for (agg = hyb->aggavail; agg; agg = anext) {
+    anext = agg->next;
+    PetscCall(PetscFree2(agg->abuf, agg->bbuf));
+    PetscCall(PetscFree(agg));
+  }
+  hyb->aggavail = NULL;
+  PetscCall(PetscSFHybridFreeWindow_Private(sf));
+  for (link = hyb->links; link; link = next) {
+    next = link->next;
+    if (!link->isbuiltin) PetscCallMPI(MPI_Type_free(&link->unit));
+    PetscCall(PetscFree(link));
+  }
+  hyb->links = NULL;
+  PetscCall(PetscFree4(hyb->rootseg, hyb->rootdisp, hyb->rootslot, hyb->leafseg));
+  PetscCall(PetscFree2(hyb->leafdisp, hyb->leafslot));
+  PetscCall(PetscFree3(hyb->iranks, hyb->ioffset, hyb->irootloc));
+  PetscCall(PetscFree(hyb->ops));
+  PetscCall(PetscSFDestroy(&hyb->offsf));
+  PetscCall(PetscSFDestroy(&hyb->nodesf));
+  PetscCall(PetscSFDestroy(&hyb->farsf));
+  PetscCall(PetscSFDestroy(&hyb->rootaggsf));
+  PetscCall(PetscSFDestroy(&hyb->leadersf));
+  PetscCall(PetscSFDestroy(&hyb->leafaggsf));
+  hyb->seq[0] = hyb->seq[1] = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Hybrid(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFReset_Hybrid(sf));
+  PetscCall(PetscFree(sf->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Hybrid(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Hybrid options");
+  PetscCall(PetscOptionsBoundedInt("-sf_hybrid_slots", "Number of shared memory operations in each direction that can be in flight at the same time", "PetscSFSetFromOptions", hyb->nslots, &hyb->nslots, NULL, 1));
+  PetscCall(PetscOptionsBool("-sf_hybrid_aggregate", "Route the data of other nodes through one leader rank per node", "PetscSFSetFromOptions", hyb->aggregate, &hyb->aggregate, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Hybrid(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data, *nhyb = (PetscSF_Hybrid *)newsf->data;
+
+  PetscFunctionBegin;
+  nhyb->nslots    = hyb->nslots;
+  nhyb->aggregate = hyb->aggregate;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFView_Hybrid(PetscSF sf, PetscViewer viewer)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscBool       isascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &isascii));
+  if (isascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  shared memory slots=%" PetscInt_FMT " MultiSF sort=%s\n", hyb->nslots, sf->rankorder ? "rank-order" : "unordered"));
+    if (hyb->aggregate) PetscCall(PetscViewerASCIIPrintf(viewer, "  data of other nodes routed through node leaders\n"));
+    if (sf->setupcalled) {
+      PetscMPIInt rank;
+
+      PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)sf), &rank));
+      PetscCall(PetscViewerASCIIPushSynchronized(viewer));
+      PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "  [%d] Remote root ranks on this node=%" PetscInt_FMT ", on other nodes=%" PetscInt_FMT "\n", rank, hyb->nodesf->nranks - hyb->nodesf->ndranks, hyb->farsf ? hyb->farsf->nranks : hyb->offsf->nranks - hyb->offsf->ndranks));
+      PetscCall(PetscViewerFlush(viewer));
+      PetscCall(PetscViewerASCIIPopSynchronized(viewer));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Hybrid(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
+static PetscErrorCode PetscSFBcastEnd_Hybrid(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+static PetscErrorCode PetscSFReduceBegin_Hybrid(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
+static PetscErrorCode PetscSFReduceEnd_Hybrid(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+
+/* Start the part of an operation on farsf: move the data to the leader of its node and post the messages between leaders */
+static PetscErrorCode PetscSFHybridAggBegin_Private(PetscSF sf, MPI_Datatype unit, PetscSFDirection direction, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, const void *leafdata, MPI_Op op)
+{
+  PetscSF_Hybrid   *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFLink       link;
+  PetscSFHybridAgg  agg, *p;
+  PetscInt          nA, nB;
+
+  PetscFunctionBegin;
+  if (!PetscMemTypeHost(rootmtype) || !PetscMemTypeHost(leafmtype)) {
+    if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFBcastBegin_Basic(hyb->farsf, unit, rootmtype, rootdata, leafmtype, (void *)leafdata, op));
+    else PetscCall(PetscSFReduceBegin_Basic(hyb->farsf, unit, leafmtype, leafdata, rootmtype, (void *)rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (agg = hyb->agginuse; agg; agg = agg->next) PetscCheck(agg->direction != direction || agg->rootdata != rootdata || agg->leafdata != leafdata || !(rootdata || leafdata), PETSC_COMM_SELF, PETSC_ERR_SUP, "Overlapped PetscSF with the same rootdata(%p), leafdata(%p). Undo the overlapping to avoid the error.", rootdata, leafdata);
+  PetscCall(PetscSFHybridGetLink_Private(sf, unit, &link));
+  for (p = &hyb->aggavail; *p && (*p)->link != link; p = &(*p)->next);
+  if (*p) {
+    agg = *p;
+    *p  = agg->next;
+  } else {
+    PetscCall(PetscSFGetGraph(hyb->leadersf, &nB, &nA, NULL, NULL));
+    PetscCall(PetscNew(&agg));
+    agg->link = link;
+    PetscCall(PetscMalloc2(nA * link->unitbytes, &agg->abuf, nB * link->unitbytes, &agg->bbuf));
+  }
+  agg->direction = direction;
+  agg->rootdata  = rootdata;
+  agg->leafdata  = leafdata;
+  agg->next      = hyb->agginuse;
+  hyb->agginuse  = agg;
+
+  /* The steps within the node are done here, the messages between leaders progress until XxxEnd() */
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFBcastBegin_Hybrid(hyb->rootaggsf, unit, PETSC_MEMTYPE_HOST, rootdata, PETSC_MEMTYPE_HOST, agg->abuf, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd_Hybrid(hyb->rootaggsf, unit, rootdata, agg->abuf, MPI_REPLACE));
+    PetscCall(PetscSFReduceBegin_Basic(hyb->leadersf, unit, PETSC_MEMTYPE_HOST, agg->abuf, PETSC_MEMTYPE_HOST, agg->bbuf, MPI_REPLACE));
+  } else {
+    PetscCall(PetscSFReduceBegin_Hybrid(hyb->leafaggsf, unit, PETSC_MEMTYPE_HOST, leafdata, PETSC_MEMTYPE_HOST, agg->bbuf, MPI_REPLACE));
+    PetscCall(PetscSFReduceEnd_Hybrid(hyb->leafaggsf, unit, leafdata, agg->bbuf, MPI_REPLACE));
+    PetscCall(PetscSFBcastBegin_Basic(hyb->leadersf, unit, PETSC_MEMTYPE_HOST, agg->bbuf, PETSC_MEMTYPE_HOST, agg->abuf, MPI_REPLACE));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Finish the part of an operation on farsf: complete the messages between leaders and apply op on the other node */
+static PetscErrorCode PetscSFHybridAggEnd_Private(PetscSF sf, MPI_Datatype unit, PetscSFDirection direction, const void *rootdata, const void *leafdata, MPI_Op op)
+{
+  PetscSF_Hybrid   *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFHybridAgg  agg, *p;
+  PetscBool         match = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  for (p = &hyb->agginuse; (agg = *p); p = &agg->next) {
+    if (agg->direction != direction || agg->rootdata != rootdata || agg->leafdata != leafdata) continue;
+    PetscCall(MPIPetsc_Type_compare(unit, agg->link->unit, &match));
+    if (match) break;
+  }
+  if (!agg) { /* farsf was used for device memory */
+    if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFBcastEnd_Basic(hyb->farsf, unit, rootdata, (void *)leafdata, op));
+    else PetscCall(PetscSFReduceEnd_Basic(hyb->farsf, unit, leafdata, (void *)rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *p = agg->next;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFReduceEnd_Basic(hyb->leadersf, unit, agg->abuf, agg->bbuf, MPI_REPLACE));
+    PetscCall(PetscSFBcastBegin_Hybrid(hyb->leafaggsf, unit, PETSC_MEMTYPE_HOST, agg->bbuf, PETSC_MEMTYPE_HOST, (void *)leafdata, op));
+    PetscCall(PetscSFBcastEnd_Hybrid(hyb->leafaggsf, unit, agg->bbuf, (void *)leafdata, op));
+  } else {
+    PetscCall(PetscSFBcastEnd_Basic(hyb->leadersf, unit, agg->bbuf, agg->abuf, MPI_REPLACE));
+    PetscCall(PetscSFReduceBegin_Hybrid(hyb->rootaggsf, unit, PETSC_MEMTYPE_HOST, agg->abuf, PETSC_MEMTYPE_HOST, (void *)rootdata, op));
+    PetscCall(PetscSFReduceEnd_Hybrid(hyb->rootaggsf, unit, agg->abuf, (void *)rootdata, op));
+  }
+  agg->next     = hyb->aggavail;
+  hyb->aggavail = agg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Hybrid(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb  = (PetscSF_Hybrid *)sf->data;
+  PetscSFLink     link = NULL;
+  PetscBool       useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHybridUseShm_Private(sf, unit, rootmtype, leafmtype, op, &link, &useshm));
+  if (useshm) PetscCall(PetscSFHybridBegin_Private(sf, link, PETSCSF_ROOT2LEAF, rootdata, leafdata));
+  else PetscCall(PetscSFBcastBegin_Basic(hyb->nodesf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+  if (hyb->farsf) PetscCall(PetscSFHybridAggBegin_Private(sf, unit, PETSCSF_ROOT2LEAF, rootmtype, rootdata, leafmtype, leafdata, op));
+  PetscCall(PetscSFBcastBegin_Basic(hyb->offsf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Hybrid(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFHybridOp hop;
+  PetscBool       found;
+
+  PetscFunctionBegin;
+  /* Release the peers waiting on our acks first, the off-node messages progress in the meantime */
+  PetscCall(PetscSFHybridGetOp_Private(sf, unit, PETSCSF_ROOT2LEAF, rootdata, leafdata, &hop, &found));
+  if (found) PetscCall(PetscSFHybridEnd_Private(sf, &hop, leafdata, op));
+  else PetscCall(PetscSFBcastEnd_Basic(hyb->nodesf, unit, rootdata, leafdata, op));
+  if (hyb->farsf) PetscCall(PetscSFHybridAggEnd_Private(sf, unit, PETSCSF_ROOT2LEAF, rootdata, leafdata, op));
+  PetscCall(PetscSFBcastEnd_Basic(hyb->offsf, unit, rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Hybrid(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb  = (PetscSF_Hybrid *)sf->data;
+  PetscSFLink     link = NULL;
+  PetscBool       useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHybridUseShm_Private(sf, unit, rootmtype, leafmtype, op, &link, &useshm));
+  if (useshm) PetscCall(PetscSFHybridBegin_Private(sf, link, PETSCSF_LEAF2ROOT, rootdata, leafdata));
+  else PetscCall(PetscSFReduceBegin_Basic(hyb->nodesf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+  if (hyb->farsf) PetscCall(PetscSFHybridAggBegin_Private(sf, unit, PETSCSF_LEAF2ROOT, rootmtype, rootdata, leafmtype, leafdata, op));
+  PetscCall(PetscSFReduceBegin_Basic(hyb->offsf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Hybrid(PetscSF sf, MPI_Datatype unit, const void *leafdata, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+  PetscSFHybridOp hop;
+  PetscBool       found;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHybridGetOp_Private(sf, unit, PETSCSF_LEAF2ROOT, rootdata, leafdata, &hop, &found));
+  if (found) PetscCall(PetscSFHybridEnd_Private(sf, &hop, rootdata, op));
+  else PetscCall(PetscSFReduceEnd_Basic(hyb->nodesf, unit, leafdata, rootdata, op));
+  if (hyb->farsf) PetscCall(PetscSFHybridAggEnd_Private(sf, unit, PETSCSF_LEAF2ROOT, rootdata, leafdata, op));
+  PetscCall(PetscSFReduceEnd_Basic(hyb->offsf, unit, leafdata, rootdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Fetch-and-op needs a round trip, so the on-node part keeps using MPI, and the off-node part is not aggregated */
+static PetscErrorCode PetscSFFetchAndOpBegin_Hybrid(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, void *rootdata, PetscMemType leafmtype, const void *leafdata, void *leafupdate, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFFetchAndOpBegin_Basic(hyb->nodesf, unit, rootmtype, rootdata, leafmtype, leafdata, leafupdate, op));
+  if (hyb->farsf) PetscCall(PetscSFFetchAndOpBegin_Basic(hyb->farsf, unit, rootmtype, rootdata, leafmtype, leafdata, leafupdate, op));
+  PetscCall(PetscSFFetchAndOpBegin_Basic(hyb->offsf, unit, rootmtype, rootdata, leafmtype, leafdata, leafupdate, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFFetchAndOpEnd_Hybrid(PetscSF sf, MPI_Datatype unit, void *rootdata, const void *leafdata, void *leafupdate, MPI_Op op)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFFetchAndOpEnd_Basic(hyb->nodesf, unit, rootdata, leafdata, leafupdate, op));
+  if (hyb->farsf) PetscCall(PetscSFFetchAndOpEnd_Basic(hyb->farsf, unit, rootdata, leafdata, leafupdate, op));
+  PetscCall(PetscSFFetchAndOpEnd_Basic(hyb->offsf, unit, rootdata, leafdata, leafupdate, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFGetLeafRanks_Hybrid(PetscSF sf, PetscInt *niranks, const PetscMPIInt **iranks, const PetscInt **ioffset, const PetscInt **irootloc)
+{
+  PetscSF_Hybrid *hyb = (PetscSF_Hybrid *)sf->data;
+
+  PetscFunctionBegin;
+  if (niranks) *niranks = hyb->niranks;
+  if (iranks) *iranks = hyb->iranks;
+  if (ioffset) *ioffset = hyb->ioffset;
+  if (irootloc) *irootloc = hyb->irootloc;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   PETSCSFHYBRID - A `PetscSF` that communicates with the ranks on the same node through MPI-3 shared memory, and with the other ranks through MPI like `PETSCSFBASIC`
+
+   Options Database Keys:
++  -sf_hybrid_slots <2>  - number of `PetscSFBcastBegin()` (and of `PetscSFReduceBegin()`) that can be in flight at the same time
+-  -sf_hybrid_aggregate - route the data exchanged with other nodes through one leader rank per node
+
+   Level: intermediate
+
+   Notes:
+   The ranks on the node are found with `PetscShmCommGet()`. For host memory, the roots needed by the leaves of other ranks
+   on the node (or, in a reduction, the leaves) are packed once into a buffer in a shared memory window, and those ranks
+   unpack them directly from it in `PetscSFBcastEnd()` (or `PetscSFReduceEnd()`), without MPI messages. Only the traffic
+   with the other nodes goes through MPI. Fetch-and-op operations, device memory and user-defined `MPI_Op` use MPI on the
+   node as well; all ranks must then pass the same memory types.
+
+   The shared memory window is sized for the largest unit communicated so far. It is resized, collectively on the node,
+   when a larger unit is used, which must happen when the `PetscSF` has no operation in flight.
+
+   With `-sf_hybrid_aggregate`, the data of host memory for the other nodes is first moved through shared memory to the
+   leader of the node (rank 0 of the communicator of `PetscShmCommGetMpiShmComm()`), which sends one message per node it
+   talks to, to the leader of that node, which distributes it through shared memory. Messages between nodes are then only sent by the
+   leaders, one per pair of nodes instead of one per pair of ranks, at the price of two more copies. Device memory and fetch-and-op
+   operations do not use the leaders.
+
+.seealso: `PetscSF`, `PetscSFType`, `PETSCSFBASIC`, `PETSCSFWINDOW`, `PetscSFCreate()`, `PetscShmCommGet()`
+M*/
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hybrid(PetscSF sf)
+{
+  PetscSF_Hybrid *hyb;
+
+  PetscFunctionBegin;
+  sf->ops->SetUp           = PetscSFSetUp_Hybrid;
+  sf->ops->Reset           = PetscSFReset_Hybrid;
+  sf->ops->Destroy         = PetscSFDestroy_Hybrid;
+  sf->ops->SetFromOptions  = PetscSFSetFromOptions_Hybrid;
+  sf->ops->Duplicate       = PetscSFDuplicate_Hybrid;
+  sf->ops->View            = PetscSFView_Hybrid;
+  sf->ops->BcastBegin      = PetscSFBcastBegin_Hybrid;
+  sf->ops->BcastEnd        = PetscSFBcastEnd_Hybrid;
+  sf->ops->ReduceBegin     = PetscSFReduceBegin_Hybrid;
+  sf->ops->ReduceEnd       = PetscSFReduceEnd_Hybrid;
+  sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Hybrid;
+  sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Hybrid;
+  sf->ops->GetLeafRanks    = PetscSFGetLeafRanks_Hybrid;
+
+  sf->collective = PETSC_FALSE;
+
+  PetscCall(PetscNew(&hyb));
+  hyb->win    = MPI_WIN_NULL;
+  hyb->nslots = 2;
+  sf->data    = (void *)hyb;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -18,6 +18,7 @@ PetscLogEvent PETSCSF_SectSF;
 PetscLogEvent PETSCSF_RemoteOff;
 PetscLogEvent PETSCSF_Pack;
 PetscLogEvent PETSCSF_Unpack;
+PetscLogEvent PETSCSF_Autotune;
 
 /*@C
   PetscSFInitializePackage - Initialize `PetscSF` package
@@ -55,6 +56,29 @@ PetscErrorCode PetscSFInitializePackage(void)
   PetscCall(PetscLogEventRegister("SFRemoteOff", PETSCSF_CLASSID, &PETSCSF_RemoteOff));
   PetscCall(PetscLogEventRegister("SFPack", PETSCSF_CLASSID, &PETSCSF_Pack));
   PetscCall(PetscLogEventRegister("SFUnpack", PETSCSF_CLASSID, &PETSCSF_Unpack));
+  PetscCall(PetscLogEventRegister("SFAutotune", PETSCSF_CLASSID, &PETSCSF_Autotune));
+  /* One event per candidate type of the autotuning, looked up by name in PetscSFSetUp() */
+  {
+    const char *tunetypes[] = {PETSCSFBASIC,
+#if defined(PETSC_HAVE_MPI_WIN_CREATE)
+                               PETSCSFWINDOW,
+#endif
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+                               PETSCSFNEIGHBOR,
+#endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+                               PETSCSFHYBRID,
+#endif
+    };
+
+    for (size_t t = 0; t < PETSC_STATIC_ARRAY_LENGTH(tunetypes); t++) {
+      PetscLogEvent event;
+      char          name[64];
+
+      PetscCall(PetscSNPrintf(name, sizeof(name), "SFTune %s", tunetypes[t]));
+      PetscCall(PetscLogEventRegister(name, PETSCSF_CLASSID, &event));
+    }
+  }
   /* Flag non-collective events */
   PetscCall(PetscLogEventSetCollective(PETSCSF_Pack, PETSC_FALSE));
   PetscCall(PetscLogEventSetCollective(PETSCSF_Unpack, PETSC_FALSE));
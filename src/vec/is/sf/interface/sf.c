@@ -42,6 +42,7 @@ const char *const PetscSFConcatenateRootModes[] = {"local", "shared", "global",
 + -sf_type basic                 - Use MPI persistent Isend/Irecv for communication (Default)
 . -sf_type window                - Use MPI-3 one-sided window for communication
 . -sf_type neighbor              - Use MPI-3 neighborhood collectives for communication
+. -sf_type hybrid                - Use MPI-3 shared memory with the ranks on the same node and MPI with the others
 - -sf_neighbor_persistent <bool> - If true, use MPI-4 persistent neighborhood collectives for communication (used along with -sf_type neighbor)
 
   Level: intermediate
@@ -72,6 +73,10 @@ PetscErrorCode PetscSFCreate(MPI_Comm comm, PetscSF *sf)
   b->ingroup   = MPI_GROUP_NULL;
   b->outgroup  = MPI_GROUP_NULL;
   b->graphset  = PETSC_FALSE;
+
+  b->pack_threads           = PETSC_FALSE;
+  b->pack_threads_threshold = 32768;
+  b->autotune_its           = 10;
 #if defined(PETSC_HAVE_DEVICE)
   b->use_gpu_aware_mpi    = use_gpu_aware_mpi;
   b->use_stream_aware_mpi = PETSC_FALSE;
@@ -235,6 +240,9 @@ PetscErrorCode PetscSFDestroy(PetscSF *sf)
   PetscCall(PetscSFReset(*sf));
   PetscTryTypeMethod(*sf, Destroy);
   PetscCall(PetscSFDestroy(&(*sf)->vscat.lsf));
+  for (PetscInt i = 0; i < (*sf)->autotune_ntypes; i++) PetscCall(PetscFree((*sf)->autotune_types[i]));
+  PetscCall(PetscFree((*sf)->autotune_types));
+  PetscCall(PetscFree((*sf)->autotune_time));
   if ((*sf)->vscat.bs > 1) PetscCallMPI(MPI_Type_free(&(*sf)->vscat.unit));
 #if defined(PETSC_HAVE_CUDA) && defined(PETSC_HAVE_MPIX_STREAM)
   if ((*sf)->use_stream_aware_mpi) {
@@ -268,6 +276,73 @@ static PetscErrorCode PetscSFCheckGraphValid_Private(PetscSF sf)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Time a few PetscSFBcast() and PetscSFReduce() of PetscScalar on duplicates of the graph with each candidate type, and set the fastest type on sf */
+static PetscErrorCode PetscSFAutotune_Private(PetscSF sf)
+{
+  MPI_Comm       comm       = PetscObjectComm((PetscObject)sf);
+  const char    *deftypes[] = {PETSCSFBASIC,
+#if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+                               PETSCSFNEIGHBOR,
+#endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+                               PETSCSFHYBRID,
+#endif
+  };
+  PetscInt       t, it, best = 0, nleafspace = sf->nleaves ? sf->maxleaf + 1 : 0;
+  PetscScalar   *rootdata, *leafdata;
+  PetscLogDouble t0, t1;
+
+  PetscFunctionBegin;
+  if (!sf->autotune_ntypes) {
+    sf->autotune_ntypes = PETSC_STATIC_ARRAY_LENGTH(deftypes);
+    PetscCall(PetscMalloc1(sf->autotune_ntypes, &sf->autotune_types));
+    for (t = 0; t < sf->autotune_ntypes; t++) PetscCall(PetscStrallocpy(deftypes[t], &sf->autotune_types[t]));
+  }
+  PetscCall(PetscLogEventBegin(PETSCSF_Autotune, sf, 0, 0, 0));
+  PetscCall(PetscFree(sf->autotune_time));
+  PetscCall(PetscMalloc1(sf->autotune_ntypes, &sf->autotune_time));
+  PetscCall(PetscCalloc2(sf->nroots, &rootdata, nleafspace, &leafdata));
+  for (t = 0; t < sf->autotune_ntypes; t++) {
+    PetscSF       tsf;
+    PetscLogEvent event;
+    char          name[64];
+
+    /* The events of the candidate types are registered by PetscSFInitializePackage(), so that -log_view reports the measurements */
+    PetscCall(PetscSNPrintf(name, sizeof(name), "SFTune %s", sf->autotune_types[t]));
+    PetscCall(PetscLogEventGetId(name, &event));
+    PetscCall(PetscSFDuplicate(sf, PETSCSF_DUPLICATE_GRAPH, &tsf));
+    PetscCall(PetscSFSetType(tsf, sf->autotune_types[t]));
+    PetscCall(PetscSFSetUp(tsf));
+    /* Warm up, which also allocates buffers and builds persistent requests */
+    PetscCall(PetscSFBcastBegin(tsf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(tsf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(PetscSFReduceBegin(tsf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+    PetscCall(PetscSFReduceEnd(tsf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+    PetscCallMPI(MPI_Barrier(comm));
+    if (event >= 0) PetscCall(PetscLogEventBegin(event, sf, 0, 0, 0));
+    PetscCall(PetscTime(&t0));
+    for (it = 0; it < sf->autotune_its; it++) {
+      PetscCall(PetscSFBcastBegin(tsf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(tsf, MPIU_SCALAR, rootdata, leafdata, MPI_REPLACE));
+      PetscCall(PetscSFReduceBegin(tsf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+      PetscCall(PetscSFReduceEnd(tsf, MPIU_SCALAR, leafdata, rootdata, MPI_SUM));
+    }
+    PetscCall(PetscTime(&t1));
+    if (event >= 0) PetscCall(PetscLogEventEnd(event, sf, 0, 0, 0));
+    PetscCall(PetscSFDestroy(&tsf));
+    /* The slowest rank decides, so that all ranks pick the same type */
+    sf->autotune_time[t] = (t1 - t0) / PetscMax(sf->autotune_its, 1);
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &sf->autotune_time[t], 1, MPI_DOUBLE, MPI_MAX, comm));
+    PetscCall(PetscInfo(sf, "Type %s takes %g seconds per PetscSFBcast() and PetscSFReduce() pair\n", sf->autotune_types[t], (double)sf->autotune_time[t]));
+    if (sf->autotune_time[t] < sf->autotune_time[best]) best = t;
+  }
+  PetscCall(PetscFree2(rootdata, leafdata));
+  PetscCall(PetscInfo(sf, "Autotuning selected type %s\n", sf->autotune_types[best]));
+  PetscCall(PetscSFSetType(sf, sf->autotune_types[best]));
+  PetscCall(PetscLogEventEnd(PETSCSF_Autotune, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PetscSFSetUp - set up communication structures for a `PetscSF`, after this is done it may be used to perform communication
 
@@ -288,6 +363,7 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
   if (sf->setupcalled) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCall(PetscLogEventBegin(PETSCSF_SetUp, sf, 0, 0, 0));
   PetscCall(PetscSFCheckGraphValid_Private(sf));
+  if (sf->autotune && sf->pattern == PETSCSF_PATTERN_GENERAL) PetscCall(PetscSFAutotune_Private(sf));
   if (!((PetscObject)sf)->type_name) PetscCall(PetscSFSetType(sf, PETSCSFBASIC)); /* Zero all sf->ops */
   PetscTryTypeMethod(sf, SetUp);
 #if defined(PETSC_HAVE_CUDA)
@@ -325,6 +401,11 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
   Options Database Keys:
 + -sf_type                                                                                                         - implementation type, see `PetscSFSetType()`
 . -sf_rank_order                                                                                                   - sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise
+. -sf_pack_threads                                                                                                 - use OpenMP threads to pack and unpack host data (default: false). The number of threads is set with `-omp_num_threads`
+. -sf_pack_threads_threshold <bytes>                                                                               - minimal size of the data packed or unpacked at once to use threads, smaller ones are done by one thread (default: 32768)
+. -sf_autotune                                                                                                    - time the candidate types on the graph in `PetscSFSetUp()` and keep the fastest one (default: false)
+. -sf_autotune_types <basic,neighbor,...>                                                                          - candidate types, they must support general graphs (default: basic, and neighbor and hybrid if available)
+. -sf_autotune_its <its>                                                                                           - number of timed `PetscSFBcastBegin()`/`PetscSFReduceBegin()` pairs per candidate (default: 10)
 . -sf_use_default_stream                                                                                           - Assume callers of `PetscSF` computed the input root/leafdata with the default CUDA stream. `PetscSF` will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between `PetscSF` and its caller (default: true).
                             If true, this option only works with `-use_gpu_aware_mpi 1`.
@@ -352,6 +433,27 @@ PetscErrorCode PetscSFSetFromOptions(PetscSF sf)
   PetscCall(PetscOptionsFList("-sf_type", "PetscSF implementation type", "PetscSFSetType", PetscSFList, deft, type, sizeof(type), &flg));
   PetscCall(PetscSFSetType(sf, flg ? type : deft));
   PetscCall(PetscOptionsBool("-sf_rank_order", "sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise", "PetscSFSetRankOrder", sf->rankorder, &sf->rankorder, NULL));
+  PetscCall(PetscOptionsBool("-sf_pack_threads", "Use OpenMP threads to pack and unpack host data", "PetscSFSetFromOptions", sf->pack_threads, &sf->pack_threads, NULL));
+  PetscCall(PetscOptionsInt("-sf_pack_threads_threshold", "Minimal size in bytes of the data packed or unpacked at once to use threads", "PetscSFSetFromOptions", sf->pack_threads_threshold, &sf->pack_threads_threshold, NULL));
+#if !defined(PETSC_HAVE_OPENMP)
+  if (sf->pack_threads) PetscCall(PetscInfo(sf, "Ignoring -sf_pack_threads since PETSc was not configured with OpenMP\n"));
+  sf->pack_threads = PETSC_FALSE;
+#endif
+  PetscCall(PetscOptionsBool("-sf_autotune", "Time the candidate types in PetscSFSetUp() and keep the fastest", "PetscSFSetFromOptions", sf->autotune, &sf->autotune, NULL));
+  if (sf->autotune) {
+    char    *types[16];
+    PetscInt ntypes = PETSC_STATIC_ARRAY_LENGTH(types);
+
+    PetscCall(PetscOptionsStringArray("-sf_autotune_types", "Candidate types for autotuning", "PetscSFSetFromOptions", types, &ntypes, &flg));
+    if (flg) {
+      for (PetscInt i = 0; i < sf->autotune_ntypes; i++) PetscCall(PetscFree(sf->autotune_types[i]));
+      PetscCall(PetscFree(sf->autotune_types));
+      PetscCall(PetscMalloc1(ntypes, &sf->autotune_types));
+      for (PetscInt i = 0; i < ntypes; i++) sf->autotune_types[i] = types[i];
+      sf->autotune_ntypes = ntypes;
+    }
+    PetscCall(PetscOptionsInt("-sf_autotune_its", "Number of timed PetscSFBcast() and PetscSFReduce() pairs per candidate", "PetscSFSetFromOptions", sf->autotune_its, &sf->autotune_its, NULL));
+  }
 #if defined(PETSC_HAVE_DEVICE)
   {
     char      backendstr[32] = {0};
@@ -729,6 +831,8 @@ PetscErrorCode PetscSFDuplicate(PetscSF sf, PetscSFDuplicateOption opt, PetscSF
   PetscCall(PetscSFGetType(sf, &type));
   if (type) PetscCall(PetscSFSetType(*newsf, type));
   (*newsf)->allow_multi_leaves = sf->allow_multi_leaves; /* Dup this flag earlier since PetscSFSetGraph() below checks on this flag */
+  (*newsf)->pack_threads           = sf->pack_threads;
+  (*newsf)->pack_threads_threshold = sf->pack_threads_threshold;
   if (opt == PETSCSF_DUPLICATE_GRAPH) {
     PetscSFCheckGraphSet(sf, 1);
     if (sf->pattern == PETSCSF_PATTERN_GENERAL) {
@@ -887,6 +991,13 @@ PetscErrorCode PetscSFView(PetscSF sf, PetscViewer viewer)
 
     PetscCall(PetscObjectPrintClassNamePrefixType((PetscObject)sf, viewer));
     PetscCall(PetscViewerASCIIPushTab(viewer));
+    if (sf->autotune_time) {
+      PetscCall(PetscViewerASCIIPrintf(viewer, "Type selected by autotuning, seconds per PetscSFBcast() and PetscSFReduce() pair:"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+      for (i = 0; i < sf->autotune_ntypes; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s %g", sf->autotune_types[i], (double)sf->autotune_time[i]));
+      PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+      PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+    }
     if (sf->pattern == PETSCSF_PATTERN_GENERAL) {
       if (!sf->graphset) {
         PetscCall(PetscViewerASCIIPrintf(viewer, "PetscSFSetGraph() has not been called yet\n"));
@@ -1598,6 +1709,186 @@ PetscErrorCode PetscSFReduceEnd(PetscSF sf, MPI_Datatype unit, const void *leafd
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  PetscSFBcastManyBegin - begin several pointwise broadcasts on the same star forest, sending one aggregated message per neighbor rank, to be
+  concluded with a call to `PetscSFBcastManyEnd()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest on which to communicate
+. n        - number of broadcasts, must be the same on all ranks
+. unit     - array of length `n`, data type associated with each node of each broadcast
+. rootdata - array of length `n`, buffers to broadcast
+- op       - array of length `n`, operations to use for reduction
+
+  Output Parameter:
+. leafdata - array of length `n`, buffers to be reduced with values from each leaf's respective root
+
+  Level: intermediate
+
+  Notes:
+  The call is equivalent to calling `PetscSFBcastBegin()` for each of the `n` (`unit`, `rootdata`, `leafdata`, `op`) tuples, but
+  the remote data of all tuples is sent in one message per neighbor rank instead of `n` messages. This reduces the message count
+  (and hence the latency) when several arrays, for example coordinates, fields and labels, are communicated on the same `PetscSF`.
+
+  `PetscSFBcastManyEnd()` must be called with the same arrays. Only `PETSCSFBASIC` aggregates messages; other types, and data in
+  device memory, fall back to one `PetscSFBcastBegin()` per tuple.
+
+.seealso: `PetscSF`, `PetscSFBcastManyEnd()`, `PetscSFBcastBegin()`, `PetscSFReduceManyBegin()`
+@*/
+PetscErrorCode PetscSFBcastManyBegin(PetscSF sf, PetscInt n, const MPI_Datatype unit[], const void *const rootdata[], void *const leafdata[], const MPI_Op op[])
+{
+  PetscInt      i;
+  PetscMemType *rootmtype, *leafmtype;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of broadcasts %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(unit, 3);
+  PetscAssertPointer(rootdata, 4);
+  PetscAssertPointer(leafdata, 5);
+  PetscAssertPointer(op, 6);
+  PetscCall(PetscSFSetUp(sf));
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastBegin, sf, 0, 0, 0));
+  PetscCall(PetscMalloc2(n, &rootmtype, n, &leafmtype));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscGetMemType(rootdata[i], &rootmtype[i]));
+    PetscCall(PetscGetMemType(leafdata[i], &leafmtype[i]));
+  }
+  if (sf->ops->BcastManyBegin) PetscUseTypeMethod(sf, BcastManyBegin, n, unit, rootmtype, rootdata, leafmtype, leafdata, op);
+  else {
+    for (i = 0; i < n; i++) PetscUseTypeMethod(sf, BcastBegin, unit[i], rootmtype[i], rootdata[i], leafmtype[i], leafdata[i], op[i]);
+  }
+  PetscCall(PetscFree2(rootmtype, leafmtype));
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastBegin, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastManyEnd - end broadcasts started with `PetscSFBcastManyBegin()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. n        - number of broadcasts
+. unit     - array of length `n`, data types
+. rootdata - array of length `n`, buffers to broadcast
+- op       - array of length `n`, operations to use for reduction
+
+  Output Parameter:
+. leafdata - array of length `n`, buffers to be reduced with values from each leaf's respective root
+
+  Level: intermediate
+
+.seealso: `PetscSF`, `PetscSFBcastManyBegin()`, `PetscSFBcastEnd()`
+@*/
+PetscErrorCode PetscSFBcastManyEnd(PetscSF sf, PetscInt n, const MPI_Datatype unit[], const void *const rootdata[], void *const leafdata[], const MPI_Op op[])
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  if (sf->ops->BcastManyEnd) PetscUseTypeMethod(sf, BcastManyEnd, n, unit, rootdata, leafdata, op);
+  else {
+    for (i = 0; i < n; i++) PetscUseTypeMethod(sf, BcastEnd, unit[i], rootdata[i], leafdata[i], op[i]);
+  }
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceManyBegin - begin several reductions of leafdata into rootdata on the same star forest, sending one aggregated message
+  per neighbor rank, to be completed with a call to `PetscSFReduceManyEnd()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. n        - number of reductions, must be the same on all ranks
+. unit     - array of length `n`, data types
+. leafdata - array of length `n`, values to reduce
+- op       - array of length `n`, reduction operations
+
+  Output Parameter:
+. rootdata - array of length `n`, results of reduction of values from all leaves of each root
+
+  Level: intermediate
+
+  Note:
+  The call is equivalent to calling `PetscSFReduceBegin()` for each of the `n` tuples, but with one message per neighbor rank.
+  See `PetscSFBcastManyBegin()` for the restrictions.
+
+.seealso: `PetscSF`, `PetscSFReduceManyEnd()`, `PetscSFReduceBegin()`, `PetscSFBcastManyBegin()`
+@*/
+PetscErrorCode PetscSFReduceManyBegin(PetscSF sf, PetscInt n, const MPI_Datatype unit[], const void *const leafdata[], void *const rootdata[], const MPI_Op op[])
+{
+  PetscInt      i;
+  PetscMemType *rootmtype, *leafmtype;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(n >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of reductions %" PetscInt_FMT " cannot be negative", n);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscAssertPointer(unit, 3);
+  PetscAssertPointer(leafdata, 4);
+  PetscAssertPointer(rootdata, 5);
+  PetscAssertPointer(op, 6);
+  PetscCall(PetscSFSetUp(sf));
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_ReduceBegin, sf, 0, 0, 0));
+  PetscCall(PetscMalloc2(n, &rootmtype, n, &leafmtype));
+  for (i = 0; i < n; i++) {
+    PetscCall(PetscGetMemType(rootdata[i], &rootmtype[i]));
+    PetscCall(PetscGetMemType(leafdata[i], &leafmtype[i]));
+  }
+  if (sf->ops->ReduceManyBegin) PetscUseTypeMethod(sf, ReduceManyBegin, n, unit, leafmtype, leafdata, rootmtype, rootdata, op);
+  else {
+    for (i = 0; i < n; i++) PetscUseTypeMethod(sf, ReduceBegin, unit[i], leafmtype[i], leafdata[i], rootmtype[i], rootdata[i], op[i]);
+  }
+  PetscCall(PetscFree2(rootmtype, leafmtype));
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_ReduceBegin, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFReduceManyEnd - end reductions started with `PetscSFReduceManyBegin()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. n        - number of reductions
+. unit     - array of length `n`, data types
+. leafdata - array of length `n`, values to reduce
+- op       - array of length `n`, reduction operations
+
+  Output Parameter:
+. rootdata - array of length `n`, results of reduction of values from all leaves of each root
+
+  Level: intermediate
+
+.seealso: `PetscSF`, `PetscSFReduceManyBegin()`, `PetscSFReduceEnd()`
+@*/
+PetscErrorCode PetscSFReduceManyEnd(PetscSF sf, PetscInt n, const MPI_Datatype unit[], const void *const leafdata[], void *const rootdata[], const MPI_Op op[])
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_ReduceEnd, sf, 0, 0, 0));
+  if (sf->ops->ReduceManyEnd) PetscUseTypeMethod(sf, ReduceManyEnd, n, unit, leafdata, rootdata, op);
+  else {
+    for (i = 0; i < n; i++) PetscUseTypeMethod(sf, ReduceEnd, unit[i], leafdata[i], rootdata[i], op[i]);
+  }
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_ReduceEnd, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscSFFetchAndOpBegin - begin operation that fetches values from root and updates atomically by applying operation using my leaf value,
   to be completed with `PetscSFFetchAndOpEnd()`
@@ -12,6 +12,9 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Alltoall(PetscSF);
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF);
 #endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hybrid(PetscSF);
+#endif
 
 PetscFunctionList PetscSFList;
 PetscBool         PetscSFRegisterAllCalled;
@@ -41,6 +44,9 @@ PetscErrorCode PetscSFRegisterAll(void)
   PetscCall(PetscSFRegister(PETSCSFALLTOALL, PetscSFCreate_Alltoall));
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
   PetscCall(PetscSFRegister(PETSCSFNEIGHBOR, PetscSFCreate_Neighbor));
+#endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscCall(PetscSFRegister(PETSCSFHYBRID, PetscSFCreate_Hybrid));
 #endif
   PetscFunctionReturn(PETSC_SUCCESS);
 }
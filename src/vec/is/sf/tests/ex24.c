@@ -0,0 +1,115 @@
+static const char help[] = "Test PetscSFBcastManyBegin/End() and PetscSFReduceManyBegin/End() against one operation at a time\n\n";
+
+#include <petscsf.h>
+
+#define NOPS 3
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, nroots = 6, nleaves = 8, i, j, k, bs = 3;
+  PetscMPIInt  rank, size;
+  MPI_Datatype unit[NOPS], vec3;
+  MPI_Op       op[NOPS];
+  PetscInt    *root[NOPS], *leaf[NOPS], *rootref[NOPS], *leafref[NOPS], len[NOPS], nroot[NOPS], nleaf[NOPS];
+  PetscBool    match = PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+
+  /* Leaves are strided and several of them may point to the same root */
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  for (i = 0; i < nleaves; i++) {
+    ilocal[i]        = 2 * i;
+    iremote[i].rank  = (rank + i) % size;
+    iremote[i].index = (5 * i + rank) % nroots;
+  }
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, nroots, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+
+  /* Three operations with different units and ops on the same SF */
+  PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, MPIU_INT, &vec3));
+  PetscCallMPI(MPI_Type_commit(&vec3));
+  unit[0] = MPIU_INT;
+  op[0]   = MPI_REPLACE;
+  len[0]  = 1;
+  unit[1] = vec3;
+  op[1]   = MPI_SUM;
+  len[1]  = bs;
+  unit[2] = MPIU_INT;
+  op[2]   = MPI_MAX;
+  len[2]  = 1;
+  for (k = 0; k < NOPS; k++) {
+    nroot[k] = nroots * len[k];
+    nleaf[k] = 2 * nleaves * len[k];
+    PetscCall(PetscMalloc4(nroot[k], &root[k], nroot[k], &rootref[k], nleaf[k], &leaf[k], nleaf[k], &leafref[k]));
+  }
+
+  /* Bcast */
+  for (k = 0; k < NOPS; k++) {
+    for (j = 0; j < nroot[k]; j++) root[k][j] = 100 * rank + 10 * k + j;
+    for (j = 0; j < nleaf[k]; j++) leaf[k][j] = leafref[k][j] = -j;
+  }
+  PetscCall(PetscSFBcastManyBegin(sf, NOPS, unit, (const void *const *)root, (void *const *)leaf, op));
+  PetscCall(PetscSFBcastManyEnd(sf, NOPS, unit, (const void *const *)root, (void *const *)leaf, op));
+  for (k = 0; k < NOPS; k++) {
+    PetscCall(PetscSFBcastBegin(sf, unit[k], root[k], leafref[k], op[k]));
+    PetscCall(PetscSFBcastEnd(sf, unit[k], root[k], leafref[k], op[k]));
+    for (j = 0; j < nleaf[k]; j++) match = (PetscBool)(match && leaf[k][j] == leafref[k][j]);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSFBcastMany %s\n", match ? "matches" : "does not match"));
+
+  /* Reduce */
+  op[0] = MPI_SUM;
+  for (k = 0; k < NOPS; k++) {
+    for (j = 0; j < nleaf[k]; j++) leaf[k][j] = 100 * rank + 10 * k + j;
+    for (j = 0; j < nroot[k]; j++) root[k][j] = rootref[k][j] = j;
+  }
+  PetscCall(PetscSFReduceManyBegin(sf, NOPS, unit, (const void *const *)leaf, (void *const *)root, op));
+  PetscCall(PetscSFReduceManyEnd(sf, NOPS, unit, (const void *const *)leaf, (void *const *)root, op));
+  for (k = 0; k < NOPS; k++) {
+    PetscCall(PetscSFReduceBegin(sf, unit[k], leaf[k], rootref[k], op[k]));
+    PetscCall(PetscSFReduceEnd(sf, unit[k], leaf[k], rootref[k], op[k]));
+    for (j = 0; j < nroot[k]; j++) match = (PetscBool)(match && root[k][j] == rootref[k][j]);
+  }
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, &match, 1, MPIU_BOOL, MPI_LAND, PETSC_COMM_WORLD));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "PetscSFReduceMany %s\n", match ? "matches" : "does not match"));
+
+  for (k = 0; k < NOPS; k++) PetscCall(PetscFree4(root[k], rootref[k], leaf[k], leafref[k]));
+  PetscCallMPI(MPI_Type_free(&vec3));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 3}}
+      output_file: output/ex24_1.out
+
+      test:
+        suffix: basic
+        args: -sf_type basic
+
+      test:
+        suffix: neighbor
+        requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+        args: -sf_type neighbor
+
+      test:
+        suffix: basic_threads
+        args: -sf_type basic -sf_pack_threads -sf_pack_threads_threshold 0 -omp_num_threads 3
+
+      test:
+        suffix: autotune
+        args: -sf_autotune -sf_autotune_its 2
+
+TEST*/
@@ -613,4 +613,27 @@ int main(int argc, char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_basic_threads
+      output_file: output/ex1_10_basic.out
+      nsize: 4
+      args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0 -sf_pack_threads -sf_pack_threads_threshold 0 -omp_num_threads 3
+
+   testset:
+      filter: grep -v "type" | grep -v "sort" | grep -v "on this node"
+      output_file: output/ex1_10_hybrid.out
+      nsize: 4
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+      args: -sf_type hybrid -test_all -test_bcastop 0 -test_fetchandop 0
+      test:
+         suffix: 10_hybrid
+         args: -sf_hybrid_slots {{1 2}}
+      test:
+         suffix: 10_hybrid_noshared
+         args: -noshared
+      test:
+         suffix: 10_hybrid_aggregate
+         filter: grep -v "type" | grep -v "sort" | grep -v "on this node" | grep -v "node leaders"
+         args: -sf_hybrid_aggregate -noshared {{0 1}}
+
 TEST*/
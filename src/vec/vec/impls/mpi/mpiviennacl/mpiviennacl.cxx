@@ -177,6 +177,8 @@ static PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy                   = VecAXPY_Seq;
     vv->ops->axpby                  = VecAXPBY_Seq;
     vv->ops->maxpy                  = VecMAXPY_Seq;
+    vv->ops->maxpby                 = VecMAXPBY_Seq;
+    vv->ops->maxpymdot              = VecMAXPYAndMDot_MPI;
     vv->ops->aypx                   = VecAYPX_Seq;
     vv->ops->axpbypcz               = VecAXPBYPCZ_Seq;
     vv->ops->pointwisemult          = VecPointwiseMult_Seq;
@@ -209,6 +211,8 @@ static PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy            = VecAXPY_SeqViennaCL;
     vv->ops->axpby           = VecAXPBY_SeqViennaCL;
     vv->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    vv->ops->maxpby          = NULL;
+    vv->ops->maxpymdot       = NULL;
     vv->ops->aypx            = VecAYPX_SeqViennaCL;
     vv->ops->axpbypcz        = VecAXPBYPCZ_SeqViennaCL;
     vv->ops->pointwisemult   = VecPointwiseMult_SeqViennaCL;
@@ -524,7 +524,9 @@ static struct _VecOps DvOps = {PetscDesignatedInitializer(duplicate, VecDuplicat
                                PetscDesignatedInitializer(sum, NULL),
                                PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_MPI),
                                PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_MPI),
-                               PetscDesignatedInitializer(errorwnorm, NULL)};
+                               PetscDesignatedInitializer(errorwnorm, NULL),
+                               PetscDesignatedInitializer(maxpby, VecMAXPBY_Seq),
+                               PetscDesignatedInitializer(maxpymdot, VecMAXPYAndMDot_MPI)};
 
 /*
     VecCreate_MPI_Private - Basic create routine called by VecCreate_MPI() (i.e. VecCreateMPI()),
@@ -25,6 +25,14 @@ PetscErrorCode VecMDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecMAXPYAndMDot_MPI(Vec yin, PetscInt nv, const PetscScalar alpha[], Vec x[], PetscInt nz, const Vec z[], PetscScalar *val)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMAXPYAndMDot_Seq(yin, nv, alpha, x, nz, z, val));
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, val, nz, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)yin)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecMDot_MPI_GEMV(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
 {
   PetscFunctionBegin;
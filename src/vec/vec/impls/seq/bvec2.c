@@ -884,6 +884,8 @@ static struct _VecOps DvOps = {
   PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_Seq),
   PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_Seq),
   PetscDesignatedInitializer(errorwnorm, NULL),
+  PetscDesignatedInitializer(maxpby, VecMAXPBY_Seq),
+  PetscDesignatedInitializer(maxpymdot, VecMAXPYAndMDot_Seq),
 };
 
 /*
@@ -755,6 +755,167 @@ PetscErrorCode VecMAXPY_Seq_GEMV(Vec yin, PetscInt nv, const PetscScalar alpha[]
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The kernels below that combine several vectors sweep them in chunks of VEC_SEQ_CHUNK entries, with all the vectors
+   applied to a chunk before moving to the next, so that y (and the vectors read twice) is only streamed once from memory
+*/
+#define VEC_SEQ_CHUNK 512
+
+/* y = beta y + sum alpha[j] x[j] on the chunk [k, k + n), y is not read when beta is zero */
+static inline void VecMAXPBYChunk_Private(PetscInt k, PetscInt n, PetscScalar *PETSC_RESTRICT yy, PetscScalar beta, PetscInt nv, const PetscScalar alpha[], const PetscScalar *const xx[])
+{
+  PetscInt j = 1;
+
+  yy += k;
+  if (!nv) {
+    if (beta == (PetscScalar)0.0) {
+      for (PetscInt i = 0; i < n; i++) yy[i] = 0.0;
+    } else if (beta != (PetscScalar)1.0) {
+      for (PetscInt i = 0; i < n; i++) yy[i] *= beta;
+    }
+    return;
+  }
+  if (beta == (PetscScalar)0.0) {
+    for (PetscInt i = 0; i < n; i++) yy[i] = alpha[0] * xx[0][k + i];
+  } else if (beta == (PetscScalar)1.0) {
+    for (PetscInt i = 0; i < n; i++) yy[i] += alpha[0] * xx[0][k + i];
+  } else {
+    for (PetscInt i = 0; i < n; i++) yy[i] = beta * yy[i] + alpha[0] * xx[0][k + i];
+  }
+  for (; j + 4 <= nv; j += 4) {
+    const PetscScalar *PETSC_RESTRICT x0 = xx[j] + k, *PETSC_RESTRICT x1 = xx[j + 1] + k, *PETSC_RESTRICT x2 = xx[j + 2] + k, *PETSC_RESTRICT x3 = xx[j + 3] + k;
+    const PetscScalar                 a0 = alpha[j], a1 = alpha[j + 1], a2 = alpha[j + 2], a3 = alpha[j + 3];
+
+    for (PetscInt i = 0; i < n; i++) yy[i] += a0 * x0[i] + a1 * x1[i] + a2 * x2[i] + a3 * x3[i];
+  }
+  for (; j < nv; j++) {
+    const PetscScalar *PETSC_RESTRICT x0 = xx[j] + k;
+    const PetscScalar                 a0 = alpha[j];
+
+    for (PetscInt i = 0; i < n; i++) yy[i] += a0 * x0[i];
+  }
+}
+
+/* val[j] += y' conj(z[j]) on the chunk [k, k + n) */
+static inline void VecMDotChunk_Private(PetscInt k, PetscInt n, const PetscScalar *PETSC_RESTRICT yy, PetscInt nz, const PetscScalar *const zz[], PetscScalar val[])
+{
+  PetscInt j = 0;
+
+  yy += k;
+  for (; j + 4 <= nz; j += 4) {
+    const PetscScalar *PETSC_RESTRICT z0 = zz[j] + k, *PETSC_RESTRICT z1 = zz[j + 1] + k, *PETSC_RESTRICT z2 = zz[j + 2] + k, *PETSC_RESTRICT z3 = zz[j + 3] + k;
+    PetscScalar                       sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscScalar y = yy[i];
+
+      sum0 += y * PetscConj(z0[i]);
+      sum1 += y * PetscConj(z1[i]);
+      sum2 += y * PetscConj(z2[i]);
+      sum3 += y * PetscConj(z3[i]);
+    }
+    val[j] += sum0;
+    val[j + 1] += sum1;
+    val[j + 2] += sum2;
+    val[j + 3] += sum3;
+  }
+  for (; j < nz; j++) {
+    const PetscScalar *PETSC_RESTRICT z0   = zz[j] + k;
+    PetscScalar                       sum0 = 0.0;
+
+    for (PetscInt i = 0; i < n; i++) sum0 += yy[i] * PetscConj(z0[i]);
+    val[j] += sum0;
+  }
+}
+
+static PetscErrorCode VecGetArraysRead_Private(PetscInt nv, const Vec x[], Vec y, const PetscScalar *yy, const PetscScalar *xx[])
+{
+  PetscFunctionBegin;
+  for (PetscInt j = 0; j < nv; j++) {
+    if (x[j] == y) xx[j] = yy;
+    else PetscCall(VecGetArrayRead(x[j], &xx[j]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecRestoreArraysRead_Private(PetscInt nv, const Vec x[], Vec y, const PetscScalar *xx[])
+{
+  PetscFunctionBegin;
+  for (PetscInt j = 0; j < nv; j++) {
+    if (x[j] != y) PetscCall(VecRestoreArrayRead(x[j], &xx[j]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* number of vectors whose arrays the kernels above hold at once, more vectors are applied in several sweeps over y */
+#define VEC_SEQ_NV_BLOCK 32
+
+/*  y = beta y + sum alpha[i] x[i] */
+PetscErrorCode VecMAXPBY_Seq(Vec yin, PetscInt nv, const PetscScalar alpha[], PetscScalar beta, Vec xin[])
+{
+  const PetscInt     n = yin->map->n;
+  PetscScalar       *yy;
+  const PetscScalar *xx[VEC_SEQ_NV_BLOCK];
+  PetscInt           j = 0;
+
+  PetscFunctionBegin;
+  if (beta == (PetscScalar)0.0) PetscCall(VecGetArrayWrite(yin, &yy));
+  else PetscCall(VecGetArray(yin, &yy));
+  do {
+    const PetscInt nb = PetscMin(VEC_SEQ_NV_BLOCK, nv - j);
+
+    PetscCall(VecGetArraysRead_Private(nb, xin + j, NULL, NULL, xx));
+    for (PetscInt k = 0; k < n; k += VEC_SEQ_CHUNK) VecMAXPBYChunk_Private(k, PetscMin(VEC_SEQ_CHUNK, n - k), yy, j ? 1.0 : beta, nb, alpha + j, xx);
+    PetscCall(VecRestoreArraysRead_Private(nb, xin + j, NULL, xx));
+    j += nb;
+  } while (j < nv);
+  if (beta == (PetscScalar)0.0) PetscCall(VecRestoreArrayWrite(yin, &yy));
+  else PetscCall(VecRestoreArray(yin, &yy));
+  PetscCall(PetscLogFlops(nv * 2.0 * n + (beta == (PetscScalar)0.0 || beta == (PetscScalar)1.0 ? 0.0 : n)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*  y = y + sum alpha[i] x[i], then val[j] = y' conj(z[j]) with the updated y; z[] can contain y and the x[] */
+PetscErrorCode VecMAXPYAndMDot_Seq(Vec yin, PetscInt nv, const PetscScalar alpha[], Vec xin[], PetscInt nz, const Vec zin[], PetscScalar val[])
+{
+  const PetscInt     n = yin->map->n;
+  PetscScalar       *yy;
+  const PetscScalar *xx[VEC_SEQ_NV_BLOCK], *zz[VEC_SEQ_NV_BLOCK];
+  PetscInt           jx = 0, jz = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(val, nz));
+  PetscCall(VecGetArray(yin, &yy));
+  /* the inner products with the first block of z[] are computed in the sweep that applies the last block of x[] */
+  do {
+    const PetscInt nbx = PetscMin(VEC_SEQ_NV_BLOCK, nv - jx), nbz = jx + nbx == nv ? PetscMin(VEC_SEQ_NV_BLOCK, nz) : 0;
+
+    PetscCall(VecGetArraysRead_Private(nbx, xin + jx, NULL, NULL, xx));
+    PetscCall(VecGetArraysRead_Private(nbz, zin, yin, yy, zz));
+    for (PetscInt k = 0; k < n; k += VEC_SEQ_CHUNK) {
+      const PetscInt m = PetscMin(VEC_SEQ_CHUNK, n - k);
+
+      VecMAXPBYChunk_Private(k, m, yy, 1.0, nbx, alpha + jx, xx);
+      VecMDotChunk_Private(k, m, yy, nbz, zz, val);
+    }
+    PetscCall(VecRestoreArraysRead_Private(nbz, zin, yin, zz));
+    PetscCall(VecRestoreArraysRead_Private(nbx, xin + jx, NULL, xx));
+    jx += nbx;
+    jz = nbz;
+  } while (jx < nv);
+  while (jz < nz) {
+    const PetscInt nbz = PetscMin(VEC_SEQ_NV_BLOCK, nz - jz);
+
+    PetscCall(VecGetArraysRead_Private(nbz, zin + jz, yin, yy, zz));
+    for (PetscInt k = 0; k < n; k += VEC_SEQ_CHUNK) VecMDotChunk_Private(k, PetscMin(VEC_SEQ_CHUNK, n - k), yy, nbz, zz, val + jz);
+    PetscCall(VecRestoreArraysRead_Private(nbz, zin + jz, yin, zz));
+    jz += nbz;
+  }
+  PetscCall(VecRestoreArray(yin, &yy));
+  PetscCall(PetscLogFlops(nv * 2.0 * n + PetscMax(nz * (2.0 * n - 1), 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/faypx.h>
 
 PetscErrorCode VecAYPX_Seq(Vec yin, PetscScalar alpha, Vec xin)
@@ -1197,6 +1197,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_Seq;
     V->ops->mtdot_local     = VecMTDot_Seq;
     V->ops->maxpy           = VecMAXPY_Seq;
+    V->ops->maxpby          = VecMAXPBY_Seq;
+    V->ops->maxpymdot       = VecMAXPYAndMDot_Seq;
     V->ops->mdot            = VecMDot_Seq;
     V->ops->mtdot           = VecMTDot_Seq;
     V->ops->aypx            = VecAYPX_Seq;
@@ -1226,6 +1228,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_SeqViennaCL;
     V->ops->mtdot_local     = VecMTDot_SeqViennaCL;
     V->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    V->ops->maxpby          = NULL;
+    V->ops->maxpymdot       = NULL;
     V->ops->mdot            = VecMDot_SeqViennaCL;
     V->ops->mtdot           = VecMTDot_SeqViennaCL;
     V->ops->aypx            = VecAYPX_SeqViennaCL;
@@ -1276,7 +1276,7 @@ PetscErrorCode VecMAXPYAsync_Private(Vec y, PetscInt nv, const PetscScalar alpha
   Note:
   `y` cannot be any of the `x` vectors
 
-.seealso: [](ch_vectors), `Vec`, `VecMAXPBY()`,`VecAYPX()`, `VecWAXPY()`, `VecAXPY()`, `VecAXPBYPCZ()`, `VecAXPBY()`
+.seealso: [](ch_vectors), `Vec`, `VecMAXPBY()`,`VecAYPX()`, `VecWAXPY()`, `VecAXPY()`, `VecAXPBYPCZ()`, `VecAXPBY()`, `VecMAXPYAndMDot()`
 @*/
 PetscErrorCode VecMAXPY(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[])
 {
@@ -1305,7 +1305,7 @@ PetscErrorCode VecMAXPY(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[])
   Developer Notes:
   This is a convenience routine, but implementations might be able to optimize it, for example, when `beta` is zero.
 
-.seealso: [](ch_vectors), `Vec`, `VecMAXPY()`, `VecAYPX()`, `VecWAXPY()`, `VecAXPY()`, `VecAXPBYPCZ()`, `VecAXPBY()`
+.seealso: [](ch_vectors), `Vec`, `VecMAXPY()`, `VecAYPX()`, `VecWAXPY()`, `VecAXPY()`, `VecAXPBYPCZ()`, `VecAXPBY()`, `VecMAXPYAndMDot()`
 @*/
 PetscErrorCode VecMAXPBY(Vec y, PetscInt nv, const PetscScalar alpha[], PetscScalar beta, Vec x[])
 {
@@ -1355,6 +1355,89 @@ PetscErrorCode VecMAXPBY(Vec y, PetscInt nv, const PetscScalar alpha[], PetscSca
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  VecMAXPYAndMDot - Computes `y = y + sum alpha[i] x[i]` and then the inner products of the updated `y` with the vectors `z[j]`
+
+  Collective
+
+  Input Parameters:
++ y     - the vector to update
+. nv    - number of scalars and x-vectors
+. alpha - array of scalars
+. x     - array of vectors
+. nz    - number of z-vectors
+- z     - array of vectors, which can contain `y` and any of the `x` vectors
+
+  Output Parameter:
+. val - array of the `nz` inner products, `val[j] = y' conj(z[j])` as computed by `VecMDot()`
+
+  Level: advanced
+
+  Notes:
+  This has the same result as `VecMAXPY()` followed by `VecMDot()`, up to rounding. For `VECSEQ` and `VECMPI` the update and the
+  inner products are computed in a single sweep over the vectors, one cache-sized chunk at a time, so that `y` and the vectors
+  that appear in both `x` and `z` are only read once from memory instead of twice. The vector types that do not provide the
+  fused operation call `VecMAXPY()` and `VecMDot()`.
+
+  `y` cannot be any of the `x` vectors.
+
+.seealso: [](ch_vectors), `Vec`, `VecMAXPY()`, `VecMDot()`, `VecMAXPBY()`, `VecDotNorm2()`
+@*/
+PetscErrorCode VecMAXPYAndMDot(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[], PetscInt nz, const Vec z[], PetscScalar val[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 1);
+  PetscValidType(y, 1);
+  VecCheckAssembled(y);
+  PetscValidLogicalCollectiveInt(y, nv, 2);
+  PetscValidLogicalCollectiveInt(y, nz, 5);
+  PetscCall(VecSetErrorIfLocked(y, 1));
+  PetscCheck(nv >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nv);
+  PetscCheck(nz >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nz);
+  if (!y->ops->maxpymdot) {
+    PetscCall(VecMAXPY(y, nv, alpha, x));
+    PetscCall(VecMDot(y, nz, z, val));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (nv) {
+    PetscAssertPointer(alpha, 3);
+    PetscAssertPointer(x, 4);
+  }
+  if (nz) {
+    PetscAssertPointer(z, 6);
+    PetscAssertPointer(val, 7);
+  }
+  for (PetscInt i = 0; i < nv; ++i) {
+    PetscValidLogicalCollectiveScalar(y, alpha[i], 3);
+    PetscValidHeaderSpecific(x[i], VEC_CLASSID, 4);
+    PetscValidType(x[i], 4);
+    PetscCheckSameTypeAndComm(y, 1, x[i], 4);
+    VecCheckSameSize(y, 1, x[i], 4);
+    PetscCheck(y != x[i], PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Array of vectors 'x' cannot contain y, found x[%" PetscInt_FMT "] == y", i);
+    VecCheckAssembled(x[i]);
+    PetscCall(VecLockReadPush(x[i]));
+  }
+  for (PetscInt j = 0; j < nz; ++j) {
+    PetscValidHeaderSpecific(z[j], VEC_CLASSID, 6);
+    PetscValidType(z[j], 6);
+    PetscCheckSameTypeAndComm(y, 1, z[j], 6);
+    VecCheckSameSize(y, 1, z[j], 6);
+    VecCheckAssembled(z[j]);
+    if (z[j] != y) PetscCall(VecLockReadPush(z[j]));
+  }
+
+  PetscCall(PetscLogEventBegin(VEC_MAXPYMDot, y, nv ? *x : NULL, nz ? *z : NULL, 0));
+  PetscUseTypeMethod(y, maxpymdot, nv, alpha, x, nz, z, val);
+  PetscCall(PetscLogEventEnd(VEC_MAXPYMDot, y, nv ? *x : NULL, nz ? *z : NULL, 0));
+  if (nv) PetscCall(PetscObjectStateIncrease((PetscObject)y));
+
+  for (PetscInt i = 0; i < nv; ++i) PetscCall(VecLockReadPop(x[i]));
+  for (PetscInt j = 0; j < nz; ++j) {
+    if (z[j] != y) PetscCall(VecLockReadPop(z[j]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   VecConcatenate - Creates a new vector that is a vertical concatenation of all the given array of vectors
   in the order they appear in the array. The concatenated vector resides on the same
@@ -0,0 +1,101 @@
+static char help[] = "Tests VecMAXPBY() and VecMAXPYAndMDot() against VecMAXPY() and VecMDot().\n\n";
+
+#include <petscvec.h>
+
+int main(int argc, char **argv)
+{
+  Vec         *x, y, yref, w, z[5];
+  PetscInt     n = 1100, nvs[] = {0, 1, 3, 4, 9};
+  PetscScalar  alpha[9], betas[] = {0.0, 1.0, -2.0}, val[5], valref[5];
+  PetscReal    nrm, nrmref;
+  PetscRandom  rnd;
+  PetscBool    ok = PETSC_TRUE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &y));
+  PetscCall(VecSetSizes(y, n, PETSC_DECIDE));
+  PetscCall(VecSetFromOptions(y));
+  PetscCall(VecDuplicate(y, &yref));
+  PetscCall(VecDuplicate(y, &w));
+  PetscCall(VecDuplicateVecs(y, 9, &x));
+  for (PetscInt i = 0; i < 9; i++) {
+    PetscCall(VecSetRandom(x[i], rnd));
+    alpha[i] = 1.0 / (i + 1.0) - 0.3;
+  }
+  PetscCall(VecSetRandom(w, rnd));
+
+  /* y = beta y + sum alpha[i] x[i] */
+  for (PetscInt k = 0; k < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(nvs); k++) {
+    for (PetscInt b = 0; b < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(betas); b++) {
+      PetscCall(VecSetRandom(y, rnd));
+      PetscCall(VecCopy(y, yref));
+      PetscCall(VecMAXPBY(y, nvs[k], alpha, betas[b], x));
+      PetscCall(VecScale(yref, betas[b]));
+      PetscCall(VecMAXPY(yref, nvs[k], alpha, x));
+      PetscCall(VecNorm(yref, NORM_2, &nrmref));
+      PetscCall(VecAXPY(y, -1.0, yref));
+      PetscCall(VecNorm(y, NORM_2, &nrm));
+      if (nrm > 100 * PETSC_MACHINE_EPSILON * nrmref) {
+        ok = PETSC_FALSE;
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD, "VecMAXPBY() with %" PetscInt_FMT " vectors and beta %g: error %g\n", nvs[k], (double)PetscRealPart(betas[b]), (double)nrm));
+      }
+    }
+  }
+
+  /* y = y + sum alpha[i] x[i], then the inner products of y with itself, two of the x[i] and another vector */
+  for (PetscInt k = 0; k < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(nvs); k++) {
+    for (PetscInt nz = 0; nz <= 5; nz++) {
+      PetscCall(VecSetRandom(y, rnd));
+      PetscCall(VecCopy(y, yref));
+      z[0] = w;
+      z[1] = y;
+      z[2] = x[0];
+      z[3] = x[8];
+      z[4] = y;
+      PetscCall(VecMAXPYAndMDot(y, nvs[k], alpha, x, nz, z, val));
+      z[1] = z[4] = yref;
+      PetscCall(VecMAXPY(yref, nvs[k], alpha, x));
+      PetscCall(VecMDot(yref, nz, z, valref));
+      PetscCall(VecNorm(yref, NORM_2, &nrmref));
+      for (PetscInt j = 0; j < nz; j++) {
+        if (PetscAbsScalar(val[j] - valref[j]) > 100 * PETSC_MACHINE_EPSILON * n * PetscMax(nrmref * nrmref, 1.0)) {
+          ok = PETSC_FALSE;
+          PetscCall(PetscPrintf(PETSC_COMM_WORLD, "VecMAXPYAndMDot() with %" PetscInt_FMT " vectors: inner product %" PetscInt_FMT " of %" PetscInt_FMT " is %g instead of %g\n", nvs[k], j, nz, (double)PetscRealPart(val[j]), (double)PetscRealPart(valref[j])));
+        }
+      }
+      PetscCall(VecAXPY(y, -1.0, yref));
+      PetscCall(VecNorm(y, NORM_2, &nrm));
+      if (nrm > 100 * PETSC_MACHINE_EPSILON * nrmref) {
+        ok = PETSC_FALSE;
+        PetscCall(PetscPrintf(PETSC_COMM_WORLD, "VecMAXPYAndMDot() with %" PetscInt_FMT " vectors: error %g\n", nvs[k], (double)nrm));
+      }
+    }
+  }
+  if (ok) PetscCall(PetscPrintf(PETSC_COMM_WORLD, "VecMAXPBY() and VecMAXPYAndMDot() agree with VecMAXPY() and VecMDot()\n"));
+
+  PetscCall(VecDestroyVecs(9, &x));
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&yref));
+  PetscCall(VecDestroy(&y));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      output_file: output/ex65_1.out
+
+   test:
+      suffix: small
+      args: -n 7
+      output_file: output/ex65_1.out
+
+TEST*/